@@ -0,0 +1,116 @@
+//
+//  LatencyRecorder.cpp
+//  cPPiIS Tools - Load Generator Latency Recorder Implementation
+//
+
+#include "LatencyRecorder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace BSUIR {
+namespace Tools {
+
+namespace {
+
+// Stage order for the breakdown table
+const char* const STAGES[] = {"queue", "connect", "ttfb", "transfer", "parse", "callback"};
+
+double percentile(const std::vector<int64_t>& sorted, double fraction) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+    size_t index = rank == 0 ? 0 : std::min(rank - 1, sorted.size() - 1);
+    return static_cast<double>(sorted[index]) / 1e6;
+}
+
+void printRow(std::ostream& out, const std::string& label, const LatencyRecorder::Summary& summary) {
+    out << "  " << std::left << std::setw(34) << label << std::right
+        << std::setw(9) << summary.count
+        << std::fixed << std::setprecision(2)
+        << std::setw(10) << summary.p50
+        << std::setw(10) << summary.p90
+        << std::setw(10) << summary.p99
+        << std::setw(10) << summary.p999
+        << std::setw(10) << summary.max << "\n";
+}
+
+} // namespace
+
+void LatencyRecorder::record(const std::string& endpoint, const std::string& stage, std::chrono::nanoseconds duration) {
+    std::lock_guard<std::mutex> lock(mutex);
+    endpoints[endpoint][stage].samples.push_back(std::max<int64_t>(0, duration.count()));
+}
+
+void LatencyRecorder::recordError(const std::string& endpoint) {
+    std::lock_guard<std::mutex> lock(mutex);
+    endpoints[endpoint]["total"].errors++;
+}
+
+LatencyRecorder::Summary LatencyRecorder::summarize(std::vector<int64_t> samples) {
+    Summary result;
+    std::sort(samples.begin(), samples.end());
+    result.count = samples.size();
+    result.p50 = percentile(samples, 0.50);
+    result.p90 = percentile(samples, 0.90);
+    result.p99 = percentile(samples, 0.99);
+    result.p999 = percentile(samples, 0.999);
+    result.max = samples.empty() ? 0.0 : static_cast<double>(samples.back()) / 1e6;
+    return result;
+}
+
+LatencyRecorder::Summary LatencyRecorder::summary(const std::string& endpoint, const std::string& stage) const {
+    std::vector<int64_t> copy;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto endpointIt = endpoints.find(endpoint);
+        if (endpointIt == endpoints.end()) return {};
+        auto stageIt = endpointIt->second.find(stage);
+        if (stageIt == endpointIt->second.end()) return {};
+        copy = stageIt->second.samples;
+    }
+    return summarize(std::move(copy));
+}
+
+void LatencyRecorder::report(std::ostream& out, double elapsedSeconds) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::size_t totalRequests = 0;
+    std::size_t totalErrors = 0;
+    for (const auto& endpoint : endpoints) {
+        auto total = endpoint.second.find("total");
+        if (total != endpoint.second.end()) {
+            totalRequests += total->second.samples.size();
+            totalErrors += total->second.errors;
+        }
+    }
+
+    out << "\n📊 Load test results (" << std::fixed << std::setprecision(1) << elapsedSeconds << " s)\n"
+        << "  Requests: " << totalRequests << ", errors: " << totalErrors
+        << ", throughput: " << std::setprecision(1)
+        << (elapsedSeconds > 0 ? static_cast<double>(totalRequests) / elapsedSeconds : 0.0) << " req/s\n\n";
+
+    out << "  " << std::left << std::setw(34) << "endpoint / stage (ms)" << std::right
+        << std::setw(9) << "count" << std::setw(10) << "p50" << std::setw(10) << "p90"
+        << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << "\n";
+
+    for (const auto& endpoint : endpoints) {
+        auto total = endpoint.second.find("total");
+        if (total != endpoint.second.end()) {
+            std::string label = endpoint.first;
+            if (total->second.errors > 0) {
+                label += " (" + std::to_string(total->second.errors) + " err)";
+            }
+            printRow(out, label, summarize(total->second.samples));
+        }
+        for (const char* stage : STAGES) {
+            auto series = endpoint.second.find(stage);
+            if (series != endpoint.second.end()) {
+                printRow(out, std::string("    ") + stage, summarize(series->second.samples));
+            }
+        }
+    }
+    out.flush();
+}
+
+} // namespace Tools
+} // namespace BSUIR
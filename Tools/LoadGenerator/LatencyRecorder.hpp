@@ -0,0 +1,76 @@
+//
+//  LatencyRecorder.hpp
+//  cPPiIS Tools - Load Generator Latency Recorder
+//
+//  Exact percentile bookkeeping for load test series
+//
+
+#ifndef LatencyRecorder_hpp
+#define LatencyRecorder_hpp
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace BSUIR {
+namespace Tools {
+
+/**
+ * @brief Collects raw latency samples per endpoint and stage
+ *
+ * Samples are kept in full so percentiles are exact; a run of a few
+ * million requests needs only tens of megabytes.
+ */
+class LatencyRecorder {
+public:
+    struct Summary {
+        std::size_t count = 0;
+        double p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;   ///< milliseconds
+    };
+
+private:
+    struct Series {
+        std::vector<int64_t> samples;   ///< nanoseconds
+        std::size_t errors = 0;
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::string, std::map<std::string, Series>> endpoints;
+
+    static Summary summarize(std::vector<int64_t> samples);
+
+public:
+    /**
+     * @brief Record one stage duration
+     * @param endpoint Endpoint path, e.g. "/markbook"
+     * @param stage Stage name ("total", "connect", "ttfb", ...)
+     * @param duration Measured duration (negative values are clamped)
+     */
+    void record(const std::string& endpoint, const std::string& stage, std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Count a failed request for an endpoint
+     */
+    void recordError(const std::string& endpoint);
+
+    /**
+     * @brief Summary for one series
+     */
+    Summary summary(const std::string& endpoint, const std::string& stage) const;
+
+    /**
+     * @brief Print throughput and percentile tables
+     * @param out Output stream
+     * @param elapsedSeconds Wall-clock duration of the run
+     */
+    void report(std::ostream& out, double elapsedSeconds) const;
+};
+
+} // namespace Tools
+} // namespace BSUIR
+
+#endif /* LatencyRecorder_hpp */
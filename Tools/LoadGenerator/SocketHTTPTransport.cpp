@@ -0,0 +1,276 @@
+//
+//  SocketHTTPTransport.cpp
+//  cPPiIS Tools - Plain HTTP/1.1 Transport Implementation
+//
+
+#include "SocketHTTPTransport.hpp"
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+
+namespace BSUIR {
+namespace Tools {
+
+namespace {
+
+struct ParsedUrl {
+    std::string host;
+    std::string port = "80";
+    std::string target = "/";
+};
+
+bool parseUrl(const std::string& url, ParsedUrl& parsed) {
+    const std::string scheme = "http://";
+    if (url.compare(0, scheme.size(), scheme) != 0) {
+        return false;
+    }
+
+    size_t hostStart = scheme.size();
+    size_t pathStart = url.find('/', hostStart);
+    std::string authority = url.substr(hostStart, pathStart == std::string::npos ? std::string::npos : pathStart - hostStart);
+    if (pathStart != std::string::npos) {
+        parsed.target = url.substr(pathStart);
+    }
+
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos) {
+        parsed.host = authority.substr(0, colon);
+        parsed.port = authority.substr(colon + 1);
+    } else {
+        parsed.host = authority;
+    }
+    return !parsed.host.empty();
+}
+
+bool sendAll(int socket, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t written = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            if (written < 0 && errno == EINTR) continue;
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+std::string lowercase(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+void applyTimeout(int socket, double seconds) {
+    timeval timeout{};
+    timeout.tv_sec = static_cast<time_t>(seconds);
+    timeout.tv_usec = static_cast<suseconds_t>((seconds - static_cast<double>(timeout.tv_sec)) * 1e6);
+    ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+} // namespace
+
+// ========================================
+// SocketHTTPTransport Implementation
+// ========================================
+
+SocketHTTPTransport::SocketHTTPTransport(std::shared_ptr<IExecutor> executor)
+    : ioExecutor(std::move(executor)) {
+}
+
+SocketHTTPTransport::~SocketHTTPTransport() {
+    for (int socket : idleConnections) {
+        ::close(socket);
+    }
+}
+
+void SocketHTTPTransport::send(const HTTPRequest& request, ResponseCallback callback) {
+    auto self = shared_from_this();
+    ioExecutor->post([self, request, callback = std::move(callback)] {
+        callback(self->execute(request));
+    });
+}
+
+HTTPResponse SocketHTTPTransport::execute(const HTTPRequest& request) {
+    HTTPResponse response;
+    response.timings.requestStart = HTTPTimings::Clock::now();
+
+    ParsedUrl url;
+    if (!parseUrl(request.url, url)) {
+        response.errorMessage = "Unsupported URL: " + request.url;
+        return response;
+    }
+
+    std::ostringstream wire;
+    wire << httpMethodName(request.method) << " " << url.target << " HTTP/1.1\r\n"
+         << "Host: " << url.host << ":" << url.port << "\r\n";
+    for (const auto& header : request.headers) {
+        wire << header.first << ": " << header.second << "\r\n";
+    }
+    std::string cookie = jarFor(request).cookieHeader(request.url);
+    if (!cookie.empty()) {
+        wire << "Cookie: " << cookie << "\r\n";
+    }
+    wire << "Content-Length: " << request.body.size() << "\r\n\r\n" << request.body;
+    const std::string bytes = wire.str();
+
+    // A pooled connection may have been closed by the server; retry once on a fresh one
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        bool reused = false;
+        int socket = acquireConnection(url.host, url.port, reused);
+        if (socket < 0) {
+            response.errorMessage = "Connection failed: " + url.host + ":" + url.port;
+            return response;
+        }
+        response.timings.connectEnd = HTTPTimings::Clock::now();
+        applyTimeout(socket, request.timeoutSeconds);
+
+        bool keepAlive = false;
+        if (exchange(socket, bytes, request, response, keepAlive)) {
+            if (keepAlive) {
+                releaseConnection(socket);
+            } else {
+                ::close(socket);
+            }
+            response.success = response.statusCode >= 200 && response.statusCode < 300;
+            if (!response.success) {
+                response.errorMessage = "HTTP Error " + std::to_string(response.statusCode);
+            }
+            return response;
+        }
+
+        ::close(socket);
+        if (!reused) {
+            break;
+        }
+    }
+
+    response.statusCode = 0;
+    response.errorMessage = "Network error while talking to " + url.host;
+    return response;
+}
+
+bool SocketHTTPTransport::exchange(int socket, const std::string& wire, const HTTPRequest& request,
+                                   HTTPResponse& response, bool& keepAlive) {
+    if (!sendAll(socket, wire)) {
+        return false;
+    }
+
+    std::string buffer;
+    char chunk[16 * 1024];
+    size_t headerEnd = std::string::npos;
+
+    while (headerEnd == std::string::npos) {
+        ssize_t received = ::recv(socket, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return false;
+        }
+        if (buffer.empty()) {
+            response.timings.firstByte = HTTPTimings::Clock::now();
+        }
+        buffer.append(chunk, static_cast<size_t>(received));
+        headerEnd = buffer.find("\r\n\r\n");
+    }
+
+    std::istringstream head(buffer.substr(0, headerEnd));
+    std::string statusLine;
+    std::getline(head, statusLine);
+    std::istringstream statusStream(statusLine);
+    std::string version;
+    statusStream >> version >> response.statusCode;
+
+    keepAlive = version == "HTTP/1.1";
+    size_t contentLength = 0;
+    std::string line;
+    while (std::getline(head, line)) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string name = lowercase(line.substr(0, colon));
+        std::string value = line.substr(colon + 1);
+        value.erase(0, value.find_first_not_of(' '));
+        if (!value.empty() && value.back() == '\r') value.pop_back();
+
+        if (name == "content-length") {
+            contentLength = static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+        } else if (name == "connection") {
+            keepAlive = lowercase(value) != "close";
+        } else if (name == "set-cookie") {
+            jarFor(request).setCookie(request.url, value);
+        }
+    }
+
+    const size_t bodyStart = headerEnd + 4;
+    while (buffer.size() < bodyStart + contentLength) {
+        ssize_t received = ::recv(socket, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(received));
+    }
+
+    response.data = buffer.substr(bodyStart, contentLength);
+    response.timings.responseEnd = HTTPTimings::Clock::now();
+    return true;
+}
+
+int SocketHTTPTransport::acquireConnection(const std::string& host, const std::string& port, bool& reused) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!idleConnections.empty()) {
+            int socket = idleConnections.back();
+            idleConnections.pop_back();
+            reused = true;
+            return socket;
+        }
+    }
+
+    reused = false;
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (::getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+        return -1;
+    }
+
+    int socket = -1;
+    for (addrinfo* address = addresses; address; address = address->ai_next) {
+        socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (socket < 0) continue;
+        if (::connect(socket, address->ai_addr, address->ai_addrlen) == 0) break;
+        ::close(socket);
+        socket = -1;
+    }
+    ::freeaddrinfo(addresses);
+
+    if (socket >= 0) {
+        int noDelay = 1;
+        ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+    return socket;
+}
+
+void SocketHTTPTransport::releaseConnection(int socket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    idleConnections.push_back(socket);
+}
+
+std::string SocketHTTPTransport::cookieHeader(const std::string& url) const {
+    return cookies->cookieHeader(url);
+}
+
+void SocketHTTPTransport::restoreCookies(const std::string& url, const std::string& header) {
+    cookies->restoreCookies(url, header);
+}
+
+} // namespace Tools
+} // namespace BSUIR
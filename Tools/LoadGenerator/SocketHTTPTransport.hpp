@@ -0,0 +1,67 @@
+//
+//  SocketHTTPTransport.hpp
+//  cPPiIS Tools - Plain HTTP/1.1 Transport
+//
+//  Blocking POSIX socket transport for driving a loopback or LAN
+//  server (the mock IIS server) from command line tools
+//
+
+#ifndef SocketHTTPTransport_hpp
+#define SocketHTTPTransport_hpp
+
+#include "CookieJar.hpp"
+#include "HTTPTransport.hpp"
+#include "Executor.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace BSUIR {
+namespace Tools {
+
+/**
+ * @brief Keep-alive HTTP/1.1 client over plain TCP
+ *
+ * Requests run on the injected I/O executor, so the executor size caps
+ * the number of requests in flight. Each transport instance keeps its
+ * own idle connections and therefore models one device; cookies go to
+ * the request's jar, or the instance's own when it has none.
+ * Only http:// URLs with Content-Length framed responses are supported.
+ */
+class SocketHTTPTransport : public IHTTPTransport,
+                            public std::enable_shared_from_this<SocketHTTPTransport> {
+private:
+    std::shared_ptr<IExecutor> ioExecutor;
+
+    mutable std::mutex mutex;
+    std::vector<int> idleConnections;
+    std::shared_ptr<CookieJar> cookies = std::make_shared<CookieJar>();
+
+    HTTPResponse execute(const HTTPRequest& request);
+    bool exchange(int socket, const std::string& wire, const HTTPRequest& request,
+                  HTTPResponse& response, bool& keepAlive);
+
+    int acquireConnection(const std::string& host, const std::string& port, bool& reused);
+    void releaseConnection(int socket);
+
+    CookieJar& jarFor(const HTTPRequest& request) const {
+        return request.cookies ? *request.cookies : *cookies;
+    }
+
+public:
+    explicit SocketHTTPTransport(std::shared_ptr<IExecutor> executor);
+    ~SocketHTTPTransport() override;
+
+    SocketHTTPTransport(const SocketHTTPTransport&) = delete;
+    SocketHTTPTransport& operator=(const SocketHTTPTransport&) = delete;
+
+    void send(const HTTPRequest& request, ResponseCallback callback) override;
+    std::string cookieHeader(const std::string& url) const override;
+    void restoreCookies(const std::string& url, const std::string& header) override;
+};
+
+} // namespace Tools
+} // namespace BSUIR
+
+#endif /* SocketHTTPTransport_hpp */
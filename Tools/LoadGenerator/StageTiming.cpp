@@ -0,0 +1,138 @@
+//
+//  StageTiming.cpp
+//  cPPiIS Tools - Load Generator Stage Instrumentation Implementation
+//
+
+#include "StageTiming.hpp"
+#include "MockIISService.hpp"
+#include <utility>
+
+namespace BSUIR {
+namespace Tools {
+
+namespace {
+
+thread_local std::shared_ptr<RequestSample> activeSample;
+thread_local HTTPTimings::Clock::time_point pendingIntendedStart;
+
+void recordSpan(LatencyRecorder& recorder,
+                const std::string& endpoint,
+                const char* stage,
+                HTTPTimings::Clock::time_point from,
+                HTTPTimings::Clock::time_point to) {
+    if (HTTPTimings::isSet(from) && HTTPTimings::isSet(to)) {
+        recorder.record(endpoint, stage, to - from);
+    }
+}
+
+} // namespace
+
+// ========================================
+// SampleContext Implementation
+// ========================================
+
+std::shared_ptr<RequestSample> SampleContext::current() {
+    return activeSample;
+}
+
+void SampleContext::setIntendedStart(HTTPTimings::Clock::time_point intended) {
+    pendingIntendedStart = intended;
+}
+
+HTTPTimings::Clock::time_point SampleContext::takeIntendedStart() {
+    auto intended = pendingIntendedStart;
+    pendingIntendedStart = {};
+    return HTTPTimings::isSet(intended) ? intended : HTTPTimings::Clock::now();
+}
+
+SampleContext::Scope::Scope(std::shared_ptr<RequestSample> sample)
+    : previous(std::move(activeSample)) {
+    activeSample = std::move(sample);
+}
+
+SampleContext::Scope::~Scope() {
+    activeSample = std::move(previous);
+}
+
+// ========================================
+// TimingTransport Implementation
+// ========================================
+
+TimingTransport::TimingTransport(std::shared_ptr<IHTTPTransport> wrapped, std::atomic<int64_t>& busyCounter)
+    : inner(std::move(wrapped)), busy(busyCounter) {
+}
+
+void TimingTransport::send(const HTTPRequest& request, ResponseCallback callback) {
+    auto sample = std::make_shared<RequestSample>();
+    sample->endpoint = Mock::endpointPath(request.url);
+    sample->intendedStart = SampleContext::takeIntendedStart();
+
+    ++busy;
+    inner->send(request, [this, sample, callback = std::move(callback)](const HTTPResponse& response) mutable {
+        sample->network = response.timings;
+        {
+            SampleContext::Scope scope(sample);
+            std::exchange(callback, nullptr)(response);
+        }
+        --busy;
+    });
+}
+
+// ========================================
+// StageExecutor Implementation
+// ========================================
+
+StageExecutor::StageExecutor(std::shared_ptr<IExecutor> wrapped, Stage executorStage, LatencyRecorder& latencyRecorder,
+                             std::atomic<int64_t>& busyCounter)
+    : inner(std::move(wrapped)), stage(executorStage), recorder(latencyRecorder), busy(busyCounter) {
+}
+
+void StageExecutor::post(std::function<void()> task) {
+    auto sample = SampleContext::current();
+    ++busy;
+    // The task is released before busy drops: its captures may hold the
+    // last references to executors, which must not die on their own thread
+    if (!sample) {
+        inner->post([this, task = std::move(task)]() mutable {
+            std::exchange(task, nullptr)();
+            --busy;
+        });
+        return;
+    }
+
+    if (stage == Stage::Parsing) {
+        inner->post([this, sample, task = std::move(task)]() mutable {
+            {
+                SampleContext::Scope scope(sample);
+                std::exchange(task, nullptr)();
+            }
+            --busy;
+        });
+        return;
+    }
+
+    // Delivery is the last thing parsing does, so posting here ends the parse stage
+    sample->parseEnd = HTTPTimings::Clock::now();
+    inner->post([this, sample, task = std::move(task)]() mutable {
+        {
+            SampleContext::Scope scope(sample);
+            std::exchange(task, nullptr)();
+        }
+        sample->callbackEnd = HTTPTimings::Clock::now();
+        recordStages(recorder, *sample);
+        --busy;
+    });
+}
+
+void recordStages(LatencyRecorder& recorder, const RequestSample& sample) {
+    const auto& network = sample.network;
+    recordSpan(recorder, sample.endpoint, "queue", sample.intendedStart, network.requestStart);
+    recordSpan(recorder, sample.endpoint, "connect", network.requestStart, network.connectEnd);
+    recordSpan(recorder, sample.endpoint, "ttfb", network.connectEnd, network.firstByte);
+    recordSpan(recorder, sample.endpoint, "transfer", network.firstByte, network.responseEnd);
+    recordSpan(recorder, sample.endpoint, "parse", network.responseEnd, sample.parseEnd);
+    recordSpan(recorder, sample.endpoint, "callback", sample.parseEnd, sample.callbackEnd);
+}
+
+} // namespace Tools
+} // namespace BSUIR
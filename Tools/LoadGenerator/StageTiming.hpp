@@ -0,0 +1,118 @@
+//
+//  StageTiming.hpp
+//  cPPiIS Tools - Load Generator Stage Instrumentation
+//
+//  Transport and executor decorators that follow one request through
+//  the ApiService pipeline without modifying it
+//
+
+#ifndef StageTiming_hpp
+#define StageTiming_hpp
+
+#include "HTTPTransport.hpp"
+#include "Executor.hpp"
+#include "LatencyRecorder.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace BSUIR {
+namespace Tools {
+
+/**
+ * @brief Timestamps of one request across all pipeline stages
+ */
+struct RequestSample {
+    std::string endpoint;
+    HTTPTimings::Clock::time_point intendedStart;   ///< When the scenario wanted to send
+    HTTPTimings network;                            ///< Filled by the transport
+    HTTPTimings::Clock::time_point parseEnd;        ///< Result handed to the callback stage
+    HTTPTimings::Clock::time_point callbackEnd;     ///< User callback returned
+};
+
+/**
+ * @brief Thread-local request context used to correlate pipeline hops
+ *
+ * ApiService hops transport → parsing executor → callbacks executor.
+ * Each decorator captures the sample active on the posting thread and
+ * re-activates it on the thread that runs the work.
+ */
+class SampleContext {
+public:
+    static std::shared_ptr<RequestSample> current();
+
+    /**
+     * @brief Set the intended send time for requests issued on this thread
+     *
+     * The load generator sets it before starting a request so queueing
+     * delay is measured from the schedule, not from the actual send,
+     * which keeps coordinated omission out of the results.
+     */
+    static void setIntendedStart(HTTPTimings::Clock::time_point intended);
+    static HTTPTimings::Clock::time_point takeIntendedStart();
+
+    class Scope {
+    private:
+        std::shared_ptr<RequestSample> previous;
+
+    public:
+        explicit Scope(std::shared_ptr<RequestSample> sample);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
+
+/**
+ * @brief Transport decorator creating a RequestSample per request
+ *
+ * busy counts requests whose callback has not returned, so the run can
+ * wait for background refreshes before tearing the services down.
+ */
+class TimingTransport : public IHTTPTransport {
+private:
+    std::shared_ptr<IHTTPTransport> inner;
+    std::atomic<int64_t>& busy;
+
+public:
+    TimingTransport(std::shared_ptr<IHTTPTransport> wrapped, std::atomic<int64_t>& busyCounter);
+
+    void send(const HTTPRequest& request, ResponseCallback callback) override;
+};
+
+/**
+ * @brief Executor decorator marking parse and callback stage boundaries
+ *
+ * busy counts tasks not finished yet, the task's captures included.
+ */
+class StageExecutor : public IExecutor {
+public:
+    enum class Stage {
+        Parsing,    ///< Runs response parsing (ServiceExecutors::parsing)
+        Callbacks   ///< Runs user callbacks (ServiceExecutors::callbacks)
+    };
+
+private:
+    std::shared_ptr<IExecutor> inner;
+    Stage stage;
+    LatencyRecorder& recorder;
+    std::atomic<int64_t>& busy;
+
+public:
+    StageExecutor(std::shared_ptr<IExecutor> wrapped, Stage executorStage, LatencyRecorder& latencyRecorder,
+                  std::atomic<int64_t>& busyCounter);
+
+    void post(std::function<void()> task) override;
+};
+
+/**
+ * @brief Record every observed stage duration of a completed sample
+ */
+void recordStages(LatencyRecorder& recorder, const RequestSample& sample);
+
+} // namespace Tools
+} // namespace BSUIR
+
+#endif /* StageTiming_hpp */
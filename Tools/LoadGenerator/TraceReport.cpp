@@ -0,0 +1,78 @@
+//
+//  TraceReport.cpp
+//  cPPiIS Tools - Load Generator Trace Report
+//
+
+#include "TraceReport.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+
+namespace BSUIR {
+namespace Tools {
+
+namespace {
+
+using Children = std::unordered_map<uint64_t, std::vector<const Tracing::SpanRecord*>>;
+
+double milliseconds(uint64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1e6;
+}
+
+void printSpan(std::ostream& out, const Tracing::SpanRecord& span, const Children& children,
+               uint64_t origin, int depth) {
+    char line[160];
+    std::snprintf(line, sizeof(line), "  %9.3f %9.3f  %*s%s",
+                  milliseconds(span.startNanoseconds - origin), milliseconds(span.durationNanoseconds()),
+                  depth * 2, "", span.name);
+    out << line;
+    for (const auto& attribute : span.attributes) {
+        out << " " << attribute.key << "=";
+        if (attribute.isNumber) {
+            out << attribute.number;
+        } else {
+            out << attribute.text;
+        }
+    }
+    out << "\n";
+
+    auto found = children.find(span.spanId);
+    if (found == children.end()) {
+        return;
+    }
+    for (const auto* child : found->second) {
+        printSpan(out, *child, children, origin, depth + 1);
+    }
+}
+
+} // namespace
+
+void printSlowestTraces(std::ostream& out, const std::vector<Tracing::SpanRecord>& spans, std::size_t count) {
+    std::vector<const Tracing::SpanRecord*> roots;
+    Children children;
+    for (const auto& span : spans) {
+        if (span.parentId == 0) {
+            roots.push_back(&span);
+        } else {
+            children[span.parentId].push_back(&span);
+        }
+    }
+    for (auto& entry : children) {
+        std::sort(entry.second.begin(), entry.second.end(), [](const auto* a, const auto* b) {
+            return a->startNanoseconds < b->startNanoseconds;
+        });
+    }
+    std::sort(roots.begin(), roots.end(), [](const auto* a, const auto* b) {
+        return a->durationNanoseconds() > b->durationNanoseconds();
+    });
+
+    out << "\n🔬 Slowest of " << roots.size() << " sampled operations (" << spans.size() << " spans)\n"
+        << "   start ms    dur ms  span\n";
+    for (std::size_t i = 0; i < std::min(count, roots.size()); ++i) {
+        out << "\n";
+        printSpan(out, *roots[i], children, roots[i]->startNanoseconds, 0);
+    }
+}
+
+} // namespace Tools
+} // namespace BSUIR
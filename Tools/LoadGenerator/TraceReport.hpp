@@ -0,0 +1,29 @@
+//
+//  TraceReport.hpp
+//  cPPiIS Tools - Load Generator Trace Report
+//
+//  Span trees of the slowest sampled operations
+//
+
+#ifndef TraceReport_hpp
+#define TraceReport_hpp
+
+#include "Tracing.hpp"
+#include <ostream>
+#include <vector>
+
+namespace BSUIR {
+namespace Tools {
+
+/**
+ * @brief Print the span trees of the slowest root spans
+ * @param out Destination stream
+ * @param spans Spans collected by a Tracing::SpanBuffer
+ * @param count Number of traces to print
+ */
+void printSlowestTraces(std::ostream& out, const std::vector<Tracing::SpanRecord>& spans, std::size_t count);
+
+} // namespace Tools
+} // namespace BSUIR
+
+#endif /* TraceReport_hpp */
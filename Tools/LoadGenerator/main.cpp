@@ -0,0 +1,369 @@
+//
+//  main.cpp
+//  cPPiIS Tools - Load Generator
+//
+//  Drives many virtual students through ApiService against the mock IIS
+//  (in-process or over loopback HTTP) at an open-loop arrival rate and
+//  reports per-endpoint and per-stage latency percentiles.
+//  Build (from this directory):
+//    c++ -std=c++20 -O2 -I../../cPPiIS -I../../cPPiIS/Core -I../MockIISServer
+//        *.cpp ../MockIISServer/MockIISService.cpp ../MockIISServer/MockIISTransport.cpp
+//        ../../cPPiIS/Core/{HTTPClient,CookieJar,CurlHTTPTransport,JSONParser,Executor,CoroutineFramePool,BSUIROOPDemo,TimerWheel,TrafficCapture,Log,Tracing,Metrics,PollingController,Profiler,Watchdog,LocalStore,ModelDiff,StringPool,MarkbookColumns,RosterIndex,SkillTrie,SkillAutocomplete}.cpp
+//        -x c++ ../../cPPiIS/Core/{ApiService,IConfigProvider,SecureTokenStorage}.mm -o load-generator -pthread -lcurl
+//
+//  Example:
+//    ./load-generator --users 5000 --rate 200 --refreshes 3 --refresh-interval 10
+//    ./load-generator --target http://127.0.0.1:8080/api/v1 --users 1000 --rate 100
+//    ./load-generator --users 2000 --rate 500 --trace-sample 0.05 --trace-slowest 3
+//
+
+#include "ApiService.hpp"
+#include "Metrics.hpp"
+#include "Profiler.hpp"
+#include "Config.h"
+#include "LatencyRecorder.hpp"
+#include "MockIISTransport.hpp"
+#include "SocketHTTPTransport.hpp"
+#include "StageTiming.hpp"
+#include "TraceReport.hpp"
+#include "TimerWheel.hpp"
+#include "Watchdog.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BSUIR;
+using namespace BSUIR::Tools;
+using Clock = HTTPTimings::Clock;
+
+namespace {
+
+struct LoadOptions {
+    std::string target = "mock";            ///< "mock" or an http:// base URL
+    int users = 1000;                       ///< Virtual users arriving over the run
+    double arrivalRate = 100.0;             ///< Users per second (Poisson arrivals)
+    int refreshes = 2;                      ///< Periodic refreshes after the first load
+    double refreshInterval = 30.0;          ///< Seconds between refreshes
+    std::string password = "password";
+    std::size_t ioThreads = 64;             ///< Concurrent requests for --target http://
+    std::size_t parseThreads = 0;           ///< 0 selects hardware concurrency
+    std::size_t callbackThreads = 2;
+    std::size_t scenarioThreads = 2;
+    uint64_t seed = 7;
+    std::string recordPath;                 ///< Traffic capture to append to (empty: off)
+    double traceSampleRate = 0.0;           ///< Fraction of operations to trace (0: off)
+    std::size_t traceSlowest = 5;           ///< Span trees printed after the report
+    std::string metricsPath;                ///< Core metrics export, .json or Prometheus text (empty: off)
+    std::string profilePath;                ///< Chrome trace-event timeline (empty: off)
+    double stallBudgetMs = 16.0;            ///< Callback / observer budget (0: watchdog off)
+    double stallSampleMs = 0.0;             ///< Stack-sample invocations running this long (0: off)
+    Mock::MockIISConfig mock;               ///< Used for --target mock
+};
+
+// Scenario sleeps and mock latency; finer than the shared wheel's 10 ms
+// ticks so the simulated latency keeps its shape
+TimerWheelOptions millisecondTicks() {
+    TimerWheelOptions options;
+    options.tick = std::chrono::milliseconds(1);
+    return options;
+}
+
+/**
+ * @brief Shared state of one load test run
+ */
+struct LoadContext {
+    LoadOptions options;
+    LatencyRecorder recorder;
+    std::atomic<int64_t> busy{0};                   ///< Requests and pipeline tasks not finished yet
+    std::shared_ptr<TimerWheel> timer = std::make_shared<TimerWheel>(millisecondTicks());
+    std::shared_ptr<IExecutor> scenarioExecutor;
+    ServiceExecutors executors;
+
+    std::shared_ptr<Mock::MockIISService> mockService;
+    std::shared_ptr<IExecutor> ioExecutor;
+    std::shared_ptr<TrafficRecorder> trafficRecorder;
+
+    std::mutex doneMutex;
+    std::condition_variable allDone;
+    int finishedUsers = 0;
+};
+
+/**
+ * @brief Suspend until a point in time, then continue on the scenario executor
+ */
+class SleepUntil {
+private:
+    LoadContext& context;
+    Clock::time_point due;
+
+public:
+    SleepUntil(LoadContext& loadContext, Clock::time_point wakeAt) : context(loadContext), due(wakeAt) {}
+
+    bool await_ready() const noexcept {
+        return Clock::now() >= due;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        auto delay = std::chrono::duration_cast<std::chrono::microseconds>(due - Clock::now());
+        auto executor = context.scenarioExecutor;
+        context.timer->schedule(delay, [executor, handle] {
+            executor->post([handle] { handle.resume(); });
+        });
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Await one API call and record its end-to-end latency
+ *
+ * Latency is measured from the intended start, so a request delayed by
+ * a saturated client still counts its waiting time.
+ */
+template<typename T>
+Task<bool> timed(LoadContext& context, std::string endpoint, Clock::time_point intended, Task<ApiResult<T>> call) {
+    SampleContext::setIntendedStart(intended);
+    ApiResult<T> result = co_await call;
+    context.recorder.record(endpoint, "total", Clock::now() - intended);
+    if (!result.success) {
+        context.recorder.recordError(endpoint);
+    }
+    co_return result.success;
+}
+
+std::unique_ptr<ApiService> makeVirtualUser(LoadContext& context) {
+    std::shared_ptr<IHTTPTransport> transport;
+    std::string baseUrl = context.options.target;
+
+    if (context.options.target == "mock") {
+        baseUrl = "http://mock.local/api/v1";
+        transport = std::make_shared<Mock::MockIISTransport>(context.mockService, context.timer);
+    } else {
+        transport = std::make_shared<SocketHTTPTransport>(context.ioExecutor);
+    }
+
+    auto client = std::make_unique<HTTPClient>(std::make_shared<TimingTransport>(std::move(transport), context.busy));
+    client->setTrafficRecorder(context.trafficRecorder);
+    auto api = std::make_unique<ApiService>(ConfigProviderFactory::createCustomConfig(baseUrl, false), std::move(client));
+    api->setExecutors(context.executors);
+    api->setCoroutineExecutor(context.scenarioExecutor);
+    return api;
+}
+
+/**
+ * @brief Scenario: login, initial load of profile + markbook + group, periodic refresh
+ */
+Task<void> runVirtualUser(LoadContext& context, ApiService& api, std::string studentNumber, Clock::time_point arrival) {
+    co_await SleepUntil(context, arrival);
+
+    bool loggedIn = co_await timed(context, API_LOGIN_ENDPOINT, arrival,
+                                   api.loginAsync(studentNumber, context.options.password));
+    if (!loggedIn) {
+        co_return;
+    }
+
+    const auto sessionStart = Clock::now();
+    co_await whenAll(
+        timed(context, API_PERSONAL_INFO_ENDPOINT, sessionStart, api.personalInfoAsync()),
+        timed(context, API_MARKBOOK_ENDPOINT, sessionStart, api.markbookAsync()),
+        timed(context, API_GROUP_INFO_ENDPOINT, sessionStart, api.groupInfoAsync()));
+
+    for (int refresh = 1; refresh <= context.options.refreshes; ++refresh) {
+        const auto intended = sessionStart + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(context.options.refreshInterval * refresh));
+        co_await SleepUntil(context, intended);
+        co_await whenAll(
+            timed(context, API_MARKBOOK_ENDPOINT, intended, api.markbookAsync()),
+            timed(context, API_GROUP_INFO_ENDPOINT, intended, api.groupInfoAsync()));
+    }
+}
+
+bool writeMetrics(const std::string& path) {
+    auto& registry = Metrics::MetricsRegistry::shared();
+    if (path.size() < 5 || path.compare(path.size() - 5, 5, ".json") != 0) {
+        return Metrics::writePrometheusFile(registry, path);
+    }
+    std::ofstream file(path);
+    file << Metrics::toJSON(registry.snapshot()) << "\n";
+    return static_cast<bool>(file);
+}
+
+void printUsage() {
+    std::cout
+        << "Usage: load-generator [options]\n"
+        << "  --target mock|URL        In-process mock (default) or http:// base URL\n"
+        << "  --users N                Virtual users (default 1000)\n"
+        << "  --rate R                 Arrivals per second, Poisson (default 100)\n"
+        << "  --refreshes N            Refresh cycles per user (default 2)\n"
+        << "  --refresh-interval S     Seconds between refreshes (default 30)\n"
+        << "  --password PW            Password sent on login\n"
+        << "  --io-threads N           Concurrent socket requests (default 64)\n"
+        << "  --parse-threads N        Parsing pool size (default: cores)\n"
+        << "  --callback-threads N     Callback pool size (default 2)\n"
+        << "  --seed N                 Arrival process seed\n"
+        << "  --record PATH            Append all exchanges to a traffic capture\n"
+        << "  --trace-sample P         Trace a fraction of operations (default 0)\n"
+        << "  --trace-slowest N        Span trees of the N slowest traced operations (default 5)\n"
+        << "  --metrics-out PATH       Write core metrics at exit (.json or Prometheus text)\n"
+        << "  --profile PATH           Write a Chrome trace / Perfetto timeline of the run\n"
+        << "  --stall-budget MS        Report callbacks and observers slower than this (default 16, 0: off)\n"
+        << "  --stall-sample MS        Stack-sample invocations running this long (default 0: off)\n"
+        << "  Mock target only:\n"
+        << "  --latency SPEC           none | fixed:MS | uniform:MIN:MAX | lognormal:MEDIAN:SIGMA\n"
+        << "  --semesters N --subjects N --students N --error-rate P --error-status CODE\n";
+}
+
+bool parseOptions(int argc, char* argv[], LoadOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+
+        if (option == "--target")                 options.target = value;
+        else if (option == "--users")             options.users = std::stoi(value);
+        else if (option == "--rate")              options.arrivalRate = std::stod(value);
+        else if (option == "--refreshes")         options.refreshes = std::stoi(value);
+        else if (option == "--refresh-interval")  options.refreshInterval = std::stod(value);
+        else if (option == "--password")          options.password = value;
+        else if (option == "--io-threads")        options.ioThreads = std::stoul(value);
+        else if (option == "--parse-threads")     options.parseThreads = std::stoul(value);
+        else if (option == "--callback-threads")  options.callbackThreads = std::stoul(value);
+        else if (option == "--seed")              options.seed = std::stoull(value);
+        else if (option == "--record")            options.recordPath = value;
+        else if (option == "--trace-sample")      options.traceSampleRate = std::stod(value);
+        else if (option == "--trace-slowest")     options.traceSlowest = std::stoul(value);
+        else if (option == "--metrics-out")       options.metricsPath = value;
+        else if (option == "--profile")           options.profilePath = value;
+        else if (option == "--stall-budget")      options.stallBudgetMs = std::stod(value);
+        else if (option == "--stall-sample")      options.stallSampleMs = std::stod(value);
+        else if (option == "--latency")           options.mock.latency = Mock::LatencyDistribution::parse(value);
+        else if (option == "--semesters")         options.mock.semesters = std::stoi(value);
+        else if (option == "--subjects")          options.mock.subjectsPerSemester = std::stoi(value);
+        else if (option == "--students")          options.mock.students = std::stoi(value);
+        else if (option == "--error-rate")        options.mock.errorRate = std::stod(value);
+        else if (option == "--error-status")      options.mock.errorStatus = std::stoi(value);
+        else return false;
+    }
+    return options.users > 0 && options.arrivalRate > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LoadContext context;
+    if (!parseOptions(argc, argv, context.options)) {
+        printUsage();
+        return 2;
+    }
+    const LoadOptions& options = context.options;
+
+    context.scenarioExecutor = ExecutorFactory::createThreadPool(options.scenarioThreads);
+    context.executors.parsing = std::make_shared<StageExecutor>(
+        ExecutorFactory::createThreadPool(options.parseThreads), StageExecutor::Stage::Parsing, context.recorder,
+        context.busy);
+    context.executors.callbacks = std::make_shared<StageExecutor>(
+        ExecutorFactory::createThreadPool(options.callbackThreads), StageExecutor::Stage::Callbacks, context.recorder,
+        context.busy);
+
+    if (!options.recordPath.empty()) {
+        context.trafficRecorder = std::make_shared<TrafficRecorder>(options.recordPath);
+        if (!context.trafficRecorder->isOpen()) {
+            std::cerr << "❌ Cannot open " << options.recordPath << std::endl;
+            return 1;
+        }
+    }
+
+    Watchdog::Options watchdog;
+    watchdog.budget = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double, std::milli>(options.stallBudgetMs));
+    watchdog.sampleAfter = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double, std::milli>(options.stallSampleMs));
+    Watchdog::configure(watchdog);
+
+    std::shared_ptr<Tracing::SpanBuffer> spans;
+    if (options.traceSampleRate > 0) {
+        spans = std::make_shared<Tracing::SpanBuffer>();
+        Tracing::setSink(spans);
+        Tracing::setSampleRate(options.traceSampleRate);
+    }
+
+    if (options.target == "mock") {
+        context.mockService = std::make_shared<Mock::MockIISService>(options.mock);
+    } else {
+        context.ioExecutor = ExecutorFactory::createThreadPool(options.ioThreads);
+    }
+
+    std::vector<std::unique_ptr<ApiService>> users;
+    users.reserve(static_cast<std::size_t>(options.users));
+    for (int i = 0; i < options.users; ++i) {
+        users.push_back(makeVirtualUser(context));
+    }
+
+    if (!options.profilePath.empty()) {
+        Profiler::setThreadName("main");
+        Profiler::start();
+    }
+
+    std::cout << "🚀 " << options.users << " virtual users at " << options.arrivalRate
+           << "/s against " << options.target << std::endl;
+
+    // Open loop: arrival times are fixed up front, independent of response times
+    std::mt19937_64 random(options.seed);
+    std::exponential_distribution<double> interArrival(options.arrivalRate);
+    const auto start = Clock::now();
+    auto arrival = start;
+
+    for (int i = 0; i < options.users; ++i) {
+        arrival += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interArrival(random)));
+        std::string studentNumber = std::to_string(42850000 + i);
+        spawn(runVirtualUser(context, *users[static_cast<std::size_t>(i)], std::move(studentNumber), arrival), [&context] {
+            std::lock_guard<std::mutex> lock(context.doneMutex);
+            context.finishedUsers++;
+            context.allDone.notify_one();
+        });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(context.doneMutex);
+        context.allDone.wait(lock, [&] { return context.finishedUsers == options.users; });
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    // Background refreshes and the tail of the last deliveries still use the
+    // services and executors; each hop is counted before the previous ends
+    while (context.busy.load() != 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    Profiler::stop();
+
+    context.recorder.report(std::cout, elapsed);
+    if (const auto stalls = Watchdog::recentStalls(); !stalls.empty()) {
+        std::cout << "🐢 " << stalls.size() << " recent callback/observer stalls, last: "
+                  << stalls.back().name << " (" << stalls.back().subject << ") "
+                  << std::chrono::duration<double, std::milli>(stalls.back().duration).count() << " ms" << std::endl;
+    }
+    if (spans) {
+        printSlowestTraces(std::cout, spans->drain(), options.traceSlowest);
+    }
+    if (!options.metricsPath.empty() && !writeMetrics(options.metricsPath)) {
+        std::cerr << "❌ Cannot write " << options.metricsPath << std::endl;
+        return 1;
+    }
+    if (!options.profilePath.empty()) {
+        if (!Profiler::writeChromeTrace(options.profilePath)) {
+            std::cerr << "❌ Cannot write " << options.profilePath << std::endl;
+            return 1;
+        }
+        if (const uint64_t dropped = Profiler::droppedEvents()) {
+            std::cout << "⚠️ Profile buffer full, " << dropped << " events dropped" << std::endl;
+        }
+    }
+    return 0;
+}
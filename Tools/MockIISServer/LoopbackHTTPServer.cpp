@@ -0,0 +1,271 @@
+//
+//  LoopbackHTTPServer.cpp
+//  cPPiIS Tools - Loopback HTTP Front End Implementation
+//
+
+#include "LoopbackHTTPServer.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+namespace BSUIR {
+namespace Mock {
+
+namespace {
+
+const std::size_t MAX_HEADER_BYTES = 64 * 1024;
+
+const char* reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 429: return "Too Many Requests";
+        case 503: return "Service Unavailable";
+        default:  return status >= 500 ? "Internal Server Error" : "Unknown";
+    }
+}
+
+bool sendAll(int socket, const std::string& data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t written = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            if (written < 0 && errno == EINTR) continue;
+            return false;
+        }
+        sent += static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+std::string trimSpaces(const std::string& value) {
+    size_t start = value.find_first_not_of(" \t");
+    if (start == std::string::npos) return "";
+    size_t end = value.find_last_not_of(" \t\r");
+    return value.substr(start, end - start + 1);
+}
+
+bool parseMethod(const std::string& token, HTTPMethod& method) {
+    if (token == "GET")    { method = HTTPMethod::Get;    return true; }
+    if (token == "POST")   { method = HTTPMethod::Post;   return true; }
+    if (token == "PUT")    { method = HTTPMethod::Put;    return true; }
+    if (token == "DELETE") { method = HTTPMethod::Delete; return true; }
+    return false;
+}
+
+} // namespace
+
+// ========================================
+// LoopbackHTTPServer Implementation
+// ========================================
+
+LoopbackHTTPServer::LoopbackHTTPServer(std::shared_ptr<MockIISService> mockService, uint16_t port)
+    : service(std::move(mockService)), requestedPort(port) {
+}
+
+LoopbackHTTPServer::~LoopbackHTTPServer() {
+    stop();
+}
+
+bool LoopbackHTTPServer::start(std::string* error) {
+    listenSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        if (error) *error = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    int reuse = 1;
+    ::setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(requestedPort);
+
+    if (::bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listenSocket, SOMAXCONN) < 0) {
+        if (error) *error = std::string("bind/listen: ") + std::strerror(errno);
+        ::close(listenSocket);
+        listenSocket = -1;
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    ::getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length);
+    boundPort = ntohs(address.sin_port);
+
+    running = true;
+    acceptThread = std::thread([this] { acceptLoop(); });
+    return true;
+}
+
+void LoopbackHTTPServer::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+
+    ::shutdown(listenSocket, SHUT_RDWR);
+    ::close(listenSocket);
+    if (acceptThread.joinable()) {
+        acceptThread.join();
+    }
+
+    std::list<std::unique_ptr<Connection>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        remaining.swap(connections);
+    }
+    for (auto& connection : remaining) {
+        ::shutdown(connection->socket, SHUT_RDWR);
+    }
+    for (auto& connection : remaining) {
+        if (connection->thread.joinable()) {
+            connection->thread.join();
+        }
+    }
+}
+
+uint16_t LoopbackHTTPServer::port() const noexcept {
+    return boundPort;
+}
+
+std::string LoopbackHTTPServer::baseUrl() const {
+    return "http://127.0.0.1:" + std::to_string(boundPort) + "/api/v1";
+}
+
+void LoopbackHTTPServer::reapFinishedConnections() {
+    std::list<std::unique_ptr<Connection>> finished;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (auto it = connections.begin(); it != connections.end();) {
+            if ((*it)->finished.load()) {
+                finished.push_back(std::move(*it));
+                it = connections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto& connection : finished) {
+        connection->thread.join();
+    }
+}
+
+void LoopbackHTTPServer::acceptLoop() {
+    while (running.load()) {
+        int client = ::accept(listenSocket, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        int noDelay = 1;
+        ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        reapFinishedConnections();
+
+        auto connection = std::make_unique<Connection>();
+        connection->socket = client;
+        Connection* raw = connection.get();
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            connections.push_back(std::move(connection));
+        }
+        raw->thread = std::thread([this, raw] {
+            serveConnection(*raw);
+            ::close(raw->socket);
+            raw->finished = true;
+        });
+    }
+}
+
+void LoopbackHTTPServer::serveConnection(Connection& connection) {
+    std::string buffer;
+    char chunk[16 * 1024];
+
+    auto readMore = [&]() {
+        ssize_t received = ::recv(connection.socket, chunk, sizeof(chunk), 0);
+        if (received <= 0) return false;
+        buffer.append(chunk, static_cast<std::size_t>(received));
+        return true;
+    };
+
+    while (running.load()) {
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (buffer.size() > MAX_HEADER_BYTES || !readMore()) return;
+        }
+
+        std::istringstream head(buffer.substr(0, headerEnd));
+        std::string requestLine;
+        std::getline(head, requestLine);
+
+        std::istringstream requestLineStream(requestLine);
+        std::string methodToken, target, version;
+        requestLineStream >> methodToken >> target >> version;
+
+        HTTPRequest request;
+        if (!parseMethod(methodToken, request.method)) {
+            sendAll(connection.socket, "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+            return;
+        }
+        request.url = target;
+
+        bool keepAlive = version == "HTTP/1.1";
+        std::size_t contentLength = 0;
+        std::string line;
+        while (std::getline(head, line)) {
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) continue;
+            std::string name = trimSpaces(line.substr(0, colon));
+            std::string value = trimSpaces(line.substr(colon + 1));
+            std::string lowerName = name;
+            std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (lowerName == "content-length") {
+                contentLength = static_cast<std::size_t>(std::strtoull(value.c_str(), nullptr, 10));
+            } else if (lowerName == "connection") {
+                keepAlive = value != "close";
+            }
+            request.headers[name] = value;
+        }
+
+        const std::size_t bodyStart = headerEnd + 4;
+        while (buffer.size() < bodyStart + contentLength) {
+            if (!readMore()) return;
+        }
+        request.body = buffer.substr(bodyStart, contentLength);
+        buffer.erase(0, bodyStart + contentLength);
+
+        MockResponse response = service->handle(request);
+        if (response.delay.count() > 0) {
+            std::this_thread::sleep_for(response.delay);
+        }
+
+        std::ostringstream out;
+        out << "HTTP/1.1 " << response.statusCode << " " << reasonPhrase(response.statusCode) << "\r\n";
+        for (const auto& header : response.headers) {
+            out << header.first << ": " << header.second << "\r\n";
+        }
+        out << "Content-Length: " << response.body.size() << "\r\n"
+            << "Connection: " << (keepAlive ? "keep-alive" : "close") << "\r\n\r\n"
+            << response.body;
+
+        if (!sendAll(connection.socket, out.str()) || !keepAlive) {
+            return;
+        }
+    }
+}
+
+} // namespace Mock
+} // namespace BSUIR
@@ -0,0 +1,86 @@
+//
+//  LoopbackHTTPServer.hpp
+//  cPPiIS Tools - Loopback HTTP Front End
+//
+//  Minimal HTTP/1.1 server on 127.0.0.1 that exposes MockIISService
+//  to real network stacks (NSURLSession, curl, the Python scripts)
+//
+
+#ifndef LoopbackHTTPServer_hpp
+#define LoopbackHTTPServer_hpp
+
+#include "MockIISService.hpp"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace BSUIR {
+namespace Mock {
+
+/**
+ * @brief Thread-per-connection HTTP/1.1 server bound to the loopback interface
+ *
+ * Supports keep-alive and Content-Length bodies, which is all that
+ * IIS clients need. Latency from the service is applied by sleeping on
+ * the connection thread before the response is written.
+ */
+class LoopbackHTTPServer {
+private:
+    struct Connection {
+        int socket = -1;
+        std::atomic<bool> finished{false};
+        std::thread thread;
+    };
+
+    std::shared_ptr<MockIISService> service;
+    uint16_t requestedPort;
+    uint16_t boundPort = 0;
+    int listenSocket = -1;
+    std::atomic<bool> running{false};
+    std::thread acceptThread;
+
+    std::mutex connectionsMutex;
+    std::list<std::unique_ptr<Connection>> connections;
+
+    void acceptLoop();
+    void serveConnection(Connection& connection);
+    void reapFinishedConnections();
+
+public:
+    LoopbackHTTPServer(std::shared_ptr<MockIISService> mockService, uint16_t port = 0);
+    ~LoopbackHTTPServer();
+
+    LoopbackHTTPServer(const LoopbackHTTPServer&) = delete;
+    LoopbackHTTPServer& operator=(const LoopbackHTTPServer&) = delete;
+
+    /**
+     * @brief Bind and start accepting connections
+     * @param error Receives a description on failure
+     * @return true if the server is listening
+     */
+    bool start(std::string* error = nullptr);
+
+    /**
+     * @brief Stop accepting, close all connections and join threads
+     */
+    void stop();
+
+    /**
+     * @brief Port actually bound (useful when 0 was requested)
+     */
+    uint16_t port() const noexcept;
+
+    /**
+     * @brief Base URL clients should use, e.g. http://127.0.0.1:8080/api/v1
+     */
+    std::string baseUrl() const;
+};
+
+} // namespace Mock
+} // namespace BSUIR
+
+#endif /* LoopbackHTTPServer_hpp */
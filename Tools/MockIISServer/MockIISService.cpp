@@ -0,0 +1,464 @@
+//
+//  MockIISService.cpp
+//  cPPiIS Tools - Mock IIS Server Implementation
+//
+
+#include "MockIISService.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace BSUIR {
+namespace Mock {
+
+namespace {
+
+const char* const STUDENT_NUMBER_PLACEHOLDER = "{{studentNumber}}";
+const char* const SESSION_COOKIE = "JSESSIONID";
+
+const char* const SUBJECT_NAMES[] = {
+    "Математика", "Физика", "ООП", "Алгоритмы и структуры данных", "Философия",
+    "Базы данных", "Английский язык", "АПЭЦ", "Операционные системы", "Компьютерные сети",
+    "Теория вероятностей", "Дискретная математика", "Экономика", "Физическая культура"
+};
+
+const char* const LAST_NAMES[] = {
+    "Борутенко", "Бугай", "Василевский", "Гришко", "Дроздов", "Ермолович",
+    "Жук", "Зайцев", "Ковалёв", "Лисовская", "Мельник", "Новик", "Орлова"
+};
+
+const char* const FIRST_NAMES[] = {
+    "Богдан", "Елизавета", "Владислав", "Алексей", "Мария", "Ольга",
+    "Дмитрий", "Анна", "Сергей", "Юлия", "Артём", "Наталья"
+};
+
+const char* const SKILLS[] = {
+    "C", "C#", "C++", "CSS", "Docker", "Git", "Go", "HTML", "Java", "Java EE",
+    "Java Spring", "JavaScript", "Kotlin", "Linux", "Objective-C", "PostgreSQL",
+    "Python", "React", "Rust", "SQL", "Swift", "SwiftUI", "TypeScript"
+};
+
+template<typename T, std::size_t N>
+constexpr std::size_t countOf(const T (&)[N]) {
+    return N;
+}
+
+std::string formatDouble(double value) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << value;
+    return out.str();
+}
+
+// Minimal extraction of a top-level string field from a JSON body
+std::string extractJsonString(const std::string& json, const std::string& key) {
+    const std::string needle = "\"" + key + "\"";
+    size_t pos = json.find(needle);
+    if (pos == std::string::npos) return "";
+    pos = json.find(':', pos + needle.size());
+    if (pos == std::string::npos) return "";
+    pos = json.find('"', pos);
+    if (pos == std::string::npos) return "";
+    size_t end = json.find('"', pos + 1);
+    if (end == std::string::npos) return "";
+    return json.substr(pos + 1, end - pos - 1);
+}
+
+std::string toLowerAscii(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return value;
+}
+
+// Decode %XX escapes and '+' of a query parameter value
+std::string decodeQueryValue(const std::string& value) {
+    std::string decoded;
+    decoded.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '%' && i + 2 < value.size() &&
+            std::isxdigit(static_cast<unsigned char>(value[i + 1])) && std::isxdigit(static_cast<unsigned char>(value[i + 2]))) {
+            decoded.push_back(static_cast<char>(std::stoi(value.substr(i + 1, 2), nullptr, 16)));
+            i += 2;
+        } else {
+            decoded.push_back(value[i] == '+' ? ' ' : value[i]);
+        }
+    }
+    return decoded;
+}
+
+std::string replaceAll(std::string text, const std::string& from, const std::string& to) {
+    size_t pos = 0;
+    while ((pos = text.find(from, pos)) != std::string::npos) {
+        text.replace(pos, from.size(), to);
+        pos += to.size();
+    }
+    return text;
+}
+
+} // namespace
+
+// ========================================
+// LatencyDistribution Implementation
+// ========================================
+
+LatencyDistribution LatencyDistribution::parse(const std::string& spec) {
+    LatencyDistribution result;
+    std::vector<std::string> parts;
+    std::stringstream stream(spec);
+    std::string part;
+    while (std::getline(stream, part, ':')) {
+        parts.push_back(part);
+    }
+    if (parts.empty()) {
+        return result;
+    }
+
+    try {
+        if (parts[0] == "fixed" && parts.size() == 2) {
+            result.kind = Kind::Fixed;
+            result.first = std::stod(parts[1]);
+        } else if (parts[0] == "uniform" && parts.size() == 3) {
+            result.kind = Kind::Uniform;
+            result.first = std::stod(parts[1]);
+            result.second = std::stod(parts[2]);
+        } else if (parts[0] == "lognormal" && parts.size() == 3) {
+            result.kind = Kind::LogNormal;
+            result.first = std::stod(parts[1]);
+            result.second = std::stod(parts[2]);
+        }
+    } catch (...) {
+        return LatencyDistribution{};
+    }
+    return result;
+}
+
+std::chrono::microseconds LatencyDistribution::sample(std::mt19937_64& engine) const {
+    double milliseconds = 0.0;
+    switch (kind) {
+        case Kind::None:
+            break;
+        case Kind::Fixed:
+            milliseconds = first;
+            break;
+        case Kind::Uniform:
+            milliseconds = std::uniform_real_distribution<double>(first, std::max(first, second))(engine);
+            break;
+        case Kind::LogNormal:
+            milliseconds = std::lognormal_distribution<double>(std::log(std::max(first, 0.001)), second)(engine);
+            break;
+    }
+    return std::chrono::microseconds(static_cast<int64_t>(std::max(0.0, milliseconds) * 1000.0));
+}
+
+// ========================================
+// Helpers
+// ========================================
+
+std::string endpointPath(const std::string& url, std::string* query) {
+    std::string path = url;
+
+    size_t scheme = path.find("://");
+    if (scheme != std::string::npos) {
+        size_t slash = path.find('/', scheme + 3);
+        path = slash == std::string::npos ? "/" : path.substr(slash);
+    }
+
+    size_t questionMark = path.find('?');
+    if (query) {
+        *query = questionMark == std::string::npos ? "" : path.substr(questionMark + 1);
+    }
+    if (questionMark != std::string::npos) {
+        path.erase(questionMark);
+    }
+
+    const std::string prefix = "/api/v1";
+    if (path.compare(0, prefix.size(), prefix) == 0) {
+        path.erase(0, prefix.size());
+    }
+    if (path.empty() || path.front() != '/') {
+        path.insert(path.begin(), '/');
+    }
+    return path;
+}
+
+// ========================================
+// MockIISService Implementation
+// ========================================
+
+MockIISService::MockIISService(MockIISConfig configuration)
+    : config(std::move(configuration)),
+      randomEngine(config.seed) {
+    generateFixtures();
+    loadFixtureOverrides();
+}
+
+const MockIISConfig& MockIISService::getConfig() const noexcept {
+    return config;
+}
+
+void MockIISService::generateFixtures() {
+    std::mt19937_64 engine(config.seed);
+    auto chance = [&engine](double probability) {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(engine) < probability;
+    };
+
+    fixtures["login"] =
+        "{\"username\":\"" + std::string(STUDENT_NUMBER_PLACEHOLDER) + "\","
+        "\"fio\":\"Василевский Владислав Валерьевич\","
+        "\"group\":\"420603\",\"email\":\"student@bsuir.by\",\"photoUrl\":null}";
+
+    fixtures["personal-information"] =
+        "{\"id\":12345,\"studentNumber\":\"" + std::string(STUDENT_NUMBER_PLACEHOLDER) + "\","
+        "\"firstName\":\"Владислав\",\"lastName\":\"Василевский\",\"middleName\":\"Валерьевич\","
+        "\"firstNameBel\":\"Уладзіслаў\",\"lastNameBel\":\"Васілеўскі\",\"middleNameBel\":\"Валер'евіч\","
+        "\"birthDate\":\"2007-06-14\",\"course\":2,\"faculty\":\"ФИТУ\",\"speciality\":\"СУИ (АСОИ)\","
+        "\"group\":\"420603\",\"email\":\"student@bsuir.by\",\"phone\":\"+375290000000\"}";
+
+    // Markbook: every semester but the last one is fully graded
+    std::ostringstream markbook;
+    double gpaSum = 0.0;
+    int gradedSemesters = 0;
+    markbook << "{\"studentNumber\":\"" << STUDENT_NUMBER_PLACEHOLDER << "\",\"overallGPA\":__GPA__,\"semesters\":[";
+    for (int semester = 1; semester <= config.semesters; ++semester) {
+        const bool graded = semester < config.semesters;
+        std::ostringstream subjects;
+        int gradeSum = 0;
+        for (int index = 0; index < config.subjectsPerSemester; ++index) {
+            const std::size_t nameIndex = static_cast<std::size_t>(semester * 3 + index) % countOf(SUBJECT_NAMES);
+            std::string name = SUBJECT_NAMES[nameIndex];
+            if (config.subjectsPerSemester > static_cast<int>(countOf(SUBJECT_NAMES))) {
+                name += " " + std::to_string(index + 1);
+            }
+            const bool exam = index % 3 != 2;
+            const int grade = std::uniform_int_distribution<int>(4, 10)(engine);
+            gradeSum += grade;
+
+            if (index > 0) subjects << ",";
+            subjects << "{\"name\":\"" << name << "\","
+                     << "\"hours\":" << formatDouble(36.0 * (2 + index % 5)) << ","
+                     << "\"credits\":" << (2 + index % 5) << ","
+                     << "\"controlForm\":\"" << (exam ? "Экзамен" : "Зачет") << "\","
+                     << "\"grade\":" << (graded ? std::to_string(grade) : "null") << ","
+                     << "\"retakes\":" << (graded && chance(0.05) ? 1 : 0) << ","
+                     << "\"averageGrade\":" << (chance(0.9) ? formatDouble(6.0 + (grade % 4) * 0.75) : "null") << ","
+                     << "\"retakeChance\":" << formatDouble(graded ? 0.0 : (chance(0.3) ? 0.2 * (index % 5) : 0.0)) << ","
+                     << "\"isOnline\":" << (chance(0.2) ? "true" : "false") << "}";
+        }
+
+        const double gpa = graded && config.subjectsPerSemester > 0
+            ? static_cast<double>(gradeSum) / config.subjectsPerSemester : 0.0;
+        if (graded) {
+            gpaSum += gpa;
+            ++gradedSemesters;
+        }
+
+        if (semester > 1) markbook << ",";
+        markbook << "{\"number\":" << semester << ",\"gpa\":" << formatDouble(gpa)
+                 << ",\"subjects\":[" << subjects.str() << "]}";
+    }
+    markbook << "]}";
+    fixtures["markbook"] = replaceAll(markbook.str(), "__GPA__",
+                                      formatDouble(gradedSemesters ? gpaSum / gradedSemesters : 0.0));
+
+    // Group roster
+    std::ostringstream group;
+    group << "{\"group\":{\"number\":\"420603\",\"faculty\":\"ФИТУ\",\"course\":2,"
+          << "\"curator\":{\"fullName\":\"Трофимович Алексей Фёдорович\",\"phone\":\"+375172938997\","
+          << "\"email\":\"trofimaf@bsuir.by\",\"profileUrl\":\"/employees/a-trofimovich\"}},"
+          << "\"students\":[";
+    for (int number = 1; number <= config.students; ++number) {
+        const std::size_t last = std::uniform_int_distribution<std::size_t>(0, countOf(LAST_NAMES) - 1)(engine);
+        const std::size_t first = std::uniform_int_distribution<std::size_t>(0, countOf(FIRST_NAMES) - 1)(engine);
+        if (number > 1) group << ",";
+        group << "{\"number\":" << number << ",\"fullName\":\"" << LAST_NAMES[last] << " "
+              << FIRST_NAMES[first] << "\"}";
+    }
+    group << "]}";
+    fixtures["user-group-info"] = group.str();
+
+    fixtures["mark-sheet"] =
+        "{\"markSheets\":[{\"id\":1001,\"orderDate\":\"2024-09-01\",\"status\":\"готова\","
+        "\"subject\":\"Математика\",\"semester\":1,\"type\":\"экзаменационная\"}],"
+        "\"canOrder\":true,\"paymentInfo\":{\"system\":\"ЕРИП\",\"path\":\"Образование и развитие - БГУИР\"}}";
+
+    fixtures["certificate"] =
+        "{\"certificates\":[{\"number\":\"5187\",\"orderDate\":\"25.08.2025\","
+        "\"purpose\":\"по месту требования\",\"status\":\"напечатана\",\"rejectReason\":null}]}";
+}
+
+void MockIISService::loadFixtureOverrides() {
+    if (config.fixturesDirectory.empty()) {
+        return;
+    }
+
+    for (auto& fixture : fixtures) {
+        std::ifstream file(config.fixturesDirectory + "/" + fixture.first + ".json", std::ios::binary);
+        if (file) {
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            fixture.second = contents.str();
+        }
+    }
+}
+
+std::string MockIISService::startSession(const std::string& username) {
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+
+    // Drop expired sessions opportunistically
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = sessions.begin(); it != sessions.end();) {
+        it = it->second.expiresAt <= now ? sessions.erase(it) : std::next(it);
+    }
+
+    const uint64_t serial = ++sessionCounter;
+    std::ostringstream id;
+    id << std::hex << std::setw(16) << std::setfill('0') << (config.seed ^ (serial * 0x9E3779B97F4A7C15ULL))
+       << std::setw(8) << serial;
+    sessions[id.str()] = Session{username, now + std::chrono::seconds(config.sessionTtlSeconds)};
+    return id.str();
+}
+
+bool MockIISService::lookupSession(const std::map<std::string, std::string>& headers, std::string& username) {
+    std::string cookieHeader;
+    for (const auto& header : headers) {
+        if (toLowerAscii(header.first) == "cookie") {
+            cookieHeader = header.second;
+        }
+    }
+
+    const std::string needle = std::string(SESSION_COOKIE) + "=";
+    size_t pos = cookieHeader.find(needle);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    size_t end = cookieHeader.find(';', pos);
+    std::string id = cookieHeader.substr(pos + needle.size(),
+                                         end == std::string::npos ? std::string::npos : end - pos - needle.size());
+
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    auto it = sessions.find(id);
+    if (it == sessions.end() || it->second.expiresAt <= std::chrono::steady_clock::now()) {
+        return false;
+    }
+    username = it->second.username;
+    return true;
+}
+
+std::size_t MockIISService::sessionCount() {
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    return sessions.size();
+}
+
+MockResponse MockIISService::errorResponse(int status, const std::string& path) const {
+    const char* reason = status == 401 ? "Unauthorized"
+                       : status == 403 ? "Forbidden"
+                       : status == 404 ? "Not Found"
+                       : status == 429 ? "Too Many Requests"
+                       : status == 503 ? "Service Unavailable"
+                       : "Internal Server Error";
+    MockResponse response;
+    response.statusCode = status;
+    response.body = "{\"timestamp\":\"2025-01-01T00:00:00.000+00:00\",\"status\":" + std::to_string(status) +
+                    ",\"error\":\"" + reason + "\",\"path\":\"/api/v1" + path + "\"}";
+    return response;
+}
+
+MockResponse MockIISService::handleLogin(const HTTPRequest& request) {
+    const std::string username = extractJsonString(request.body, "username");
+    const std::string password = extractJsonString(request.body, "password");
+
+    if (username.empty() || password.empty() || (!config.password.empty() && password != config.password)) {
+        return errorResponse(401, "/auth/login");
+    }
+
+    MockResponse response = serveFixture("login", username);
+    response.headers["Set-Cookie"] = std::string(SESSION_COOKIE) + "=" + startSession(username) + "; Path=/; HttpOnly";
+    return response;
+}
+
+MockResponse MockIISService::serveFixture(const std::string& name, const std::string& username) const {
+    MockResponse response;
+    auto it = fixtures.find(name);
+    if (it == fixtures.end()) {
+        return errorResponse(404, "/" + name);
+    }
+    response.body = replaceAll(it->second, STUDENT_NUMBER_PLACEHOLDER, username);
+    return response;
+}
+
+MockResponse MockIISService::serveSkills(const std::string& query) const {
+    std::string prefix;
+    const std::string key = "name=";
+    size_t pos = query.find(key);
+    if (pos != std::string::npos) {
+        size_t end = query.find('&', pos);
+        prefix = toLowerAscii(decodeQueryValue(
+            query.substr(pos + key.size(), end == std::string::npos ? std::string::npos : end - pos - key.size())));
+    }
+
+    std::ostringstream body;
+    body << "{\"skills\":[";
+    bool first = true;
+    for (const char* skill : SKILLS) {
+        if (toLowerAscii(skill).compare(0, prefix.size(), prefix) == 0) {
+            body << (first ? "" : ",") << "\"" << skill << "\"";
+            first = false;
+        }
+    }
+    body << "]}";
+
+    MockResponse response;
+    response.body = body.str();
+    return response;
+}
+
+MockResponse MockIISService::handle(const HTTPRequest& request) {
+    std::string query;
+    const std::string path = endpointPath(request.url, &query);
+
+    std::chrono::microseconds delay{0};
+    bool injectError = false;
+    {
+        std::lock_guard<std::mutex> lock(randomMutex);
+        delay = config.latency.sample(randomEngine);
+        if (config.errorRate > 0.0 && (config.errorPath.empty() || config.errorPath == path)) {
+            injectError = std::uniform_real_distribution<double>(0.0, 1.0)(randomEngine) < config.errorRate;
+        }
+    }
+
+    MockResponse response;
+    std::string username;
+
+    if (injectError) {
+        response = errorResponse(config.errorStatus, path);
+    } else if (path == "/auth/login") {
+        response = request.method == HTTPMethod::Post ? handleLogin(request) : errorResponse(404, path);
+    } else if (!lookupSession(request.headers, username)) {
+        response = errorResponse(401, path);
+    } else if (path == "/personal-information") {
+        response = serveFixture("personal-information", username);
+    } else if (path == "/markbook") {
+        response = serveFixture("markbook", username);
+    } else if (path == "/student-groups/user-group-info") {
+        response = serveFixture("user-group-info", username);
+    } else if (path == "/mark-sheet") {
+        response = serveFixture("mark-sheet", username);
+    } else if (path == "/certificate") {
+        response = serveFixture("certificate", username);
+    } else if (path == "/skill") {
+        response = serveSkills(query);
+    } else {
+        response = errorResponse(404, path);
+    }
+
+    response.headers["Content-Type"] = "application/json;charset=UTF-8";
+    response.delay = delay;
+    return response;
+}
+
+} // namespace Mock
+} // namespace BSUIR
@@ -0,0 +1,142 @@
+//
+//  MockIISService.hpp
+//  cPPiIS Tools - Mock IIS Server
+//
+//  Deterministic in-process emulation of the documented IIS endpoints
+//  for offline benchmarking of the ApiService stack
+//
+
+#ifndef MockIISService_hpp
+#define MockIISService_hpp
+
+#include "HTTPTransport.hpp"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace BSUIR {
+namespace Mock {
+
+/**
+ * @brief Response latency distribution
+ *
+ * Parsed from "none", "fixed:<ms>", "uniform:<minMs>:<maxMs>" or
+ * "lognormal:<medianMs>:<sigma>".
+ */
+struct LatencyDistribution {
+    enum class Kind { None, Fixed, Uniform, LogNormal };
+
+    Kind kind = Kind::None;
+    double first = 0.0;   ///< fixed/min/median in milliseconds
+    double second = 0.0;  ///< max in milliseconds or lognormal sigma
+
+    /**
+     * @brief Parse a distribution specification
+     * @param spec Specification string
+     * @return Parsed distribution (Kind::None on malformed input)
+     */
+    static LatencyDistribution parse(const std::string& spec);
+
+    /**
+     * @brief Draw one latency sample
+     */
+    std::chrono::microseconds sample(std::mt19937_64& engine) const;
+};
+
+/**
+ * @brief Mock server configuration
+ */
+struct MockIISConfig {
+    int semesters = 4;                      ///< Semesters in the generated markbook
+    int subjectsPerSemester = 8;            ///< Subjects per semester
+    int students = 25;                      ///< Students in the generated group roster
+    LatencyDistribution latency;            ///< Per-response latency
+    double errorRate = 0.0;                 ///< Probability of an injected error
+    int errorStatus = 500;                  ///< Status code of injected errors
+    std::string errorPath;                  ///< Restrict injection to one path (empty: all)
+    std::string password;                   ///< Accepted password (empty: any non-empty)
+    std::string fixturesDirectory;          ///< Optional directory with <endpoint>.json overrides
+    int sessionTtlSeconds = 3600;           ///< Cookie session lifetime
+    uint64_t seed = 42;                     ///< Seed for fixtures, latency and errors
+};
+
+/**
+ * @brief Response produced by the mock service
+ */
+struct MockResponse {
+    int statusCode = 200;
+    std::string body;
+    std::map<std::string, std::string> headers;
+    std::chrono::microseconds delay{0};     ///< Latency to apply before delivery
+};
+
+/**
+ * @brief Request handler emulating IIS
+ *
+ * Serves /auth/login, /personal-information, /markbook,
+ * /student-groups/user-group-info, /mark-sheet, /certificate and
+ * /skill, with or without the /api/v1 prefix. Login issues a
+ * JSESSIONID cookie that every other endpoint requires. Thread-safe.
+ */
+class MockIISService {
+private:
+    MockIISConfig config;
+    std::map<std::string, std::string> fixtures;
+
+    struct Session {
+        std::string username;
+        std::chrono::steady_clock::time_point expiresAt;
+    };
+
+    std::mutex sessionsMutex;
+    std::unordered_map<std::string, Session> sessions;
+    uint64_t sessionCounter = 0;
+
+    std::mutex randomMutex;
+    std::mt19937_64 randomEngine;
+
+    void generateFixtures();
+    void loadFixtureOverrides();
+
+    std::string startSession(const std::string& username);
+    bool lookupSession(const std::map<std::string, std::string>& headers, std::string& username);
+
+    MockResponse handleLogin(const HTTPRequest& request);
+    MockResponse serveFixture(const std::string& name, const std::string& username) const;
+    MockResponse serveSkills(const std::string& query) const;
+    MockResponse errorResponse(int status, const std::string& path) const;
+
+public:
+    explicit MockIISService(MockIISConfig configuration = {});
+
+    /**
+     * @brief Handle one request
+     * @param request Request; url may be absolute or a bare path
+     * @return Response including the latency to apply
+     */
+    MockResponse handle(const HTTPRequest& request);
+
+    /**
+     * @brief Number of live sessions
+     */
+    std::size_t sessionCount();
+
+    const MockIISConfig& getConfig() const noexcept;
+};
+
+/**
+ * @brief Strip scheme, host, /api/v1 prefix and query from a URL
+ * @param url Absolute URL or path
+ * @param query Receives the query string without '?'
+ * @return Endpoint path such as "/markbook"
+ */
+std::string endpointPath(const std::string& url, std::string* query = nullptr);
+
+} // namespace Mock
+} // namespace BSUIR
+
+#endif /* MockIISService_hpp */
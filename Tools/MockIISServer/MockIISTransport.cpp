@@ -0,0 +1,67 @@
+//
+//  MockIISTransport.cpp
+//  cPPiIS Tools - In-Process Mock Transport Implementation
+//
+
+#include "MockIISTransport.hpp"
+
+namespace BSUIR {
+namespace Mock {
+
+// ========================================
+// MockIISTransport Implementation
+// ========================================
+
+HTTPResponse toHTTPResponse(const MockResponse& mock) {
+    HTTPResponse response;
+    response.statusCode = mock.statusCode;
+    response.success = mock.statusCode >= 200 && mock.statusCode < 300;
+    response.data = mock.body;
+    if (!response.success) {
+        response.errorMessage = "HTTP Error " + std::to_string(mock.statusCode);
+    }
+    return response;
+}
+
+MockIISTransport::MockIISTransport(std::shared_ptr<MockIISService> mockService,
+                                   std::shared_ptr<TimerWheel> sharedScheduler)
+    : service(std::move(mockService)),
+      scheduler(sharedScheduler ? std::move(sharedScheduler) : TimerWheel::shared()) {
+}
+
+void MockIISTransport::send(const HTTPRequest& request, ResponseCallback callback) {
+    const auto requestStart = HTTPTimings::Clock::now();
+    CookieJar& jar = request.cookies ? *request.cookies : *cookies;
+    HTTPRequest routed = request;
+    const std::string cookie = jar.cookieHeader(request.url);
+    if (!cookie.empty()) {
+        routed.headers["Cookie"] = cookie;
+    }
+
+    MockResponse mock = service->handle(routed);
+
+    auto setCookie = mock.headers.find("Set-Cookie");
+    if (setCookie != mock.headers.end()) {
+        jar.setCookie(request.url, setCookie->second);
+    }
+
+    HTTPResponse response = toHTTPResponse(mock);
+    response.timings.requestStart = requestStart;
+    response.timings.connectEnd = requestStart;
+
+    scheduler->schedule(mock.delay, [callback = std::move(callback), response = std::move(response)]() mutable {
+        response.timings.firstByte = response.timings.responseEnd = HTTPTimings::Clock::now();
+        callback(response);
+    });
+}
+
+std::string MockIISTransport::cookieHeader(const std::string& url) const {
+    return cookies->cookieHeader(url);
+}
+
+void MockIISTransport::restoreCookies(const std::string& url, const std::string& header) {
+    cookies->restoreCookies(url, header);
+}
+
+} // namespace Mock
+} // namespace BSUIR
@@ -0,0 +1,57 @@
+//
+//  MockIISTransport.hpp
+//  cPPiIS Tools - In-Process Mock Transport
+//
+//  IHTTPTransport that routes HTTPClient requests straight into a
+//  MockIISService, applying its latency on a timer thread
+//
+
+#ifndef MockIISTransport_hpp
+#define MockIISTransport_hpp
+
+#include "CookieJar.hpp"
+#include "HTTPTransport.hpp"
+#include "MockIISService.hpp"
+#include "TimerWheel.hpp"
+#include <memory>
+#include <string>
+
+namespace BSUIR {
+namespace Mock {
+
+/**
+ * @brief In-process transport backed by MockIISService
+ *
+ * Cookies go to the request's jar like on the real transports, so one
+ * instance can serve many simulated sessions; requests without a jar
+ * share the instance's own, which then stands for one device.
+ */
+class MockIISTransport : public IHTTPTransport {
+private:
+    std::shared_ptr<MockIISService> service;
+    std::shared_ptr<TimerWheel> scheduler;
+    std::shared_ptr<CookieJar> cookies = std::make_shared<CookieJar>();
+
+public:
+    /**
+     * @param mockService Service answering the requests
+     * @param sharedScheduler Timer applying latency, which lands up to one
+     *        of its ticks late (default: TimerWheel::shared(), 10 ms ticks)
+     */
+    explicit MockIISTransport(std::shared_ptr<MockIISService> mockService,
+                              std::shared_ptr<TimerWheel> sharedScheduler = nullptr);
+
+    void send(const HTTPRequest& request, ResponseCallback callback) override;
+    std::string cookieHeader(const std::string& url) const override;
+    void restoreCookies(const std::string& url, const std::string& header) override;
+};
+
+/**
+ * @brief Convert a mock response into the transport response shape
+ */
+HTTPResponse toHTTPResponse(const MockResponse& response);
+
+} // namespace Mock
+} // namespace BSUIR
+
+#endif /* MockIISTransport_hpp */
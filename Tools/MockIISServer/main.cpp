@@ -0,0 +1,102 @@
+//
+//  main.cpp
+//  cPPiIS Tools - Mock IIS Server
+//
+//  Command line entry point serving fixture data on the loopback interface.
+//  Build (from this directory):
+//    c++ -std=c++20 -O2 -I../../cPPiIS/Core *.cpp ../../cPPiIS/Core/{CookieJar,TimerWheel}.cpp -o mock-iis-server -pthread
+//
+//  Example:
+//    ./mock-iis-server --port 8080 --semesters 8 --students 30
+//                      --latency lognormal:40:0.5 --error-rate 0.01 --error-status 503
+//
+
+#include "LoopbackHTTPServer.hpp"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void handleSignal(int) {
+    stopRequested = 1;
+}
+
+void printUsage() {
+    std::cout
+        << "Usage: mock-iis-server [options]\n"
+        << "  --port N               Listen port on 127.0.0.1 (default 8080, 0 = any)\n"
+        << "  --semesters N          Semesters in the markbook (default 4)\n"
+        << "  --subjects N           Subjects per semester (default 8)\n"
+        << "  --students N           Students in the group roster (default 25)\n"
+        << "  --latency SPEC         none | fixed:MS | uniform:MIN:MAX | lognormal:MEDIAN:SIGMA\n"
+        << "  --error-rate P         Probability of an injected error (default 0)\n"
+        << "  --error-status CODE    Status of injected errors (default 500)\n"
+        << "  --error-path PATH      Only inject errors for this endpoint, e.g. /markbook\n"
+        << "  --password PW          Only accept this password (default: any)\n"
+        << "  --fixtures DIR         Directory with <endpoint>.json overrides\n"
+        << "  --session-ttl SECONDS  Session cookie lifetime (default 3600)\n"
+        << "  --seed N               Seed for generated data and randomness (default 42)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    using namespace BSUIR::Mock;
+
+    MockIISConfig config;
+    uint16_t port = 8080;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << option << std::endl;
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (option == "--port")               port = static_cast<uint16_t>(std::stoi(next()));
+        else if (option == "--semesters")     config.semesters = std::stoi(next());
+        else if (option == "--subjects")      config.subjectsPerSemester = std::stoi(next());
+        else if (option == "--students")      config.students = std::stoi(next());
+        else if (option == "--latency")       config.latency = LatencyDistribution::parse(next());
+        else if (option == "--error-rate")    config.errorRate = std::stod(next());
+        else if (option == "--error-status")  config.errorStatus = std::stoi(next());
+        else if (option == "--error-path")    config.errorPath = next();
+        else if (option == "--password")      config.password = next();
+        else if (option == "--fixtures")      config.fixturesDirectory = next();
+        else if (option == "--session-ttl")   config.sessionTtlSeconds = std::stoi(next());
+        else if (option == "--seed")          config.seed = std::stoull(next());
+        else {
+            printUsage();
+            return option == "--help" ? 0 : 2;
+        }
+    }
+
+    auto service = std::make_shared<MockIISService>(config);
+    LoopbackHTTPServer server(service, port);
+
+    std::string error;
+    if (!server.start(&error)) {
+        std::cerr << "❌ Mock IIS: " << error << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::cout << "🚀 Mock IIS listening on " << server.baseUrl() << std::endl;
+    while (!stopRequested) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    server.stop();
+    std::cout << "🛑 Mock IIS stopped" << std::endl;
+    return 0;
+}
@@ -0,0 +1,408 @@
+//
+//  main.cpp
+//  cPPiIS Tools - ApiService Stress Test
+//
+//  Hammers every public method of one shared ApiService from many threads
+//  against the in-process mock IIS. Meant to run under ThreadSanitizer:
+//  any report, a hung callback or a crash is a failure. Before hammering,
+//  the mock's markbook and group roster are fetched once and checked
+//  against what the mock generated.
+//  Build (from this directory):
+//    c++ -std=c++20 -O1 -g -fsanitize=thread -I../../cPPiIS -I../../cPPiIS/Core -I../MockIISServer
+//        main.cpp ../MockIISServer/MockIISService.cpp ../MockIISServer/MockIISTransport.cpp
+//        ../../cPPiIS/Core/{HTTPClient,CookieJar,CurlHTTPTransport,JSONParser,Executor,CoroutineFramePool,BSUIROOPDemo,TimerWheel,TrafficCapture,Log,Tracing,Metrics,PollingController,Profiler,Watchdog,LocalStore,ModelDiff,StringPool,MarkbookColumns,RosterIndex,SkillTrie,SkillAutocomplete}.cpp
+//        -x c++ ../../cPPiIS/Core/{ApiService,IConfigProvider,SecureTokenStorage}.mm -o stress-test -pthread -lcurl
+//
+//  Example:
+//    ./stress-test                          # 8 threads for 5 seconds
+//    ./stress-test --threads 16 --seconds 30
+//
+
+#include "ApiService.hpp"
+#include "LocalStore.hpp"
+#include "MarkbookColumns.hpp"
+#include "MockIISService.hpp"
+#include "MockIISTransport.hpp"
+#include "RosterIndex.hpp"
+#include "SecureTokenStorage.hpp"
+#include "Task.hpp"
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <iostream>
+#include <locale>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BSUIR;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+/**
+ * @brief Session vault kept in memory
+ */
+class MemoryVault : public ISecureVault {
+private:
+    mutable std::mutex mutex;
+    std::map<std::string, std::string> blobs;
+
+public:
+    std::optional<std::string> read(const std::string& key) const override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = blobs.find(key);
+        return it == blobs.end() ? std::nullopt : std::optional<std::string>(it->second);
+    }
+
+    bool write(const std::string& key, const std::string& value) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        blobs[key] = value;
+        return true;
+    }
+
+    void remove(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        blobs.erase(key);
+    }
+};
+
+/**
+ * @brief Transport decorator counting requests whose callback has not returned
+ */
+class CountingTransport : public IHTTPTransport {
+private:
+    std::shared_ptr<IHTTPTransport> inner;
+    std::atomic<int64_t>& busy;
+
+public:
+    CountingTransport(std::shared_ptr<IHTTPTransport> wrapped, std::atomic<int64_t>& counter)
+        : inner(std::move(wrapped)), busy(counter) {}
+
+    void send(const HTTPRequest& request, ResponseCallback callback) override {
+        ++busy;
+        inner->send(request, [this, callback = std::move(callback)](const HTTPResponse& response) {
+            callback(response);
+            --busy;
+        });
+    }
+
+    std::string cookieHeader(const std::string& url) const override { return inner->cookieHeader(url); }
+    void restoreCookies(const std::string& url, const std::string& header) override {
+        inner->restoreCookies(url, header);
+    }
+};
+
+/**
+ * @brief Executor decorator counting tasks not finished yet
+ */
+class CountingExecutor : public IExecutor {
+private:
+    std::shared_ptr<IExecutor> inner;
+    std::atomic<int64_t>& busy;
+
+public:
+    CountingExecutor(std::shared_ptr<IExecutor> wrapped, std::atomic<int64_t>& counter)
+        : inner(std::move(wrapped)), busy(counter) {}
+
+    void post(std::function<void()> task) override {
+        ++busy;
+        inner->post([this, task = std::move(task)] {
+            task();
+            --busy;
+        });
+    }
+};
+
+/**
+ * @brief Observer counting what it is told
+ */
+class CountingObserver : public Observer {
+public:
+    std::atomic<uint64_t> events{0};
+
+    void onUserLoggedIn(const AbstractUser*) override { ++events; }
+    void onUserLoggedOut() override { ++events; }
+    void onDataUpdated(const std::string&) override { ++events; }
+    void onMarkbookChanged(const MarkbookChangeSet&) override { ++events; }
+    void onGroupInfoChanged(const GroupChangeSet&) override { ++events; }
+};
+
+/**
+ * @brief State shared by the hammering threads
+ */
+struct StressContext {
+    ApiService& api;
+    ServiceExecutors executors;
+    std::shared_ptr<IExecutor> coroutines;
+    std::shared_ptr<LocalStore> store;
+    std::shared_ptr<RosterIndex> roster;
+    std::shared_ptr<MemoryVault> vault;
+    std::atomic<int64_t> outstanding{0};        ///< Callbacks and coroutines not finished yet
+    int64_t maxOutstanding = 64;                ///< Callers wait while this many results are due
+    std::atomic<uint64_t> operations{0};
+    std::atomic<uint64_t> failures{0};          ///< Results with success == false (expected under logout races)
+    std::atomic<uint64_t> duplicates{0};        ///< Callbacks invoked more than once
+};
+
+template<typename T>
+std::function<void(const ApiResult<T>&)> track(StressContext& context, const char* method) {
+    ++context.outstanding;
+    // Cached data may be followed by a refreshed delivery; nothing else repeats
+    enum Delivery { None, Cached, Final };
+    auto delivered = std::make_shared<std::atomic<int>>(None);
+    return [&context, delivered, method](const ApiResult<T>& result) {
+        int expected = None;
+        if (!delivered->compare_exchange_strong(expected, result.cacheAge ? Cached : Final)) {
+            if (expected == Cached && delivered->compare_exchange_strong(expected, Final)) {
+                return;
+            }
+            ++context.duplicates;
+            std::cerr << "Callback of " << method << " called again (" << (result.success ? "success" : "failure")
+                      << (result.cacheAge ? ", cached" : "") << ")" << std::endl;
+            return;
+        }
+        if (!result.success) {
+            ++context.failures;
+        }
+        --context.outstanding;
+    };
+}
+
+template<typename T>
+void spawnTracked(StressContext& context, Task<ApiResult<T>> task) {
+    ++context.outstanding;
+    spawn(std::move(task), [&context](ApiResult<T> result) {
+        if (!result.success) {
+            ++context.failures;
+        }
+        --context.outstanding;
+    });
+}
+
+void hammer(StressContext& context, unsigned seed, Clock::time_point deadline) {
+    std::mt19937 random(seed);
+    CountingObserver observer;
+    bool observing = false;
+    const std::string account = "1021" + std::to_string(1000 + seed);
+    const char* prefixes[] = {"c", "ja", "py", "sq", "do"};
+    const CachedModel models[] = {CachedModel::PersonalInfo, CachedModel::Markbook, CachedModel::GroupInfo};
+    ApiService& api = context.api;
+
+    while (Clock::now() < deadline) {
+        // Parsing is slow under the sanitizer; without a bound the backlog
+        // would outlast the run by minutes
+        while (context.outstanding.load() >= context.maxOutstanding && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        switch (random() % 24) {
+            case 0:  api.login(account, "password", track<LoginResponse>(context, "login")); break;
+            case 1:  if (random() % 8 == 0) api.logout(); break;
+            case 2:  (void)api.isAuthenticated(); break;
+            case 3:  api.getPersonalInfo(track<PersonalInfo>(context, "getPersonalInfo")); break;
+            case 4:  api.getMarkbook(track<Markbook>(context, "getMarkbook")); break;
+            case 5:  api.getGroupInfo(track<GroupInfo>(context, "getGroupInfo")); break;
+            case 6:  api.searchSkills(prefixes[random() % 5], track<std::vector<std::string>>(context, "searchSkills")); break;
+            case 7:  api.setTokens("access-" + std::to_string(random() % 4), "refresh"); break;
+            case 8:  (void)api.getAccessToken(); (void)api.getRefreshToken(); break;
+            case 9:  api.setExecutors(context.executors); break;
+            case 10: api.setLocalStore(random() % 2 ? context.store : nullptr); break;
+            case 11: api.setFreshnessPolicy(models[random() % 3],
+                                            FreshnessPolicy{std::chrono::seconds(random() % 3),
+                                                            std::chrono::seconds(60)}); break;
+            case 12: api.setRosterIndex(random() % 2 ? context.roster : nullptr); break;
+            case 13: {
+                PrefetchPolicy policy;
+                if (random() % 2) {
+                    policy.models = {CachedModel::PersonalInfo, CachedModel::Markbook};
+                    policy.minInterval = std::chrono::seconds(0);
+                }
+                api.setPrefetchPolicy(policy);
+                break;
+            }
+            case 14: api.setSessionVault(random() % 4 ? context.vault : nullptr, std::chrono::seconds(60)); break;
+            case 15: api.setCredentialsProvider(random() % 2 ? CredentialsProvider([account] {
+                         return std::optional<std::pair<std::string, std::string>>({account, "password"});
+                     }) : CredentialsProvider()); break;
+            case 16: (void)api.prefetchStats(); (void)api.prefetchStats(models[random() % 3]); break;
+            case 17: api.setCoroutineExecutor(random() % 2 ? context.coroutines : nullptr); break;
+            case 18: spawnTracked(context, api.loginAsync(account, "password")); break;
+            case 19: spawnTracked(context, api.personalInfoAsync()); break;
+            case 20: spawnTracked(context, api.markbookAsync()); break;
+            case 21: spawnTracked(context, api.groupInfoAsync()); break;
+            case 22:
+                if (observing) api.removeObserver(&observer);
+                else api.addObserver(&observer);
+                observing = !observing;
+                break;
+            case 23: (void)api.getConfig().getApiBaseUrl(); break;
+        }
+        ++context.operations;
+    }
+
+    if (observing) {
+        api.removeObserver(&observer);
+    }
+}
+
+/**
+ * @brief Wait for one callback-style result
+ */
+template<typename T, typename Call>
+std::optional<ApiResult<T>> await(Call call) {
+    auto promise = std::make_shared<std::promise<ApiResult<T>>>();
+    auto future = promise->get_future();
+    call([promise](const ApiResult<T>& result) { promise->set_value(result); });
+    if (future.wait_for(std::chrono::seconds(30)) != std::future_status::ready) {
+        return std::nullopt;
+    }
+    return future.get();
+}
+
+/**
+ * @brief Round-trip the mock's markbook and roster through the parser
+ *
+ * The generated fixtures must come back with every semester, subject and
+ * student, the markbook must fill MarkbookColumns row for row, and the
+ * roster must reach the RosterIndex and be found by name there.
+ */
+bool checkModels(const std::shared_ptr<Mock::MockIISService>& mockService) {
+    const Mock::MockIISConfig& config = mockService->getConfig();
+    ApiService api(ConfigProviderFactory::createCustomConfig("http://mock.local/api/v1", false),
+                   std::make_unique<HTTPClient>(std::make_shared<Mock::MockIISTransport>(mockService)));
+    auto roster = std::make_shared<RosterIndex>();
+    api.setRosterIndex(roster);
+
+    auto login = await<LoginResponse>([&api](auto callback) { api.login("10210001", "password", callback); });
+    auto markbook = await<Markbook>([&api](auto callback) { api.getMarkbook(callback); });
+    auto group = await<GroupInfo>([&api](auto callback) { api.getGroupInfo(callback); });
+    if (!login || !login->success || !markbook || !markbook->success || !group || !group->success) {
+        std::cout << "❌ Model check: requests to the mock failed" << std::endl;
+        return false;
+    }
+
+    bool passed = static_cast<int>(markbook->data->semesters.size()) == config.semesters;
+    for (const auto& semester : markbook->data->semesters) {
+        passed = passed && static_cast<int>(semester.subjects.size()) == config.subjectsPerSemester;
+        for (const auto& subject : semester.subjects) {
+            passed = passed && !subject.name.empty() && !subject.controlForm.empty();
+        }
+    }
+    const MarkbookColumns columns(*markbook->data);
+    passed = passed && columns.rowCount() == static_cast<std::size_t>(config.semesters * config.subjectsPerSemester) &&
+             columns.semesterCount() == markbook->data->semesters.size();
+    if (passed && columns.rowCount() > 0) {
+        const Semester& first = markbook->data->semesters.front();
+        passed = columns.findRow(first.number, first.subjects.front().name, first.subjects.front().controlForm) ==
+                 std::optional<std::size_t>(0);
+    }
+    passed = passed && static_cast<int>(group->data->students.size()) == config.students &&
+             !group->data->number.empty() && !group->data->curator.fullName.empty() &&
+             roster->size() == group->data->students.size();
+    if (passed && !group->data->students.empty()) {
+        const GroupStudent& first = group->data->students.front();
+        // The mock may give two students the same name, so any exact match will do
+        const std::string key = group->data->number + "/" + std::to_string(first.number);
+        const auto matches = roster->search(first.fullName, group->data->students.size());
+        passed = std::any_of(matches.begin(), matches.end(), [&key](const RosterMatch& match) { return match.key == key; });
+    }
+    std::cout << (passed ? "✅" : "❌") << " Model check: " << markbook->data->semesters.size() << " semesters, "
+              << columns.rowCount() << " subject rows, "
+              << group->data->students.size() << " students, " << roster->size() << " indexed" << std::endl;
+    return passed;
+}
+
+void printUsage() {
+    std::cout
+        << "Usage: stress-test [options]\n"
+        << "  --threads N    Hammering threads (default 8)\n"
+        << "  --seconds N    Duration (default 5)\n"
+        << "  --in-flight N  Results due at once before callers wait (default 64)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned threadCount = 8;
+    int seconds = 5;
+    int64_t maxOutstanding = 64;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (option == "--threads" && i + 1 < argc)      threadCount = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (option == "--seconds" && i + 1 < argc) seconds = std::stoi(argv[++i]);
+        else if (option == "--in-flight" && i + 1 < argc) maxOutstanding = std::stoll(argv[++i]);
+        else {
+            printUsage();
+            return option == "--help" ? 0 : 2;
+        }
+    }
+
+    // libstdc++ fills the ctype narrow cache lazily and without
+    // synchronization when std::regex compiles (GCC bug 77704); filling it
+    // up front keeps that benign race out of the report
+    const auto& ctype = std::use_facet<std::ctype<char>>(std::locale());
+    for (int c = 0; c < 256; ++c) {
+        ctype.narrow(static_cast<char>(c), '\0');
+    }
+
+    // Requests and tasks still running, so teardown can wait for a quiet service
+    std::atomic<int64_t> busy{0};
+    auto mockService = std::make_shared<Mock::MockIISService>();
+    if (!checkModels(mockService)) {
+        return 1;
+    }
+    auto transport = std::make_shared<CountingTransport>(std::make_shared<Mock::MockIISTransport>(mockService), busy);
+    auto api = std::make_unique<ApiService>(ConfigProviderFactory::createCustomConfig("http://mock.local/api/v1", false),
+                                            std::make_unique<HTTPClient>(transport));
+
+    const std::string storePath = "stress-test-" + std::to_string(::getpid()) + ".store";
+    auto pool = std::make_shared<CountingExecutor>(ExecutorFactory::createThreadPool(4), busy);
+
+    StressContext context{*api, ServiceExecutors{pool, pool, pool, nullptr}, pool,
+                          std::make_shared<LocalStore>(storePath, false),
+                          std::make_shared<RosterIndex>(), std::make_shared<MemoryVault>()};
+    context.maxOutstanding = maxOutstanding;
+
+    std::cout << "Hammering one ApiService from " << threadCount << " threads for " << seconds << " s" << std::endl;
+    const auto deadline = Clock::now() + std::chrono::seconds(seconds);
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back(hammer, std::ref(context), i + 1, deadline);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every callback must eventually run, whatever the interleaving; the
+    // service is destroyed only once prefetches and posted work are done too
+    api->setPrefetchPolicy(PrefetchPolicy{});
+    const auto drainDeadline = Clock::now() + std::chrono::seconds(30);
+    int quietChecks = 0;
+    while (quietChecks < 5 && Clock::now() < drainDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        quietChecks = context.outstanding.load() == 0 && busy.load() == 0 ? quietChecks + 1 : 0;
+    }
+    const int64_t hung = context.outstanding.load();
+    const int64_t running = busy.load();
+
+    if (running > 0) {
+        // Destroying the service under running work would only add noise
+        std::cout << running << " requests or tasks never finished" << std::endl;
+        (void)api.release();
+        return 1;
+    }
+    api.reset();
+    pool.reset();
+    std::remove(storePath.c_str());
+
+    std::cout << context.operations.load() << " operations, " << context.failures.load()
+              << " failed results, " << hung << " callbacks never called, "
+              << context.duplicates.load() << " called again" << std::endl;
+    return hung == 0 && context.duplicates.load() == 0 ? 0 : 1;
+}
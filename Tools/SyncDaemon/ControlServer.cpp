@@ -0,0 +1,337 @@
+//
+//  ControlServer.cpp
+//  cPPiIS Tools - Sync Daemon Control Socket Implementation
+//
+
+#include "ControlServer.hpp"
+#include "Metrics.hpp"
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+namespace BSUIR {
+namespace Tools {
+
+namespace {
+
+const std::size_t MAX_LINE_BYTES = 4096;
+
+bool sendAll(int socket, const std::string& data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t written = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            if (written < 0 && errno == EINTR) continue;
+            return false;
+        }
+        sent += static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+std::string quote(const std::string& value) {
+    std::string result = "\"";
+    for (unsigned char c : value) {
+        switch (c) {
+            case '"':  result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    result += escaped;
+                } else {
+                    result += static_cast<char>(c);
+                }
+        }
+    }
+    return result + "\"";
+}
+
+std::string error(const std::string& message) {
+    return "{\"error\":" + quote(message) + "}";
+}
+
+int64_t unixSeconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+std::string toJSON(const AccountStatus& status) {
+    std::ostringstream json;
+    json << "{\"account\":" << quote(status.studentNumber)
+         << ",\"state\":\"" << AccountStatus::stateName(status.state) << "\""
+         << ",\"lastSync\":" << unixSeconds(status.lastSync)
+         << ",\"syncs\":" << status.syncs
+         << ",\"failures\":" << status.failures
+         << ",\"changes\":" << status.changes
+         << ",\"intervals\":{\"personal\":" << status.intervals[static_cast<std::size_t>(CachedModel::PersonalInfo)].count()
+         << ",\"markbook\":" << status.intervals[static_cast<std::size_t>(CachedModel::Markbook)].count()
+         << ",\"group\":" << status.intervals[static_cast<std::size_t>(CachedModel::GroupInfo)].count() << "}"
+         << ",\"lastError\":" << quote(status.lastError) << "}";
+    return json.str();
+}
+
+bool parseModel(const std::string& name, CachedModel& model) {
+    if (name == "personal") { model = CachedModel::PersonalInfo; return true; }
+    if (name == "markbook") { model = CachedModel::Markbook;     return true; }
+    if (name == "group")    { model = CachedModel::GroupInfo;    return true; }
+    return false;
+}
+
+// True when nobody accepts on the socket at address; otherwise reason says why it must stay
+bool probeSocket(const sockaddr_un& address, std::string* reason) {
+    const int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) {
+        *reason = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+    const int result = ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    const int connectError = errno;
+    ::close(probe);
+
+    if (result == 0) {
+        *reason = std::string(address.sun_path) + " is in use by another running daemon";
+        return false;
+    }
+    if (connectError != ECONNREFUSED) {
+        *reason = std::string("connect ") + address.sun_path + ": " + std::strerror(connectError);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ========================================
+// ControlServer Implementation
+// ========================================
+
+ControlServer::ControlServer(SyncDaemon& syncDaemon, std::string path)
+    : daemon(syncDaemon), socketPath(std::move(path)) {
+}
+
+ControlServer::~ControlServer() {
+    stop();
+}
+
+bool ControlServer::start(std::string* error) {
+    sockaddr_un address{};
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        if (error) *error = "Socket path too long: " + socketPath;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        if (error) *error = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    // A socket file left by a killed daemon would make bind fail; anything
+    // else at the path, or a socket someone still listens on, is not ours to delete
+    struct stat existing{};
+    if (::lstat(socketPath.c_str(), &existing) == 0) {
+        std::string reason;
+        if (!S_ISSOCK(existing.st_mode)) {
+            reason = socketPath + " exists and is not a socket";
+        } else if (probeSocket(address, &reason)) {
+            ::unlink(socketPath.c_str());
+        }
+        if (!reason.empty()) {
+            if (error) *error = reason;
+            ::close(listenSocket);
+            listenSocket = -1;
+            return false;
+        }
+    }
+    const mode_t previousMask = ::umask(0177);
+    const bool bound = ::bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    ::umask(previousMask);
+    if (!bound || ::listen(listenSocket, 16) < 0) {
+        if (error) *error = std::string("bind/listen: ") + std::strerror(errno);
+        ::close(listenSocket);
+        listenSocket = -1;
+        return false;
+    }
+
+    running = true;
+    acceptThread = std::thread([this] { acceptLoop(); });
+    return true;
+}
+
+void ControlServer::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    ::shutdown(listenSocket, SHUT_RDWR);
+    ::close(listenSocket);
+    if (acceptThread.joinable()) {
+        acceptThread.join();
+    }
+
+    std::list<std::unique_ptr<Connection>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        remaining.swap(connections);
+    }
+    // Wakes connection threads blocked in recv on an idle client
+    for (auto& connection : remaining) {
+        ::shutdown(connection->socket, SHUT_RDWR);
+    }
+    for (auto& connection : remaining) {
+        if (connection->thread.joinable()) {
+            connection->thread.join();
+        }
+        ::close(connection->socket);
+    }
+    ::unlink(socketPath.c_str());
+}
+
+void ControlServer::reapFinishedConnections() {
+    std::list<std::unique_ptr<Connection>> finished;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (auto it = connections.begin(); it != connections.end();) {
+            if ((*it)->finished.load()) {
+                finished.push_back(std::move(*it));
+                it = connections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto& connection : finished) {
+        connection->thread.join();
+        ::close(connection->socket);
+    }
+}
+
+void ControlServer::acceptLoop() {
+    while (running.load()) {
+        int client = ::accept(listenSocket, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        reapFinishedConnections();
+
+        auto connection = std::make_unique<Connection>();
+        connection->socket = client;
+        Connection* raw = connection.get();
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            connections.push_back(std::move(connection));
+        }
+        // Closed only once joined, so stop() never shuts down a reused
+        // descriptor; the shutdown tells the client right away
+        raw->thread = std::thread([this, raw] {
+            serveConnection(raw->socket);
+            ::shutdown(raw->socket, SHUT_RDWR);
+            raw->finished = true;
+        });
+    }
+}
+
+void ControlServer::serveConnection(int socket) {
+    std::string buffer;
+    char chunk[1024];
+    while (running.load()) {
+        const size_t newline = buffer.find('\n');
+        if (newline != std::string::npos) {
+            std::string line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (!sendAll(socket, execute(line) + "\n")) {
+                return;
+            }
+            continue;
+        }
+        if (buffer.size() > MAX_LINE_BYTES) {
+            sendAll(socket, error("Line too long") + "\n");
+            return;
+        }
+        ssize_t received = ::recv(socket, chunk, sizeof(chunk), 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return;
+        }
+        buffer.append(chunk, static_cast<size_t>(received));
+    }
+}
+
+std::string ControlServer::execute(const std::string& command) {
+    std::istringstream words(command);
+    std::string verb, argument, extra;
+    words >> verb >> argument >> extra;
+
+    if (verb == "status") {
+        const SyncSummary summary = daemon.summary();
+        std::ostringstream json;
+        json << "{\"accounts\":" << summary.accounts
+             << ",\"pending\":" << summary.pending
+             << ",\"syncing\":" << summary.syncing
+             << ",\"active\":" << summary.active
+             << ",\"failed\":" << summary.failed
+             << ",\"syncs\":" << summary.syncs
+             << ",\"failures\":" << summary.failures
+             << ",\"changes\":" << summary.changes << "}";
+        return json.str();
+    }
+    if (verb == "list") {
+        std::string json = "[";
+        for (const auto& status : daemon.statuses()) {
+            if (json.size() > 1) json += ",";
+            json += toJSON(status);
+        }
+        return json + "]";
+    }
+    if (verb == "account") {
+        auto status = daemon.status(argument);
+        return status ? toJSON(*status) : error("Unknown account " + argument);
+    }
+    if (verb == "get") {
+        CachedModel model;
+        if (!parseModel(extra, model)) {
+            return error("Usage: get <number> personal|markbook|group");
+        }
+        auto stored = daemon.stored(argument, model);
+        if (!stored) {
+            return error("Nothing stored for " + argument + " " + extra);
+        }
+        // Raw newlines only occur between JSON tokens, so the body fits on one line
+        std::string body = stored->value;
+        for (char& c : body) {
+            if (c == '\n' || c == '\r') c = ' ';
+        }
+        return "{\"account\":" + quote(argument) + ",\"model\":" + quote(extra) +
+               ",\"storedAt\":" + std::to_string(unixSeconds(stored->storedAt)) + ",\"data\":" + body + "}";
+    }
+    if (verb == "refresh") {
+        if (argument == "all") {
+            return "{\"started\":" + std::to_string(daemon.refreshAll()) + "}";
+        }
+        return daemon.refresh(argument) ? "{\"started\":1}" : error("Unknown account " + argument);
+    }
+    if (verb == "metrics") {
+        return Metrics::toPrometheus(Metrics::MetricsRegistry::shared().snapshot()) + "# EOF";
+    }
+    return error("Commands: status, list, account N, get N personal|markbook|group, refresh N|all, metrics");
+}
+
+} // namespace Tools
+} // namespace BSUIR
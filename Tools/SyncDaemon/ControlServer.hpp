@@ -0,0 +1,93 @@
+//
+//  ControlServer.hpp
+//  cPPiIS Tools - Sync Daemon Control Socket
+//
+//  Line protocol on a Unix domain socket for querying and steering a
+//  running SyncDaemon (status, stored data, forced refreshes, metrics)
+//
+
+#ifndef ControlServer_hpp
+#define ControlServer_hpp
+
+#include "SyncDaemon.hpp"
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace BSUIR {
+namespace Tools {
+
+/**
+ * @brief Local control socket of the sync daemon
+ *
+ * Each line received is one command; each answer is one line of JSON,
+ * except "metrics", which answers Prometheus text ending in "# EOF".
+ *
+ *   status                          totals over all accounts
+ *   list                            status of every account
+ *   account <number>                status of one account, with the
+ *                                   current refresh interval per model
+ *   get <number> personal|markbook|group
+ *                                   last stored response
+ *   refresh <number>|all            sync now
+ *   metrics                         core metrics
+ *
+ * Each connection is served on its own thread, so an idle client does
+ * not hold up the others; the socket file is created 0600 since stored
+ * data is personal.
+ */
+class ControlServer {
+private:
+    struct Connection {
+        int socket = -1;
+        std::atomic<bool> finished{false};
+        std::thread thread;
+    };
+
+    SyncDaemon& daemon;
+    std::string socketPath;
+    int listenSocket = -1;
+    std::atomic<bool> running{false};
+    std::thread acceptThread;
+
+    std::mutex connectionsMutex;
+    std::list<std::unique_ptr<Connection>> connections;
+
+    void acceptLoop();
+    void serveConnection(int socket);
+    void reapFinishedConnections();
+
+public:
+    ControlServer(SyncDaemon& syncDaemon, std::string path);
+    ~ControlServer();
+
+    ControlServer(const ControlServer&) = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    /**
+     * @brief Bind the socket (replacing a stale one) and start serving
+     *
+     * A file at the path that is not a socket is left alone and fails the
+     * start.
+     * @param error Receives a description on failure
+     */
+    bool start(std::string* error = nullptr);
+
+    /**
+     * @brief Stop serving and remove the socket file
+     */
+    void stop();
+
+    /**
+     * @brief Answer one command line (exposed for tests and one-shot use)
+     */
+    std::string execute(const std::string& command);
+};
+
+} // namespace Tools
+} // namespace BSUIR
+
+#endif /* ControlServer_hpp */
@@ -0,0 +1,511 @@
+//
+//  SyncDaemon.cpp
+//  cPPiIS Tools - Headless Account Sync Implementation
+//
+
+#include "SyncDaemon.hpp"
+#include "Config.h"
+#include "Log.hpp"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <sstream>
+#include <utility>
+
+namespace BSUIR {
+namespace Tools {
+
+namespace {
+
+constexpr const char* POLLING_STORE_KEY = "sync polling";
+
+// Models due within this of the earliest one are fetched in the same sync
+constexpr std::chrono::seconds COALESCE_WINDOW{60};
+
+const std::array<CachedModel, 3> SYNCED_MODELS = {
+    CachedModel::PersonalInfo, CachedModel::Markbook, CachedModel::GroupInfo
+};
+
+const char* modelEndpoint(CachedModel model) {
+    switch (model) {
+        case CachedModel::PersonalInfo: return API_PERSONAL_INFO_ENDPOINT;
+        case CachedModel::Markbook:     return API_MARKBOOK_ENDPOINT;
+        case CachedModel::GroupInfo:    return API_GROUP_INFO_ENDPOINT;
+        case CachedModel::Count:        break;
+    }
+    return "";
+}
+
+std::size_t fingerprint(const std::optional<StoredValue>& stored) {
+    return stored ? std::hash<std::string>{}(stored->value) : 0;
+}
+
+} // namespace
+
+// ========================================
+// Account List
+// ========================================
+
+std::vector<SyncAccount> loadAccounts(const std::string& path, std::string* error) {
+    std::ifstream file(path);
+    if (!file) {
+        if (error) *error = "Cannot open " + path;
+        return {};
+    }
+
+    std::vector<SyncAccount> accounts;
+    std::string line;
+    for (int number = 1; std::getline(file, line); ++number) {
+        std::istringstream fields(line);
+        SyncAccount account;
+        std::string extra;
+        if (!(fields >> account.studentNumber) || account.studentNumber[0] == '#') {
+            continue;
+        }
+        if (!(fields >> account.password) || (fields >> extra)) {
+            if (error) *error = path + ":" + std::to_string(number) + ": expected <student number> <password>";
+            return {};
+        }
+        accounts.push_back(std::move(account));
+    }
+    return accounts;
+}
+
+// ========================================
+// FileSessionVault Implementation
+// ========================================
+
+FileSessionVault::FileSessionVault(std::string sessionDirectory, std::string studentNumber)
+    : directory(std::move(sessionDirectory)), account(std::move(studentNumber)) {
+}
+
+std::string FileSessionVault::pathFor(const std::string& key) const {
+    return directory + "/" + account + "." + key;
+}
+
+std::optional<std::string> FileSessionVault::read(const std::string& key) const {
+    std::ifstream file(pathFor(key), std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+bool FileSessionVault::write(const std::string& key, const std::string& value) {
+    // Temporary file + rename, created 0600 so the session is never world-readable
+    const std::string path = pathFor(key);
+    const std::string temporary = path + ".tmp";
+    int descriptor = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (descriptor < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < value.size()) {
+        ssize_t result = ::write(descriptor, value.data() + written, value.size() - written);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            ::close(descriptor);
+            ::unlink(temporary.c_str());
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    ::close(descriptor);
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+void FileSessionVault::remove(const std::string& key) {
+    ::unlink(pathFor(key).c_str());
+}
+
+// ========================================
+// Session
+// ========================================
+
+const char* AccountStatus::stateName(State state) noexcept {
+    switch (state) {
+        case State::Pending: return "pending";
+        case State::Syncing: return "syncing";
+        case State::Active:  return "active";
+        case State::Failed:  return "failed";
+    }
+    return "pending";
+}
+
+/**
+ * @brief One account: its service, status and the fetches of the running sync
+ */
+struct SyncDaemon::Session : public Observer {
+    SyncAccount account;
+    std::unique_ptr<ApiService> api;
+
+    mutable std::mutex mutex;
+    AccountStatus status;
+    TimerWheel::TimerId timer = 0;  ///< Pending refresh
+    std::array<std::chrono::steady_clock::time_point, static_cast<std::size_t>(CachedModel::Count)> due{};
+    int outstanding = 0;            ///< Fetches of the running sync not yet answered
+    std::string fetchError;
+
+    void onUserLoggedIn(const AbstractUser*) override {}
+    void onUserLoggedOut() override {}
+    void onDataUpdated(const std::string&) override {}
+
+    void onMarkbookChanged(const MarkbookChangeSet&) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++status.changes;
+    }
+
+    void onGroupInfoChanged(const GroupChangeSet&) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++status.changes;
+    }
+};
+
+// ========================================
+// SyncDaemon Implementation
+// ========================================
+
+SyncDaemon::SyncDaemon(SyncOptions syncOptions, std::shared_ptr<IHTTPTransport> sharedTransport)
+    : options(std::move(syncOptions)),
+      transport(sharedTransport ? std::move(sharedTransport) : HTTPTransportFactory::createDefault()) {
+    if (options.baseUrl.empty()) {
+        options.baseUrl = API_BASE_URL;
+    }
+}
+
+SyncDaemon::~SyncDaemon() {
+    stop();
+}
+
+bool SyncDaemon::start(const std::vector<SyncAccount>& accounts, std::string* error) {
+    store = std::make_shared<LocalStore>(options.storePath, options.syncWrites);
+    if (!store->isOpen()) {
+        if (error) *error = "Cannot open store " + options.storePath;
+        return false;
+    }
+    executors.parsing = ExecutorFactory::createThreadPool(options.parseThreads);
+    timers = std::make_shared<TimerWheel>();
+    executors.timers = timers;
+
+    for (const auto& [model, boost] : options.boosts) {
+        polling.addBoost(modelEndpoint(model), boost);
+    }
+    if (auto saved = store->get(POLLING_STORE_KEY); saved && !polling.restore(saved->value)) {
+        BSUIR_LOG_WARNING(General, "⚠️ Saved polling history unreadable, relearning");
+    }
+
+    const FreshnessPolicy networkOnly{std::chrono::seconds(0), std::chrono::seconds(0)};
+    for (const auto& account : accounts) {
+        if (sessions.count(account.studentNumber)) {
+            continue;
+        }
+        auto session = std::make_unique<Session>();
+        session->account = account;
+        session->status.studentNumber = account.studentNumber;
+
+        auto client = std::make_unique<HTTPClient>(transport);
+        session->api = std::make_unique<ApiService>(
+            ConfigProviderFactory::createCustomConfig(options.baseUrl, false), std::move(client));
+        ApiService& api = *session->api;
+        api.setExecutors(executors);
+        api.setLocalStore(store);
+        for (CachedModel model : {CachedModel::PersonalInfo, CachedModel::Markbook, CachedModel::GroupInfo}) {
+            // Every sync goes to the network; the store only records the result
+            api.setFreshnessPolicy(model, networkOnly);
+        }
+        api.setCredentialsProvider([account] {
+            return std::optional<std::pair<std::string, std::string>>({account.studentNumber, account.password});
+        });
+        api.addObserver(session.get());
+        if (!options.sessionDirectory.empty()) {
+            api.setSessionVault(std::make_shared<FileSessionVault>(options.sessionDirectory, account.studentNumber));
+        }
+
+        order.push_back(session.get());
+        sessions.emplace(account.studentNumber, std::move(session));
+    }
+
+    const double spacing = options.loginRate > 0 ? 1e6 / options.loginRate : 0.0;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        scheduleSync(*order[i], std::chrono::microseconds(static_cast<int64_t>(spacing * static_cast<double>(i))));
+    }
+    if (options.refreshInterval.count() > 0) {
+        BSUIR_LOG_INFO(General, "🔁 Syncing ", order.size(), " accounts every ", options.refreshInterval.count(), " s");
+    } else {
+        BSUIR_LOG_INFO(General, "🔁 Syncing ", order.size(), " accounts at adaptive intervals");
+    }
+    return true;
+}
+
+void SyncDaemon::stop() {
+    if (stopping.exchange(true)) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(idleMutex);
+        idle.wait(lock, [this] { return inFlight == 0; });
+    }
+    for (Session* session : order) {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        timers->cancel(std::exchange(session->timer, 0));
+    }
+    if (timers) {
+        // A refresh timer that fired before the cancels may still be on the
+        // timer thread; one scheduled now runs only after it has returned
+        std::promise<void> drained;
+        timers->schedule(std::chrono::microseconds(0), [&drained] { drained.set_value(); });
+        drained.get_future().wait();
+    }
+    if (store && store->isOpen()) {
+        store->put(POLLING_STORE_KEY, polling.serialize());
+    }
+    if (store) {
+        BSUIR_LOG_INFO(General, "🛑 Sync stopped, ", store->size(), " responses stored");
+    }
+}
+
+std::chrono::microseconds SyncDaemon::nextDelay(Session& session) const {
+    std::chrono::steady_clock::time_point earliest;
+    {
+        std::lock_guard<std::mutex> lock(session.mutex);
+        earliest = *std::min_element(session.due.begin(), session.due.end());
+    }
+    const auto delay = std::chrono::duration_cast<std::chrono::microseconds>(earliest - std::chrono::steady_clock::now());
+    return TimerWheel::jittered(std::max(delay, std::chrono::microseconds(0)), options.jitter);
+}
+
+void SyncDaemon::scheduleSync(Session& session, std::chrono::microseconds delay) {
+    const TimerWheel::TimerId id = timers->schedule(delay, [this, &session] {
+        if (!stopping.load()) {
+            sync(session);
+        }
+    });
+    TimerWheel::TimerId replaced;
+    {
+        std::lock_guard<std::mutex> lock(session.mutex);
+        replaced = std::exchange(session.timer, id);
+    }
+    timers->cancel(replaced);
+}
+
+void SyncDaemon::sync(Session& session, bool everything) {
+    {
+        // Tested under idleMutex so a sync either is counted before stop()
+        // waits for inFlight or sees stopping and never starts
+        std::lock_guard<std::mutex> lock(idleMutex);
+        if (stopping.load()) {
+            return;
+        }
+        ++inFlight;
+    }
+    std::vector<CachedModel> models;
+    {
+        std::lock_guard<std::mutex> lock(session.mutex);
+        if (session.status.state == AccountStatus::State::Syncing) {
+            leaveSync();
+            return;
+        }
+        session.status.state = AccountStatus::State::Syncing;
+        // A pending timer is superseded by this sync, which schedules the next one
+        timers->cancel(std::exchange(session.timer, 0));
+
+        // The timer may fire early by its jitter; whatever is due first is always included
+        const auto earliest = *std::min_element(session.due.begin(), session.due.end());
+        const auto threshold = std::max(std::chrono::steady_clock::now(), earliest) + COALESCE_WINDOW;
+        for (CachedModel model : SYNCED_MODELS) {
+            if (everything || session.due[static_cast<std::size_t>(model)] <= threshold) {
+                models.push_back(model);
+            }
+        }
+    }
+
+    if (session.api->isAuthenticated()) {
+        fetch(session, models);
+        return;
+    }
+    session.api->login(session.account.studentNumber, session.account.password,
+        [this, &session, models](const ApiResult<LoginResponse>& result) {
+            if (!result.success) {
+                finishSync(session, false, "Login failed: " + (result.error ? result.error->message : std::string()));
+                return;
+            }
+            fetch(session, models);
+        });
+}
+
+void SyncDaemon::fetch(Session& session, const std::vector<CachedModel>& models) {
+    {
+        std::lock_guard<std::mutex> lock(session.mutex);
+        session.outstanding = static_cast<int>(models.size());
+        session.fetchError.clear();
+    }
+    for (CachedModel model : models) {
+        // The service stores the body before answering, so comparing the
+        // stored value tells whether this poll found anything new
+        const std::string key = session.account.studentNumber + " " + modelEndpoint(model);
+        const std::size_t before = fingerprint(store->get(key));
+        auto answered = [this, &session, model, key, before](const char* name, bool success,
+                                                             const std::optional<ApiError>& error) {
+            finishModel(session, model, !success ? PollOutcome::Failed
+                                        : fingerprint(store->get(key)) != before ? PollOutcome::Changed
+                                        : PollOutcome::Unchanged);
+            bool last;
+            std::string failure;
+            {
+                std::lock_guard<std::mutex> lock(session.mutex);
+                if (!success && session.fetchError.empty()) {
+                    session.fetchError = std::string(name) + ": " + (error ? error->message : "failed");
+                }
+                last = --session.outstanding == 0;
+                failure = session.fetchError;
+            }
+            if (last) {
+                finishSync(session, failure.empty(), failure);
+            }
+        };
+        switch (model) {
+            case CachedModel::PersonalInfo:
+                session.api->getPersonalInfo([answered](const ApiResult<PersonalInfo>& result) {
+                    answered("personal info", result.success, result.error);
+                });
+                break;
+            case CachedModel::Markbook:
+                session.api->getMarkbook([answered](const ApiResult<Markbook>& result) {
+                    answered("markbook", result.success, result.error);
+                });
+                break;
+            case CachedModel::GroupInfo:
+                session.api->getGroupInfo([answered](const ApiResult<GroupInfo>& result) {
+                    answered("group info", result.success, result.error);
+                });
+                break;
+            case CachedModel::Count:
+                break;
+        }
+    }
+}
+
+void SyncDaemon::finishModel(Session& session, CachedModel model, PollOutcome outcome) {
+    const char* endpoint = modelEndpoint(model);
+    polling.record(session.account.studentNumber, endpoint, outcome);
+    const std::chrono::seconds interval = options.refreshInterval.count() > 0
+        ? options.refreshInterval
+        : polling.interval(session.account.studentNumber, endpoint);
+
+    std::lock_guard<std::mutex> lock(session.mutex);
+    session.due[static_cast<std::size_t>(model)] = std::chrono::steady_clock::now() + interval;
+    session.status.intervals[static_cast<std::size_t>(model)] = interval;
+}
+
+void SyncDaemon::finishSync(Session& session, bool success, const std::string& error) {
+    {
+        std::lock_guard<std::mutex> lock(session.mutex);
+        AccountStatus& status = session.status;
+        status.state = success ? AccountStatus::State::Active : AccountStatus::State::Failed;
+        status.lastError = error;
+        if (success) {
+            ++status.syncs;
+            status.lastSync = std::chrono::system_clock::now();
+        } else {
+            ++status.failures;
+        }
+    }
+    if (!success) {
+        BSUIR_LOG_WARNING(General, "⚠️ Sync of ", session.account.studentNumber, " failed: ", error);
+    }
+    if (!stopping.load()) {
+        scheduleSync(session, nextDelay(session));
+    }
+    leaveSync();
+}
+
+void SyncDaemon::leaveSync() {
+    std::lock_guard<std::mutex> lock(idleMutex);
+    if (--inFlight == 0) {
+        idle.notify_all();
+    }
+}
+
+bool SyncDaemon::refresh(const std::string& studentNumber) {
+    auto it = sessions.find(studentNumber);
+    if (it == sessions.end() || stopping.load()) {
+        return false;
+    }
+    sync(*it->second, true);
+    return true;
+}
+
+std::size_t SyncDaemon::refreshAll() {
+    std::size_t started = 0;
+    for (Session* session : order) {
+        if (stopping.load()) {
+            break;
+        }
+        bool busy;
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            busy = session->status.state == AccountStatus::State::Syncing;
+        }
+        if (!busy) {
+            sync(*session, true);
+            ++started;
+        }
+    }
+    return started;
+}
+
+std::optional<AccountStatus> SyncDaemon::status(const std::string& studentNumber) const {
+    auto it = sessions.find(studentNumber);
+    if (it == sessions.end()) {
+        return std::nullopt;
+    }
+    std::lock_guard<std::mutex> lock(it->second->mutex);
+    return it->second->status;
+}
+
+std::vector<AccountStatus> SyncDaemon::statuses() const {
+    std::vector<AccountStatus> result;
+    result.reserve(order.size());
+    for (const Session* session : order) {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        result.push_back(session->status);
+    }
+    return result;
+}
+
+SyncSummary SyncDaemon::summary() const {
+    SyncSummary total;
+    total.accounts = order.size();
+    for (const Session* session : order) {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        const AccountStatus& status = session->status;
+        switch (status.state) {
+            case AccountStatus::State::Pending: ++total.pending; break;
+            case AccountStatus::State::Syncing: ++total.syncing; break;
+            case AccountStatus::State::Active:  ++total.active; break;
+            case AccountStatus::State::Failed:  ++total.failed; break;
+        }
+        total.syncs += status.syncs;
+        total.failures += status.failures;
+        total.changes += status.changes;
+    }
+    return total;
+}
+
+std::optional<StoredValue> SyncDaemon::stored(const std::string& studentNumber, CachedModel model) const {
+    if (!store || !sessions.count(studentNumber)) {
+        return std::nullopt;
+    }
+    return store->get(studentNumber + " " + modelEndpoint(model));
+}
+
+} // namespace Tools
+} // namespace BSUIR
@@ -0,0 +1,213 @@
+//
+//  SyncDaemon.hpp
+//  cPPiIS Tools - Headless Account Sync
+//
+//  Keeps one ApiService session per student account, refreshes profile,
+//  markbook and group info on a schedule and persists them to a local store
+//
+
+#ifndef SyncDaemon_hpp
+#define SyncDaemon_hpp
+
+#include "ApiService.hpp"
+#include "LocalStore.hpp"
+#include "PollingController.hpp"
+#include "TimerWheel.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace BSUIR {
+namespace Tools {
+
+/**
+ * @brief Credentials of one synced account
+ */
+struct SyncAccount {
+    std::string studentNumber;
+    std::string password;
+};
+
+/**
+ * @brief Read an account list: one "<student number> <password>" per line,
+ *        blank lines and lines starting with '#' ignored
+ * @param path File path
+ * @param error Receives the first problem (file or line number)
+ * @return Accounts in file order; empty on error
+ */
+std::vector<SyncAccount> loadAccounts(const std::string& path, std::string* error = nullptr);
+
+/**
+ * @brief Saved sessions as one 0600 file per account in a private directory
+ *
+ * Stands in for the iOS Keychain on a server: the directory should live
+ * on an encrypted volume readable only by the daemon's user.
+ */
+class FileSessionVault : public ISecureVault {
+private:
+    std::string directory;
+    std::string account;
+
+    std::string pathFor(const std::string& key) const;
+
+public:
+    FileSessionVault(std::string sessionDirectory, std::string studentNumber);
+
+    std::optional<std::string> read(const std::string& key) const override;
+    bool write(const std::string& key, const std::string& value) override;
+    void remove(const std::string& key) override;
+};
+
+struct SyncOptions {
+    std::string baseUrl;
+    std::string storePath = "bsuir-sync.store";
+    bool syncWrites = false;                        ///< fsync every store write
+    std::string sessionDirectory;                   ///< Saved sessions (empty: log in on every start)
+    std::chrono::seconds refreshInterval{0};        ///< Same interval for every model (0: adaptive per account and model)
+    std::vector<std::pair<CachedModel, PollingBoost>> boosts;  ///< Faster polling windows, e.g. exam weeks (adaptive only)
+    double jitter = 0.1;                            ///< Refresh times spread by +-this fraction
+    double loginRate = 20.0;                        ///< First syncs started per second
+    std::size_t parseThreads = 0;                   ///< 0 selects hardware concurrency
+};
+
+/**
+ * @brief Sync state of one account as reported on the control socket
+ */
+struct AccountStatus {
+    enum class State { Pending, Syncing, Active, Failed };
+
+    std::string studentNumber;
+    State state = State::Pending;
+    std::chrono::system_clock::time_point lastSync;     ///< Last complete refresh (epoch if none)
+    std::string lastError;
+    uint64_t syncs = 0;
+    uint64_t failures = 0;
+    uint64_t changes = 0;                               ///< Markbook and group change sets seen
+    std::array<std::chrono::seconds, static_cast<std::size_t>(CachedModel::Count)> intervals{};  ///< Current refresh interval per model
+
+    static const char* stateName(State state) noexcept;
+};
+
+/**
+ * @brief Totals over all accounts
+ */
+struct SyncSummary {
+    std::size_t accounts = 0;
+    std::size_t pending = 0;
+    std::size_t syncing = 0;
+    std::size_t active = 0;
+    std::size_t failed = 0;
+    uint64_t syncs = 0;
+    uint64_t failures = 0;
+    uint64_t changes = 0;
+};
+
+/**
+ * @brief Periodic refresh of many accounts in one process
+ *
+ * All sessions share one store, one parsing pool, one timer wheel and one
+ * transport (by default the libcurl event loop); each keeps its cookies
+ * in its own HTTPClient's jar, so an account costs an ApiService and a
+ * cookie jar rather than threads or connections. A sync logs
+ * in when the account has no session (a saved one is resumed without a
+ * login), then fetches the three models straight from the network; the
+ * service writes each response to the store under "<number> <endpoint>".
+ * Sessions the server drops are renewed with the account's password on
+ * the next 401.
+ *
+ * First syncs are spread at loginRate per second and fetch every model.
+ * Afterwards each model of each account is due on its own: a
+ * PollingController learns from whether the stored body changed how
+ * often to poll it (a roster that never changes drifts towards days, a
+ * markbook in exam week towards minutes), unless a fixed refreshInterval
+ * is set. A sync fetches the models due within a minute of each other
+ * together; its timer is jittered so the accounts do not drift into
+ * bursts. What was learned is kept in the store across restarts.
+ */
+class SyncDaemon {
+private:
+    struct Session;
+
+    SyncOptions options;
+    std::shared_ptr<IHTTPTransport> transport;
+    std::shared_ptr<LocalStore> store;
+    ServiceExecutors executors;
+    std::unordered_map<std::string, std::unique_ptr<Session>> sessions;
+    std::vector<Session*> order;
+
+    std::shared_ptr<TimerWheel> timers;             ///< Refresh timers; shared with the services for retries and expiry
+    PollingController polling;
+
+    std::atomic<bool> stopping{false};
+    std::mutex idleMutex;
+    std::condition_variable idle;
+    std::size_t inFlight = 0;
+
+    void scheduleSync(Session& session, std::chrono::microseconds delay);
+    void sync(Session& session, bool everything = false);
+    void fetch(Session& session, const std::vector<CachedModel>& models);
+    void finishModel(Session& session, CachedModel model, PollOutcome outcome);
+    void finishSync(Session& session, bool success, const std::string& error);
+    void leaveSync();
+    std::chrono::microseconds nextDelay(Session& session) const;
+
+public:
+    /**
+     * @param syncOptions Settings
+     * @param sharedTransport Transport of every account (default: the platform transport)
+     */
+    explicit SyncDaemon(SyncOptions syncOptions, std::shared_ptr<IHTTPTransport> sharedTransport = nullptr);
+    ~SyncDaemon();
+
+    SyncDaemon(const SyncDaemon&) = delete;
+    SyncDaemon& operator=(const SyncDaemon&) = delete;
+
+    /**
+     * @brief Open the store and start syncing the accounts
+     * @param accounts Accounts to keep in sync (duplicates are ignored)
+     * @param error Receives a description on failure
+     */
+    bool start(const std::vector<SyncAccount>& accounts, std::string* error = nullptr);
+
+    /**
+     * @brief Stop scheduling and wait for syncs in flight
+     */
+    void stop();
+
+    /**
+     * @brief Sync all models of an account now (no-op while it is already syncing)
+     * @return false if the account is unknown
+     */
+    bool refresh(const std::string& studentNumber);
+
+    /**
+     * @brief Sync every idle account now
+     * @return Number of syncs started
+     */
+    std::size_t refreshAll();
+
+    std::optional<AccountStatus> status(const std::string& studentNumber) const;
+    std::vector<AccountStatus> statuses() const;
+    SyncSummary summary() const;
+
+    /**
+     * @brief Last stored response of a model
+     * @param studentNumber Account
+     * @param model Cached model
+     * @return Raw JSON body with its write time, empty if never synced
+     */
+    std::optional<StoredValue> stored(const std::string& studentNumber, CachedModel model) const;
+};
+
+} // namespace Tools
+} // namespace BSUIR
+
+#endif /* SyncDaemon_hpp */
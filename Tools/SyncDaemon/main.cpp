@@ -0,0 +1,189 @@
+//
+//  main.cpp
+//  cPPiIS Tools - Sync Daemon
+//
+//  Headless Linux service keeping many student accounts in sync with IIS:
+//  periodic refresh into a local store, queried over a control socket.
+//  Build (from this directory):
+//    c++ -std=c++20 -O2 -I../../cPPiIS -I../../cPPiIS/Core -I../MockIISServer
+//        *.cpp ../MockIISServer/MockIISService.cpp ../MockIISServer/MockIISTransport.cpp
+//        ../../cPPiIS/Core/{HTTPClient,CookieJar,CurlHTTPTransport,JSONParser,Executor,CoroutineFramePool,BSUIROOPDemo,TimerWheel,TrafficCapture,Log,Tracing,Metrics,PollingController,Profiler,Watchdog,LocalStore,ModelDiff,StringPool,MarkbookColumns,RosterIndex,SkillTrie,SkillAutocomplete}.cpp
+//        -x c++ ../../cPPiIS/Core/{ApiService,IConfigProvider,SecureTokenStorage}.mm -o bsuir-sync -pthread -lcurl
+//
+//  Example:
+//    ./bsuir-sync --accounts accounts.txt --sessions /var/lib/bsuir-sync/sessions
+//                 --store /var/lib/bsuir-sync/data.store --socket /run/bsuir-sync.sock
+//    ./bsuir-sync --accounts accounts.txt --target mock --interval 5
+//    ./bsuir-sync --accounts accounts.txt --boost 2026-12-21:2027-01-31:0.1
+//    echo "get 10210001 markbook" | socat - UNIX-CONNECT:/run/bsuir-sync.sock
+//
+
+#include "ControlServer.hpp"
+#include "CurlHTTPTransport.hpp"
+#include "MockIISTransport.hpp"
+#include "SyncDaemon.hpp"
+#include <sys/stat.h>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace BSUIR;
+using namespace BSUIR::Tools;
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void handleSignal(int) {
+    stopRequested = 1;
+}
+
+/**
+ * @brief Parse "YYYY-MM-DD:YYYY-MM-DD[:FACTOR]" (local dates, end inclusive)
+ */
+bool parseBoost(const std::string& value, PollingBoost& boost) {
+    std::istringstream input(value);
+    std::tm from{}, to{};
+    char separator = 0;
+    input >> std::get_time(&from, "%Y-%m-%d") >> separator >> std::get_time(&to, "%Y-%m-%d");
+    if (input.fail() || separator != ':') {
+        return false;
+    }
+    if (input.peek() == ':') {
+        input.get();
+        if (!(input >> boost.factor) || boost.factor <= 0 || boost.factor > 1) {
+            return false;
+        }
+    }
+    from.tm_isdst = -1;
+    to.tm_isdst = -1;
+    ++to.tm_mday;
+    boost.begin = std::chrono::system_clock::from_time_t(std::mktime(&from));
+    boost.end = std::chrono::system_clock::from_time_t(std::mktime(&to));
+    return boost.begin < boost.end;
+}
+
+void printUsage() {
+    std::cout
+        << "Usage: bsuir-sync --accounts FILE [options]\n"
+        << "  --accounts FILE           \"<student number> <password>\" per line\n"
+        << "  --target mock|URL         In-process mock IIS or API base URL (default: production)\n"
+        << "  --store PATH              Local store file (default bsuir-sync.store)\n"
+        << "  --fsync                   fsync every store write\n"
+        << "  --sessions DIR            Keep sessions across restarts in DIR (created 0700)\n"
+        << "  --interval SECONDS        Fixed refresh interval for every model (default: adaptive)\n"
+        << "  --boost FROM:TO[:FACTOR]  Poll the markbook FACTOR times as often (default 0.25)\n"
+        << "                            between two YYYY-MM-DD dates, e.g. an exam session\n"
+        << "  --jitter FRACTION         Spread of refresh times (default 0.1)\n"
+        << "  --login-rate N            First syncs started per second (default 20)\n"
+        << "  --parse-threads N         Parsing pool size (default: hardware concurrency)\n"
+        << "  --max-host-connections N  Connections per host across all accounts (default 64)\n"
+        << "  --socket PATH             Control socket (default bsuir-sync.sock)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SyncOptions options;
+    std::string accountsPath;
+    std::string target;
+    std::string socketPath = "bsuir-sync.sock";
+    long maxHostConnections = 64;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << option << std::endl;
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (option == "--accounts")                  accountsPath = next();
+        else if (option == "--target")               target = next();
+        else if (option == "--store")                options.storePath = next();
+        else if (option == "--fsync")                options.syncWrites = true;
+        else if (option == "--sessions")             options.sessionDirectory = next();
+        else if (option == "--interval")             options.refreshInterval = std::chrono::seconds(std::stoi(next()));
+        else if (option == "--jitter")               options.jitter = std::stod(next());
+        else if (option == "--boost") {
+            PollingBoost boost;
+            if (!parseBoost(next(), boost)) {
+                std::cerr << "Expected --boost YYYY-MM-DD:YYYY-MM-DD[:FACTOR]" << std::endl;
+                return 2;
+            }
+            options.boosts.emplace_back(CachedModel::Markbook, boost);
+        }
+        else if (option == "--login-rate")           options.loginRate = std::stod(next());
+        else if (option == "--parse-threads")        options.parseThreads = std::stoul(next());
+        else if (option == "--max-host-connections") maxHostConnections = std::stol(next());
+        else if (option == "--socket")               socketPath = next();
+        else {
+            printUsage();
+            return option == "--help" ? 0 : 2;
+        }
+    }
+
+    if (accountsPath.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    std::string error;
+    const std::vector<SyncAccount> accounts = loadAccounts(accountsPath, &error);
+    if (accounts.empty()) {
+        std::cerr << (error.empty() ? "No accounts in " + accountsPath : error) << std::endl;
+        return 1;
+    }
+
+    if (!options.sessionDirectory.empty() &&
+        ::mkdir(options.sessionDirectory.c_str(), 0700) != 0 && errno != EEXIST) {
+        std::cerr << "Cannot create " << options.sessionDirectory << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    std::shared_ptr<IHTTPTransport> transport;
+    if (target == "mock") {
+        options.baseUrl = "http://mock.local/api/v1";
+        transport = std::make_shared<Mock::MockIISTransport>(std::make_shared<Mock::MockIISService>());
+    } else {
+        options.baseUrl = target;
+#ifdef BSUIR_HAS_CURL
+        CurlHTTPTransport::setMaxHostConnections(maxHostConnections);
+#endif
+    }
+
+    SyncDaemon daemon(options, transport);
+    if (!daemon.start(accounts, &error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    ControlServer control(daemon, socketPath);
+    if (!control.start(&error)) {
+        std::cerr << error << std::endl;
+        daemon.stop();
+        return 1;
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::cout << "Syncing " << accounts.size() << " accounts, control socket " << socketPath << std::endl;
+
+    while (!stopRequested) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    std::cout << "Stopping..." << std::endl;
+    control.stop();
+    daemon.stop();
+    return 0;
+}
@@ -0,0 +1,243 @@
+//
+//  main.cpp
+//  cPPiIS Tools - Traffic Replay
+//
+//  Feeds a traffic capture (HTTPClient::setTrafficRecorder) back through
+//  JSONParser or the full ApiService stack for reproducible benchmarks.
+//  Build (from this directory):
+//    c++ -std=c++20 -O2 -I../../cPPiIS -I../../cPPiIS/Core main.cpp
+//        ../../cPPiIS/Core/{HTTPClient,CookieJar,CurlHTTPTransport,JSONParser,Executor,CoroutineFramePool,BSUIROOPDemo,TimerWheel,TrafficCapture,Log,Tracing,Metrics,PollingController,Profiler,Watchdog,LocalStore,ModelDiff,StringPool,MarkbookColumns,RosterIndex,SkillTrie,SkillAutocomplete}.cpp
+//        -x c++ ../../cPPiIS/Core/{ApiService,IConfigProvider,SecureTokenStorage}.mm -o traffic-replay -pthread -lcurl
+//
+//  Example:
+//    ./traffic-replay info markbook.bstr
+//    ./traffic-replay parse markbook.bstr --iterations 200    # compare digests across parser versions
+//    ./traffic-replay api markbook.bstr --pacing recorded
+//
+
+#include "ApiService.hpp"
+#include "Config.h"
+#include "TrafficCapture.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BSUIR;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+std::string endpointOf(const TrafficEntry& entry) {
+    std::string key = trafficKey(entry.request);
+    std::string path = key.substr(key.find(' ') + 1);
+    path = path.substr(0, path.find('?'));
+    const std::string prefix = "/api/v1";
+    if (path.compare(0, prefix.size(), prefix) == 0) {
+        path = path.substr(prefix.size());
+    }
+    return path;
+}
+
+uint64_t fnv1a(const std::string& text, uint64_t hash = 14695981039346656037ull) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Canonical dump of the parsed model; equal digests mean equal parser output
+std::string canonical(const std::string& endpoint, const std::string& json, bool& parsed) {
+    std::ostringstream out;
+    out << std::setprecision(6);
+    parsed = false;
+
+    if (endpoint == API_LOGIN_ENDPOINT) {
+        if (auto login = JSONParser::parseLoginResponse(json)) {
+            parsed = true;
+            out << login->studentNumber << '|' << login->firstName << '|' << login->lastName << '|' << login->middleName;
+        }
+    } else if (endpoint == API_PERSONAL_INFO_ENDPOINT) {
+        if (auto info = JSONParser::parsePersonalInfo(json)) {
+            parsed = true;
+            out << info->studentNumber << '|' << info->lastName << '|' << info->firstName << '|'
+                << info->group << '|' << info->course << '|' << info->faculty << '|' << info->email;
+        }
+    } else if (endpoint == API_MARKBOOK_ENDPOINT) {
+        if (auto markbook = JSONParser::parseMarkbook(json)) {
+            parsed = true;
+            out << markbook->studentNumber << '|' << markbook->overallGPA;
+            for (const auto& semester : markbook->semesters) {
+                out << "|S" << semester.number << ':' << semester.gpa;
+                for (const auto& subject : semester.subjects) {
+                    out << "|" << subject.name << ':' << subject.grade.value_or(-1) << ':' << subject.credits;
+                }
+            }
+        }
+    } else if (endpoint == API_GROUP_INFO_ENDPOINT) {
+        if (auto group = JSONParser::parseGroupInfo(json)) {
+            parsed = true;
+            out << group->number << '|' << group->faculty << '|' << group->course << '|' << group->curator.fullName;
+            for (const auto& student : group->students) {
+                out << '|' << student.number << ':' << student.fullName;
+            }
+        }
+    }
+    return out.str();
+}
+
+double percentileMs(std::vector<int64_t>& samples, double fraction) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    std::size_t index = std::min(samples.size() - 1, static_cast<std::size_t>(fraction * static_cast<double>(samples.size())));
+    return static_cast<double>(samples[index]) / 1e6;
+}
+
+int commandInfo(const std::vector<TrafficEntry>& entries, std::ostream& out) {
+    struct Stats { std::size_t count = 0, bytes = 0, errors = 0; };
+    std::map<std::string, Stats> stats;
+    for (const auto& entry : entries) {
+        Stats& endpoint = stats[trafficKey(entry.request).substr(0, trafficKey(entry.request).find(' ') + 1) + endpointOf(entry)];
+        endpoint.count++;
+        endpoint.bytes += entry.response.data.size();
+        endpoint.errors += entry.response.isSuccessful() ? 0 : 1;
+    }
+
+    out << "📼 " << entries.size() << " recorded exchanges\n";
+    for (const auto& endpoint : stats) {
+        out << "  " << std::left << std::setw(44) << endpoint.first << std::right
+            << std::setw(7) << endpoint.second.count << " req "
+            << std::setw(10) << endpoint.second.bytes / std::max<std::size_t>(1, endpoint.second.count) << " B avg "
+            << std::setw(5) << endpoint.second.errors << " err\n";
+    }
+    return 0;
+}
+
+int commandParse(const std::vector<TrafficEntry>& entries, int iterations, std::ostream& out) {
+    struct Stats { std::vector<int64_t> samples; uint64_t digest = 14695981039346656037ull; std::size_t failures = 0; };
+    std::map<std::string, Stats> stats;
+
+    for (const auto& entry : entries) {
+        if (!entry.response.isSuccessful()) continue;
+        const std::string endpoint = endpointOf(entry);
+        Stats& endpointStats = stats[endpoint];
+
+        bool parsed = false;
+        endpointStats.digest = fnv1a(canonical(endpoint, entry.response.data, parsed), endpointStats.digest);
+        endpointStats.failures += parsed ? 0 : 1;
+
+        for (int i = 0; i < iterations; ++i) {
+            const auto start = Clock::now();
+            bool ignored = false;
+            canonical(endpoint, entry.response.data, ignored);
+            endpointStats.samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+    }
+
+    out << "🧪 Parser benchmark (" << iterations << " iterations per response)\n";
+    for (auto& endpoint : stats) {
+        auto& samples = endpoint.second.samples;
+        out << "  " << std::left << std::setw(36) << endpoint.first << std::right << std::fixed << std::setprecision(3)
+            << " p50 " << std::setw(8) << percentileMs(samples, 0.50) << " ms"
+            << "  p99 " << std::setw(8) << percentileMs(samples, 0.99) << " ms"
+            << "  failed " << endpoint.second.failures
+            << "  digest " << std::hex << endpoint.second.digest << std::dec << "\n";
+    }
+    return 0;
+}
+
+int commandApi(const std::vector<TrafficEntry>& entries, ReplayTransport::Pacing pacing, std::ostream& out) {
+    // Millisecond ticks, so replayed durations stay close to the recorded ones
+    TimerWheelOptions ticks;
+    ticks.tick = std::chrono::milliseconds(1);
+    auto timer = std::make_shared<TimerWheel>(ticks);
+    auto client = std::make_unique<HTTPClient>(std::make_shared<ReplayTransport>(entries, pacing, timer));
+    ApiService api(ConfigProviderFactory::createCustomConfig("http://replay.local/api/v1", false), std::move(client));
+
+    std::map<std::string, std::vector<int64_t>> latencies;
+    std::size_t failures = 0;
+    const auto start = Clock::now();
+
+    for (const auto& entry : entries) {
+        if (pacing == ReplayTransport::Pacing::Recorded) {
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(entry.offset));
+        }
+
+        const std::string endpoint = endpointOf(entry);
+        const auto issued = Clock::now();
+        bool success = true;
+
+        if (endpoint == API_LOGIN_ENDPOINT) {
+            success = syncWait(api.loginAsync(TEST_LOGIN, "replay")).success;
+        } else if (endpoint == API_PERSONAL_INFO_ENDPOINT) {
+            success = syncWait(api.personalInfoAsync()).success;
+        } else if (endpoint == API_MARKBOOK_ENDPOINT) {
+            success = syncWait(api.markbookAsync()).success;
+        } else if (endpoint == API_GROUP_INFO_ENDPOINT) {
+            success = syncWait(api.groupInfoAsync()).success;
+        } else {
+            continue;
+        }
+
+        failures += success == entry.response.isSuccessful() ? 0 : 1;
+        latencies[endpoint].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - issued).count());
+    }
+
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    out << "🔁 ApiService replay in " << std::fixed << std::setprecision(2) << elapsed << " s, "
+        << failures << " outcome mismatches\n";
+    for (auto& endpoint : latencies) {
+        out << "  " << std::left << std::setw(36) << endpoint.first << std::right
+            << std::setw(7) << endpoint.second.size() << " req"
+            << "  p50 " << std::setw(8) << percentileMs(endpoint.second, 0.50) << " ms"
+            << "  p99 " << std::setw(8) << percentileMs(endpoint.second, 0.99) << " ms\n";
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+void printUsage() {
+    std::cout
+        << "Usage: traffic-replay <info|parse|api> CAPTURE [options]\n"
+        << "  parse --iterations N        Parse every recorded response N times (default 100)\n"
+        << "  api   --pacing recorded|fast Replay through ApiService (default fast)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 2;
+    }
+
+    const std::string command = argv[1];
+    int iterations = 100;
+    auto pacing = ReplayTransport::Pacing::AsFastAsPossible;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        const std::string option = argv[i];
+        const std::string value = argv[i + 1];
+        if (option == "--iterations") iterations = std::max(1, std::stoi(value));
+        else if (option == "--pacing") pacing = value == "recorded" ? ReplayTransport::Pacing::Recorded
+                                                                    : ReplayTransport::Pacing::AsFastAsPossible;
+    }
+
+    std::string error;
+    auto entries = readTrafficCapture(argv[2], &error);
+    if (!error.empty()) {
+        std::cerr << "❌ " << error << std::endl;
+        return 1;
+    }
+
+    if (command == "info")  return commandInfo(entries, std::cout);
+    if (command == "parse") return commandParse(entries, iterations, std::cout);
+    if (command == "api")   return commandApi(entries, pacing, std::cout);
+
+    printUsage();
+    return 2;
+}
@@ -0,0 +1,270 @@
+//
+//  ApiServiceTests.cpp
+//  cPPiIS Tools - ApiService Unit Tests
+//
+//  The service runs against a scripted transport that answers inline,
+//  so every getter completes before it returns.
+//
+
+#include "ApiService.hpp"
+#include "SkillAutocomplete.hpp"
+#include "UnitTests.hpp"
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BSUIR;
+
+namespace UnitTests {
+
+namespace {
+
+/**
+ * @brief Transport serving per-account fixtures, or 401 once the session is revoked
+ */
+class ScriptedTransport : public IHTTPTransport {
+public:
+    std::map<std::string, std::string> markbooks;   ///< account -> markbook body
+    std::map<std::string, std::string> groups;      ///< account -> group info body
+    std::string account;                            ///< Logged in by the last login request
+    bool revoked = false;
+
+    void send(const HTTPRequest& request, ResponseCallback callback) override {
+        HTTPResponse response;
+        response.success = true;
+        response.statusCode = 200;
+        if (request.url.find("/auth/login") != std::string::npos) {
+            const std::string key = "\"username\":\"";
+            const std::size_t start = request.body.find(key) + key.size();
+            account = request.body.substr(start, request.body.find('"', start) - start);
+            revoked = false;
+            response.data = "{\"username\":\"" + account + "\",\"fio\":\"Тестовый Студент\",\"group\":\"420603\","
+                            "\"email\":\"student@bsuir.by\",\"photoUrl\":null}";
+        } else if (revoked) {
+            response.statusCode = 401;
+        } else if (request.url.find("/markbook") != std::string::npos) {
+            response.data = markbooks[account];
+        } else if (request.url.find("/user-group-info") != std::string::npos) {
+            response.data = groups[account];
+        } else if (request.url.find("/skill") != std::string::npos) {
+            response.data = "{\"skills\":[\"Python\",\"PyTorch\"]}";
+        } else {
+            response.statusCode = 404;
+        }
+        callback(response);
+    }
+};
+
+std::string markbookJSON(const std::string& account, const std::string& subject, int grade) {
+    return "{\"studentNumber\":\"" + account + "\",\"overallGPA\":" + std::to_string(grade) +
+           ",\"semesters\":[{\"number\":1,\"gpa\":" + std::to_string(grade) + ",\"subjects\":[{\"name\":\"" + subject +
+           "\",\"hours\":72,\"credits\":3,\"controlForm\":\"Экзамен\",\"grade\":" + std::to_string(grade) +
+           ",\"retakes\":0,\"averageGrade\":7.5,\"retakeChance\":0,\"isOnline\":false}]}]}";
+}
+
+std::string groupJSON(const std::string& number, const std::vector<std::string>& students) {
+    std::string json = "{\"group\":{\"number\":\"" + number + "\",\"faculty\":\"ФИТУ\",\"course\":2,"
+                       "\"curator\":{\"fullName\":\"Куратор\",\"phone\":\"\",\"email\":\"\",\"profileUrl\":\"\"}},"
+                       "\"students\":[";
+    for (std::size_t i = 0; i < students.size(); ++i) {
+        if (i > 0) json += ",";
+        json += "{\"number\":" + std::to_string(i + 1) + ",\"fullName\":\"" + students[i] + "\"}";
+    }
+    return json + "]}";
+}
+
+/**
+ * @brief Observer keeping every change set it is told about
+ */
+class RecordingObserver : public Observer {
+public:
+    std::mutex mutex;
+    std::vector<MarkbookChangeSet> markbooks;
+    std::vector<GroupChangeSet> groups;
+
+    void onUserLoggedIn(const AbstractUser*) override {}
+    void onUserLoggedOut() override {}
+    void onDataUpdated(const std::string&) override {}
+    void onMarkbookChanged(const MarkbookChangeSet& changes) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        markbooks.push_back(changes);
+    }
+    void onGroupInfoChanged(const GroupChangeSet& changes) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        groups.push_back(changes);
+    }
+
+    std::size_t events() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return markbooks.size() + groups.size();
+    }
+};
+
+/**
+ * @brief Executor holding tasks until the test runs them
+ */
+class QueueExecutor : public IExecutor {
+private:
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+
+public:
+    void post(std::function<void()> task) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+
+    std::size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tasks.size();
+    }
+
+    /**
+     * @brief Run queued tasks, including ones they post, until done() holds
+     */
+    template<typename Done>
+    bool runUntil(Done done, std::chrono::milliseconds timeout = std::chrono::seconds(2)) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!done()) {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!tasks.empty()) {
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                }
+            }
+            if (task) {
+                task();
+            } else if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        return true;
+    }
+};
+
+bool fetchAll(ApiService& api) {
+    bool markbook = false, group = false;
+    api.getMarkbook([&markbook](const ApiResult<Markbook>& result) { markbook = result.success; });
+    api.getGroupInfo([&group](const ApiResult<GroupInfo>& result) { group = result.success; });
+    return markbook && group;
+}
+
+bool login(ApiService& api, const std::string& account) {
+    bool success = false;
+    api.login(account, "password", [&success](const ApiResult<LoginResponse>& result) { success = result.success; });
+    return success;
+}
+
+void testSnapshotsPerAccount(TestContext& context) {
+    auto transport = std::make_shared<ScriptedTransport>();
+    transport->markbooks["10210001"] = markbookJSON("10210001", "ОАиП", 8);
+    transport->groups["10210001"] = groupJSON("420603", {"Иванов Иван", "Петров Пётр"});
+    transport->markbooks["10210002"] = markbookJSON("10210002", "Физика", 6);
+    transport->groups["10210002"] = groupJSON("420604", {"Сидоров Сидор"});
+
+    ApiService api(ConfigProviderFactory::createCustomConfig("http://unit.local/api/v1", false),
+                   std::make_unique<HTTPClient>(transport));
+    RecordingObserver observer;
+    api.addObserver(&observer);
+
+    // Account A: the first fetch is the baseline, a changed grade is reported
+    context.check(login(api, "10210001") && fetchAll(api), "account A fetches its models");
+    context.checkEqual(observer.events(), 0u, "first snapshot of a session announces nothing");
+    transport->markbooks["10210001"] = markbookJSON("10210001", "ОАиП", 9);
+    context.check(fetchAll(api), "account A fetches again");
+    context.check(observer.markbooks.size() == 1 && observer.markbooks[0].changes.size() == 1 &&
+                      observer.markbooks[0].changes[0].kind == MarkbookChangeKind::GradeChanged,
+                  "same account: grade change reported");
+
+    // The server revokes the session; with no credentials provider it expires
+    transport->revoked = true;
+    fetchAll(api);
+    context.check(!api.isAuthenticated(), "session of account A expired");
+
+    // Account B logs in on the same service: A's snapshots are no baseline
+    const std::size_t before = observer.events();
+    context.check(login(api, "10210002") && fetchAll(api), "account B fetches its models");
+    context.checkEqual(observer.events(), before, "account B's first snapshots announce nothing");
+    bool leaked = false;
+    for (const auto& set : observer.markbooks) {
+        for (const auto& change : set.changes) {
+            leaked = leaked || change.subject == "Физика";
+        }
+    }
+    for (const auto& set : observer.groups) {
+        for (const auto& change : set.changes) {
+            leaked = leaked || change.student.fullName == "Сидоров Сидор";
+        }
+    }
+    context.check(!leaked, "no change events mix accounts A and B");
+
+    // B expires and logs in again: its own snapshot still is the baseline
+    transport->revoked = true;
+    fetchAll(api);
+    transport->markbooks["10210002"] = markbookJSON("10210002", "Физика", 7);
+    context.check(login(api, "10210002") && fetchAll(api), "account B logs in again");
+    context.check(observer.markbooks.size() == 2 && observer.markbooks[1].changes.size() == 1 &&
+                      observer.markbooks[1].changes[0].subject == "Физика",
+                  "same account after expiry: change reported against its own snapshot");
+
+    api.removeObserver(&observer);
+}
+
+void testAutocompleteDelivery(TestContext& context) {
+    auto transport = std::make_shared<ScriptedTransport>();
+    ApiService api(ConfigProviderFactory::createCustomConfig("http://unit.local/api/v1", false),
+                   std::make_unique<HTTPClient>(transport));
+    auto queue = std::make_shared<QueueExecutor>();
+    api.setExecutors(ServiceExecutors{nullptr, nullptr, queue, nullptr});
+    bool loggedIn = false;
+    api.login("10210001", "password", [&loggedIn](const ApiResult<LoginResponse>& result) { loggedIn = result.success; });
+    context.check(queue->runUntil([&loggedIn] { return loggedIn; }), "login delivered on the callback executor");
+
+    SkillAutocompleteOptions options;
+    options.debounce = std::chrono::milliseconds(1);
+    SkillAutocomplete autocomplete(api, options);
+    const auto self = std::this_thread::get_id();
+
+    // Answered after the debounce: the timer thread only posts the result
+    bool answered = false, onExecutor = false;
+    autocomplete.complete("py", [&](const ApiResult<SkillSuggestions>& result) {
+        answered = result.success && result.data && result.data->skills.size() == 2;
+        onExecutor = std::this_thread::get_id() == self;
+    });
+    context.check(queue->runUntil([&answered] { return answered; }), "network answer delivered");
+    context.check(onExecutor, "network answer runs on the callback executor");
+
+    // Covered by the trie: answered without a request, still through the executor
+    bool cached = false;
+    autocomplete.complete("pyt", [&cached](const ApiResult<SkillSuggestions>& result) {
+        cached = result.success && result.data && result.data->fromCache;
+    });
+    context.check(!cached && queue->size() == 1, "local hit posted, not run inline");
+    context.check(queue->runUntil([&cached] { return cached; }), "local hit delivered from the cache");
+
+    // A superseded query's cancellation takes the same path
+    bool cancelled = false;
+    autocomplete.complete("r", [&cancelled](const ApiResult<SkillSuggestions>& result) {
+        cancelled = !result.success && result.error && result.error->code == API_ERROR_CANCELLED;
+    });
+    autocomplete.cancel();
+    context.check(!cancelled, "cancellation posted, not run inline");
+    context.check(queue->runUntil([&cancelled] { return cancelled; }), "cancellation delivered");
+}
+
+} // namespace
+
+void apiServiceTests(TestContext& context) {
+    testSnapshotsPerAccount(context);
+    testAutocompleteDelivery(context);
+}
+
+} // namespace UnitTests
@@ -0,0 +1,238 @@
+//
+//  CookieJarTests.cpp
+//  cPPiIS Tools - CookieJar Unit Tests
+//
+
+#include "CookieJar.hpp"
+#include "UnitTests.hpp"
+#include <string>
+#include <vector>
+
+using namespace BSUIR;
+
+namespace UnitTests {
+
+namespace {
+
+using Clock = CookieJar::Clock;
+
+// Tue, 14 Nov 2023 22:13:20 GMT
+const Clock::time_point NOW = Clock::from_time_t(1700000000);
+
+struct DateCase {
+    const char* text;
+    bool valid;
+    int64_t seconds;
+};
+
+const DateCase DATES[] = {
+    {"Wed, 21 Oct 2026 07:28:00 GMT", true, 1792567680},        // RFC 1123
+    {"Wednesday, 21-Oct-26 07:28:00 GMT", true, 1792567680},    // RFC 850
+    {"Wed Oct 21 07:28:00 2026", true, 1792567680},             // asctime
+    {"21 oct 2026 7:28:0", true, 1792567680},                   // any order, short fields
+    {"Thu, 01 Jan 70 00:00:00 GMT", true, 0},                   // two-digit year 70..99
+    {"Mon, 21 Oct 69 00:00:00 GMT", true, 3149539200},          // two-digit year 0..69
+    {"Thu, 29 Feb 2024 00:00:00 GMT", true, 1709164800},
+    {"Mon, 01 Jan 1601 00:00:00 GMT", true, -11644473600},
+    {"Wed, 29 Feb 2023 00:00:00 GMT", false, 0},                // not a leap year
+    {"Wed, 31 Apr 2026 07:28:00 GMT", false, 0},
+    {"Wed, 21 Oct 2026 GMT", false, 0},                         // no time
+    {"Wed, 21 2026 07:28:00 GMT", false, 0},                    // no month
+    {"Wed, 21 Oct 2026 24:00:00 GMT", false, 0},
+    {"Wed, 21 Oct 2026 07:60:00 GMT", false, 0},
+    {"Sun, 31 Dec 1600 23:59:59 GMT", false, 0},
+    {"", false, 0},
+};
+
+struct SetCase {
+    const char* url;
+    const char* setCookie;
+    bool accepted;
+    const char* description;
+};
+
+const SetCase SETS[] = {
+    {"https://iis.bsuir.by/api/v1/login", "a=1", true, "plain cookie"},
+    {"https://iis.bsuir.by/", "b=2; Domain=.bsuir.by", true, "parent domain with leading dot"},
+    {"https://iis.bsuir.by/", "b=2; Domain=BSUIR.by", true, "parent domain in upper case"},
+    {"https://iis.bsuir.by/", "c=3; Domain=iis.bsuir.by", true, "own host as domain"},
+    {"https://iis.bsuir.by/", "d=4; Domain=other.by", false, "unrelated domain"},
+    {"https://iis.bsuir.by/", "d=4; Domain=sub.iis.bsuir.by", false, "subdomain of the host"},
+    {"https://iis.bsuir.by/", "d=4; Domain=by", false, "dotless, public-suffix-like domain"},
+    {"https://iis.bsuir.by/", "d=4; Domain=.by", false, "dotless domain with leading dot"},
+    {"http://localhost/", "d=4; Domain=localhost", true, "dotless domain equal to the host"},
+    {"http://10.0.0.1/", "d=4; Domain=0.0.1", false, "domain suffix of an IP address"},
+    {"https://iis.bsuir.by/", "novalue", false, "no equals sign"},
+    {"https://iis.bsuir.by/", "=1", false, "empty name"},
+    {"https://iis.bsuir.by/", "a\x01=1", false, "control character in name"},
+    {"not a url", "a=1", false, "URL without scheme"},
+};
+
+struct MatchCase {
+    const char* url;
+    const char* header;
+    const char* description;
+};
+
+// Against the jar built by buildMatchJar
+const MatchCase MATCHES[] = {
+    {"https://iis.bsuir.by/", "host=1; domain=1; root=1", "host-only and domain cookies on the host"},
+    {"https://sub.iis.bsuir.by/", "domain=1; root=1", "host-only cookie not sent to a subdomain"},
+    {"https://bsuir.by/", "domain=1", "domain cookie on the domain itself"},
+    {"https://notbsuir.by/", "", "domain cookie not sent to a lookalike host"},
+    {"http://iis.bsuir.by/", "host=1; domain=1", "secure cookie withheld over http"},
+    {"https://iis.bsuir.by/api", "api=1; host=1; domain=1; root=1", "path equal to the cookie path"},
+    {"https://iis.bsuir.by/api/v1/markbook", "deep=1; api=1; host=1; domain=1; root=1",
+     "longest path first, then creation order"},
+    {"https://iis.bsuir.by/apix", "host=1; domain=1; root=1", "cookie path is not a path-segment prefix"},
+    {"https://iis.bsuir.by/api?x=/api/v1/markbook", "api=1; host=1; domain=1; root=1",
+     "query string ignored for path matching"},
+    {"https://IIS.BSUIR.BY./", "host=1; domain=1; root=1", "host compared case-insensitively, trailing dot"},
+};
+
+void buildMatchJar(CookieJar& jar) {
+    jar.setCookie("https://iis.bsuir.by/", "host=1", NOW);
+    jar.setCookie("https://iis.bsuir.by/", "domain=1; Domain=bsuir.by", NOW);
+    jar.setCookie("https://iis.bsuir.by/", "root=1; Secure; Domain=iis.bsuir.by", NOW);
+    // Default path of /api/v1/markbook is /api/v1
+    jar.setCookie("https://iis.bsuir.by/api/v1/markbook", "deep=1", NOW);
+    jar.setCookie("https://iis.bsuir.by/", "api=1; Path=/api", NOW);
+}
+
+struct ExpiryCase {
+    const char* setCookie;
+    bool stored;
+    int64_t expires;        ///< Expected Cookie::expires when stored
+    const char* description;
+};
+
+const ExpiryCase EXPIRIES[] = {
+    {"s=1", true, 0, "no attributes: session cookie"},
+    {"s=1; Max-Age=60", true, 1700000060, "Max-Age from the response time"},
+    {"s=1; Expires=Wed, 21 Oct 2026 07:28:00 GMT", true, 1792567680, "Expires date"},
+    {"s=1; Expires=Wed, 21 Oct 2026 07:28:00 GMT; Max-Age=60", true, 1700000060, "Max-Age wins after Expires"},
+    {"s=1; Max-Age=60; Expires=Wed, 21 Oct 2026 07:28:00 GMT", true, 1700000060, "Max-Age wins before Expires"},
+    {"s=1; Expires=Thu, 01 Jan 2015 00:00:00 GMT; Max-Age=60", true, 1700000060,
+     "Max-Age revives a past Expires"},
+    {"s=1; Max-Age=abc; Expires=Wed, 21 Oct 2026 07:28:00 GMT", true, 1792567680, "malformed Max-Age ignored"},
+    {"s=1; Expires=not a date", true, 0, "malformed Expires ignored"},
+    {"s=1; Max-Age=0; Expires=Wed, 21 Oct 2026 07:28:00 GMT", false, 0, "Max-Age=0 expires at once"},
+    {"s=1; Max-Age=-5", false, 0, "negative Max-Age expires at once"},
+    {"s=1; Expires=Thu, 01 Jan 2015 00:00:00 GMT", false, 0, "past Expires"},
+};
+
+void testDates(TestContext& context) {
+    for (const DateCase& date : DATES) {
+        int64_t seconds = 0;
+        const bool valid = CookieJar::parseCookieDate(date.text, seconds);
+        if (context.check(valid == date.valid, std::string("parseCookieDate validity of \"") + date.text + "\"") &&
+            date.valid) {
+            context.checkEqual(seconds, date.seconds, std::string("parseCookieDate(\"") + date.text + "\")");
+        }
+    }
+}
+
+void testStoring(TestContext& context) {
+    for (const SetCase& set : SETS) {
+        CookieJar jar;
+        const bool accepted = jar.setCookie(set.url, set.setCookie, NOW);
+        context.check(accepted == set.accepted, std::string(set.accepted ? "accepts " : "rejects ") + set.description);
+        context.checkEqual(jar.size(), set.accepted ? 1u : 0u, std::string("stored count for ") + set.description);
+    }
+
+    CookieJar jar;
+    jar.setCookie("https://iis.bsuir.by/", "b=2; Domain=.bsuir.by", NOW);
+    jar.setCookie("https://iis.bsuir.by/", "a=1", NOW);
+    const auto sent = jar.cookies("https://iis.bsuir.by/", NOW);
+    if (context.checkEqual(sent.size(), 2u, "both cookies sent")) {
+        context.check(!sent[0].hostOnly && sent[0].domain == "bsuir.by", "Domain attribute makes a domain cookie");
+        context.check(sent[1].hostOnly && sent[1].domain == "iis.bsuir.by", "no Domain makes a host-only cookie");
+    }
+}
+
+void testMatching(TestContext& context) {
+    CookieJar jar;
+    buildMatchJar(jar);
+    context.checkEqual(jar.size(), 5u, "match jar stored every cookie");
+    for (const MatchCase& match : MATCHES) {
+        context.checkEqual(jar.cookieHeader(match.url, NOW), std::string(match.header), match.description);
+    }
+}
+
+void testExpiry(TestContext& context) {
+    for (const ExpiryCase& expiry : EXPIRIES) {
+        CookieJar jar;
+        context.check(jar.setCookie("https://iis.bsuir.by/", expiry.setCookie, NOW),
+                      std::string("line accepted: ") + expiry.description);
+        const auto sent = jar.cookies("https://iis.bsuir.by/", NOW);
+        if (context.checkEqual(sent.size(), expiry.stored ? 1u : 0u, expiry.description) && expiry.stored) {
+            context.checkEqual(sent[0].expires, expiry.expires, std::string("expiry: ") + expiry.description);
+        }
+    }
+
+    CookieJar jar;
+    jar.setCookie("https://iis.bsuir.by/", "short=1; Max-Age=60", NOW);
+    jar.setCookie("https://iis.bsuir.by/", "session=1", NOW);
+    context.checkEqual(jar.cookieHeader("https://iis.bsuir.by/", NOW + std::chrono::seconds(59)),
+                       std::string("short=1; session=1"), "cookie sent before Max-Age elapses");
+    context.checkEqual(jar.cookieHeader("https://iis.bsuir.by/", NOW + std::chrono::seconds(60)),
+                       std::string("session=1"), "cookie withheld once Max-Age elapses");
+    context.checkEqual(jar.removeExpired(NOW + std::chrono::seconds(60)), 1u, "removeExpired drops the expired one");
+    context.checkEqual(jar.size(), 1u, "session cookie kept by removeExpired");
+}
+
+void testReplacement(TestContext& context) {
+    CookieJar jar;
+    jar.setCookie("https://iis.bsuir.by/", "a=1", NOW);
+    jar.setCookie("https://iis.bsuir.by/", "b=2", NOW);
+    jar.setCookie("https://iis.bsuir.by/", "a=3", NOW);
+    context.checkEqual(jar.cookieHeader("https://iis.bsuir.by/", NOW), std::string("a=3; b=2"),
+                       "replacement keeps its place in the sending order");
+    context.checkEqual(jar.size(), 2u, "replacement does not add a cookie");
+
+    jar.setCookie("https://iis.bsuir.by/", "a=4; Path=/api", NOW);
+    context.checkEqual(jar.size(), 3u, "same name on another path is a separate cookie");
+
+    jar.setCookie("https://iis.bsuir.by/", "a=; Max-Age=0", NOW);
+    context.checkEqual(jar.cookieHeader("https://iis.bsuir.by/", NOW), std::string("b=2"),
+                       "expired Set-Cookie deletes the stored cookie");
+    context.checkEqual(jar.cookieHeader("https://iis.bsuir.by/api", NOW), std::string("a=4; b=2"),
+                       "deletion only hits the matching path");
+}
+
+void testPersistence(TestContext& context) {
+    CookieJar jar;
+    buildMatchJar(jar);
+    jar.setCookie("https://iis.bsuir.by/", "gone=1; Max-Age=60", NOW);
+    const std::string text = jar.serialize(NOW + std::chrono::seconds(120));
+
+    CookieJar restored;
+    context.check(restored.restore(text, NOW), "restore accepts serialize output");
+    context.checkEqual(restored.size(), 5u, "expired cookie not serialized");
+    for (const MatchCase& match : MATCHES) {
+        context.checkEqual(restored.cookieHeader(match.url, NOW), std::string(match.header),
+                           std::string("after restore: ") + match.description);
+    }
+    context.check(!restored.restore("garbage", NOW), "restore rejects malformed text");
+    context.checkEqual(restored.size(), 5u, "failed restore leaves the jar unchanged");
+
+    CookieJar header;
+    header.restoreCookies("https://iis.bsuir.by/api", "JSESSIONID=abc; theme = dark ;broken");
+    context.checkEqual(header.cookieHeader("https://iis.bsuir.by/"), std::string("JSESSIONID=abc; theme=dark"),
+                       "restoreCookies installs the pairs of a Cookie header");
+    context.checkEqual(header.cookieHeader("https://sub.iis.bsuir.by/"), std::string(),
+                       "restored cookies are host-only");
+}
+
+} // namespace
+
+void cookieJarTests(TestContext& context) {
+    testDates(context);
+    testStoring(context);
+    testMatching(context);
+    testExpiry(context);
+    testReplacement(context);
+    testPersistence(context);
+}
+
+} // namespace UnitTests
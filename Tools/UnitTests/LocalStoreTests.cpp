@@ -0,0 +1,274 @@
+//
+//  LocalStoreTests.cpp
+//  cPPiIS Tools - LocalStore Unit Tests
+//
+//  Stores live in the working directory and are removed afterwards. Torn
+//  and corrupt tails are produced by editing the file between opens, the
+//  way a crash mid-write or a bad sector leaves it.
+//
+
+#include "LocalStore.hpp"
+#include "UnitTests.hpp"
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace BSUIR;
+
+namespace UnitTests {
+
+namespace {
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+// Millisecond precision, as the store keeps it
+const TimePoint T1 = TimePoint(std::chrono::milliseconds(1700000000123));
+const TimePoint T2 = TimePoint(std::chrono::milliseconds(1700000600456));
+const TimePoint T3 = TimePoint(std::chrono::milliseconds(1700001200789));
+
+const std::size_t MAGIC_BYTES = 8;
+
+std::string storePath(const char* name) {
+    return "unit-tests-" + std::to_string(::getpid()) + "-" + name + ".store";
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << contents;
+}
+
+std::size_t varintBytes(uint64_t value) {
+    std::size_t bytes = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++bytes;
+    }
+    return bytes;
+}
+
+// Bytes of one record as documented in LocalStore.hpp
+std::size_t recordBytes(const std::string& key, const std::string& value, TimePoint storedAt) {
+    const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(storedAt.time_since_epoch()).count();
+    const std::size_t payload = 1 + varintBytes(static_cast<uint64_t>(milliseconds)) + varintBytes(key.size()) +
+                                key.size() + varintBytes(value.size()) + value.size();
+    return 4 + payload + 4;
+}
+
+bool holds(const LocalStore& store, const std::string& key, const std::string& value, TimePoint storedAt) {
+    const auto found = store.get(key);
+    return found && found->value == value && found->storedAt == storedAt;
+}
+
+struct Damage {
+    const char* description;
+    void (*apply)(std::string& file, std::size_t lastRecord);   ///< lastRecord: offset of the final record
+};
+
+// Each damages only the last of three records; replay must keep the first two
+const Damage DAMAGES[] = {
+    {"last record cut short", [](std::string& file, std::size_t) { file.resize(file.size() - 1); }},
+    {"cut inside the length prefix", [](std::string& file, std::size_t last) { file.resize(last + 2); }},
+    {"cut after the length prefix", [](std::string& file, std::size_t last) { file.resize(last + 4); }},
+    {"corrupt checksum", [](std::string& file, std::size_t) { file.back() ^= 0x01; }},
+    {"corrupt payload byte", [](std::string& file, std::size_t last) { file[last + 6] ^= 0x40; }},
+    {"length beyond the file", [](std::string& file, std::size_t last) { file[last + 3] = '\x7f'; }},
+};
+
+void testReplay(TestContext& context) {
+    const std::string path = storePath("replay");
+    std::remove(path.c_str());
+    {
+        LocalStore store(path, false);
+        context.check(store.isOpen() && store.size() == 0, "new store opens empty");
+        context.check(store.put("a", "1", T1) && store.put("b", "2", T2) && store.put("a", "3", T3),
+                      "writes succeed");
+        context.check(store.erase("b"), "erase succeeds");
+        context.check(store.erase("missing"), "erasing an absent key succeeds");
+        context.check(!store.get("b") && store.size() == 1, "erased key gone at once");
+    }
+    {
+        LocalStore store(path, false);
+        context.check(holds(store, "a", "3", T3), "latest value and storedAt replayed");
+        context.check(!store.get("b"), "erase survives reopen");
+        context.checkEqual(store.size(), 1u, "one live key after reopen");
+        context.check(store.put("b", "4", T1), "erased key written again");
+    }
+    {
+        LocalStore store(path, false);
+        context.check(holds(store, "b", "4", T1), "key written after its erase survives reopen");
+    }
+    std::remove(path.c_str());
+
+    // An empty file, e.g. from a crash right after creation, is a new store
+    writeFile(path, "");
+    {
+        LocalStore store(path, false);
+        context.check(store.isOpen() && store.size() == 0, "empty file opens as a new store");
+        context.check(store.put("a", "1", T1), "empty file accepts writes");
+    }
+    {
+        LocalStore store(path, false);
+        context.check(holds(store, "a", "1", T1), "empty file gets the magic on first open");
+    }
+    std::remove(path.c_str());
+}
+
+void testDamagedTail(TestContext& context) {
+    const std::string path = storePath("damaged");
+    for (const Damage& damage : DAMAGES) {
+        std::remove(path.c_str());
+        {
+            LocalStore store(path, false);
+            store.put("a", "first", T1);
+            store.put("b", "second", T2);
+            store.put("c", "third", T3);
+        }
+        std::string file = readFile(path);
+        const std::size_t intact = MAGIC_BYTES + recordBytes("a", "first", T1) + recordBytes("b", "second", T2);
+        context.checkEqual(file.size(), intact + recordBytes("c", "third", T3),
+                           std::string("file layout as documented: ") + damage.description);
+        damage.apply(file, intact);
+        writeFile(path, file);
+
+        {
+            LocalStore store(path, false);
+            context.check(store.isOpen(), std::string("opens: ") + damage.description);
+            context.check(holds(store, "a", "first", T1) && holds(store, "b", "second", T2),
+                          std::string("intact records kept: ") + damage.description);
+            context.check(!store.get("c") && store.size() == 2, std::string("damaged record dropped: ") +
+                                                                    damage.description);
+            context.checkEqual(readFile(path).size(), intact, std::string("tail cut on open: ") + damage.description);
+            store.put("d", "fourth", T3);
+        }
+        {
+            LocalStore store(path, false);
+            context.check(store.size() == 3 && holds(store, "d", "fourth", T3),
+                          std::string("write after the cut replays: ") + damage.description);
+        }
+    }
+
+    // Garbage after the last intact record is cut like a torn record
+    std::remove(path.c_str());
+    {
+        LocalStore store(path, false);
+        store.put("a", "first", T1);
+        store.put("b", "second", T2);
+        store.put("c", "third", T3);
+    }
+    std::string file = readFile(path);
+    const std::size_t complete = file.size();
+    writeFile(path, file + std::string("\x05\x00\x00\x00zz", 6));
+    {
+        LocalStore store(path, false);
+        context.check(store.size() == 3 && holds(store, "c", "third", T3), "garbage after intact records ignored");
+        context.checkEqual(readFile(path).size(), complete, "garbage cut on open");
+    }
+
+    // Replay stops at the first corrupt record, even if later ones are intact
+    const std::size_t second = MAGIC_BYTES + recordBytes("a", "first", T1);
+    file[second + recordBytes("b", "second", T2) - 1] ^= 0x01;
+    writeFile(path, file);
+    {
+        LocalStore store(path, false);
+        context.check(holds(store, "a", "first", T1) && store.size() == 1, "records after a corrupt one dropped");
+        context.checkEqual(readFile(path).size(), second, "file cut at the corrupt record");
+    }
+    std::remove(path.c_str());
+}
+
+struct MagicCase {
+    const char* contents;
+    std::size_t size;
+    const char* description;
+};
+
+const MagicCase MAGICS[] = {
+    {"NOTSTORE\x01\x00\x00\x00x\x00\x00\x00\x00", 17, "other file"},
+    {"BSSTOR02", 8, "other format version"},
+    {"BSS", 3, "shorter than the magic"},
+};
+
+void testBadMagic(TestContext& context) {
+    const std::string path = storePath("magic");
+    for (const MagicCase& magic : MAGICS) {
+        const std::string contents(magic.contents, magic.size);
+        writeFile(path, contents);
+        {
+            LocalStore store(path, false);
+            context.check(!store.isOpen(), std::string("refused: ") + magic.description);
+            context.check(!store.put("a", "1", T1) && !store.get("a"), std::string("no writes: ") + magic.description);
+        }
+        context.check(readFile(path) == contents, std::string("file left untouched: ") + magic.description);
+    }
+    std::remove(path.c_str());
+}
+
+void testCompaction(TestContext& context) {
+    const std::string path = storePath("compact");
+    std::remove(path.c_str());
+    {
+        LocalStore store(path, false);
+        for (int i = 0; i < 10; ++i) {
+            store.put("kept", "version " + std::to_string(i), T1);
+        }
+        store.put("kept", "final", T2);
+        store.put("erased", "gone", T1);
+        store.put("other", "value", T3);
+        store.erase("erased");
+        const std::size_t before = readFile(path).size();
+
+        context.check(store.compact(), "compact succeeds");
+        const std::size_t expected = MAGIC_BYTES + recordBytes("kept", "final", T2) + recordBytes("other", "value", T3);
+        context.checkEqual(readFile(path).size(), expected, "only live records rewritten");
+        context.check(expected < before, "compaction shrinks the file");
+        context.check(holds(store, "kept", "final", T2) && holds(store, "other", "value", T3) && !store.get("erased"),
+                      "live set unchanged by compaction");
+        context.check(store.put("late", "write", T1), "writes continue after compaction");
+    }
+    {
+        LocalStore store(path, false);
+        context.checkEqual(store.size(), 3u, "compacted log replays the live keys");
+        context.check(holds(store, "kept", "final", T2) && holds(store, "other", "value", T3) &&
+                          holds(store, "late", "write", T1),
+                      "values and storedAt survive compaction");
+        context.check(!store.get("erased"), "erased key stays erased after compaction");
+    }
+    std::remove((path + ".tmp").c_str());
+
+    // Overwrites of one key compact on their own once the log is mostly garbage
+    std::remove(path.c_str());
+    {
+        LocalStore store(path, false);
+        const std::string value(1000, 'x');
+        for (int i = 0; i < 500; ++i) {
+            store.put("key", value + std::to_string(i), T1);
+        }
+        context.check(readFile(path).size() < 160u * 1024u, "log compacted automatically");
+        context.check(holds(store, "key", value + "499", T1), "latest overwrite kept");
+    }
+    {
+        LocalStore store(path, false);
+        context.check(store.size() == 1 && holds(store, "key", std::string(1000, 'x') + "499", T1),
+                      "automatic compaction replays");
+    }
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+void localStoreTests(TestContext& context) {
+    testReplay(context);
+    testDamagedTail(context);
+    testBadMagic(context);
+    testCompaction(context);
+}
+
+} // namespace UnitTests
@@ -0,0 +1,194 @@
+//
+//  MarkbookColumnsTests.cpp
+//  cPPiIS Tools - MarkbookColumns Unit Tests
+//
+//  Aggregates are checked against hand-computed values and against a
+//  plain row-by-row reference over the Markbook the columns came from.
+//
+
+#include "MarkbookColumns.hpp"
+#include "UnitTests.hpp"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace BSUIR;
+
+namespace UnitTests {
+
+namespace {
+
+struct Row {
+    int semester;
+    const char* name;
+    const char* controlForm;
+    std::optional<int> grade;
+    int credits;
+    double hours;
+    std::optional<double> average;
+    double retakeChance;
+};
+
+// Semester 2 has more rows than the kernels' four lanes, so both the
+// vector body and the remainder loop are exercised
+const Row ROWS[] = {
+    {1, "Математика", "Экзамен", 8, 4, 100, 7.5, 0.1},
+    {1, "Физика", "Зачёт", 6, 2, 50, std::nullopt, 0.2},
+    {1, "История", "Экзамен", std::nullopt, 3, 80, 6.0, 0.5},
+    {2, "Программирование", "Экзамен", 10, 0, 20, 9.0, 0.0},
+    {2, "Базы данных", "Экзамен", std::nullopt, 5, 60, std::nullopt, 0.3},
+    {2, "Сети", "Зачёт", 4, 1, 30, 5.0, 0.4},
+    {2, "Физкультура", "Зачёт", std::nullopt, 0, 40, std::nullopt, 0.05},
+    {2, "Английский", "Экзамен", 7, 2, 70, 8.0, 0.1},
+    {2, "Математика", "Экзамен", 9, 4, 100, 6.5, 0.2},
+};
+
+Markbook buildMarkbook(const std::vector<Row>& rows) {
+    Markbook markbook{};
+    for (const Row& row : rows) {
+        if (markbook.semesters.empty() || markbook.semesters.back().number != row.semester) {
+            markbook.semesters.push_back(Semester{row.semester, 0.0, {}});
+        }
+        markbook.semesters.back().subjects.push_back(Subject{InternedString(row.name), row.hours, row.credits,
+                                                             InternedString(row.controlForm), row.grade, 0,
+                                                             row.average, row.retakeChance, false});
+    }
+    return markbook;
+}
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+
+// Credit-weighted mean grade, plain mean if no graded row has credits
+double referenceGPA(const std::vector<Row>& rows, int semester = 0) {
+    double weighted = 0.0, credits = 0.0, sum = 0.0;
+    int graded = 0;
+    for (const Row& row : rows) {
+        if ((semester != 0 && row.semester != semester) || !row.grade) continue;
+        weighted += *row.grade * row.credits;
+        credits += row.credits;
+        sum += *row.grade;
+        ++graded;
+    }
+    if (credits > 0.0) return weighted / credits;
+    return graded ? sum / graded : 0.0;
+}
+
+void checkAgainstReference(TestContext& context, const MarkbookColumns& columns, const std::vector<Row>& rows,
+                           const std::string& label) {
+    context.check(near(columns.overall().gpa(), referenceGPA(rows)), label + ": overall GPA");
+    for (std::size_t i = 0; i < columns.semesterCount(); ++i) {
+        context.check(near(columns.semester(i).gpa(), referenceGPA(rows, columns.semesterNumber(i))),
+                      label + ": semester " + std::to_string(columns.semesterNumber(i)) + " GPA");
+    }
+    MarkbookColumns::Distribution distribution{};
+    uint32_t graded = 0;
+    for (const Row& row : rows) {
+        if (row.grade) {
+            ++distribution[static_cast<std::size_t>(*row.grade)];
+            ++graded;
+        }
+    }
+    context.check(columns.distribution() == distribution, label + ": grade distribution");
+    context.checkEqual(columns.overall().graded, graded, label + ": graded rows");
+}
+
+void testConstruction(TestContext& context) {
+    const std::vector<Row> rows(std::begin(ROWS), std::end(ROWS));
+    const MarkbookColumns columns(buildMarkbook(rows));
+
+    context.checkEqual(columns.rowCount(), rows.size(), "one row per subject");
+    context.checkEqual(columns.semesterCount(), 2u, "one range per semester");
+    context.check(columns.semesterRows(0) == std::make_pair<std::size_t, std::size_t>(0, 3), "semester 1 rows");
+    context.check(columns.semesterRows(1) == std::make_pair<std::size_t, std::size_t>(3, 9), "semester 2 rows");
+    context.check(columns.grade(2) == std::nullopt && columns.grade(0) == 8, "null grade kept apart from 0");
+    context.check(columns.averageGrade(1) == std::nullopt && columns.averageGrade(0) == 7.5,
+                  "null average kept apart from 0");
+
+    // (8*4 + 6*2) / 6 and (10*0 + 4*1 + 7*2 + 9*4) / 7
+    context.check(near(columns.semester(0).gpa(), 44.0 / 6.0), "semester 1 GPA by hand");
+    context.check(near(columns.semester(1).gpa(), 54.0 / 7.0), "semester 2 GPA by hand");
+    context.check(near(columns.overall().gpa(), 98.0 / 13.0), "overall GPA by hand");
+    context.check(near(columns.semesterHours(1), 320.0), "semester hours");
+    context.check(near(columns.semesterAverageGrade(0), 6.75), "semester group average skips nulls");
+    context.check(near(columns.expectedRetakes(), 0.5 + 0.3 + 0.05), "expected retakes over pending rows");
+    context.check(columns.pendingRows() == std::vector<std::size_t>{2, 4, 6}, "pending rows");
+    checkAgainstReference(context, columns, rows, "constructed");
+
+    context.check(columns.findRow(2, "Математика", "Экзамен") == std::optional<std::size_t>(8),
+                  "findRow by semester, name and control form");
+    context.check(!columns.findRow(3, "Математика", "Экзамен"), "findRow with another semester");
+    context.check(!columns.findRow(1, "Физика", "Экзамен"), "findRow with another control form");
+    context.check(!columns.findRow(1, "Химия никогда не встречалась", "Экзамен"), "findRow with a name never interned");
+
+    // No graded row carries credits: plain mean
+    const MarkbookColumns uncredited(buildMarkbook({{1, "A", "Зачёт", 6, 0, 1, std::nullopt, 0.0},
+                                                    {1, "B", "Зачёт", 9, 0, 1, std::nullopt, 0.0}}));
+    context.check(near(uncredited.overall().gpa(), 7.5), "plain mean without credits");
+    const MarkbookColumns empty(Markbook{});
+    context.check(empty.rowCount() == 0 && empty.overall().gpa() == 0.0, "empty markbook");
+}
+
+struct GradeUpdate {
+    std::size_t row;
+    std::optional<int> value;
+    const char* description;
+};
+
+// Applied in order; each step is checked against the row-by-row reference
+const GradeUpdate UPDATES[] = {
+    {2, 9, "pending exam graded"},
+    {0, 5, "existing grade changed"},
+    {3, 2, "grade on a row without credits"},
+    {1, std::nullopt, "grade cleared"},
+    {6, 14, "out-of-range grade clamped"},
+    {1, 6, "cleared grade restored"},
+    {4, 0, "zero is a grade, not a gap"},
+};
+
+void testWhatIf(TestContext& context) {
+    std::vector<Row> rows(std::begin(ROWS), std::end(ROWS));
+    MarkbookColumns columns(buildMarkbook(rows));
+    const MarkbookColumns original = columns;
+
+    for (const GradeUpdate& update : UPDATES) {
+        columns.setGrade(update.row, update.value);
+        rows[update.row].grade = update.value ? std::optional<int>(std::min(*update.value, MarkbookColumns::MAX_GRADE))
+                                              : std::nullopt;
+        checkAgainstReference(context, columns, rows, update.description);
+        context.check(columns.grade(update.row) == rows[update.row].grade, std::string("row grade: ") + update.description);
+    }
+    context.check(columns.pendingRows().empty(), "every row graded after the updates");
+    context.check(near(original.overall().gpa(), 98.0 / 13.0), "copy made before setGrade is untouched");
+}
+
+void testProjection(TestContext& context) {
+    const std::vector<Row> rows(std::begin(ROWS), std::end(ROWS));
+    const MarkbookColumns columns(buildMarkbook(rows));
+
+    for (int assumed : {0, 4, 7, 10, 12, -3}) {
+        std::vector<Row> projected = rows;
+        const int clamped = std::clamp(assumed, 0, MarkbookColumns::MAX_GRADE);
+        for (Row& row : projected) {
+            if (!row.grade) row.grade = clamped;
+        }
+        context.check(near(columns.projectedGPA(assumed), referenceGPA(projected)),
+                      "projectedGPA(" + std::to_string(assumed) + ") matches filling every pending row");
+    }
+    // (98 + 10 * (3 + 5 + 0)) / (13 + 8)
+    context.check(near(columns.projectedGPA(10), 178.0 / 21.0), "projectedGPA(10) by hand");
+    context.check(columns.pendingRows().size() == 3, "projectedGPA leaves the rows pending");
+}
+
+} // namespace
+
+void markbookColumnsTests(TestContext& context) {
+    testConstruction(context);
+    testWhatIf(context);
+    testProjection(context);
+}
+
+} // namespace UnitTests
@@ -0,0 +1,184 @@
+//
+//  ModelDiffTests.cpp
+//  cPPiIS Tools - ModelDiff Unit Tests
+//
+
+#include "ModelDiff.hpp"
+#include "UnitTests.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace BSUIR;
+
+namespace UnitTests {
+
+namespace {
+
+struct Row {
+    int semester;
+    const char* name;
+    const char* controlForm;
+    std::optional<int> grade;
+    std::optional<double> average;
+    double retakeChance;
+};
+
+Markbook buildMarkbook(const std::vector<Row>& rows) {
+    Markbook markbook{};
+    for (const Row& row : rows) {
+        if (markbook.semesters.empty() || markbook.semesters.back().number != row.semester) {
+            markbook.semesters.push_back(Semester{row.semester, 0.0, {}});
+        }
+        markbook.semesters.back().subjects.push_back(Subject{InternedString(row.name), 72.0, 3,
+                                                             InternedString(row.controlForm), row.grade, 0,
+                                                             row.average, row.retakeChance, false});
+    }
+    return markbook;
+}
+
+// "kind semester/name/form" per change, joined by '|'
+std::string describe(const MarkbookChangeSet& set) {
+    std::string text;
+    for (const MarkbookChange& change : set.changes) {
+        if (!text.empty()) text.push_back('|');
+        text += std::string(markbookChangeKindName(change.kind)) + " " + std::to_string(change.semester) + "/" +
+                change.subject + "/" + change.controlForm;
+    }
+    return text;
+}
+
+struct MarkbookCase {
+    std::vector<Row> before;
+    std::vector<Row> after;
+    const char* changes;
+    const char* description;
+};
+
+const MarkbookCase MARKBOOKS[] = {
+    {{{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     {{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     "", "identical snapshots"},
+    {{{1, "ОАиП", "Экзамен", std::nullopt, 7.5, 0.1}},
+     {{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     "gradePosted 1/ОАиП/Экзамен", "grade posted"},
+    {{{1, "ОАиП", "Экзамен", 7, 7.5, 0.1}},
+     {{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     "gradeChanged 1/ОАиП/Экзамен", "grade changed"},
+    {{{1, "ОАиП", "Экзамен", 7, 7.5, 0.1}},
+     {{1, "ОАиП", "Экзамен", std::nullopt, 7.5, 0.1}},
+     "gradeRemoved 1/ОАиП/Экзамен", "grade removed"},
+    {{{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     {{1, "ОАиП", "Экзамен", 8, 7.6, 0.1}},
+     "averageChanged 1/ОАиП/Экзамен", "group average changed"},
+    {{{1, "ОАиП", "Экзамен", 8, std::nullopt, 0.1}},
+     {{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     "averageChanged 1/ОАиП/Экзамен", "group average appeared"},
+    {{{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     {{1, "ОАиП", "Экзамен", 8, 7.5 + 1e-12, 0.1 + 1e-12}},
+     "", "rounding noise ignored"},
+    {{{1, "ОАиП", "Экзамен", std::nullopt, 7.5, 0.1}},
+     {{1, "ОАиП", "Экзамен", std::nullopt, 7.5, 0.3}},
+     "retakeChanceChanged 1/ОАиП/Экзамен", "retake chance changed"},
+    {{{1, "ОАиП", "Экзамен", 7, 7.0, 0.1}},
+     {{1, "ОАиП", "Экзамен", 9, 7.2, 0.0}},
+     "gradeChanged 1/ОАиП/Экзамен|averageChanged 1/ОАиП/Экзамен|retakeChanceChanged 1/ОАиП/Экзамен",
+     "every field of one subject, in a fixed order"},
+    {{},
+     {{2, "Физика", "Зачёт", std::nullopt, std::nullopt, 0.2}, {2, "ОАиП", "Экзамен", 9, std::nullopt, 0.0}},
+     "subjectAdded 2/Физика/Зачёт|subjectAdded 2/ОАиП/Экзамен|gradePosted 2/ОАиП/Экзамен",
+     "added subjects, a graded one also posts its grade"},
+    {{{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}, {1, "Физика", "Зачёт", 9, std::nullopt, 0.0}},
+     {{1, "Физика", "Зачёт", 9, std::nullopt, 0.0}},
+     "subjectRemoved 1/ОАиП/Экзамен", "removed subject"},
+    {{{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     {{1, "ОАиП", "Курсовая работа", 8, 7.5, 0.1}},
+     "subjectAdded 1/ОАиП/Курсовая работа|gradePosted 1/ОАиП/Курсовая работа|subjectRemoved 1/ОАиП/Экзамен",
+     "control form is part of the key; removals last"},
+    {{{1, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     {{2, "ОАиП", "Экзамен", 8, 7.5, 0.1}},
+     "subjectAdded 2/ОАиП/Экзамен|gradePosted 2/ОАиП/Экзамен|subjectRemoved 1/ОАиП/Экзамен",
+     "semester is part of the key"},
+    {{{1, "Физика", "Зачёт", 5, std::nullopt, 0.0}, {1, "ОАиП", "Экзамен", 5, std::nullopt, 0.0}},
+     {{1, "ОАиП", "Экзамен", 6, std::nullopt, 0.0}, {1, "Физика", "Зачёт", 6, std::nullopt, 0.0}},
+     "gradeChanged 1/ОАиП/Экзамен|gradeChanged 1/Физика/Зачёт", "changes in the new snapshot's order"},
+    {{{1, "Физвоспитание", "Зачёт", 5, std::nullopt, 0.0}, {1, "Физвоспитание", "Зачёт", 6, std::nullopt, 0.0}},
+     {{1, "Физвоспитание", "Зачёт", 5, std::nullopt, 0.0}, {1, "Физвоспитание", "Зачёт", 7, std::nullopt, 0.0}},
+     "gradeChanged 1/Физвоспитание/Зачёт", "duplicate keys matched in order of appearance"},
+    {{{1, "Физвоспитание", "Зачёт", 5, std::nullopt, 0.0}, {1, "Физвоспитание", "Зачёт", 6, std::nullopt, 0.0}},
+     {{1, "Физвоспитание", "Зачёт", 5, std::nullopt, 0.0}},
+     "subjectRemoved 1/Физвоспитание/Зачёт", "second of two duplicates removed"},
+};
+
+struct GroupCase {
+    std::vector<GroupStudent> before;
+    std::vector<GroupStudent> after;
+    const char* changes;    ///< "+number name" / "-number name", joined by '|'
+    const char* description;
+};
+
+const GroupCase GROUPS[] = {
+    {{{1, "Иванов"}, {2, "Петров"}}, {{1, "Иванов"}, {2, "Петров"}}, "", "same roster"},
+    {{{1, "Иванов"}, {2, "Петров"}}, {{2, "Петров"}, {1, "Иванов"}}, "", "reordered roster"},
+    {{{1, "Иванов"}}, {{1, "Иванов"}, {3, "Сидоров"}}, "+3 Сидоров", "student added"},
+    {{{1, "Иванов"}, {2, "Петров"}}, {{2, "Петров"}}, "-1 Иванов", "student removed"},
+    {{{1, "Иванов"}, {2, "Петров"}}, {{1, "Иванов"}, {2, "Кузнецов"}}, "+2 Кузнецов|-2 Петров",
+     "number reassigned: removal and addition"},
+    {{{1, "Иванов"}, {2, "Петров"}, {3, "Сидоров"}}, {{4, "Орлов"}}, "+4 Орлов|-1 Иванов|-2 Петров|-3 Сидоров",
+     "removals in the old roster's order"},
+};
+
+std::string describe(const GroupChangeSet& set) {
+    std::string text;
+    for (const GroupChange& change : set.changes) {
+        if (!text.empty()) text.push_back('|');
+        text += (change.kind == GroupChangeKind::StudentAdded ? "+" : "-") + std::to_string(change.student.number) +
+                " " + change.student.fullName;
+    }
+    return text;
+}
+
+void testMarkbooks(TestContext& context) {
+    for (const MarkbookCase& test : MARKBOOKS) {
+        const MarkbookChangeSet set = diffMarkbook(buildMarkbook(test.before), buildMarkbook(test.after));
+        context.checkEqual(describe(set), std::string(test.changes), test.description);
+        context.check(set.empty() == (test.changes[0] == '\0'), std::string("empty(): ") + test.description);
+    }
+
+    // Old and new values travel with the change
+    const MarkbookChangeSet set = diffMarkbook(buildMarkbook({{1, "ОАиП", "Экзамен", 7, std::nullopt, 0.1}}),
+                                               buildMarkbook({{1, "ОАиП", "Экзамен", 9, 7.2, 0.4}}));
+    const auto grades = set.ofKind(MarkbookChangeKind::GradeChanged);
+    context.check(grades.size() == 1 && grades[0].oldGrade == 7 && grades[0].newGrade == 9, "old and new grade");
+    const auto averages = set.ofKind(MarkbookChangeKind::AverageChanged);
+    context.check(averages.size() == 1 && !averages[0].oldAverage && averages[0].newAverage == 7.2,
+                  "old and new average");
+    const auto chances = set.ofKind(MarkbookChangeKind::RetakeChanceChanged);
+    context.check(chances.size() == 1 && chances[0].oldRetakeChance == 0.1 && chances[0].newRetakeChance == 0.4,
+                  "old and new retake chance");
+    context.check(set.ofKind(MarkbookChangeKind::GradePosted).empty(), "ofKind filters by kind");
+
+    const MarkbookChangeSet removed = diffMarkbook(buildMarkbook({{1, "ОАиП", "Экзамен", 7, 6.5, 0.1}}), Markbook{});
+    context.check(removed.changes.size() == 1 && removed.changes[0].oldGrade == 7 &&
+                      removed.changes[0].oldAverage == 6.5 && !removed.changes[0].newGrade,
+                  "removed subject carries its last values");
+}
+
+void testGroups(TestContext& context) {
+    for (const GroupCase& test : GROUPS) {
+        GroupInfo before{}, after{};
+        before.students = test.before;
+        after.students = test.after;
+        const GroupChangeSet set = diffGroupInfo(before, after);
+        context.checkEqual(describe(set), std::string(test.changes), test.description);
+    }
+}
+
+} // namespace
+
+void modelDiffTests(TestContext& context) {
+    testMarkbooks(context);
+    testGroups(context);
+}
+
+} // namespace UnitTests
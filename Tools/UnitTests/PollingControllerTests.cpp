@@ -0,0 +1,270 @@
+//
+//  PollingControllerTests.cpp
+//  cPPiIS Tools - PollingController Unit Tests
+//
+//  Every poll is recorded at an explicit time, so the learned intervals
+//  do not depend on the wall clock.
+//
+
+#include "Config.h"
+#include "Metrics.hpp"
+#include "PollingController.hpp"
+#include "UnitTests.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace BSUIR;
+
+namespace UnitTests {
+
+namespace {
+
+using Clock = PollingController::Clock;
+using std::chrono::hours;
+using std::chrono::minutes;
+using std::chrono::seconds;
+
+// Tue, 14 Nov 2023 22:13:20 GMT
+const Clock::time_point NOW = Clock::from_time_t(1700000000);
+
+// Rounding to whole seconds may move an interval by one
+bool near(seconds actual, seconds expected) {
+    return std::llabs(actual.count() - expected.count()) <= 1;
+}
+
+struct PriorCase {
+    const char* endpoint;
+    seconds initial;
+    const char* description;
+};
+
+const PriorCase PRIORS[] = {
+    {API_MARKBOOK_ENDPOINT, minutes(15), "markbook"},
+    {API_PERSONAL_INFO_ENDPOINT, hours(24), "personal info"},
+    {API_GROUP_INFO_ENDPOINT, hours(24), "group info"},
+    {"/certificate", seconds(900), "endpoint without defaults"},
+};
+
+/**
+ * @brief Record polls every gap, each finding a change with the given period
+ * @param changeEvery Every n-th poll finds a change (0: none does)
+ * @return Time of the last poll
+ */
+Clock::time_point poll(PollingController& controller, const std::string& account, const std::string& endpoint,
+                       Clock::time_point start, seconds gap, int polls, int changeEvery) {
+    Clock::time_point time = start;
+    for (int i = 0; i < polls; ++i) {
+        time = start + gap * i;
+        const bool changed = changeEvery > 0 && i > 0 && i % changeEvery == 0;
+        controller.record(account, endpoint, changed ? PollOutcome::Changed : PollOutcome::Unchanged, time);
+    }
+    return time;
+}
+
+void testPrior(TestContext& context) {
+    PollingController controller;
+    for (const PriorCase& prior : PRIORS) {
+        const PollingEstimate estimate = controller.estimate("a", prior.endpoint, NOW);
+        context.check(near(estimate.interval, prior.initial), std::string("prior gives initialInterval: ") +
+                                                                  prior.description);
+        context.check(estimate.polls == 0 && estimate.changes == 0 && !estimate.boosted,
+                      std::string("nothing learned yet: ") + prior.description);
+    }
+
+    PollingBounds bounds;
+    bounds.minInterval = seconds(10);
+    bounds.maxInterval = hours(10);
+    bounds.initialInterval = seconds(1234);
+    controller.setBounds("/custom", bounds);
+    context.check(near(controller.interval("a", "/custom", NOW), seconds(1234)), "custom initialInterval");
+
+    // The first poll only starts the clock
+    controller.record("a", API_MARKBOOK_ENDPOINT, PollOutcome::Changed, NOW);
+    const PollingEstimate first = controller.estimate("a", API_MARKBOOK_ENDPOINT, NOW);
+    context.check(near(first.interval, minutes(15)) && first.polls == 1 && first.changes == 0,
+                  "first poll leaves the prior");
+}
+
+void testLearning(TestContext& context) {
+    PollingController controller;
+    const PollingBounds bounds = defaultPollingBounds(API_MARKBOOK_ENDPOINT);
+
+    // Changes on every poll two minutes apart: as fast as allowed
+    Clock::time_point last = poll(controller, "busy", API_MARKBOOK_ENDPOINT, NOW, minutes(2), 50, 1);
+    const PollingEstimate busy = controller.estimate("busy", API_MARKBOOK_ENDPOINT, last);
+    context.checkEqual(busy.interval.count(), bounds.minInterval.count(), "frequent changes clamp to minInterval");
+    context.checkEqual(busy.changes, 49u, "changes counted");
+    context.checkEqual(busy.polls, 50u, "polls counted");
+
+    // Nothing changes in weeks of polling: as slow as allowed
+    last = poll(controller, "quiet", API_MARKBOOK_ENDPOINT, NOW, hours(6), 120, 0);
+    const PollingEstimate quiet = controller.estimate("quiet", API_MARKBOOK_ENDPOINT, last);
+    context.checkEqual(quiet.interval.count(), bounds.maxInterval.count(), "no changes clamp to maxInterval");
+    context.check(quiet.changesPerDay < busy.changesPerDay, "quiet rate below busy rate");
+
+    // In between: a change about every fourth hourly poll
+    last = poll(controller, "daily", API_MARKBOOK_ENDPOINT, NOW, hours(1), 200, 4);
+    const PollingEstimate daily = controller.estimate("daily", API_MARKBOOK_ENDPOINT, last);
+    context.check(daily.interval > bounds.minInterval && daily.interval < bounds.maxInterval,
+                  "moderate rate stays inside the bounds");
+    // 6 changes a day at 2 polls per change: close to 2 hours
+    context.check(daily.interval > minutes(90) && daily.interval < minutes(150), "interval follows the change rate");
+
+    // Failed polls and query strings
+    controller.record("daily", API_MARKBOOK_ENDPOINT, PollOutcome::Failed, last + hours(1));
+    const PollingEstimate failed = controller.estimate("daily", API_MARKBOOK_ENDPOINT, last);
+    context.check(failed.polls == daily.polls && failed.interval == daily.interval, "failed poll teaches nothing");
+    controller.record("daily", std::string(API_MARKBOOK_ENDPOINT) + "?semester=1", PollOutcome::Unchanged,
+                      last + hours(1));
+    context.checkEqual(controller.estimate("daily", API_MARKBOOK_ENDPOINT, last).polls, daily.polls + 1,
+                       "query string ignored");
+
+    // A poll at the same time as the previous one compares nothing
+    PollingController repeated;
+    repeated.record("a", "/x", PollOutcome::Unchanged, NOW);
+    repeated.record("a", "/x", PollOutcome::Changed, NOW);
+    context.check(repeated.estimate("a", "/x", NOW).changes == 0, "poll without elapsed time counts no change");
+
+    // Accounts are independent; forget drops one
+    context.check(controller.interval("fresh", API_MARKBOOK_ENDPOINT, NOW) == controller.interval("x", API_MARKBOOK_ENDPOINT, NOW),
+                  "unknown account gets the prior");
+    controller.forget("busy");
+    context.check(controller.estimate("busy", API_MARKBOOK_ENDPOINT, NOW).polls == 0, "forget drops the account");
+    context.check(controller.estimate("quiet", API_MARKBOOK_ENDPOINT, NOW).polls == 120, "forget keeps other accounts");
+
+    // Outcomes reach bsuir_polls_total through the cached counters
+    Metrics::Counter& counter = Metrics::MetricsRegistry::shared().counter(
+        "bsuir_polls_total", {{"endpoint", "/counted"}, {"outcome", "not_modified"}});
+    const uint64_t before = counter.value();
+    for (int i = 0; i < 3; ++i) {
+        controller.record("a", "/counted?i=" + std::to_string(i), PollOutcome::NotModified, NOW + seconds(i));
+    }
+    context.checkEqual(counter.value() - before, 3u, "polls counted by endpoint and outcome");
+}
+
+struct BoostCase {
+    seconds beginOffset;    ///< Relative to the time of asking
+    seconds endOffset;
+    double factor;
+    seconds interval;       ///< Expected, the unboosted one being 15 minutes
+    bool boosted;
+    const char* description;
+};
+
+const BoostCase BOOSTS[] = {
+    {-hours(1), hours(1), 0.25, seconds(225), true, "active boost multiplies the interval"},
+    {-hours(1), hours(1), 0.05, seconds(45), true, "boost may go below minInterval"},
+    {-hours(1), hours(1), 3.0, minutes(15), true, "factor above 1 clamped"},
+    {-hours(1), hours(1), 0.0, seconds(1), true, "interval never below one second"},
+    {minutes(5), hours(2), 0.25, minutes(5), false, "upcoming boost: wake at its start"},
+    {minutes(15), hours(2), 0.25, minutes(15), false, "boost starting when the poll is due"},
+    {hours(1), hours(2), 0.25, minutes(15), false, "boost after the next poll"},
+    {-hours(2), -hours(1), 0.25, minutes(15), false, "boost already over"},
+    {seconds(0), hours(1), 0.25, seconds(225), true, "boost beginning now is active"},
+    {-hours(1), seconds(0), 0.25, minutes(15), false, "boost ending now is over"},
+};
+
+void testBoosts(TestContext& context) {
+    for (const BoostCase& test : BOOSTS) {
+        PollingController controller;
+        controller.addBoost(API_MARKBOOK_ENDPOINT, PollingBoost{NOW + test.beginOffset, NOW + test.endOffset, test.factor});
+        const PollingEstimate estimate = controller.estimate("a", API_MARKBOOK_ENDPOINT, NOW);
+        context.check(near(estimate.interval, test.interval), std::string(test.description) + " (got " +
+                                                                  std::to_string(estimate.interval.count()) + " s)");
+        context.check(estimate.boosted == test.boosted, std::string("boosted flag: ") + test.description);
+    }
+
+    // Of several upcoming boosts, the earliest wins
+    PollingController controller;
+    controller.addBoost(API_MARKBOOK_ENDPOINT, PollingBoost{NOW + minutes(10), NOW + hours(1), 0.25});
+    controller.addBoost(API_MARKBOOK_ENDPOINT, PollingBoost{NOW + minutes(3), NOW + hours(1), 0.25});
+    context.check(near(controller.interval("a", API_MARKBOOK_ENDPOINT, NOW), minutes(3)), "earliest upcoming boost wins");
+    // A boost added before setBounds keeps applying with the new bounds
+    PollingBounds bounds = defaultPollingBounds(API_MARKBOOK_ENDPOINT);
+    bounds.initialInterval = minutes(20);
+    controller.setBounds(API_MARKBOOK_ENDPOINT, bounds);
+    context.check(near(controller.interval("a", API_MARKBOOK_ENDPOINT, NOW + minutes(30)), minutes(5)),
+                  "boost survives setBounds");
+}
+
+// Lines come out in hash-map order
+std::string sortedLines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream input(text);
+    for (std::string line; std::getline(input, line);) {
+        lines.push_back(line);
+    }
+    std::sort(lines.begin(), lines.end());
+    std::string sorted;
+    for (const auto& line : lines) {
+        sorted += line + "\n";
+    }
+    return sorted;
+}
+
+struct RestoreCase {
+    const char* text;
+    const char* description;
+};
+
+const RestoreCase BAD_TEXTS[] = {
+    {"", "empty text"},
+    {"bsuir-polling/2\n", "other version"},
+    {"a /markbook 1 0 60 1700000000 2 0\n", "missing header"},
+    {"bsuir-polling/1\na /markbook 1 0 60 1700000000 2\n", "missing field"},
+    {"bsuir-polling/1\na /markbook one 0 60 1700000000 2 0\n", "not a number"},
+    {"bsuir-polling/1\na /markbook nan 0 60 1700000000 2 0\n", "not finite"},
+    {"bsuir-polling/1\na /markbook 1 2 60 1700000000 2 1\n", "more changes than polls"},
+    {"bsuir-polling/1\na /markbook 1 -1 60 1700000000 2 0\n", "negative changes"},
+    {"bsuir-polling/1\na /markbook 1 0 -60 1700000000 2 0\n", "negative exposure"},
+    {"bsuir-polling/1\na /markbook 1 0 60 1700000000 2 0\nb /markbook\n", "one bad line among good ones"},
+};
+
+void testPersistence(TestContext& context) {
+    PollingController original;
+    const Clock::time_point last = poll(original, "a", API_MARKBOOK_ENDPOINT, NOW, hours(1), 100, 4);
+    poll(original, "b", API_GROUP_INFO_ENDPOINT, NOW, hours(12), 20, 0);
+    const std::string text = original.serialize();
+    context.check(text.rfind("bsuir-polling/1\n", 0) == 0, "serialized text starts with the header");
+
+    PollingController restored;
+    context.check(restored.restore(text), "own serialization restored");
+    const PollingEstimate before = original.estimate("a", API_MARKBOOK_ENDPOINT, last);
+    const PollingEstimate after = restored.estimate("a", API_MARKBOOK_ENDPOINT, last);
+    context.check(after.interval == before.interval && after.polls == before.polls && after.changes == before.changes &&
+                      std::abs(after.changesPerDay - before.changesPerDay) < 1e-9,
+                  "restored estimate identical");
+    context.check(restored.estimate("b", API_GROUP_INFO_ENDPOINT, last).polls == 20, "every account restored");
+    context.checkEqual(sortedLines(restored.serialize()), sortedLines(text), "serialization round-trips");
+
+    // Learning continues from the restored state
+    original.record("a", API_MARKBOOK_ENDPOINT, PollOutcome::Changed, last + hours(1));
+    restored.record("a", API_MARKBOOK_ENDPOINT, PollOutcome::Changed, last + hours(1));
+    context.check(original.interval("a", API_MARKBOOK_ENDPOINT, last) == restored.interval("a", API_MARKBOOK_ENDPOINT, last),
+                  "restored state learns like the original");
+
+    for (const RestoreCase& bad : BAD_TEXTS) {
+        context.check(!restored.restore(bad.text), std::string("rejected: ") + bad.description);
+        context.check(restored.estimate("a", API_MARKBOOK_ENDPOINT, last).polls == before.polls + 1,
+                      std::string("state kept after rejection: ") + bad.description);
+    }
+
+    context.check(restored.restore("bsuir-polling/1\n\n"), "header without lines accepted");
+    context.check(restored.estimate("a", API_MARKBOOK_ENDPOINT, last).polls == 0, "empty state replaces the old one");
+}
+
+} // namespace
+
+void pollingControllerTests(TestContext& context) {
+    testPrior(context);
+    testLearning(context);
+    testBoosts(context);
+    testPersistence(context);
+}
+
+} // namespace UnitTests
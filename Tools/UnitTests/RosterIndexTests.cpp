@@ -0,0 +1,215 @@
+//
+//  RosterIndexTests.cpp
+//  cPPiIS Tools - RosterIndex Unit Tests
+//
+
+#include "RosterIndex.hpp"
+#include "UnitTests.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace BSUIR;
+
+namespace UnitTests {
+
+namespace {
+
+std::string toUtf8(const std::u32string& text) {
+    std::string out;
+    for (char32_t c : text) {
+        if (c < 0x80) {
+            out.push_back(static_cast<char>(c));
+        } else if (c < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+    return out;
+}
+
+std::string joinFolded(const std::vector<std::u32string>& words) {
+    std::string joined;
+    for (const auto& word : words) {
+        if (!joined.empty()) joined.push_back('|');
+        joined += toUtf8(word);
+    }
+    return joined;
+}
+
+struct FoldCase {
+    const char* text;
+    const char* words;      ///< Folded words joined by '|'
+    const char* description;
+};
+
+const FoldCase FOLDS[] = {
+    {"Ёлкин Иван", "елкин|иван", "lower case, ё folded to е"},
+    {"ІВАНОЎ", "иваноу", "Belarusian і and ў folded to и and у"},
+    {"Анна-Мария  Петрова", "анна|мария|петрова", "hyphen and runs of spaces split words"},
+    {"Д'Артаньян", "дартаньян", "apostrophe dropped inside a word"},
+    {"O’Brien", "obrien", "typographic apostrophe dropped"},
+    {"Smith2", "smith2", "Latin and digits kept"},
+    {" ,. ", "", "punctuation only"},
+};
+
+struct TransliterationCase {
+    const char* folded;
+    const char* latin;
+};
+
+const TransliterationCase TRANSLITERATIONS[] = {
+    {"елкин", "elkin"},
+    {"щербаков", "shcherbakov"},
+    {"жук", "zhuk"},
+    {"юля", "yulya"},
+    {"объект", "obekt"},
+    {"хмель", "khmel"},
+    {"цой", "tsoy"},
+    {"abc", "abc"},
+};
+
+struct SearchCase {
+    const char* query;
+    const char* firstKey;   ///< Empty when nothing should match
+    bool fuzzy;
+    const char* description;
+};
+
+const GroupStudent ROSTER[] = {
+    {1, "Ёлкин Иван Петрович"},
+    {2, "Елкина Мария Сергеевна"},
+    {3, "Щербаков Андрей Игоревич"},
+    {4, "Иванов Пётр Андреевич"},
+    {5, "Шчарбакоў Алесь Міхайлавіч"},
+};
+
+const SearchCase SEARCHES[] = {
+    {"ёлкин", "g/1", false, "exact surname first"},
+    {"ЕЛКИН", "g/1", false, "case and ё/е insensitive"},
+    {"elkin", "g/1", false, "Latin query against transliteration"},
+    {"иван ёлкин", "g/1", false, "words in any order"},
+    {"ёлкина", "g/2", false, "longer word only prefixes the longer name"},
+    {"ива", "g/1", false, "shorter completed word ranks first"},
+    {"щерб андр", "g/3", false, "prefixes of several words"},
+    {"михайлович", "g/5", true, "Russian spelling finds the Belarusian name"},
+    {"yolkin", "g/1", true, "other transliteration scheme"},
+    {"щербакв", "g/3", true, "typo"},
+    {"зз", "", false, "too short for fuzzy matching"},
+    {"ёлкин сергей", "g/2", true, "words not all prefixing one name match only fuzzily"},
+};
+
+GroupInfo roster() {
+    GroupInfo info{};
+    info.number = "g";
+    info.students.assign(std::begin(ROSTER), std::end(ROSTER));
+    return info;
+}
+
+void testFolding(TestContext& context) {
+    for (const FoldCase& fold : FOLDS) {
+        context.checkEqual(joinFolded(RosterIndex::foldWords(fold.text)), std::string(fold.words), fold.description);
+    }
+    for (const TransliterationCase& entry : TRANSLITERATIONS) {
+        const auto words = RosterIndex::foldWords(entry.folded);
+        context.checkEqual(words.empty() ? std::string() : toUtf8(RosterIndex::transliterate(words.front())),
+                           std::string(entry.latin), std::string("transliterate ") + entry.folded);
+    }
+}
+
+void testSearch(TestContext& context) {
+    RosterIndex index;
+    index.indexGroup(roster());
+    context.checkEqual(index.size(), std::size(ROSTER), "every student indexed");
+
+    for (const SearchCase& search : SEARCHES) {
+        const auto matches = index.search(search.query, 5);
+        if (search.firstKey[0] == '\0') {
+            context.checkEqual(matches.size(), 0u, search.description);
+            continue;
+        }
+        if (!context.check(!matches.empty(), std::string("some match: ") + search.description)) {
+            continue;
+        }
+        context.checkEqual(matches.front().key, std::string(search.firstKey), search.description);
+        context.check(matches.front().fuzzy == search.fuzzy,
+                      std::string(search.fuzzy ? "fuzzy: " : "prefix: ") + search.description);
+        context.check(search.fuzzy ? matches.front().score < 1.0 : matches.front().score >= 1.0,
+                      std::string("score range: ") + search.description);
+        bool ordered = true;
+        for (std::size_t i = 1; i < matches.size(); ++i) {
+            ordered = ordered && matches[i - 1].score >= matches[i].score;
+        }
+        context.check(ordered, std::string("descending scores: ") + search.description);
+    }
+
+    context.checkEqual(index.search("е", 1).size(), 1u, "limit caps the matches");
+    context.checkEqual(index.search("е", 0).size(), 0u, "limit 0 returns nothing");
+    const auto exact = index.search("ёлкин иван петрович", 5);
+    context.check(!exact.empty() && exact.front().fullName == "Ёлкин Иван Петрович" && exact.front().group == "g",
+                  "match carries display name and group");
+}
+
+void testUpdates(TestContext& context) {
+    RosterIndex index;
+    index.indexGroup(roster());
+
+    // Student 2 leaves, student 4 is renamed, student 6 joins
+    GroupInfo refreshed = roster();
+    refreshed.students.erase(refreshed.students.begin() + 1);
+    refreshed.students[2].fullName = "Иваненко Пётр Андреевич";
+    refreshed.students.push_back({6, "Новиков Олег"});
+    index.indexGroup(refreshed);
+
+    context.checkEqual(index.size(), 5u, "roster refresh keeps one entry per student");
+    const auto departed = index.search("елкина мария", 5);
+    context.check(std::none_of(departed.begin(), departed.end(), [](const RosterMatch& match) { return match.key == "g/2"; }),
+                  "departed student removed");
+    const auto renamed = index.search("иваненко", 5);
+    context.check(!renamed.empty() && renamed.front().key == "g/4" && !renamed.front().fuzzy,
+                  "renamed student found under the new name");
+    const auto joined = index.search("новиков", 5);
+    context.check(!joined.empty() && joined.front().key == "g/6", "new student indexed");
+
+    // The signed-in student's Belarusian name becomes an alias of the roster entry
+    PersonalInfo person{};
+    person.studentNumber = "10210001";
+    person.lastName = "Ёлкин";
+    person.firstName = "Иван";
+    person.middleName = "Петрович";
+    person.lastNameBel = "Ёлкін";
+    person.firstNameBel = "Іван";
+    person.middleNameBel = "Пятровіч";
+    person.group = "g";
+    index.indexPerson(person);
+    context.checkEqual(index.size(), 5u, "person folded into their roster entry");
+    const auto alias = index.search("пятровіч", 5);
+    context.check(!alias.empty() && alias.front().key == "g/1" && !alias.front().fuzzy,
+                  "Belarusian alias finds the roster entry");
+
+    // Aliases survive a refresh that leaves the student unchanged
+    index.indexGroup(refreshed);
+    const auto kept = index.search("пятровіч", 5);
+    context.check(!kept.empty() && kept.front().key == "g/1", "alias kept across an unchanged refresh");
+
+    context.check(index.remove("g/6"), "remove of an indexed key");
+    context.check(!index.remove("g/6"), "remove of a missing key");
+    context.checkEqual(index.size(), 4u, "size after remove");
+    index.clear();
+    context.checkEqual(index.size(), 0u, "clear empties the index");
+    context.check(index.search("ёлкин").empty(), "nothing found after clear");
+}
+
+} // namespace
+
+void rosterIndexTests(TestContext& context) {
+    testFolding(context);
+    testSearch(context);
+    testUpdates(context);
+}
+
+} // namespace UnitTests
@@ -0,0 +1,150 @@
+//
+//  SkillTrieTests.cpp
+//  cPPiIS Tools - SkillTrie Unit Tests
+//
+
+#include "JSONParser.hpp"
+#include "SkillTrie.hpp"
+#include "UnitTests.hpp"
+#include <string>
+#include <vector>
+
+using namespace BSUIR;
+
+namespace UnitTests {
+
+namespace {
+
+std::string joinNames(const std::vector<std::string>& names) {
+    std::string joined;
+    for (const auto& name : names) {
+        if (!joined.empty()) joined.push_back('|');
+        joined += name;
+    }
+    return joined;
+}
+
+struct FoldCase {
+    const char* text;
+    const char* key;
+};
+
+const FoldCase FOLDS[] = {
+    {"C++", "c++"},
+    {"PyTorch", "pytorch"},
+    {"ПРОГРАММИРОВАНИЕ", "программирование"},
+    {"АБВГДЕЖЗИЙКЛМНОП", "абвгдежзийклмноп"},
+    {"РСТУФХЦЧШЩЪЫЬЭЮЯ", "рстуфхцчшщъыьэюя"},
+    {"ЁІЎ", "ёіў"},
+    {"Data Science", "data science"},
+};
+
+struct Answer {
+    const char* prefix;
+    std::vector<std::string> results;
+    bool complete;
+};
+
+// Server answers recorded in order before the lookups below
+const Answer ANSWERS[] = {
+    {"py", {"Python", "PyTorch", "pytest"}, true},
+    {"go", {"Golang", "Go"}, true},
+    {"про", {"Проектирование", "Программирование"}, true},
+    {"ja", {"Java"}, false},                        // possibly truncated
+    {"Py", {"Python"}, true},                       // repeated skill
+};
+
+struct LookupCase {
+    const char* prefix;
+    bool answered;
+    const char* names;      ///< Expected names joined by '|'
+    std::size_t limit;
+    const char* description;
+};
+
+const LookupCase LOOKUPS[] = {
+    {"py", true, "pytest|Python|PyTorch", 0, "complete prefix lists its skills by folded key"},
+    {"PY", true, "pytest|Python|PyTorch", 0, "query case folded"},
+    {"pyt", true, "pytest|Python|PyTorch", 0, "longer prefix answered from a complete ancestor"},
+    {"pyth", true, "Python", 0, "narrowed locally"},
+    {"pyx", true, "", 0, "complete ancestor without the path: no such skill"},
+    {"py", true, "pytest|Python", 2, "limit"},
+    {"go", true, "Go|Golang", 0, "a name comes before its extensions"},
+    {"ПРО", true, "Программирование|Проектирование", 0, "Cyrillic folded and sorted"},
+    {"прог", true, "Программирование", 0, "Cyrillic narrowed locally"},
+    {"p", false, "", 0, "prefix shorter than any complete answer"},
+    {"ja", false, "", 0, "incomplete answer is not used"},
+    {"java", false, "", 0, "incomplete answer covers no longer prefix"},
+    {"rust", false, "", 0, "never asked"},
+};
+
+void testFolding(TestContext& context) {
+    for (const FoldCase& fold : FOLDS) {
+        context.checkEqual(SkillTrie::foldKey(fold.text), std::string(fold.key), std::string("foldKey ") + fold.text);
+    }
+}
+
+void testLookup(TestContext& context) {
+    SkillTrie trie;
+    for (const Answer& answer : ANSWERS) {
+        trie.insert(answer.prefix, answer.results, answer.complete);
+    }
+    context.checkEqual(trie.skillCount(), 8u, "each distinct skill stored once");
+
+    for (const LookupCase& lookup : LOOKUPS) {
+        const auto names = trie.lookup(lookup.prefix, lookup.limit);
+        context.check(names.has_value() == lookup.answered, std::string(lookup.answered ? "answered: " : "not answered: ") +
+                                                                  lookup.description);
+        context.check(trie.covers(lookup.prefix) == lookup.answered, std::string("covers agrees: ") + lookup.description);
+        if (names && lookup.answered) {
+            context.checkEqual(joinNames(*names), std::string(lookup.names), lookup.description);
+        }
+    }
+
+    // A later complete answer for a shorter prefix covers the earlier incomplete one
+    trie.insert("j", {"Java", "JavaScript", "Jira"}, true);
+    const auto names = trie.lookup("ja");
+    context.check(names && joinNames(*names) == "Java|JavaScript", "complete shorter prefix covers an incomplete one");
+
+    trie.insert("", {}, true);
+    context.check(trie.covers("anything"), "complete root covers every prefix");
+    context.check(trie.lookup("zzz") && trie.lookup("zzz")->empty(), "complete root answers unknown prefixes empty");
+
+    trie.clear();
+    context.checkEqual(trie.skillCount(), 0u, "clear drops skills");
+    context.checkEqual(trie.nodeCount(), 1u, "clear keeps only the root");
+    context.check(!trie.covers("py"), "clear drops coverage");
+}
+
+void testParsedSkills(TestContext& context) {
+    // Names reach the trie exactly as the JSON escapes spell them
+    const auto skills = JSONParser::parseSkills(
+        R"({"skills": ["\u041f\u0440\u043e\u0433\u0440\u0430\u043c\u043c\u0438\u0440\u043e\u0432\u0430\u043d\u0438\u0435", )"
+        R"("C\\C++", "a\"b", "x\r\ty\b\f", "\uD83D\uDE80 Rocket", "plain, with comma"]})");
+    if (!context.check(skills.has_value(), "skills response parsed")) {
+        return;
+    }
+    const std::vector<std::string> expected = {"Программирование", "C\\C++", "a\"b", "x\r\ty\b\f", "🚀 Rocket",
+                                               "plain, with comma"};
+    context.check(*skills == expected, "escapes, surrogate pairs and commas decoded");
+
+    SkillTrie trie;
+    trie.insert("про", *skills, true);
+    const auto names = trie.lookup("прог");
+    context.check(names && joinNames(*names) == "Программирование", "decoded Cyrillic name found by prefix");
+
+    const auto bare = JSONParser::parseSkills(R"(["Go"])");
+    context.check(bare && bare->size() == 1 && bare->front() == "Go", "bare array accepted");
+    context.check(!JSONParser::parseSkills(R"({"skills": ["Go")").has_value(), "unterminated array rejected");
+    context.check(!JSONParser::parseSkills(R"({"error": "x"})").has_value(), "response without skills rejected");
+}
+
+} // namespace
+
+void skillTrieTests(TestContext& context) {
+    testFolding(context);
+    testLookup(context);
+    testParsedSkills(context);
+}
+
+} // namespace UnitTests
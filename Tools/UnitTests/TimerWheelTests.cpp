@@ -0,0 +1,203 @@
+//
+//  TimerWheelTests.cpp
+//  cPPiIS Tools - TimerWheel Unit Tests
+//
+//  The wheel runs on real time, so checks are on order and lower bounds
+//  only; a loaded machine may fire timers late but never early.
+//
+
+#include "TimerWheel.hpp"
+#include "UnitTests.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BSUIR;
+using namespace std::chrono_literals;
+
+namespace UnitTests {
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+// One-microsecond ticks put level boundaries at 256 us, 65.5 ms and 16.8 s,
+// so the delays below land on the first three levels and cascade
+TimerWheelOptions microsecondTicks() {
+    TimerWheelOptions options;
+    options.tick = 1us;
+    return options;
+}
+
+struct OrderCase {
+    std::chrono::microseconds delay;
+    const char* level;
+};
+
+// Deliberately not scheduled in due order
+const OrderCase ORDER[] = {
+    {70ms, "level 2, cascades twice"},
+    {0us, "due on the next tick"},
+    {2ms, "level 1"},
+    {100us, "level 0"},
+    {30ms, "level 1, far slot"},
+    {300us, "level 1, first slot"},
+    {-5ms, "negative delay"},
+};
+
+template<typename Predicate>
+bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = 2000ms) {
+    const auto deadline = SteadyClock::now() + timeout;
+    while (!predicate()) {
+        if (SteadyClock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(200us);
+    }
+    return true;
+}
+
+void testOrder(TestContext& context) {
+    TimerWheel wheel(microsecondTicks());
+    std::mutex mutex;
+    std::vector<std::size_t> fired;
+    std::vector<SteadyClock::time_point> firedAt(std::size(ORDER));
+
+    const auto start = SteadyClock::now();
+    for (std::size_t i = 0; i < std::size(ORDER); ++i) {
+        wheel.schedule(ORDER[i].delay, [&, i] {
+            std::lock_guard<std::mutex> lock(mutex);
+            firedAt[i] = SteadyClock::now();
+            fired.push_back(i);
+        });
+    }
+
+    const bool all = waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return fired.size() == std::size(ORDER);
+    });
+    if (!context.check(all, "every timer fired")) {
+        return;
+    }
+    context.checkEqual(wheel.pending(), 0u, "nothing pending after firing");
+
+    for (std::size_t i = 0; i < std::size(ORDER); ++i) {
+        context.check(firedAt[i] >= start + std::max(ORDER[i].delay, 0us),
+                      std::string("not fired early: ") + ORDER[i].level);
+    }
+    // Timers due on distinct ticks fire in due order; the two non-positive
+    // delays share the next tick, so only compare against the rest
+    for (std::size_t position = 2; position < fired.size(); ++position) {
+        context.check(ORDER[fired[position - 1]].delay < ORDER[fired[position]].delay,
+                      std::string("fired in due order: ") + ORDER[fired[position]].level);
+    }
+}
+
+void testCancel(TestContext& context) {
+    TimerWheel wheel(microsecondTicks());
+    std::atomic<int> runs{0};
+
+    const TimerWheel::TimerId id = wheel.schedule(20ms, [&runs] { ++runs; });
+    context.check(id != 0, "schedule never returns id 0");
+    context.check(wheel.cancel(id), "cancel of a pending timer succeeds");
+    context.checkEqual(wheel.pending(), 0u, "cancelled timer no longer pending");
+    context.check(!wheel.cancel(id), "second cancel of the same id fails");
+
+    const TimerWheel::TimerId quick = wheel.schedule(0us, [&runs] { ++runs; });
+    context.check(waitFor([&runs] { return runs.load() == 1; }), "uncancelled timer fires");
+    context.check(!wheel.cancel(quick), "cancel after firing fails");
+
+    std::this_thread::sleep_for(30ms);
+    context.checkEqual(runs.load(), 1, "cancelled timer never ran");
+
+    context.check(!wheel.cancel(0), "id 0 is never valid");
+    context.check(!wheel.cancel((TimerWheel::TimerId{7} << 32) | 999), "id of a slot never allocated");
+}
+
+void testCancelAcrossLevels(TestContext& context) {
+    TimerWheel wheel(microsecondTicks());
+    constexpr int TIMERS = 64;
+    std::vector<TimerWheel::TimerId> ids;
+    std::vector<std::atomic<int>> runs(TIMERS);
+
+    // Spread over levels 0..2; the cancels below land in whichever level
+    // (or cascade position) each timer sits in by then
+    for (int i = 0; i < TIMERS; ++i) {
+        const auto delay = std::chrono::microseconds(200 + i * 1200);
+        ids.push_back(wheel.schedule(delay, [&runs, i] { ++runs[i]; }));
+    }
+    std::this_thread::sleep_for(5ms);
+    int cancelled = 0;
+    for (int i = 1; i < TIMERS; i += 2) {
+        cancelled += wheel.cancel(ids[i]) ? 1 : 0;
+    }
+
+    context.check(waitFor([&wheel] { return wheel.pending() == 0; }), "remaining timers all fired");
+    int ranEven = 0, ranCancelled = 0, ranTwice = 0;
+    for (int i = 0; i < TIMERS; ++i) {
+        ranTwice += runs[i].load() > 1 ? 1 : 0;
+        if (i % 2 == 0) {
+            ranEven += runs[i].load();
+        } else {
+            ranCancelled += runs[i].load();
+        }
+    }
+    context.checkEqual(ranEven, TIMERS / 2, "every timer that was not cancelled ran");
+    context.checkEqual(ranCancelled, TIMERS / 2 - cancelled, "a successfully cancelled timer never runs");
+    context.check(cancelled > 0, "timers not yet due could be cancelled");
+    context.checkEqual(ranTwice, 0, "no timer ran twice");
+}
+
+void testGenerationReuse(TestContext& context) {
+    TimerWheel wheel(microsecondTicks());
+    std::atomic<int> runs{0};
+
+    const TimerWheel::TimerId first = wheel.schedule(10s, [] {});
+    context.check(wheel.cancel(first), "first timer cancelled");
+
+    // The freed node is reused; the stale id must not reach the new timer
+    const TimerWheel::TimerId second = wheel.schedule(20ms, [&runs] { ++runs; });
+    context.checkEqual(second & 0xFFFFFFFFu, first & 0xFFFFFFFFu, "cancelled node reused by the next timer");
+    context.check(second != first, "reused node gets a new generation");
+    context.check(!wheel.cancel(first), "stale id cannot cancel the new timer");
+    context.checkEqual(wheel.pending(), 1u, "new timer still pending");
+    context.check(waitFor([&runs] { return runs.load() == 1; }), "new timer fires");
+
+    const TimerWheel::TimerId third = wheel.schedule(10s, [] {});
+    context.check(!wheel.cancel(second), "id of a fired timer cannot cancel its successor");
+    context.check(wheel.cancel(third), "successor cancelled by its own id");
+}
+
+void testJitter(TestContext& context) {
+    const auto delay = 1000000us;
+    context.checkEqual(TimerWheel::jittered(delay, 0.0).count(), delay.count(), "zero jitter keeps the delay");
+    context.checkEqual(TimerWheel::jittered(-5us, 0.5).count(), -5, "non-positive delay is not jittered");
+
+    bool inRange = true, clamped = true, spread = false;
+    for (int i = 0; i < 1000; ++i) {
+        const auto value = TimerWheel::jittered(delay, 0.2).count();
+        inRange = inRange && value >= 800000 && value <= 1200000;
+        spread = spread || value != delay.count();
+        const auto wide = TimerWheel::jittered(delay, 5.0).count();
+        clamped = clamped && wide >= 0 && wide <= 2000000;
+    }
+    context.check(inRange, "jittered delay within +-20%");
+    context.check(spread, "jitter actually varies the delay");
+    context.check(clamped, "jitter above 1 clamped to 1");
+}
+
+} // namespace
+
+void timerWheelTests(TestContext& context) {
+    testOrder(context);
+    testCancel(context);
+    testCancelAcrossLevels(context);
+    testGenerationReuse(context);
+    testJitter(context);
+}
+
+} // namespace UnitTests
@@ -0,0 +1,86 @@
+//
+//  UnitTests.hpp
+//  cPPiIS Tools - Core Unit Tests
+//
+//  Minimal check harness shared by the suites: each suite records its
+//  checks in a TestContext, failures are printed as they happen.
+//
+
+#ifndef UnitTests_hpp
+#define UnitTests_hpp
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace UnitTests {
+
+/**
+ * @brief Check counters of one run
+ */
+class TestContext {
+private:
+    std::string suite;
+    int suiteChecks = 0;
+    int suiteFailures = 0;
+    int totalChecks = 0;
+    int totalFailures = 0;
+
+public:
+    void beginSuite(const std::string& name) {
+        suite = name;
+        suiteChecks = 0;
+        suiteFailures = 0;
+    }
+
+    void endSuite() {
+        std::cout << (suiteFailures == 0 ? "✅ " : "❌ ") << suite << ": " << suiteChecks - suiteFailures
+                  << "/" << suiteChecks << " checks passed" << std::endl;
+    }
+
+    /**
+     * @brief Record one check
+     * @param description What was expected, printed if it did not hold
+     */
+    bool check(bool condition, const std::string& description) {
+        ++suiteChecks;
+        ++totalChecks;
+        if (!condition) {
+            ++suiteFailures;
+            ++totalFailures;
+            std::cout << "   ❌ " << suite << ": " << description << std::endl;
+        }
+        return condition;
+    }
+
+    /**
+     * @brief Record an equality check, printing both values on failure
+     */
+    template<typename T, typename U>
+    bool checkEqual(const T& actual, const U& expected, const std::string& description) {
+        if (actual == expected) {
+            return check(true, description);
+        }
+        std::ostringstream detail;
+        detail << description << " (got " << actual << ", expected " << expected << ")";
+        return check(false, detail.str());
+    }
+
+    int checks() const noexcept { return totalChecks; }
+    int failures() const noexcept { return totalFailures; }
+};
+
+// Suites, one per component
+void cookieJarTests(TestContext& context);
+void timerWheelTests(TestContext& context);
+void rosterIndexTests(TestContext& context);
+void skillTrieTests(TestContext& context);
+void markbookColumnsTests(TestContext& context);
+void modelDiffTests(TestContext& context);
+void localStoreTests(TestContext& context);
+void pollingControllerTests(TestContext& context);
+void apiServiceTests(TestContext& context);
+
+} // namespace UnitTests
+
+#endif /* UnitTests_hpp */
@@ -0,0 +1,61 @@
+//
+//  main.cpp
+//  cPPiIS Tools - Core Unit Tests
+//
+//  Table-driven checks of the deterministic core components. Exits with
+//  status 1 if any check fails.
+//  Build (from this directory):
+//    c++ -std=c++20 -O1 -g -I../../cPPiIS -I../../cPPiIS/Core *.cpp
+//        ../../cPPiIS/Core/{HTTPClient,CookieJar,CurlHTTPTransport,JSONParser,Executor,CoroutineFramePool,BSUIROOPDemo,TimerWheel,TrafficCapture,Log,Tracing,Metrics,PollingController,Profiler,Watchdog,LocalStore,ModelDiff,StringPool,MarkbookColumns,RosterIndex,SkillTrie,SkillAutocomplete}.cpp
+//        -x c++ ../../cPPiIS/Core/{ApiService,IConfigProvider,SecureTokenStorage}.mm -o unit-tests -pthread -lcurl
+//
+//  Example:
+//    ./unit-tests                 # every suite
+//    ./unit-tests CookieJar       # only the named suites
+//
+
+#include "UnitTests.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace UnitTests;
+
+namespace {
+
+struct Suite {
+    const char* name;
+    void (*run)(TestContext&);
+};
+
+const Suite SUITES[] = {
+    {"CookieJar", cookieJarTests},
+    {"TimerWheel", timerWheelTests},
+    {"RosterIndex", rosterIndexTests},
+    {"SkillTrie", skillTrieTests},
+    {"MarkbookColumns", markbookColumnsTests},
+    {"ModelDiff", modelDiffTests},
+    {"LocalStore", localStoreTests},
+    {"PollingController", pollingControllerTests},
+    {"ApiService", apiServiceTests},
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::vector<std::string> selected(argv + 1, argv + argc);
+
+    TestContext context;
+    for (const Suite& suite : SUITES) {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), suite.name) == selected.end()) {
+            continue;
+        }
+        context.beginSuite(suite.name);
+        suite.run(context);
+        context.endSuite();
+    }
+
+    std::cout << context.checks() - context.failures() << "/" << context.checks() << " checks passed" << std::endl;
+    return context.failures() == 0 ? 0 : 1;
+}
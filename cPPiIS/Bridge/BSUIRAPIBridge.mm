@@ -5,10 +5,71 @@
 
 #import "BSUIRAPIBridge.h"
 #import "BSUIRModels.h"
+#import <Security/Security.h>
 #include "../Core/ApiService.hpp"
 #include "../Config.h"
 #include <memory>
 
+namespace {
+
+// Keychain service shared with CredentialsManager.swift
+NSString *const kKeychainService = @"by.bsuir.iis";
+
+NSDictionary *keychainQuery(const std::string& key) {
+    return @{
+        (__bridge id)kSecClass: (__bridge id)kSecClassGenericPassword,
+        (__bridge id)kSecAttrService: kKeychainService,
+        (__bridge id)kSecAttrAccount: @(key.c_str())
+    };
+}
+
+/**
+ * @brief Session vault in the app's Keychain, readable after the first unlock
+ *        so a background launch can resume the session too
+ */
+class KeychainVault : public BSUIR::ISecureVault {
+public:
+    std::optional<std::string> read(const std::string& key) const override {
+        NSMutableDictionary *query = [keychainQuery(key) mutableCopy];
+        query[(__bridge id)kSecReturnData] = @YES;
+        query[(__bridge id)kSecMatchLimit] = (__bridge id)kSecMatchLimitOne;
+        CFTypeRef result = NULL;
+        if (SecItemCopyMatching((__bridge CFDictionaryRef)query, &result) != errSecSuccess || !result) {
+            return std::nullopt;
+        }
+        NSData *data = (__bridge_transfer NSData *)result;
+        return std::string(static_cast<const char *>(data.bytes), data.length);
+    }
+    
+    bool write(const std::string& key, const std::string& value) override {
+        remove(key);
+        NSMutableDictionary *item = [keychainQuery(key) mutableCopy];
+        item[(__bridge id)kSecValueData] = [NSData dataWithBytes:value.data() length:value.size()];
+        item[(__bridge id)kSecAttrAccessible] = (__bridge id)kSecAttrAccessibleAfterFirstUnlockThisDeviceOnly;
+        return SecItemAdd((__bridge CFDictionaryRef)item, NULL) == errSecSuccess;
+    }
+    
+    void remove(const std::string& key) override {
+        SecItemDelete((__bridge CFDictionaryRef)keychainQuery(key));
+    }
+};
+
+// Credentials saved by CredentialsManager when the user chose to be remembered
+std::optional<std::pair<std::string, std::string>> rememberedCredentials() {
+    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    NSString *studentNumber = [defaults stringForKey:@"bsuir_student_number"];
+    if (![defaults boolForKey:@"bsuir_remember_credentials"] || studentNumber.length == 0) {
+        return std::nullopt;
+    }
+    auto password = KeychainVault().read("bsuir_password");
+    if (!password) {
+        return std::nullopt;
+    }
+    return std::make_pair(std::string(studentNumber.UTF8String), std::move(*password));
+}
+
+} // namespace
+
 @interface BSUIRAPIBridge () {
     std::unique_ptr<BSUIR::ApiService> _apiService;
 }
@@ -39,6 +100,29 @@
         
         _apiService = std::make_unique<BSUIR::ApiService>(std::move(config));
         
+        // Decode JSON on a work-stealing pool instead of the NSURLSession delegate thread;
+        // completion blocks below still hop to the main queue for UIKit
+        BSUIR::ServiceExecutors executors;
+        executors.parsing = BSUIR::ExecutorFactory::createThreadPool();
+        _apiService->setExecutors(std::move(executors));
+        
+        // Offline-first: screens get the last known data at once and are refreshed in the background
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        NSURL *supportDirectory = [fileManager URLsForDirectory:NSApplicationSupportDirectory
+                                                      inDomains:NSUserDomainMask].firstObject;
+        [fileManager createDirectoryAtURL:supportDirectory withIntermediateDirectories:YES attributes:nil error:nil];
+        NSString *storePath = [supportDirectory URLByAppendingPathComponent:@"bsuir-store.log"].path;
+        auto store = std::make_shared<BSUIR::LocalStore>(storePath.UTF8String);
+        if (store->isOpen()) {
+            _apiService->setLocalStore(std::move(store));
+        }
+        // Profile, markbook and group info are fetched right after login, before their screens ask
+        _apiService->setPrefetchPolicy(BSUIR::defaultPrefetchPolicy());
+        
+        // Cold starts resume the saved session instead of logging in; a rejected one is renewed silently
+        _apiService->setCredentialsProvider(&rememberedCredentials);
+        _apiService->setSessionVault(std::make_shared<KeychainVault>());
+        
         NSLog(@"🚀 BSUIRAPIBridge: Initialized with base URL: %s", API_BASE_URL);
     }
     return self;
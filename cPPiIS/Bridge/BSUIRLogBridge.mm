@@ -1,4 +1,65 @@
 #import "BSUIRLogBridge.h"
+#include "../Core/Log.hpp"
+#include <memory>
+
+// MARK: - Core Log Sink
+
+@interface BSUIRLogBridge ()
+- (void)deliverCoreEntries:(NSArray<BSUIRLogEntry *> *)entries;
+@end
+
+namespace {
+
+BSUIRLogLevel bridgeLevel(BSUIR::Log::Level level) {
+    switch (level) {
+        case BSUIR::Log::Level::Trace:
+        case BSUIR::Log::Level::Debug:   return BSUIRLogLevelDebug;
+        case BSUIR::Log::Level::Info:    return BSUIRLogLevelInfo;
+        case BSUIR::Log::Level::Warning: return BSUIRLogLevelWarning;
+        case BSUIR::Log::Level::Error:
+        case BSUIR::Log::Level::Off:     return BSUIRLogLevelError;
+    }
+    return BSUIRLogLevelInfo;
+}
+
+/**
+ * @brief Forwards C++ core log entries to the bridge delegate
+ *
+ * Runs on the core log consumer thread. Entries of one batch are
+ * collected and handed to the main queue with a single dispatch.
+ */
+class BridgeLogSink : public BSUIR::Log::ILogSink {
+private:
+    __weak BSUIRLogBridge *bridge;
+    NSMutableArray<BSUIRLogEntry *> *pending = [NSMutableArray array];
+
+public:
+    explicit BridgeLogSink(BSUIRLogBridge *owner) : bridge(owner) {}
+
+    void write(const BSUIR::Log::Entry& entry) override {
+        BSUIRLogEntry *logEntry = [[BSUIRLogEntry alloc] initWithLevel:bridgeLevel(entry.level)
+                                                              category:@(BSUIR::Log::categoryName(entry.category))
+                                                               message:@(entry.message.c_str())
+                                                              metadata:nil];
+        const auto since = entry.timestamp.time_since_epoch();
+        logEntry.timestamp = [NSDate dateWithTimeIntervalSince1970:std::chrono::duration<double>(since).count()];
+        [pending addObject:logEntry];
+    }
+
+    void flush() override {
+        if (pending.count == 0) {
+            return;
+        }
+        NSArray<BSUIRLogEntry *> *batch = pending;
+        pending = [NSMutableArray array];
+        __weak BSUIRLogBridge *target = bridge;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [target deliverCoreEntries:batch];
+        });
+    }
+};
+
+} // namespace
 
 // MARK: - Log Entry Implementation
 @implementation BSUIRLogEntry
@@ -28,6 +89,9 @@
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         sharedInstance = [[BSUIRLogBridge alloc] init];
+        // Core entries reach the delegate in batches; stderr keeps them in the console
+        BSUIR::Log::addSink(std::make_shared<BridgeLogSink>(sharedInstance));
+        BSUIR::Log::addSink(std::make_shared<BSUIR::Log::StderrSink>());
     });
     return sharedInstance;
 }
@@ -96,6 +160,15 @@
 
 #pragma mark - Private Methods
 
+- (void)deliverCoreEntries:(NSArray<BSUIRLogEntry *> *)entries {
+    if (!self.delegate || ![self.delegate respondsToSelector:@selector(didReceiveLogEntry:)]) {
+        return;
+    }
+    for (BSUIRLogEntry *entry in entries) {
+        [self.delegate didReceiveLogEntry:entry];
+    }
+}
+
 - (NSString *)stringForLogLevel:(BSUIRLogLevel)level {
     switch (level) {
         case BSUIRLogLevelDebug:
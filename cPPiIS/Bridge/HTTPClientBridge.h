@@ -28,6 +28,14 @@ typedef void (*HTTPResponseCallback)(const char* responseData,
                                    const char* errorMessage,
                                    void* context);
 
+// Callback for cookieless requests; setCookies holds the cookies the
+// response set as Set-Cookie lines separated by '\n' (nullptr if none)
+typedef void (*HTTPCookieResponseCallback)(const char* responseData,
+                                          int statusCode,
+                                          const char* errorMessage,
+                                          const char* setCookies,
+                                          void* context);
+
 // C interface for HTTP requests
 void performHTTPRequest(const char* url,
                        HTTPMethodType method,
@@ -37,6 +45,23 @@ void performHTTPRequest(const char* url,
                        HTTPResponseCallback callback,
                        void* context);
 
+// Request on a session without cookie storage: sends cookieHeader and
+// reports the cookies the response sets instead of storing them
+void performCookielessHTTPRequest(const char* url,
+                                  HTTPMethodType method,
+                                  const char* headers,
+                                  const char* body,
+                                  double timeout,
+                                  const char* cookieHeader,
+                                  HTTPCookieResponseCallback callback,
+                                  void* context);
+
+// Cookie header ("name=value; ...") the shared cookie storage sends to url; caller must free()
+char* copyCookieHeader(const char* url);
+
+// Store "name=value; ..." cookies for url in the shared cookie storage
+void restoreCookieHeader(const char* url, const char* header);
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,31 +49,12 @@ NSDictionary* parseHeadersString(const char* headersString) {
     return headerDict;
 }
 
-void performHTTPRequest(const char* url,
-                       HTTPMethodType method,
-                       const char* headers,
-                       const char* body,
-                       double timeout,
-                       HTTPResponseCallback callback,
-                       void* context) {
-    
-    if (!url || !callback) {
-        if (callback) {
-            callback(nullptr, 0, "Invalid parameters", context);
-        }
-        return;
-    }
-    
-    // Create URL
-    NSString* urlString = safeStringFromCString(url);
-    NSURL* nsUrl = [NSURL URLWithString:urlString];
-    
-    if (!nsUrl) {
-        callback(nullptr, 0, "Invalid URL", context);
-        return;
-    }
-    
-    // Create request
+// Build the request shared by both sessions
+NSMutableURLRequest* buildURLRequest(NSURL* nsUrl,
+                                     HTTPMethodType method,
+                                     const char* headers,
+                                     const char* body,
+                                     double timeout) {
     NSMutableURLRequest* request = [NSMutableURLRequest requestWithURL:nsUrl];
     request.timeoutInterval = timeout;
     
@@ -105,6 +86,60 @@ void performHTTPRequest(const char* url,
         request.HTTPBody = [bodyString dataUsingEncoding:NSUTF8StringEncoding];
     }
     
+    return request;
+}
+
+// Set-Cookie lines for the cookies a response sets; caller must free()
+char* copySetCookieLines(NSHTTPURLResponse* response) {
+    // Foundation folds repeated Set-Cookie headers; let it split them again
+    NSArray<NSHTTPCookie*>* cookies = [NSHTTPCookie cookiesWithResponseHeaderFields:response.allHeaderFields
+                                                                             forURL:response.URL];
+    if (cookies.count == 0) return nullptr;
+    
+    NSMutableArray<NSString*>* lines = [NSMutableArray arrayWithCapacity:cookies.count];
+    for (NSHTTPCookie* cookie in cookies) {
+        NSMutableString* line = [NSMutableString stringWithFormat:@"%@=%@; Path=%@", cookie.name, cookie.value, cookie.path];
+        // A leading dot marks a cookie that had a Domain attribute
+        if ([cookie.domain hasPrefix:@"."]) {
+            [line appendFormat:@"; Domain=%@", [cookie.domain substringFromIndex:1]];
+        }
+        if (cookie.expiresDate) {
+            [line appendFormat:@"; Max-Age=%lld", (long long)MAX(0.0, cookie.expiresDate.timeIntervalSinceNow)];
+        }
+        if (cookie.isSecure) [line appendString:@"; Secure"];
+        if (cookie.isHTTPOnly) [line appendString:@"; HttpOnly"];
+        [lines addObject:line];
+    }
+    return strdup([lines componentsJoinedByString:@"\n"].UTF8String);
+}
+
+void performHTTPRequest(const char* url,
+                       HTTPMethodType method,
+                       const char* headers,
+                       const char* body,
+                       double timeout,
+                       HTTPResponseCallback callback,
+                       void* context) {
+    
+    if (!url || !callback) {
+        if (callback) {
+            callback(nullptr, 0, "Invalid parameters", context);
+        }
+        return;
+    }
+    
+    // Create URL
+    NSString* urlString = safeStringFromCString(url);
+    NSURL* nsUrl = [NSURL URLWithString:urlString];
+    
+    if (!nsUrl) {
+        callback(nullptr, 0, "Invalid URL", context);
+        return;
+    }
+    
+    // Create request
+    NSMutableURLRequest* request = buildURLRequest(nsUrl, method, headers, body, timeout);
+    
     // Create session with persistent cookie storage
     NSURLSessionConfiguration* config = [NSURLSessionConfiguration defaultSessionConfiguration];
     
@@ -153,4 +188,104 @@ void performHTTPRequest(const char* url,
     }];
     
     [task resume];
-}
\ No newline at end of file
+}
+
+void performCookielessHTTPRequest(const char* url,
+                                  HTTPMethodType method,
+                                  const char* headers,
+                                  const char* body,
+                                  double timeout,
+                                  const char* cookieHeader,
+                                  HTTPCookieResponseCallback callback,
+                                  void* context) {
+    
+    if (!url || !callback) {
+        if (callback) {
+            callback(nullptr, 0, "Invalid parameters", nullptr, context);
+        }
+        return;
+    }
+    
+    NSURL* nsUrl = [NSURL URLWithString:safeStringFromCString(url)];
+    if (!nsUrl) {
+        callback(nullptr, 0, "Invalid URL", nullptr, context);
+        return;
+    }
+    
+    NSMutableURLRequest* request = buildURLRequest(nsUrl, method, headers, body, timeout);
+    if (cookieHeader && strlen(cookieHeader) > 0) {
+        [request setValue:safeStringFromCString(cookieHeader) forHTTPHeaderField:@"Cookie"];
+    }
+    
+    // One session for every cookie jar: cookies are the caller's, connections are shared
+    static NSURLSession* cookielessSession = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSURLSessionConfiguration* config = [NSURLSessionConfiguration defaultSessionConfiguration];
+        config.HTTPCookieStorage = nil;
+        config.HTTPCookieAcceptPolicy = NSHTTPCookieAcceptPolicyNever;
+        config.HTTPShouldSetCookies = NO;
+        cookielessSession = [NSURLSession sessionWithConfiguration:config];
+    });
+    
+    NSURLSessionDataTask* task = [cookielessSession dataTaskWithRequest:request
+                                                      completionHandler:^(NSData* data, NSURLResponse* response, NSError* error) {
+        
+        int statusCode = 0;
+        const char* responseData = nullptr;
+        const char* errorMessage = nullptr;
+        char* setCookies = nullptr;
+        
+        if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+            NSHTTPURLResponse* httpResponse = (NSHTTPURLResponse*)response;
+            statusCode = (int)httpResponse.statusCode;
+            setCookies = copySetCookieLines(httpResponse);
+        }
+        if (error) {
+            errorMessage = [[error localizedDescription] UTF8String];
+        } else if (data) {
+            responseData = cStringFromNSData(data);
+        }
+        
+        callback(responseData, statusCode, errorMessage, setCookies, context);
+        
+        if (responseData) {
+            free((void*)responseData);
+        }
+        free(setCookies);
+    }];
+    
+    [task resume];
+}
+
+char* copyCookieHeader(const char* url) {
+    NSURL* cookieURL = [NSURL URLWithString:safeStringFromCString(url)];
+    if (!cookieURL) return nullptr;
+    
+    NSArray<NSHTTPCookie*>* cookies = [[NSHTTPCookieStorage sharedHTTPCookieStorage] cookiesForURL:cookieURL];
+    NSString* header = [NSHTTPCookie requestHeaderFieldsWithCookies:cookies][@"Cookie"];
+    return header.length > 0 ? strdup(header.UTF8String) : nullptr;
+}
+
+void restoreCookieHeader(const char* url, const char* header) {
+    NSURL* cookieURL = [NSURL URLWithString:safeStringFromCString(url)];
+    if (!cookieURL || !header) return;
+    
+    NSHTTPCookieStorage* storage = [NSHTTPCookieStorage sharedHTTPCookieStorage];
+    for (NSString* pair in [safeStringFromCString(header) componentsSeparatedByString:@"; "]) {
+        NSRange equals = [pair rangeOfString:@"="];
+        if (equals.location == NSNotFound) continue;
+        
+        // Session cookies again: they must not outlive the restored session
+        NSHTTPCookie* cookie = [NSHTTPCookie cookieWithProperties:@{
+            NSHTTPCookieName: [pair substringToIndex:equals.location],
+            NSHTTPCookieValue: [pair substringFromIndex:equals.location + 1],
+            NSHTTPCookieDomain: cookieURL.host,
+            NSHTTPCookiePath: @"/",
+            NSHTTPCookieSecure: @([cookieURL.scheme isEqualToString:@"https"])
+        }];
+        if (cookie) {
+            [storage setCookie:cookie];
+        }
+    }
+}
@@ -14,6 +14,7 @@
 #define API_PERSONAL_INFO_ENDPOINT "/personal-information"
 #define API_MARKBOOK_ENDPOINT "/markbook"
 #define API_GROUP_INFO_ENDPOINT "/student-groups/user-group-info"
+#define API_SKILL_ENDPOINT "/skill"
 
 // Test Credentials (for development only)
 #define TEST_LOGIN "42850012"
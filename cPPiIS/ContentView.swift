@@ -1,7 +1,8 @@
 import SwiftUI
 
 struct ContentView: View {
-    @State private var isAuthenticated = false
+    // A session saved by an earlier launch is resumed without the login screen
+    @State private var isAuthenticated = BSUIRAPIBridge.shared().isAuthenticated()
     @State private var isLoading = false
     
     var body: some View {
@@ -14,8 +14,25 @@
 #include "JSONParser.hpp"
 #include "IConfigProvider.hpp"
 #include "BSUIROOPDemo.hpp"
+#include "Executor.hpp"
+#include "Task.hpp"
+#include "AtomicSnapshot.hpp"
+#include "LocalStore.hpp"
+#include "RosterIndex.hpp"
+#include "SecureTokenStorage.hpp"
+#include "TimerWheel.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace BSUIR {
 
@@ -29,10 +46,103 @@ using LoginCallback = std::function<void(const ApiResult<LoginResponse>&)>;
 using PersonalInfoCallback = std::function<void(const ApiResult<PersonalInfo>&)>;
 using MarkbookCallback = std::function<void(const ApiResult<Markbook>&)>;
 using GroupInfoCallback = std::function<void(const ApiResult<GroupInfo>&)>;
+using SkillsCallback = std::function<void(const ApiResult<std::vector<std::string>>&)>;
+
+/**
+ * @brief Supplies student number and password for a silent re-login, or nullopt to give up
+ *
+ * Called on a background thread when the server rejects the session.
+ */
+using CredentialsProvider = std::function<std::optional<std::pair<std::string, std::string>>()>;
+
+/**
+ * @brief Executors used by ApiService at each stage of a request
+ *
+ * Any member left empty runs that stage inline on the thread that
+ * finished the previous stage.
+ */
+struct ServiceExecutors {
+    std::shared_ptr<IExecutor> completion;  ///< HTTP completion hand-off
+    std::shared_ptr<IExecutor> parsing;     ///< CPU-bound JSON decoding
+    std::shared_ptr<IExecutor> callbacks;   ///< User callback delivery
+    std::shared_ptr<TimerWheel> timers;     ///< Retry backoff and session expiry (default: TimerWheel::shared())
+};
+
+/**
+ * @brief Immutable authentication state published by ApiService
+ */
+struct AuthState {
+    std::string accessToken;
+    std::string refreshToken;
+    std::string account;    ///< Student number of the session; scopes cached data
+};
+
+/**
+ * @brief Models served from the local store
+ */
+enum class CachedModel {
+    PersonalInfo,
+    Markbook,
+    GroupInfo,
+    Count
+};
+
+/**
+ * @brief How long cached data of one model is served
+ */
+struct FreshnessPolicy {
+    std::chrono::seconds maxAge{0};         ///< Younger data is served without a network refresh
+    std::chrono::seconds maxStaleness{0};   ///< Older data is ignored and the getter waits for the network
+};
+
+/**
+ * @brief Default policy of a model (personal and group info: 1 day, markbook: 10 minutes;
+ *        anything up to 90 days old is served while refreshing)
+ */
+FreshnessPolicy defaultFreshnessPolicy(CachedModel model);
+
+/**
+ * @brief What to fetch in the background as soon as a login succeeds
+ */
+struct PrefetchPolicy {
+    std::vector<CachedModel> models;        ///< In the order screens usually ask for them (empty disables prefetch)
+    std::size_t maxConcurrent = 1;          ///< Prefetch requests in flight at once
+    std::chrono::seconds ttl{120};          ///< A prefetched response unused for this long is discarded
+    std::chrono::seconds minInterval{60};   ///< Another login of the same account within this does not prefetch again
+    std::size_t learningSamples = 8;        ///< Prefetches of a model before its hit ratio is judged
+    double minHitRatio = 0.25;              ///< Models whose prefetches are used less often are no longer prefetched
+};
+
+/**
+ * @brief Default policy: personal info, markbook and group info, one at a time
+ */
+PrefetchPolicy defaultPrefetchPolicy();
+
+/**
+ * @brief Outcome counters of prefetching
+ */
+struct PrefetchStats {
+    uint64_t issued = 0;        ///< Prefetch requests sent
+    uint64_t hits = 0;          ///< Prefetched responses that served at least one getter
+    uint64_t servedGetters = 0; ///< Getters handed a prefetched response, joined ones included
+    uint64_t wasted = 0;        ///< Prefetched responses expired or dropped unused
+    uint64_t failed = 0;        ///< Prefetch requests that failed
+    uint64_t throttled = 0;     ///< Prefetches skipped by minInterval or minHitRatio
+
+    double hitRatio() const noexcept;
+    double wasteRatio() const noexcept;
+};
 
 /**
  * @brief Main API service implementing OOP principles and design patterns
  * 
+ * Thread safety: all public methods may be called concurrently on one
+ * instance from any thread. Authentication state and executor
+ * configuration are published as immutable snapshots, so request
+ * methods only perform atomic loads and never take a lock (with a
+ * prefetch policy set, getters briefly lock the prefetch slots). The
+ * service must outlive every request and task it has started.
+ * 
  * This class demonstrates:
  * - Inheritance from AbstractApiService (Template Method pattern)
  * - Dependency Injection for configuration
@@ -45,8 +155,102 @@ class ApiService : public AbstractApiService, public ObserverSubject {
 private:
     std::unique_ptr<HTTPClient> httpClient;
     std::unique_ptr<IConfigProvider> configProvider;
-    std::string currentAccessToken;
-    std::string currentRefreshToken;
+    AtomicSnapshot<const AuthState> authState;
+    AtomicSnapshot<IExecutor> coroutineExecutor;
+    AtomicSnapshot<const ServiceExecutors> executors;
+    
+    struct CacheSettings {
+        std::shared_ptr<LocalStore> store;
+        std::array<FreshnessPolicy, static_cast<std::size_t>(CachedModel::Count)> policies;
+    };
+    AtomicSnapshot<const CacheSettings> cacheSettings;
+    
+    /**
+     * @brief Latest snapshot of a model and the account it was fetched for
+     */
+    template<typename Model>
+    struct AccountSnapshot {
+        std::string account;
+        Model model;
+    };
+    AtomicSnapshot<const AccountSnapshot<Markbook>> lastMarkbook;
+    AtomicSnapshot<const AccountSnapshot<GroupInfo>> lastGroupInfo;
+    AtomicSnapshot<RosterIndex> rosterIndex;
+    
+    /**
+     * @brief Prefetched response of one model, or the request still producing it
+     */
+    struct PrefetchSlot {
+        enum class Status { Empty, InFlight, Ready };
+        Status status = Status::Empty;
+        std::string account;
+        HTTPResponse response;
+        std::chrono::steady_clock::time_point fetchedAt;
+        std::vector<std::function<void(std::optional<HTTPResponse>)>> waiters;
+    };
+    
+    struct PrefetchState {
+        std::mutex mutex;
+        std::array<PrefetchSlot, static_cast<std::size_t>(CachedModel::Count)> slots;
+        std::array<PrefetchStats, static_cast<std::size_t>(CachedModel::Count)> stats;
+        std::vector<CachedModel> queue;
+        std::size_t inFlight = 0;
+        uint64_t generation = 0;            ///< Bumped on logout; older prefetches are dropped
+        std::string lastAccount;
+        std::chrono::steady_clock::time_point lastRun;
+    };
+    AtomicSnapshot<const PrefetchPolicy> prefetchPolicy;
+    std::unique_ptr<PrefetchState> prefetch;
+    
+    /**
+     * @brief Persisted login session and the re-login that renews it
+     */
+    struct SessionState {
+        std::mutex mutex;
+        std::shared_ptr<ISecureVault> vault;
+        std::chrono::seconds lifetime{0};
+        SecureTokenStorage tokens;
+        CredentialsProvider credentials;
+        std::atomic<uint64_t> epoch{0};     ///< Bumped by every login; a 401 of an older epoch is just retried
+        bool reauthenticating = false;
+        std::vector<std::function<void(bool)>> waiters;
+        uint64_t expiryTimer = 0;           ///< Renews the session when its lifetime is over
+    };
+    std::unique_ptr<SessionState> session;
+    
+    /**
+     * @brief Timers this service has pending on a wheel
+     *
+     * Shared with the timer callbacks so they never touch the service itself.
+     * The destructor clears alive, cancels what is pending and waits until
+     * no callback is running.
+     */
+    struct PendingTimers {
+        std::mutex mutex;
+        std::condition_variable drained;
+        bool alive = true;
+        int running = 0;                    ///< Callbacks currently inside their work
+        uint64_t nextKey = 0;
+        std::unordered_map<uint64_t, std::pair<std::shared_ptr<TimerWheel>, TimerWheel::TimerId>> timers;
+    };
+    std::shared_ptr<PendingTimers> pendingTimers;
+    
+    /**
+     * @brief Where a network result of a cached getter is written back
+     */
+    struct CacheRefresh {
+        std::shared_ptr<LocalStore> store;      ///< Empty when caching is off
+        std::string key;
+        std::string cachedBody;                 ///< Response already delivered from the store
+        bool servedCached = false;
+        const char* model = "";
+        
+        void commit(const std::string& body) const {
+            if (store) {
+                store->put(key, body);
+            }
+        }
+    };
     
     /**
      * @brief Set authentication token for requests
@@ -69,29 +273,167 @@ private:
      * @brief Handle login response and parse user data
      * @param response HTTP response from server
      * @param callback Login completion callback
+     * @param studentNumber Account the session belongs to
      */
-    void handleLoginResponse(const HTTPResponse& response, LoginCallback callback);
+    void handleLoginResponse(const HTTPResponse& response, LoginCallback callback, const std::string& studentNumber);
     
     /**
      * @brief Handle personal info response
      * @param response HTTP response from server
      * @param callback Personal info completion callback
+     * @param refresh Local store write-back
      */
-    void handlePersonalInfoResponse(const HTTPResponse& response, PersonalInfoCallback callback);
+    void handlePersonalInfoResponse(const HTTPResponse& response, PersonalInfoCallback callback, const CacheRefresh& refresh);
     
     /**
      * @brief Handle markbook response
      * @param response HTTP response from server
      * @param callback Markbook completion callback
+     * @param refresh Local store write-back
      */
-    void handleMarkbookResponse(const HTTPResponse& response, MarkbookCallback callback);
+    void handleMarkbookResponse(const HTTPResponse& response, MarkbookCallback callback, const CacheRefresh& refresh);
     
     /**
      * @brief Handle group info response
      * @param response HTTP response from server
      * @param callback Group info completion callback
+     * @param refresh Local store write-back
+     */
+    void handleGroupInfoResponse(const HTTPResponse& response, GroupInfoCallback callback, const CacheRefresh& refresh);
+    
+    /**
+     * @brief Handle skill search response
+     * @param response HTTP response from server
+     * @param callback Skill search completion callback
+     */
+    void handleSkillsResponse(const HTTPResponse& response, SkillsCallback callback);
+    
+    /**
+     * @brief Remember the latest snapshot of a model and announce what changed
+     *
+     * Markbook and group info are diffed against the previous snapshot of
+     * the same account; a non-empty change set goes to onMarkbookChanged /
+     * onGroupInfoChanged. A snapshot of another account is replaced
+     * without a diff. Personal info has no change events.
+     */
+    void publishSnapshot(const PersonalInfo& info);
+    void publishSnapshot(const Markbook& markbook);
+    void publishSnapshot(const GroupInfo& info);
+    
+    /**
+     * @brief Start background fetches of the policy's models for a new session
+     * @param account Student number of the session
+     */
+    void startPrefetch(const std::string& account);
+    
+    /**
+     * @brief Send queued prefetches up to the concurrency limit (call with the prefetch lock held)
+     * @return Models to request once the lock is released
+     */
+    std::vector<CachedModel> launchPrefetchesLocked(const PrefetchPolicy& policy);
+    
+    void sendPrefetch(CachedModel model, uint64_t generation);
+    void finishPrefetch(CachedModel model, uint64_t generation, const HTTPResponse& response);
+    
+    /**
+     * @brief Hand a getter the prefetched response of its model
+     * @param model Requested model
+     * @param consumer Receives the response, or nullopt if the prefetch
+     *                 failed and the getter should fetch on its own
+     * @return False if there is no usable prefetch (consumer not called)
+     */
+    bool takePrefetched(CachedModel model, std::function<void(std::optional<HTTPResponse>)> consumer);
+    
+    /**
+     * @brief Drop all prefetched data (logout)
+     */
+    void discardPrefetched();
+    
+    /**
+     * @brief Count a new login and save its session to the vault
+     * @param account Student number of the session
      */
-    void handleGroupInfoResponse(const HTTPResponse& response, GroupInfoCallback callback);
+    void beginSession(const std::string& account);
+    
+    /**
+     * @brief Adopt the session saved in the vault, if still valid
+     */
+    void restoreSession();
+    
+    /**
+     * @brief Check a restored session with one request, renewing it on 401
+     */
+    void probeSession();
+    
+    /**
+     * @brief GET that renews an expired session and retries once on 401
+     *
+     * Network errors, 408, 429 and 5xx are retried up to the configured
+     * number of attempts after an exponential, jittered backoff.
+     * @param endpoint API endpoint
+     * @param callback Response callback (gets the last failure if retries run out)
+     * @param attempt Retries already made
+     */
+    void authorizedGet(const std::string& endpoint, ResponseCallback callback, int attempt = 0);
+    
+    /**
+     * @brief Run work on the service's timer wheel
+     * @return Key for stopTimer(); the timer is cancelled if the service is destroyed first
+     */
+    uint64_t startTimer(std::chrono::microseconds delay, std::function<void()> work);
+    void stopTimer(uint64_t key);
+    
+    /**
+     * @brief Renew (or end) the session once its lifetime is over
+     * @param remaining Time left; zero cancels the timer
+     */
+    void scheduleSessionExpiry(std::chrono::seconds remaining);
+    
+    /**
+     * @brief Log in again with the credentials provider; concurrent callers share one login
+     * @param sentEpoch Session epoch the rejected request was sent in
+     * @param done Receives whether the session was renewed
+     */
+    void reauthenticate(uint64_t sentEpoch, std::function<void(bool)> done);
+    void finishReauthentication(bool renewed, bool rejected);
+    
+    /**
+     * @brief Forget a session the server no longer accepts
+     */
+    void expireSession();
+    
+    /**
+     * @brief Serve a getter from the local store, then refresh it from the network
+     * @tparam T Model type
+     * @param model Cached model (selects the freshness policy)
+     * @param endpoint API endpoint
+     * @param callback User callback
+     * @param parse JSONParser function for the model
+     * @param handle Response handler for the model
+     */
+    template<typename T>
+    void fetchCached(CachedModel model, const char* endpoint,
+                     std::function<void(const ApiResult<T>&)> callback,
+                     std::optional<T> (*parse)(const std::string&),
+                     void (ApiService::*handle)(const HTTPResponse&, std::function<void(const ApiResult<T>&)>,
+                                                const CacheRefresh&));
+    
+    /**
+     * @brief Run response handling on the parsing executor
+     * @param work Parse-and-deliver step
+     */
+    void schedule(std::function<void()> work);
+    
+    /**
+     * @brief Deliver a result through the callback executor
+     * @tparam T Result data type
+     * @param callback User callback
+     * @param result Result to deliver
+     * @param then Work to start once the callback has returned
+     */
+    template<typename T>
+    void deliver(const std::function<void(const ApiResult<T>&)>& callback, ApiResult<T> result,
+                 std::function<void()> then = nullptr);
     
     /**
      * @brief Create error result with consistent error handling
@@ -150,9 +492,9 @@ public:
     ApiService(const ApiService&) = delete;
     ApiService& operator=(const ApiService&) = delete;
     
-    // Allow move constructor and assignment
-    ApiService(ApiService&&) = default;
-    ApiService& operator=(ApiService&&) = default;
+    // Not movable: in-flight requests hold a pointer to this instance
+    ApiService(ApiService&&) = delete;
+    ApiService& operator=(ApiService&&) = delete;
     
     /**
      * @brief Authenticate user with credentials
@@ -178,6 +520,10 @@ public:
     /**
      * @brief Get user personal information
      * @param callback Completion callback with result
+     * @note With a local store the callback may run twice: first with the
+     *       cached data (cacheAge set), then with fresh data if it changed.
+     *       The same holds for getMarkbook() and getGroupInfo(); their
+     *       coroutine variants complete with the first delivery.
      */
     void getPersonalInfo(PersonalInfoCallback callback);
     
@@ -193,6 +539,14 @@ public:
      */
     void getGroupInfo(GroupInfoCallback callback);
     
+    /**
+     * @brief Search skills whose name starts with a prefix
+     * @param name Prefix typed by the user
+     * @param callback Completion callback with matching skill names
+     * @note One request per call; use SkillAutocomplete for type-ahead
+     */
+    void searchSkills(const std::string& name, SkillsCallback callback);
+    
     /**
      * @brief Set authentication tokens manually
      * @param accessToken Access token
@@ -212,6 +566,131 @@ public:
      */
     std::string getRefreshToken() const;
     
+    /**
+     * @brief Configure executors for completion, parsing and callbacks
+     * @param stageExecutors Executors per request stage
+     */
+    void setExecutors(ServiceExecutors stageExecutors);
+    
+    /**
+     * @brief Run a user callback the way request results are delivered
+     *
+     * On the callback executor if one is set, inside an "api.callback"
+     * span and a watchdog scope. For components built on the service
+     * that answer without a request, e.g. from a cache or after a timer.
+     * @param subject Type the watchdog reports if the callback stalls
+     * @param callback Callback bound to its result
+     */
+    void deliverCallback(const std::type_info& subject, std::function<void()> callback);
+    
+    /**
+     * @brief Serve personal info, markbook and group info from a local store
+     * @param store Opened store (nullptr disables caching)
+     * @note Changes found by a background refresh are also announced
+     *       through Observer::onDataUpdated with the model name
+     */
+    void setLocalStore(std::shared_ptr<LocalStore> store);
+    
+    /**
+     * @brief Override the freshness policy of one model
+     * @param model Cached model
+     * @param policy Policy to apply
+     */
+    void setFreshnessPolicy(CachedModel model, FreshnessPolicy policy);
+    
+    /**
+     * @brief Keep a roster search index up to date with fetched data
+     * @param index Index fed with every group info and personal info
+     *              response (nullptr stops feeding); may be shared by
+     *              several services to search across groups
+     */
+    void setRosterIndex(std::shared_ptr<RosterIndex> index);
+    
+    /**
+     * @brief Prefetch models in the background right after login
+     * @param policy Policy (empty models list disables prefetch)
+     * @note A getter called while its prefetch is in flight waits for it
+     *       instead of sending a second request. Consumed responses go
+     *       through the normal response path, so they also reach the
+     *       local store and observers.
+     */
+    void setPrefetchPolicy(PrefetchPolicy policy);
+    
+    /**
+     * @brief Persist login sessions so a restart can skip /auth/login
+     * @param vault Secret store for the session (nullptr stops persisting)
+     * @param lifetime How long a saved session is trusted without a login
+     * @note A valid saved session is restored immediately: isAuthenticated()
+     *       turns true, cookies go back into the transport and one request
+     *       (the prefetch, or a personal info probe) checks it in the
+     *       background. Any request answered with 401 triggers a silent
+     *       re-login through the credentials provider and is retried once;
+     *       without credentials the session ends with onUserLoggedOut.
+     *       The same happens proactively when the lifetime is over.
+     */
+    void setSessionVault(std::shared_ptr<ISecureVault> vault,
+                         std::chrono::seconds lifetime = std::chrono::hours(8));
+    
+    /**
+     * @brief Source of credentials for renewing a rejected session
+     * @param provider Provider (nullptr: a rejected session just ends)
+     */
+    void setCredentialsProvider(CredentialsProvider provider);
+    
+    /**
+     * @brief Prefetch counters over all models
+     */
+    PrefetchStats prefetchStats() const;
+    
+    /**
+     * @brief Prefetch counters of one model
+     */
+    PrefetchStats prefetchStats(CachedModel model) const;
+    
+    // ========================================
+    // Coroutine API
+    // ========================================
+    
+    /**
+     * @brief Set executor used to resume awaiting coroutines
+     * @param executor Executor for continuations (nullptr resumes inline
+     *                 on the HTTP completion thread)
+     */
+    void setCoroutineExecutor(std::shared_ptr<IExecutor> executor);
+    
+    /**
+     * @brief Awaitable variant of login()
+     * @param studentNumber Student identification number
+     * @param password User password
+     * @param token Optional cancellation token
+     * @return Task yielding the login result
+     * @note The service must outlive every task it returned
+     */
+    Task<ApiResult<LoginResponse>> loginAsync(std::string studentNumber,
+                                              std::string password,
+                                              CancellationToken token = {});
+    
+    /**
+     * @brief Awaitable variant of getPersonalInfo()
+     * @param token Optional cancellation token
+     * @return Task yielding personal information
+     */
+    Task<ApiResult<PersonalInfo>> personalInfoAsync(CancellationToken token = {});
+    
+    /**
+     * @brief Awaitable variant of getMarkbook()
+     * @param token Optional cancellation token
+     * @return Task yielding markbook data
+     */
+    Task<ApiResult<Markbook>> markbookAsync(CancellationToken token = {});
+    
+    /**
+     * @brief Awaitable variant of getGroupInfo()
+     * @param token Optional cancellation token
+     * @return Task yielding group information
+     */
+    Task<ApiResult<GroupInfo>> groupInfoAsync(CancellationToken token = {});
+    
     /**
      * @brief Get configuration provider (for testing or debugging)
      * @return Reference to configuration provider
@@ -7,10 +7,93 @@
 
 #include "ApiService.hpp"
 #include "../Config.h"
-#include <iostream>
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Tracing.hpp"
+#include "Watchdog.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
 
 namespace BSUIR {
 
+namespace {
+
+constexpr const char* SESSION_VAULT_KEY = "bsuir.session";
+
+// Backoff before retry n is min(base * 2^(n-1), max), spread by +-jitter
+constexpr std::chrono::milliseconds RETRY_BASE_DELAY{250};
+constexpr std::chrono::milliseconds RETRY_MAX_DELAY{8000};
+constexpr double RETRY_JITTER = 0.5;
+
+/**
+ * @brief Failures worth repeating a GET for: the server may answer next time
+ */
+bool isTransientFailure(const HTTPResponse& response) {
+    const int status = response.statusCode;
+    return status == 0 || status == 408 || status == 429 || status >= 500;
+}
+
+/**
+ * @brief Finish an operation's root span once its callback has run
+ */
+template<typename T>
+std::function<void(const ApiResult<T>&)> traced(const Tracing::Span& span,
+                                                 std::function<void(const ApiResult<T>&)> callback) {
+    if (!span.isActive()) {
+        return callback;
+    }
+    // Cached getters may deliver twice; the span covers the first delivery
+    auto finished = std::make_shared<std::atomic<bool>>(false);
+    return [span, finished, callback = std::move(callback)](const ApiResult<T>& result) {
+        callback(result);
+        if (!finished->exchange(true)) {
+            span.finish({{"success", result.success},
+                         {"error.code", result.error ? result.error->code : 0}});
+        }
+    };
+}
+
+/**
+ * @brief Run a JSONParser call, recording its time and allocations
+ */
+template<typename Parse>
+auto measuredParse(const Metrics::EndpointMetrics& metrics, Parse&& parse) {
+    const uint64_t allocationsBefore = Metrics::threadAllocations();
+    const auto start = std::chrono::steady_clock::now();
+    auto result = parse();
+    metrics.parseTime->record(std::chrono::steady_clock::now() - start);
+    if (Metrics::countsAllocations()) {
+        metrics.parseAllocations->record(Metrics::threadAllocations() - allocationsBefore);
+    }
+    return result;
+}
+
+/**
+ * @brief Percent-encode a query parameter value (RFC 3986 unreserved characters pass through)
+ */
+std::string encodeQueryValue(const std::string& value) {
+    static const char HEX[] = "0123456789ABCDEF";
+    std::string encoded;
+    encoded.reserve(value.size() * 3);
+    for (unsigned char c : value) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            encoded.push_back(static_cast<char>(c));
+        } else {
+            encoded.push_back('%');
+            encoded.push_back(HEX[c >> 4]);
+            encoded.push_back(HEX[c & 0x0F]);
+        }
+    }
+    return encoded;
+}
+
+// Timer state whose callback is running on this thread, if any
+thread_local const void* runningTimerState = nullptr;
+
+} // namespace
+
 // ========================================
 // ApiService Implementation
 // ========================================
@@ -19,7 +102,10 @@ ApiService::ApiService(
     std::unique_ptr<IConfigProvider> config,
     std::unique_ptr<HTTPClient> httpClientPtr
 ) : AbstractApiService(config->getApiBaseUrl()),
-    configProvider(std::move(config)) {
+    configProvider(std::move(config)),
+    prefetch(std::make_unique<PrefetchState>()),
+    session(std::make_unique<SessionState>()),
+    pendingTimers(std::make_shared<PendingTimers>()) {
     
     if (httpClientPtr) {
         httpClient = std::move(httpClientPtr);
@@ -29,16 +115,23 @@ ApiService::ApiService(
     
     httpClient->setBaseUrl(configProvider->getApiBaseUrl());
     
-    if (configProvider->isDebugMode()) {
-        std::cout << "🚀 ApiService: Initialized with base URL: " 
-                  << configProvider->getApiBaseUrl() << std::endl;
-    }
+    BSUIR_LOG_DEBUG(Api, "🚀 Initialized with base URL: ", configProvider->getApiBaseUrl());
 }
 
 ApiService::~ApiService() {
-    if (configProvider && configProvider->isDebugMode()) {
-        std::cout << "🔥 ApiService: Destructor called, cleaning up resources" << std::endl;
+    BSUIR_LOG_DEBUG(Api, "🔥 Destructor called, cleaning up resources");
+    
+    std::unique_lock<std::mutex> lock(pendingTimers->mutex);
+    pendingTimers->alive = false;
+    for (auto& [key, timer] : pendingTimers->timers) {
+        timer.first->cancel(timer.second);
     }
+    pendingTimers->timers.clear();
+    
+    // A callback that is already running cannot be cancelled, so wait it out;
+    // when its own work destroys the service, it is the one not waited for
+    const int self = runningTimerState == pendingTimers.get() ? 1 : 0;
+    pendingTimers->drained.wait(lock, [&] { return pendingTimers->running == self; });
 }
 
 // ========================================
@@ -56,9 +149,7 @@ std::string ApiService::buildEndpoint() const {
 }
 
 void ApiService::logRequest() const {
-    if (configProvider && configProvider->isDebugMode()) {
-        std::cout << "📤 ApiService: Making request to " << buildEndpoint() << std::endl;
-    }
+    BSUIR_LOG_DEBUG(Api, "📤 Making request to ", buildEndpoint());
 }
 
 bool ApiService::executeRequest(const std::string& endpoint) {
@@ -72,111 +163,409 @@ bool ApiService::executeRequest(const std::string& endpoint) {
 // ========================================
 
 void ApiService::setAuthToken(const std::string& token) {
-    currentAccessToken = token;
+    authState.update([&token](const std::shared_ptr<const AuthState>& current) {
+        auto next = std::make_shared<AuthState>(current ? *current : AuthState{});
+        next->accessToken = token;
+        return std::shared_ptr<const AuthState>(std::move(next));
+    });
     
-    if (configProvider && configProvider->isDebugMode()) {
-        std::cout << "🍪 ApiService: Session established, token length: " 
-                  << token.length() << " characters" << std::endl;
-    }
+    BSUIR_LOG_DEBUG(Api, "🍪 Session established, token length: ", token.length(), " characters");
 }
 
 void ApiService::login(const std::string& studentNumber, 
                       const std::string& password, 
                       LoginCallback callback) {
     
-    if (configProvider && configProvider->isDebugMode()) {
-        std::cout << "🔐 Starting login request for student: " << studentNumber << std::endl;
-    }
+    BSUIR_LOG_DEBUG(Api, "🔐 Starting login request for student: ", studentNumber);
+    
+    const Tracing::Span span = Tracing::Span::start("api.login");
+    Tracing::ContextScope trace(span.context());
+    callback = traced(span, std::move(callback));
     
     // Validate inputs
     if (studentNumber.empty() || password.empty()) {
         auto errorResult = createErrorResult<LoginResponse>("Invalid credentials provided", 400);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
         return;
     }
     
     // Use Template Method pattern from AbstractApiService
     if (!makeRequest()) {
         auto errorResult = createErrorResult<LoginResponse>("Request validation failed", 500);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
         return;
     }
     
     std::string requestBody = JSONParser::createLoginRequest(studentNumber, password, false); // No rememberMe
     
-    if (configProvider && configProvider->isDebugMode()) {
-        std::cout << "📤 Login request body: " << requestBody << std::endl;
-    }
-    
     httpClient->post(API_LOGIN_ENDPOINT, requestBody, 
         [this, callback, studentNumber](const HTTPResponse& response) {
-            if (configProvider && configProvider->isDebugMode()) {
-                std::cout << "🔄 Login response received for student: " << studentNumber << std::endl;
-            }
-            this->handleLoginResponse(response, callback);
+            BSUIR_LOG_DEBUG(Api, "🔄 Login response received for student: ", studentNumber);
+            schedule([this, response, callback, studentNumber] {
+                handleLoginResponse(response, callback, studentNumber);
+            });
         });
 }
 
-void ApiService::handleLoginResponse(const HTTPResponse& response, LoginCallback callback) {
-    if (configProvider && configProvider->isDebugMode()) {
-        std::cout << "🔍 Processing login response - Status: " << response.statusCode 
-                  << ", Success: " << (response.success ? "YES" : "NO") << std::endl;
-        std::cout << "📦 Raw response data: " << response.data << std::endl;
-    }
+void ApiService::handleLoginResponse(const HTTPResponse& response, LoginCallback callback,
+                                     const std::string& studentNumber) {
+    BSUIR_LOG_DEBUG(Api, "🔍 Processing login response - Status: ", response.statusCode,
+                    ", Success: ", response.success ? "YES" : "NO");
+    BSUIR_LOG_TRACE(Api, "📦 Raw response data: ", response.data);
     
     if (!response.success) {
-        if (configProvider && configProvider->isDebugMode()) {
-            std::cout << "❌ Login failed - HTTP Error: " << response.errorMessage << std::endl;
-        }
+        BSUIR_LOG_WARNING(Api, "❌ Login failed - HTTP Error: ", response.errorMessage);
         auto errorResult = createErrorResult<LoginResponse>(response.errorMessage, response.statusCode);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
         return;
     }
     
     if (response.statusCode == 200) {
-        if (configProvider && configProvider->isDebugMode()) {
-            std::cout << "✅ Login HTTP 200 - Parsing response data" << std::endl;
-        }
+        BSUIR_LOG_DEBUG(Api, "✅ Login HTTP 200 - Parsing response data");
         
-        auto parseResult = JSONParser::parseLoginResponse(response.data);
+        static const Metrics::EndpointMetrics& metrics = Metrics::endpoint(API_LOGIN_ENDPOINT);
+        auto parseResult = measuredParse(metrics, [&response] { return JSONParser::parseLoginResponse(response.data); });
         if (parseResult.has_value()) {
             // For BSUIR API, we don't get an access token
             // Authentication is maintained via session cookies
             // Set a dummy token to indicate authenticated state
+            authState.update([&studentNumber](const std::shared_ptr<const AuthState>& current) {
+                auto next = std::make_shared<AuthState>(current ? *current : AuthState{});
+                next->account = studentNumber;
+                return std::shared_ptr<const AuthState>(std::move(next));
+            });
             setAuthToken("SESSION_AUTHENTICATED");
+            beginSession(studentNumber);
+            startPrefetch(studentNumber);
             
             // Notify observers about successful login
             notifyUserLoggedIn(nullptr); // In real implementation, pass actual user
             
             // Create successful ApiResult
             ApiResult<LoginResponse> result(std::move(parseResult.value()));
-            callback(result);
+            deliver(callback, std::move(result));
         } else {
             // Create error ApiResult from parse failure
             ApiError error{-1, "Failed to parse login response", "JSON parsing error"};
             ApiResult<LoginResponse> result(error);
-            callback(result);
+            deliver(callback, std::move(result));
         }
     } else {
         auto errorResult = createErrorResult<LoginResponse>("Unexpected status code", response.statusCode);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
     }
 }
 
 void ApiService::logout() {
-    currentAccessToken.clear();
-    currentRefreshToken.clear();
+    // Cached personal data must not outlive the session on a shared device
+    auto state = authState.load();
+    authState.store(nullptr);
+    lastMarkbook.store(nullptr);
+    lastGroupInfo.store(nullptr);
+    discardPrefetched();
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->tokens.clearTokens();
+        if (session->vault) {
+            session->vault->remove(SESSION_VAULT_KEY);
+        }
+    }
+    scheduleSessionExpiry(std::chrono::seconds(0));
+    if (auto cookies = httpClient->getCookieJar()) {
+        cookies->clear();
+    }
+    auto settings = cacheSettings.load();
+    if (state && settings && settings->store) {
+        for (const char* endpoint : {API_PERSONAL_INFO_ENDPOINT, API_MARKBOOK_ENDPOINT, API_GROUP_INFO_ENDPOINT}) {
+            settings->store->erase(state->account + " " + endpoint);
+        }
+    }
     
     // Notify observers about logout
     notifyUserLoggedOut();
     
-    if (configProvider && configProvider->isDebugMode()) {
-        std::cout << "🚪 ApiService: User logged out" << std::endl;
-    }
+    BSUIR_LOG_DEBUG(Api, "🚪 User logged out");
 }
 
 bool ApiService::isAuthenticated() const noexcept {
-    return !currentAccessToken.empty();
+    auto state = authState.load();
+    return state && !state->accessToken.empty();
+}
+
+// ========================================
+// Session Persistence
+// ========================================
+
+void ApiService::setSessionVault(std::shared_ptr<ISecureVault> vault, std::chrono::seconds lifetime) {
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->vault = std::move(vault);
+        session->lifetime = lifetime;
+    }
+    restoreSession();
+}
+
+void ApiService::setCredentialsProvider(CredentialsProvider provider) {
+    std::lock_guard<std::mutex> lock(session->mutex);
+    session->credentials = std::move(provider);
+}
+
+void ApiService::beginSession(const std::string& account) {
+    ++session->epoch;
+    
+    std::chrono::seconds lifetime{0};
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if (!session->vault) {
+            return;
+        }
+        session->tokens.storeTokens(httpClient->sessionCookies(), "", static_cast<int>(session->lifetime.count()));
+        session->tokens.setAccount(account);
+        const std::string blob = session->tokens.serialize();
+        if (blob.empty() || !session->vault->write(SESSION_VAULT_KEY, blob)) {
+            // Nothing to resume from: no cookies exposed or the vault refused
+            session->vault->remove(SESSION_VAULT_KEY);
+            BSUIR_LOG_WARNING(Storage, "🔐 Session of ", account, " not saved");
+            return;
+        }
+        lifetime = session->lifetime;
+    }
+    BSUIR_LOG_DEBUG(Storage, "🔐 Session of ", account, " saved for ", lifetime.count(), " s");
+    scheduleSessionExpiry(lifetime);
+}
+
+void ApiService::restoreSession() {
+    std::string account;
+    std::string cookies;
+    int64_t remaining = 0;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if (!session->vault || isAuthenticated()) {
+            return;
+        }
+        auto blob = session->vault->read(SESSION_VAULT_KEY);
+        if (!blob) {
+            return;
+        }
+        if (!session->tokens.restore(*blob) || session->tokens.getAccount().empty()) {
+            BSUIR_LOG_INFO(Storage, "🔐 Saved session expired or unreadable, login required");
+            session->vault->remove(SESSION_VAULT_KEY);
+            return;
+        }
+        account = session->tokens.getAccount();
+        cookies = session->tokens.getAccessToken().value_or("");
+        remaining = session->tokens.getTimeUntilExpiration();
+    }
+    
+    httpClient->restoreSessionCookies(cookies);
+    authState.store(std::make_shared<const AuthState>(AuthState{"SESSION_AUTHENTICATED", "", account}));
+    ++session->epoch;
+    scheduleSessionExpiry(std::chrono::seconds(remaining));
+    BSUIR_LOG_INFO(Api, "🔑 Session of ", account, " restored without login (", remaining, " s left)");
+    
+    notifyUserLoggedIn(nullptr);
+    probeSession();
+}
+
+void ApiService::probeSession() {
+    auto state = authState.load();
+    if (!state) {
+        return;
+    }
+    
+    // A prefetch of personal info checks the session and is not wasted
+    auto policy = prefetchPolicy.load();
+    if (policy && std::find(policy->models.begin(), policy->models.end(), CachedModel::PersonalInfo) != policy->models.end()) {
+        startPrefetch(state->account);
+        return;
+    }
+    
+    auto settings = cacheSettings.load();
+    std::shared_ptr<LocalStore> store = settings ? settings->store : nullptr;
+    const std::string key = state->account + " " + API_PERSONAL_INFO_ENDPOINT;
+    authorizedGet(API_PERSONAL_INFO_ENDPOINT, [store, key](const HTTPResponse& response) {
+        if (response.isSuccessful() && store) {
+            // Stored raw like a getter refresh; the first getter is then served fresh
+            store->put(key, response.data);
+        }
+        BSUIR_LOG_DEBUG(Api, "🔑 Session probe answered ", response.statusCode);
+    });
+}
+
+void ApiService::authorizedGet(const std::string& endpoint, ResponseCallback callback, int attempt) {
+    const uint64_t sentEpoch = session->epoch.load();
+    httpClient->get(endpoint, [this, endpoint, sentEpoch, attempt, callback = std::move(callback)](const HTTPResponse& response) {
+        if (isTransientFailure(response) && attempt < configProvider->getMaxRetryAttempts()) {
+            const auto backoff = std::min(RETRY_BASE_DELAY * (int64_t{1} << std::min(attempt, 16)), RETRY_MAX_DELAY);
+            const auto delay = TimerWheel::jittered(backoff, RETRY_JITTER);
+            BSUIR_LOG_DEBUG(Api, "🔁 ", endpoint, " failed with ", response.statusCode, ", retry ", attempt + 1,
+                            " in ", std::chrono::duration_cast<std::chrono::milliseconds>(delay).count(), " ms");
+            Metrics::endpoint(endpoint.substr(0, endpoint.find('?'))).retries->add();
+            startTimer(delay, [this, endpoint, attempt, callback] {
+                authorizedGet(endpoint, callback, attempt + 1);
+            });
+            return;
+        }
+        if (response.statusCode != 401) {
+            callback(response);
+            return;
+        }
+        reauthenticate(sentEpoch, [this, endpoint, response, callback](bool renewed) {
+            if (!renewed) {
+                callback(response);
+                return;
+            }
+            Metrics::endpoint(endpoint.substr(0, endpoint.find('?'))).retries->add();
+            httpClient->get(endpoint, callback);
+        });
+    });
+}
+
+void ApiService::reauthenticate(uint64_t sentEpoch, std::function<void(bool)> done) {
+    if (!isAuthenticated()) {
+        // Logged out or already expired meanwhile: nothing to renew
+        done(false);
+        return;
+    }
+    
+    CredentialsProvider provider;
+    {
+        std::unique_lock<std::mutex> lock(session->mutex);
+        if (session->epoch.load() != sentEpoch) {
+            // The rejected cookie predates a login that has happened since
+            lock.unlock();
+            done(true);
+            return;
+        }
+        session->waiters.push_back(std::move(done));
+        if (session->reauthenticating) {
+            return;
+        }
+        session->reauthenticating = true;
+        provider = session->credentials;
+    }
+    
+    auto credentials = provider ? provider() : std::nullopt;
+    if (!credentials) {
+        BSUIR_LOG_WARNING(Api, "🔒 Session rejected and no credentials to renew it");
+        finishReauthentication(false, true);
+        return;
+    }
+    
+    BSUIR_LOG_INFO(Api, "🔄 Session rejected, logging in again as ", credentials->first);
+    const std::string account = credentials->first;
+    std::string requestBody = JSONParser::createLoginRequest(credentials->first, credentials->second, false);
+    std::fill(credentials->second.begin(), credentials->second.end(), '\0');
+    httpClient->post(API_LOGIN_ENDPOINT, requestBody, [this, account](const HTTPResponse& response) {
+        const bool renewed = response.isSuccessful() && JSONParser::parseLoginResponse(response.data).has_value();
+        if (renewed) {
+            authState.store(std::make_shared<const AuthState>(AuthState{"SESSION_AUTHENTICATED", "", account}));
+            beginSession(account);
+        }
+        // A network failure leaves the session for the next request to try again
+        finishReauthentication(renewed, response.statusCode == 401);
+    });
+}
+
+uint64_t ApiService::startTimer(std::chrono::microseconds delay, std::function<void()> work) {
+    auto stages = executors.load();
+    std::shared_ptr<TimerWheel> wheel = stages && stages->timers ? stages->timers : TimerWheel::shared();
+    
+    // Held across schedule() so the timer cannot fire before it is recorded
+    std::lock_guard<std::mutex> lock(pendingTimers->mutex);
+    const uint64_t key = ++pendingTimers->nextKey;
+    const TimerWheel::TimerId id = wheel->schedule(delay, [state = pendingTimers, key, work = std::move(work)] {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!state->alive || state->timers.erase(key) == 0) {
+                return;
+            }
+            ++state->running;
+        }
+        // Leaves the running count even if work throws, so the destructor is never stuck
+        struct Running {
+            PendingTimers& state;
+            const void* outer = std::exchange(runningTimerState, &state);
+            ~Running() {
+                runningTimerState = outer;
+                std::lock_guard<std::mutex> lock(state.mutex);
+                --state.running;
+                state.drained.notify_all();
+            }
+        } running{*state};
+        work();
+    });
+    pendingTimers->timers.emplace(key, std::make_pair(std::move(wheel), id));
+    return key;
+}
+
+void ApiService::stopTimer(uint64_t key) {
+    if (key == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pendingTimers->mutex);
+    auto it = pendingTimers->timers.find(key);
+    if (it != pendingTimers->timers.end()) {
+        it->second.first->cancel(it->second.second);
+        pendingTimers->timers.erase(it);
+    }
+}
+
+void ApiService::scheduleSessionExpiry(std::chrono::seconds remaining) {
+    uint64_t key = 0;
+    if (remaining.count() > 0) {
+        const uint64_t epoch = session->epoch.load();
+        key = startTimer(remaining, [this, epoch] {
+            if (session->epoch.load() != epoch || !isAuthenticated()) {
+                return;
+            }
+            // Renew before the server starts rejecting; without credentials this ends the session
+            BSUIR_LOG_INFO(Api, "⏰ Session lifetime over");
+            reauthenticate(epoch, [](bool) {});
+        });
+    }
+    uint64_t replaced;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        replaced = std::exchange(session->expiryTimer, key);
+    }
+    stopTimer(replaced);
+}
+
+void ApiService::finishReauthentication(bool renewed, bool rejected) {
+    std::vector<std::function<void(bool)>> waiters;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        waiters.swap(session->waiters);
+        session->reauthenticating = false;
+    }
+    if (!renewed && rejected) {
+        expireSession();
+    }
+    for (auto& waiter : waiters) {
+        waiter(renewed);
+    }
+}
+
+void ApiService::expireSession() {
+    if (!authState.load()) {
+        return;
+    }
+    authState.store(nullptr);
+    discardPrefetched();
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->tokens.clearTokens();
+        if (session->vault) {
+            session->vault->remove(SESSION_VAULT_KEY);
+        }
+    }
+    scheduleSessionExpiry(std::chrono::seconds(0));
+    BSUIR_LOG_WARNING(Api, "🔒 Session expired, login required");
+    
+    // Cached data stays: the same user usually logs in again, and change
+    // snapshots are tagged with their account in case someone else does
+    notifyUserLoggedOut();
 }
 
 // ========================================
@@ -184,92 +573,156 @@ bool ApiService::isAuthenticated() const noexcept {
 // ========================================
 
 void ApiService::getPersonalInfo(PersonalInfoCallback callback) {
+    const Tracing::Span span = Tracing::Span::start("api.personalInfo");
+    Tracing::ContextScope trace(span.context());
+    callback = traced(span, std::move(callback));
+    
     if (!isAuthenticated()) {
         auto errorResult = createErrorResult<PersonalInfo>("User not authenticated", 401);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
         return;
     }
     
-    httpClient->get(API_PERSONAL_INFO_ENDPOINT, 
-        [this, callback](const HTTPResponse& response) {
-            this->handlePersonalInfoResponse(response, callback);
-        });
+    fetchCached<PersonalInfo>(CachedModel::PersonalInfo, API_PERSONAL_INFO_ENDPOINT, std::move(callback),
+                        &JSONParser::parsePersonalInfo, &ApiService::handlePersonalInfoResponse);
 }
 
-void ApiService::handlePersonalInfoResponse(const HTTPResponse& response, PersonalInfoCallback callback) {
+void ApiService::handlePersonalInfoResponse(const HTTPResponse& response, PersonalInfoCallback callback,
+                                         const CacheRefresh& refresh) {
     if (response.success) {
-        auto parseResult = JSONParser::parsePersonalInfo(response.data);
+        static const Metrics::EndpointMetrics& metrics = Metrics::endpoint(API_PERSONAL_INFO_ENDPOINT);
+        auto parseResult = measuredParse(metrics, [&response] { return JSONParser::parsePersonalInfo(response.data); });
         if (parseResult.has_value()) {
+            refresh.commit(response.data);
+            publishSnapshot(parseResult.value());
             ApiResult<PersonalInfo> result(std::move(parseResult.value()));
-            callback(result);
+            deliver(callback, std::move(result));
+            if (refresh.servedCached) {
+                ObserverSubject::notifyDataUpdated(refresh.model);
+            }
         } else {
             ApiError error{-1, "Failed to parse personal info", "JSON parsing error"};
             ApiResult<PersonalInfo> result(error);
-            callback(result);
+            deliver(callback, std::move(result));
         }
     } else {
         auto errorResult = createErrorResult<PersonalInfo>(response.errorMessage, response.statusCode);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
     }
 }
 
 void ApiService::getMarkbook(MarkbookCallback callback) {
+    const Tracing::Span span = Tracing::Span::start("api.markbook");
+    Tracing::ContextScope trace(span.context());
+    callback = traced(span, std::move(callback));
+    
     if (!isAuthenticated()) {
         auto errorResult = createErrorResult<Markbook>("User not authenticated", 401);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
         return;
     }
     
-    httpClient->get(API_MARKBOOK_ENDPOINT, 
-        [this, callback](const HTTPResponse& response) {
-            this->handleMarkbookResponse(response, callback);
-        });
+    fetchCached<Markbook>(CachedModel::Markbook, API_MARKBOOK_ENDPOINT, std::move(callback),
+                        &JSONParser::parseMarkbook, &ApiService::handleMarkbookResponse);
 }
 
-void ApiService::handleMarkbookResponse(const HTTPResponse& response, MarkbookCallback callback) {
+void ApiService::handleMarkbookResponse(const HTTPResponse& response, MarkbookCallback callback,
+                                         const CacheRefresh& refresh) {
     if (response.success) {
-        auto parseResult = JSONParser::parseMarkbook(response.data);
+        static const Metrics::EndpointMetrics& metrics = Metrics::endpoint(API_MARKBOOK_ENDPOINT);
+        auto parseResult = measuredParse(metrics, [&response] { return JSONParser::parseMarkbook(response.data); });
         if (parseResult.has_value()) {
+            refresh.commit(response.data);
+            publishSnapshot(parseResult.value());
             ApiResult<Markbook> result(std::move(parseResult.value()));
-            callback(result);
+            deliver(callback, std::move(result));
+            if (refresh.servedCached) {
+                ObserverSubject::notifyDataUpdated(refresh.model);
+            }
         } else {
             ApiError error{-1, "Failed to parse markbook", "JSON parsing error"};
             ApiResult<Markbook> result(error);
-            callback(result);
+            deliver(callback, std::move(result));
         }
     } else {
         auto errorResult = createErrorResult<Markbook>(response.errorMessage, response.statusCode);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
     }
 }
 
 void ApiService::getGroupInfo(GroupInfoCallback callback) {
+    const Tracing::Span span = Tracing::Span::start("api.groupInfo");
+    Tracing::ContextScope trace(span.context());
+    callback = traced(span, std::move(callback));
+    
     if (!isAuthenticated()) {
         auto errorResult = createErrorResult<GroupInfo>("User not authenticated", 401);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
         return;
     }
     
-    httpClient->get(API_GROUP_INFO_ENDPOINT, 
-        [this, callback](const HTTPResponse& response) {
-            this->handleGroupInfoResponse(response, callback);
-        });
+    fetchCached<GroupInfo>(CachedModel::GroupInfo, API_GROUP_INFO_ENDPOINT, std::move(callback),
+                        &JSONParser::parseGroupInfo, &ApiService::handleGroupInfoResponse);
 }
 
-void ApiService::handleGroupInfoResponse(const HTTPResponse& response, GroupInfoCallback callback) {
+void ApiService::handleGroupInfoResponse(const HTTPResponse& response, GroupInfoCallback callback,
+                                         const CacheRefresh& refresh) {
     if (response.success) {
-        auto parseResult = JSONParser::parseGroupInfo(response.data);
+        static const Metrics::EndpointMetrics& metrics = Metrics::endpoint(API_GROUP_INFO_ENDPOINT);
+        auto parseResult = measuredParse(metrics, [&response] { return JSONParser::parseGroupInfo(response.data); });
         if (parseResult.has_value()) {
+            refresh.commit(response.data);
+            publishSnapshot(parseResult.value());
             ApiResult<GroupInfo> result(std::move(parseResult.value()));
-            callback(result);
+            deliver(callback, std::move(result));
+            if (refresh.servedCached) {
+                ObserverSubject::notifyDataUpdated(refresh.model);
+            }
         } else {
             ApiError error{-1, "Failed to parse group info", "JSON parsing error"};
             ApiResult<GroupInfo> result(error);
-            callback(result);
+            deliver(callback, std::move(result));
         }
     } else {
         auto errorResult = createErrorResult<GroupInfo>(response.errorMessage, response.statusCode);
-        callback(errorResult);
+        deliver(callback, std::move(errorResult));
+    }
+}
+
+void ApiService::searchSkills(const std::string& name, SkillsCallback callback) {
+    const Tracing::Span span = Tracing::Span::start("api.skills");
+    Tracing::ContextScope trace(span.context());
+    callback = traced(span, std::move(callback));
+    
+    if (!isAuthenticated()) {
+        auto errorResult = createErrorResult<std::vector<std::string>>("User not authenticated", 401);
+        deliver(callback, std::move(errorResult));
+        return;
+    }
+    
+    const std::string endpoint = std::string(API_SKILL_ENDPOINT) + "?name=" + encodeQueryValue(name);
+    authorizedGet(endpoint, [this, callback](const HTTPResponse& response) {
+        schedule([this, response, callback] {
+            handleSkillsResponse(response, callback);
+        });
+    });
+}
+
+void ApiService::handleSkillsResponse(const HTTPResponse& response, SkillsCallback callback) {
+    if (response.success) {
+        static const Metrics::EndpointMetrics& metrics = Metrics::endpoint(API_SKILL_ENDPOINT);
+        auto parseResult = measuredParse(metrics, [&response] { return JSONParser::parseSkills(response.data); });
+        if (parseResult.has_value()) {
+            ApiResult<std::vector<std::string>> result(std::move(parseResult.value()));
+            deliver(callback, std::move(result));
+        } else {
+            ApiError error{-1, "Failed to parse skills", "JSON parsing error"};
+            ApiResult<std::vector<std::string>> result(error);
+            deliver(callback, std::move(result));
+        }
+    } else {
+        auto errorResult = createErrorResult<std::vector<std::string>>(response.errorMessage, response.statusCode);
+        deliver(callback, std::move(errorResult));
     }
 }
 
@@ -278,22 +731,628 @@ void ApiService::handleGroupInfoResponse(const HTTPResponse& response, GroupInfo
 // ========================================
 
 void ApiService::setTokens(const std::string& accessToken, const std::string& refreshToken) {
-    currentAccessToken = accessToken;
-    currentRefreshToken = refreshToken;
+    authState.update([&](const std::shared_ptr<const AuthState>& current) {
+        return std::make_shared<const AuthState>(
+            AuthState{accessToken, refreshToken, current ? current->account : std::string()});
+    });
 }
 
 std::string ApiService::getAccessToken() const {
-    return currentAccessToken;
+    auto state = authState.load();
+    return state ? state->accessToken : std::string();
 }
 
 std::string ApiService::getRefreshToken() const {
-    return currentRefreshToken;
+    auto state = authState.load();
+    return state ? state->refreshToken : std::string();
 }
 
 const IConfigProvider& ApiService::getConfig() const {
     return *configProvider;
 }
 
+// ========================================
+// Executor Configuration
+// ========================================
+
+void ApiService::setExecutors(ServiceExecutors stageExecutors) {
+    httpClient->setCompletionExecutor(stageExecutors.completion);
+    executors.store(std::make_shared<const ServiceExecutors>(std::move(stageExecutors)));
+}
+
+void ApiService::schedule(std::function<void()> work) {
+    auto stages = executors.load();
+    if (!stages || !stages->parsing) {
+        work();
+        return;
+    }
+    
+    // Runs inside HTTPClient's callback, where the request's span is current
+    const Tracing::SpanContext trace = Tracing::current();
+    if (!trace.isSampled()) {
+        stages->parsing->post(std::move(work));
+        return;
+    }
+    const uint64_t queued = Tracing::nowNanoseconds();
+    stages->parsing->post([trace, queued, work = std::move(work)] {
+        Tracing::recordSpan("api.parse.queue", trace, queued, Tracing::nowNanoseconds());
+        Tracing::ContextScope scope(trace);
+        work();
+    });
+}
+
+void ApiService::deliverCallback(const std::type_info& subject, std::function<void()> callback) {
+    auto stages = executors.load();
+    const Tracing::SpanContext trace = Tracing::current();
+    // type_info objects live for the whole program
+    auto run = [subject = &subject, trace, callback = std::move(callback)] {
+        Tracing::ScopedSpan span("api.callback", trace);
+        Watchdog::Scope watch(Watchdog::Category::Callback, "api.callback", *subject);
+        callback();
+    };
+    if (stages && stages->callbacks) {
+        stages->callbacks->post(std::move(run));
+    } else {
+        run();
+    }
+}
+
+template<typename T>
+void ApiService::deliver(const std::function<void(const ApiResult<T>&)>& callback, ApiResult<T> result,
+                         std::function<void()> then) {
+    auto stages = executors.load();
+    const Tracing::SpanContext trace = Tracing::current();
+    if (stages && stages->callbacks) {
+        const uint64_t queued = trace.isSampled() ? Tracing::nowNanoseconds() : 0;
+        stages->callbacks->post([callback, trace, queued, result = std::move(result), then = std::move(then)] {
+            if (queued != 0) {
+                Tracing::recordSpan("api.callback.queue", trace, queued, Tracing::nowNanoseconds());
+            }
+            {
+                Tracing::ScopedSpan span("api.callback", trace);
+                Watchdog::Scope watch(Watchdog::Category::Callback, "api.callback", typeid(T));
+                callback(result);
+            }
+            if (then) {
+                then();
+            }
+        });
+    } else {
+        {
+            Tracing::ScopedSpan span("api.callback", trace);
+            Watchdog::Scope watch(Watchdog::Category::Callback, "api.callback", typeid(T));
+            callback(result);
+        }
+        if (then) {
+            then();
+        }
+    }
+}
+
+// ========================================
+// Local Store
+// ========================================
+
+FreshnessPolicy defaultFreshnessPolicy(CachedModel model) {
+    using std::chrono::hours;
+    using std::chrono::minutes;
+    const auto staleness = std::chrono::duration_cast<std::chrono::seconds>(hours(24 * 90));
+    switch (model) {
+        case CachedModel::Markbook:
+            return {std::chrono::duration_cast<std::chrono::seconds>(minutes(10)), staleness};
+        case CachedModel::PersonalInfo:
+        case CachedModel::GroupInfo:
+        case CachedModel::Count:
+            break;
+    }
+    return {std::chrono::duration_cast<std::chrono::seconds>(hours(24)), staleness};
+}
+
+namespace {
+
+const char* cachedModelName(CachedModel model) {
+    switch (model) {
+        case CachedModel::PersonalInfo: return "personalInfo";
+        case CachedModel::Markbook:     return "markbook";
+        case CachedModel::GroupInfo:    return "groupInfo";
+        case CachedModel::Count:        break;
+    }
+    return "";
+}
+
+// Copy of the current settings, or defaults when caching was never configured
+template<typename Settings>
+std::shared_ptr<Settings> copyCacheSettings(const std::shared_ptr<const Settings>& current) {
+    if (current) {
+        return std::make_shared<Settings>(*current);
+    }
+    auto settings = std::make_shared<Settings>();
+    for (std::size_t i = 0; i < settings->policies.size(); ++i) {
+        settings->policies[i] = defaultFreshnessPolicy(static_cast<CachedModel>(i));
+    }
+    return settings;
+}
+
+} // namespace
+
+void ApiService::setLocalStore(std::shared_ptr<LocalStore> store) {
+    cacheSettings.update([&store](const std::shared_ptr<const CacheSettings>& current) {
+        auto next = copyCacheSettings(current);
+        next->store = store;
+        return std::shared_ptr<const CacheSettings>(std::move(next));
+    });
+}
+
+void ApiService::setFreshnessPolicy(CachedModel model, FreshnessPolicy policy) {
+    cacheSettings.update([model, policy](const std::shared_ptr<const CacheSettings>& current) {
+        auto next = copyCacheSettings(current);
+        next->policies[static_cast<std::size_t>(model)] = policy;
+        return std::shared_ptr<const CacheSettings>(std::move(next));
+    });
+}
+
+void ApiService::setRosterIndex(std::shared_ptr<RosterIndex> index) {
+    rosterIndex.store(std::move(index));
+}
+
+void ApiService::publishSnapshot(const PersonalInfo& info) {
+    if (auto index = rosterIndex.load()) {
+        index->indexPerson(info);
+    }
+}
+
+void ApiService::publishSnapshot(const Markbook& markbook) {
+    auto state = authState.load();
+    auto current = std::make_shared<const AccountSnapshot<Markbook>>(
+        AccountSnapshot<Markbook>{state ? state->account : std::string(), markbook});
+    auto previous = lastMarkbook.load();
+    while (!lastMarkbook.compareExchange(previous, current)) {
+    }
+    // Another account's markbook is no baseline: an expired session keeps
+    // its snapshot, and a different user may log in next
+    if (!previous || previous->account != current->account) {
+        return;
+    }
+    const MarkbookChangeSet changes = diffMarkbook(previous->model, current->model);
+    if (!changes.empty()) {
+        BSUIR_LOG_DEBUG(Api, "📝 Markbook changed: ", changes.changes.size(), " changes");
+        ObserverSubject::notifyMarkbookChanged(changes);
+    }
+}
+
+void ApiService::publishSnapshot(const GroupInfo& info) {
+    if (auto index = rosterIndex.load()) {
+        index->indexGroup(info);
+    }
+    auto state = authState.load();
+    auto current = std::make_shared<const AccountSnapshot<GroupInfo>>(
+        AccountSnapshot<GroupInfo>{state ? state->account : std::string(), info});
+    auto previous = lastGroupInfo.load();
+    while (!lastGroupInfo.compareExchange(previous, current)) {
+    }
+    if (!previous || previous->account != current->account) {
+        return;
+    }
+    const GroupChangeSet changes = diffGroupInfo(previous->model, current->model);
+    if (!changes.empty()) {
+        BSUIR_LOG_DEBUG(Api, "👥 Group roster changed: ", changes.changes.size(), " changes");
+        ObserverSubject::notifyGroupInfoChanged(changes);
+    }
+}
+
+// ========================================
+// Prefetch
+// ========================================
+
+PrefetchPolicy defaultPrefetchPolicy() {
+    PrefetchPolicy policy;
+    policy.models = {CachedModel::PersonalInfo, CachedModel::Markbook, CachedModel::GroupInfo};
+    return policy;
+}
+
+double PrefetchStats::hitRatio() const noexcept {
+    return issued ? static_cast<double>(hits) / static_cast<double>(issued) : 0.0;
+}
+
+double PrefetchStats::wasteRatio() const noexcept {
+    return issued ? static_cast<double>(wasted) / static_cast<double>(issued) : 0.0;
+}
+
+namespace {
+
+const char* cachedModelEndpoint(CachedModel model) {
+    switch (model) {
+        case CachedModel::PersonalInfo: return API_PERSONAL_INFO_ENDPOINT;
+        case CachedModel::Markbook:     return API_MARKBOOK_ENDPOINT;
+        case CachedModel::GroupInfo:    return API_GROUP_INFO_ENDPOINT;
+        case CachedModel::Count:        break;
+    }
+    return "";
+}
+
+enum class PrefetchOutcome { Issued, Hit, Served, Wasted, Failed, Throttled, Count };
+
+const char* prefetchOutcomeName(PrefetchOutcome outcome) {
+    switch (outcome) {
+        case PrefetchOutcome::Issued:    return "issued";
+        case PrefetchOutcome::Hit:       return "hit";
+        case PrefetchOutcome::Served:    return "served";
+        case PrefetchOutcome::Wasted:    return "wasted";
+        case PrefetchOutcome::Failed:    return "failed";
+        case PrefetchOutcome::Throttled: return "throttled";
+        case PrefetchOutcome::Count:     break;
+    }
+    return "";
+}
+
+void countPrefetch(CachedModel model, PrefetchOutcome outcome, uint64_t amount = 1) {
+    constexpr std::size_t MODELS = static_cast<std::size_t>(CachedModel::Count);
+    constexpr std::size_t OUTCOMES = static_cast<std::size_t>(PrefetchOutcome::Count);
+    // Resolved once: every registry lookup takes its lock
+    static const std::array<std::array<Metrics::Counter*, OUTCOMES>, MODELS> counters = [] {
+        std::array<std::array<Metrics::Counter*, OUTCOMES>, MODELS> table{};
+        for (std::size_t m = 0; m < MODELS; ++m) {
+            for (std::size_t o = 0; o < OUTCOMES; ++o) {
+                table[m][o] = &Metrics::MetricsRegistry::shared().counter(
+                    "bsuir_prefetch_total",
+                    {{"model", cachedModelName(static_cast<CachedModel>(m))},
+                     {"outcome", prefetchOutcomeName(static_cast<PrefetchOutcome>(o))}},
+                    "Background prefetches after login by outcome");
+            }
+        }
+        return table;
+    }();
+    counters[static_cast<std::size_t>(model)][static_cast<std::size_t>(outcome)]->add(amount);
+}
+
+} // namespace
+
+void ApiService::setPrefetchPolicy(PrefetchPolicy policy) {
+    prefetchPolicy.store(std::make_shared<const PrefetchPolicy>(std::move(policy)));
+}
+
+PrefetchStats ApiService::prefetchStats() const {
+    std::lock_guard<std::mutex> lock(prefetch->mutex);
+    PrefetchStats total;
+    for (const auto& stats : prefetch->stats) {
+        total.issued += stats.issued;
+        total.hits += stats.hits;
+        total.servedGetters += stats.servedGetters;
+        total.wasted += stats.wasted;
+        total.failed += stats.failed;
+        total.throttled += stats.throttled;
+    }
+    return total;
+}
+
+PrefetchStats ApiService::prefetchStats(CachedModel model) const {
+    std::lock_guard<std::mutex> lock(prefetch->mutex);
+    return prefetch->stats[static_cast<std::size_t>(model)];
+}
+
+void ApiService::startPrefetch(const std::string& account) {
+    auto policy = prefetchPolicy.load();
+    if (!policy || policy->models.empty()) {
+        return;
+    }
+    
+    bool switched;
+    {
+        std::lock_guard<std::mutex> lock(prefetch->mutex);
+        switched = !prefetch->lastAccount.empty() && prefetch->lastAccount != account;
+    }
+    if (switched) {
+        // Whatever was prefetched for the previous account is of no use now
+        discardPrefetched();
+    }
+    
+    std::vector<CachedModel> launch;
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(prefetch->mutex);
+        const auto now = std::chrono::steady_clock::now();
+        const bool repeated = account == prefetch->lastAccount && now - prefetch->lastRun < policy->minInterval;
+        prefetch->lastAccount = account;
+        prefetch->lastRun = now;
+        
+        for (CachedModel model : policy->models) {
+            PrefetchStats& stats = prefetch->stats[static_cast<std::size_t>(model)];
+            const bool unrewarding = stats.issued >= policy->learningSamples && stats.hitRatio() < policy->minHitRatio;
+            if (repeated || unrewarding) {
+                ++stats.throttled;
+                countPrefetch(model, PrefetchOutcome::Throttled);
+                continue;
+            }
+            const PrefetchSlot& slot = prefetch->slots[static_cast<std::size_t>(model)];
+            const bool queued = std::find(prefetch->queue.begin(), prefetch->queue.end(), model) != prefetch->queue.end();
+            if (slot.status == PrefetchSlot::Status::Empty && !queued) {
+                prefetch->queue.push_back(model);
+            }
+        }
+        launch = launchPrefetchesLocked(*policy);
+        generation = prefetch->generation;
+    }
+    if (!launch.empty()) {
+        BSUIR_LOG_DEBUG(Api, "🛰️ Prefetching ", launch.size(), " models for ", account);
+    }
+    for (CachedModel model : launch) {
+        sendPrefetch(model, generation);
+    }
+}
+
+std::vector<CachedModel> ApiService::launchPrefetchesLocked(const PrefetchPolicy& policy) {
+    std::vector<CachedModel> launch;
+    while (prefetch->inFlight < std::max<std::size_t>(policy.maxConcurrent, 1) && !prefetch->queue.empty()) {
+        const CachedModel model = prefetch->queue.front();
+        prefetch->queue.erase(prefetch->queue.begin());
+        PrefetchSlot& slot = prefetch->slots[static_cast<std::size_t>(model)];
+        if (slot.status != PrefetchSlot::Status::Empty) {
+            continue;
+        }
+        slot.status = PrefetchSlot::Status::InFlight;
+        slot.account = prefetch->lastAccount;
+        ++prefetch->inFlight;
+        ++prefetch->stats[static_cast<std::size_t>(model)].issued;
+        countPrefetch(model, PrefetchOutcome::Issued);
+        launch.push_back(model);
+    }
+    return launch;
+}
+
+void ApiService::sendPrefetch(CachedModel model, uint64_t generation) {
+    authorizedGet(cachedModelEndpoint(model), [this, model, generation](const HTTPResponse& response) {
+        finishPrefetch(model, generation, response);
+    });
+}
+
+void ApiService::finishPrefetch(CachedModel model, uint64_t generation, const HTTPResponse& response) {
+    std::vector<std::function<void(std::optional<HTTPResponse>)>> waiters;
+    std::vector<CachedModel> launch;
+    uint64_t current;
+    {
+        std::lock_guard<std::mutex> lock(prefetch->mutex);
+        --prefetch->inFlight;
+        current = prefetch->generation;
+        PrefetchStats& stats = prefetch->stats[static_cast<std::size_t>(model)];
+        PrefetchSlot& slot = prefetch->slots[static_cast<std::size_t>(model)];
+        if (generation != current) {
+            // Finished after logout; its slot already belongs to the new generation
+            ++stats.wasted;
+            countPrefetch(model, PrefetchOutcome::Wasted);
+        } else {
+            waiters.swap(slot.waiters);
+            if (!response.success) {
+                ++stats.failed;
+                countPrefetch(model, PrefetchOutcome::Failed);
+                slot = PrefetchSlot{};
+            } else if (!waiters.empty()) {
+                // Joined getters only count once they actually get the response; however
+                // many joined, this is one prefetch and so at most one hit
+                ++stats.hits;
+                stats.servedGetters += waiters.size();
+                countPrefetch(model, PrefetchOutcome::Hit);
+                countPrefetch(model, PrefetchOutcome::Served, waiters.size());
+                slot = PrefetchSlot{};
+            } else {
+                slot.status = PrefetchSlot::Status::Ready;
+                slot.response = response;
+                slot.fetchedAt = std::chrono::steady_clock::now();
+            }
+        }
+        if (auto policy = prefetchPolicy.load()) {
+            launch = launchPrefetchesLocked(*policy);
+        }
+    }
+    
+    // A failed prefetch sends its waiters to the network on their own
+    for (auto& waiter : waiters) {
+        waiter(response.success ? std::optional<HTTPResponse>(response) : std::nullopt);
+    }
+    // Freed capacity goes to the queue even when this prefetch was stale
+    for (CachedModel next : launch) {
+        sendPrefetch(next, current);
+    }
+}
+
+bool ApiService::takePrefetched(CachedModel model, std::function<void(std::optional<HTTPResponse>)> consumer) {
+    if (!prefetchPolicy.load()) {
+        return false;
+    }
+    auto state = authState.load();
+    const std::string account = state ? state->account : std::string();
+    
+    std::optional<HTTPResponse> response;
+    {
+        std::lock_guard<std::mutex> lock(prefetch->mutex);
+        PrefetchSlot& slot = prefetch->slots[static_cast<std::size_t>(model)];
+        PrefetchStats& stats = prefetch->stats[static_cast<std::size_t>(model)];
+        if (slot.status == PrefetchSlot::Status::Empty || slot.account != account) {
+            return false;
+        }
+        if (slot.status == PrefetchSlot::Status::InFlight) {
+            slot.waiters.push_back(std::move(consumer));
+            return true;
+        }
+        auto policy = prefetchPolicy.load();
+        if (std::chrono::steady_clock::now() - slot.fetchedAt > policy->ttl) {
+            ++stats.wasted;
+            countPrefetch(model, PrefetchOutcome::Wasted);
+            slot = PrefetchSlot{};
+            return false;
+        }
+        ++stats.hits;
+        ++stats.servedGetters;
+        countPrefetch(model, PrefetchOutcome::Hit);
+        countPrefetch(model, PrefetchOutcome::Served);
+        response = std::move(slot.response);
+        slot = PrefetchSlot{};
+    }
+    consumer(std::move(response));
+    return true;
+}
+
+void ApiService::discardPrefetched() {
+    std::vector<std::function<void(std::optional<HTTPResponse>)>> waiters;
+    {
+        std::lock_guard<std::mutex> lock(prefetch->mutex);
+        ++prefetch->generation;
+        prefetch->queue.clear();
+        prefetch->lastAccount.clear();
+        for (std::size_t i = 0; i < prefetch->slots.size(); ++i) {
+            PrefetchSlot& slot = prefetch->slots[i];
+            if (slot.status == PrefetchSlot::Status::Ready) {
+                ++prefetch->stats[i].wasted;
+                countPrefetch(static_cast<CachedModel>(i), PrefetchOutcome::Wasted);
+            }
+            for (auto& waiter : slot.waiters) {
+                waiters.push_back(std::move(waiter));
+            }
+            slot = PrefetchSlot{};
+        }
+    }
+    for (auto& waiter : waiters) {
+        waiter(std::nullopt);
+    }
+}
+
+template<typename T>
+void ApiService::fetchCached(CachedModel model, const char* endpoint,
+                             std::function<void(const ApiResult<T>&)> callback,
+                             std::optional<T> (*parse)(const std::string&),
+                             void (ApiService::*handle)(const HTTPResponse&, std::function<void(const ApiResult<T>&)>,
+                                                        const CacheRefresh&)) {
+    CacheRefresh refresh;
+    refresh.model = cachedModelName(model);
+    std::optional<StoredValue> stored;
+    bool fresh = false;
+    
+    auto request = [this, endpoint, callback, handle](CacheRefresh refresh) {
+        authorizedGet(endpoint, [this, callback, handle, refresh](const HTTPResponse& response) {
+            schedule([this, response, callback, handle, refresh] {
+                if (refresh.servedCached) {
+                    // The caller already has data: only a change is worth a second delivery
+                    if (!response.success) {
+                        BSUIR_LOG_INFO(Api, "📴 Refresh of ", refresh.model, " failed (", response.statusCode,
+                                       "), keeping cached data");
+                        return;
+                    }
+                    if (response.data == refresh.cachedBody) {
+                        refresh.commit(response.data);
+                        return;
+                    }
+                }
+                (this->*handle)(response, callback, refresh);
+            });
+        });
+    };
+    
+    auto settings = cacheSettings.load();
+    if (settings && settings->store) {
+        auto state = authState.load();
+        refresh.store = settings->store;
+        refresh.key = (state ? state->account : std::string()) + " " + endpoint;
+    }
+    
+    // A prefetched response is newer than anything in the store
+    const bool prefetched = takePrefetched(model, [this, callback, handle, request, refresh](std::optional<HTTPResponse> response) {
+        if (!response) {
+            request(refresh);
+            return;
+        }
+        schedule([this, response = std::move(*response), callback, handle, refresh] {
+            (this->*handle)(response, callback, refresh);
+        });
+    });
+    if (prefetched) {
+        return;
+    }
+    
+    if (refresh.store) {
+        const FreshnessPolicy& policy = settings->policies[static_cast<std::size_t>(model)];
+        const Metrics::EndpointMetrics& metrics = Metrics::endpoint(endpoint);
+        stored = refresh.store->get(refresh.key);
+        if (stored && stored->age() <= policy.maxStaleness) {
+            metrics.cacheHits->add();
+            fresh = stored->age() < policy.maxAge;
+        } else {
+            metrics.cacheMisses->add();
+            stored.reset();
+        }
+    }
+    
+    if (!stored) {
+        request(std::move(refresh));
+        return;
+    }
+    
+    schedule([this, parse, callback, request, refresh = std::move(refresh), stored = std::move(*stored), fresh]() mutable {
+        auto parsed = parse(stored.value);
+        if (!parsed.has_value()) {
+            BSUIR_LOG_WARNING(Storage, "⚠️ Cached ", refresh.model, " is unreadable, discarding it");
+            refresh.store->erase(refresh.key);
+            request(std::move(refresh));
+            return;
+        }
+        publishSnapshot(parsed.value());
+        ApiResult<T> result(std::move(parsed.value()));
+        result.cacheAge = stored.age();
+        if (fresh) {
+            deliver(callback, std::move(result));
+            return;
+        }
+        // Refresh only once the cached data is delivered: with a pool of
+        // callback threads the fresh result could otherwise arrive first
+        refresh.cachedBody = std::move(stored.value);
+        refresh.servedCached = true;
+        deliver(callback, std::move(result), [request, refresh = std::move(refresh)]() mutable {
+            request(std::move(refresh));
+        });
+    });
+}
+
+// ========================================
+// Coroutine API
+// ========================================
+
+void ApiService::setCoroutineExecutor(std::shared_ptr<IExecutor> executor) {
+    coroutineExecutor.store(std::move(executor));
+}
+
+Task<ApiResult<LoginResponse>> ApiService::loginAsync(std::string studentNumber,
+                                                      std::string password,
+                                                      CancellationToken token) {
+    // Named local: keeps the captured strings out of the co_await temporary,
+    // which some compilers relocate bitwise when building the frame
+    ApiOperation<LoginResponse> operation(
+        [this, studentNumber = std::move(studentNumber), password = std::move(password)](LoginCallback callback) {
+            login(studentNumber, password, std::move(callback));
+        },
+        coroutineExecutor.load(),
+        std::move(token));
+    co_return co_await operation;
+}
+
+Task<ApiResult<PersonalInfo>> ApiService::personalInfoAsync(CancellationToken token) {
+    co_return co_await ApiOperation<PersonalInfo>(
+        [this](PersonalInfoCallback callback) { getPersonalInfo(std::move(callback)); },
+        coroutineExecutor.load(),
+        std::move(token));
+}
+
+Task<ApiResult<Markbook>> ApiService::markbookAsync(CancellationToken token) {
+    co_return co_await ApiOperation<Markbook>(
+        [this](MarkbookCallback callback) { getMarkbook(std::move(callback)); },
+        coroutineExecutor.load(),
+        std::move(token));
+}
+
+Task<ApiResult<GroupInfo>> ApiService::groupInfoAsync(CancellationToken token) {
+    co_return co_await ApiOperation<GroupInfo>(
+        [this](GroupInfoCallback callback) { getGroupInfo(std::move(callback)); },
+        coroutineExecutor.load(),
+        std::move(token));
+}
+
 // ========================================
 // Template Helper Method
 // ========================================
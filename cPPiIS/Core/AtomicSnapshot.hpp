@@ -0,0 +1,121 @@
+//
+//  AtomicSnapshot.hpp
+//  cPPiIS Core C++ Atomic Shared Snapshot
+//
+//  Read-mostly state published as immutable snapshots through an
+//  atomically swapped shared_ptr
+//
+
+#ifndef AtomicSnapshot_hpp
+#define AtomicSnapshot_hpp
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+// libstdc++ 12 locks std::atomic<std::shared_ptr> with a bit of the
+// pointer itself, which ThreadSanitizer cannot see; its reports would
+// drown real races, so sanitized builds use the free functions
+#if defined(__SANITIZE_THREAD__)
+#define BSUIR_TSAN 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define BSUIR_TSAN 1
+#endif
+#endif
+
+namespace BSUIR {
+
+/**
+ * @brief Atomically replaceable pointer to an immutable value
+ *
+ * Readers take a shared_ptr copy and keep using it even if a writer
+ * publishes a newer value meanwhile; writers never mutate a published
+ * value in place. Uses std::atomic<std::shared_ptr> where the standard
+ * library provides it (outside ThreadSanitizer builds) and the
+ * shared_ptr atomic free functions otherwise.
+ *
+ * @tparam T Snapshot type (usually const-qualified)
+ */
+template<typename T>
+class AtomicSnapshot {
+private:
+#if defined(__cpp_lib_atomic_shared_ptr) && __cpp_lib_atomic_shared_ptr >= 201711L && !defined(BSUIR_TSAN)
+    std::atomic<std::shared_ptr<T>> value;
+
+public:
+    AtomicSnapshot() = default;
+    explicit AtomicSnapshot(std::shared_ptr<T> initial) : value(std::move(initial)) {}
+
+    std::shared_ptr<T> load() const noexcept {
+        return value.load(std::memory_order_acquire);
+    }
+
+    void store(std::shared_ptr<T> next) noexcept {
+        value.store(std::move(next), std::memory_order_release);
+    }
+
+    bool compareExchange(std::shared_ptr<T>& expected, std::shared_ptr<T> desired) noexcept {
+        return value.compare_exchange_strong(expected, std::move(desired),
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire);
+    }
+#else
+    std::shared_ptr<T> value;
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+public:
+    AtomicSnapshot() = default;
+    explicit AtomicSnapshot(std::shared_ptr<T> initial) : value(std::move(initial)) {}
+
+    std::shared_ptr<T> load() const noexcept {
+        return std::atomic_load_explicit(&value, std::memory_order_acquire);
+    }
+
+    void store(std::shared_ptr<T> next) noexcept {
+        std::atomic_store_explicit(&value, std::move(next), std::memory_order_release);
+    }
+
+    bool compareExchange(std::shared_ptr<T>& expected, std::shared_ptr<T> desired) noexcept {
+        return std::atomic_compare_exchange_strong_explicit(&value, &expected, std::move(desired),
+                                                            std::memory_order_acq_rel,
+                                                            std::memory_order_acquire);
+    }
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+    AtomicSnapshot(const AtomicSnapshot&) = delete;
+    AtomicSnapshot& operator=(const AtomicSnapshot&) = delete;
+
+    /**
+     * @brief Apply a copy-and-modify update, retrying on concurrent writes
+     * @param transform Callable receiving the current value (may be null) and
+     *               returning the replacement
+     */
+    template<typename Transform>
+    void update(Transform&& transform) {
+        std::shared_ptr<T> current = load();
+        for (;;) {
+            std::shared_ptr<T> next = transform(current);
+            if (compareExchange(current, std::move(next))) {
+                return;
+            }
+        }
+    }
+};
+
+} // namespace BSUIR
+
+#endif /* AtomicSnapshot_hpp */
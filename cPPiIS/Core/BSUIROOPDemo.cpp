@@ -4,6 +4,8 @@
 //
 
 #include "BSUIROOPDemo.hpp"
+#include "TimerWheel.hpp"
+#include <algorithm>
 #include <iostream>
 #include <mutex>
 
@@ -13,6 +15,204 @@ namespace BSUIR {
 std::unique_ptr<AppConfig> AppConfig::instance = nullptr;
 std::mutex AppConfig::mutex_;
 
+// ========================================
+// Реестр наблюдателей
+// ========================================
+
+namespace {
+
+// Регистрации, чьи обработчики выполняются в этом потоке (вложенные последними)
+std::vector<const void*>& dispatchingOnThisThread() {
+    thread_local std::vector<const void*> stack;
+    return stack;
+}
+
+// Поток для слитых уведомлений наблюдателей без исполнителя: поток
+// таймеров общий, и обработчики на нём задерживали бы чужие таймеры
+const std::shared_ptr<IExecutor>& trailingDeliveryExecutor() {
+    static auto* executor = new std::shared_ptr<IExecutor>(ExecutorFactory::createThreadPool(1));
+    return *executor;
+}
+
+} // namespace
+
+ObserverSubject::~ObserverSubject() {
+    std::lock_guard<std::mutex> lock(writersMutex);
+    for (const auto& registration : *observers.load()) {
+        retire(*registration);
+    }
+    observers.store(std::make_shared<const ObserverList>());
+}
+
+void ObserverSubject::addObserver(Observer* observer, ObserverDelivery delivery) {
+    auto registration = std::make_shared<Registration>();
+    registration->observer = observer;
+    registration->delivery = std::move(delivery);
+    
+    std::lock_guard<std::mutex> lock(writersMutex);
+    auto next = std::make_shared<ObserverList>(*observers.load());
+    next->push_back(std::move(registration));
+    observers.store(std::move(next));
+}
+
+void ObserverSubject::removeObserver(Observer* observer) {
+    ObserverList removed;
+    {
+        std::lock_guard<std::mutex> lock(writersMutex);
+        auto current = observers.load();
+        auto next = std::make_shared<ObserverList>();
+        next->reserve(current->size());
+        for (const auto& registration : *current) {
+            (registration->observer == observer ? removed : *next).push_back(registration);
+        }
+        if (removed.empty()) {
+            return;
+        }
+        observers.store(std::move(next));
+    }
+    // Ожидание вне блокировки: обработчики могут сами добавлять наблюдателей
+    for (const auto& registration : removed) {
+        retire(*registration);
+    }
+}
+
+void ObserverSubject::retire(Registration& registration) {
+    registration.active.store(false);
+    
+    // Период ожидания: старые снимки ещё могут вызывать наблюдателя в других
+    // потоках; собственные вызовы этого потока не завершатся раньше нас
+    const auto& stack = dispatchingOnThisThread();
+    const int own = static_cast<int>(std::count(stack.begin(), stack.end(), &registration));
+    for (int calls = registration.calls.load(); calls > own; calls = registration.calls.load()) {
+        registration.calls.wait(calls);
+    }
+}
+
+template<typename Call>
+void ObserverSubject::invoke(Registration& registration, const char* event, const Call& call) {
+    // Сначала объявить вызов, потом проверить флаг: retire() делает наоборот
+    struct CallGuard {
+        Registration& registration;
+        explicit CallGuard(Registration& target) : registration(target) {
+            registration.calls.fetch_add(1);
+        }
+        ~CallGuard() {
+            registration.calls.fetch_sub(1);
+            registration.calls.notify_all();
+        }
+    } guard(registration);
+    
+    if (!registration.active.load()) {
+        return;
+    }
+    auto& stack = dispatchingOnThisThread();
+    stack.push_back(&registration);
+    struct StackGuard {
+        std::vector<const void*>& stack;
+        ~StackGuard() { stack.pop_back(); }
+    } pop{stack};
+    
+    Watchdog::Scope watch(Watchdog::Category::Observer, event, typeid(*registration.observer));
+    call(*registration.observer);
+}
+
+template<typename Call>
+void ObserverSubject::deliver(const std::shared_ptr<Registration>& registration, const char* event, Call call) {
+    if (const auto& executor = registration->delivery.executor) {
+        executor->post([registration, event, call = std::move(call)] {
+            invoke(*registration, event, call);
+        });
+        return;
+    }
+    invoke(*registration, event, call);
+}
+
+template<typename Call>
+void ObserverSubject::dispatch(const char* event, const Call& call) {
+    auto snapshot = observers.load();
+    for (const auto& registration : *snapshot) {
+        deliver(registration, event, call);
+    }
+}
+
+bool ObserverSubject::openWindow(const std::shared_ptr<Registration>& registration, const std::string& dataType) {
+    {
+        std::lock_guard<std::mutex> lock(registration->windowsMutex);
+        auto [window, opened] = registration->windows.try_emplace(dataType, false);
+        if (!opened) {
+            // Сольётся в уведомление в конце окна
+            window->second = true;
+            return false;
+        }
+    }
+    scheduleWindowEnd(registration, dataType);
+    return true;
+}
+
+void ObserverSubject::scheduleWindowEnd(const std::shared_ptr<Registration>& registration,
+                                        const std::string& dataType) {
+    TimerWheel::shared()->schedule(registration->delivery.coalesceWindow, [registration, dataType] {
+        bool repeated = false;
+        {
+            std::lock_guard<std::mutex> lock(registration->windowsMutex);
+            auto window = registration->windows.find(dataType);
+            repeated = window->second && registration->active.load();
+            if (repeated) {
+                window->second = false;
+            } else {
+                registration->windows.erase(window);
+            }
+        }
+        if (repeated) {
+            // Уведомление в конце окна открывает следующее
+            const auto& executor = registration->delivery.executor
+                ? registration->delivery.executor
+                : trailingDeliveryExecutor();
+            executor->post([registration, dataType] {
+                invoke(*registration, "onDataUpdated", [&dataType](Observer& observer) {
+                    observer.onDataUpdated(dataType);
+                });
+            });
+            scheduleWindowEnd(registration, dataType);
+        }
+    });
+}
+
+void ObserverSubject::notifyUserLoggedIn(const AbstractUser* user) {
+    Profiler::Scope profile("observer.userLoggedIn", "observer");
+    dispatch("onUserLoggedIn", [user](Observer& observer) { observer.onUserLoggedIn(user); });
+}
+
+void ObserverSubject::notifyUserLoggedOut() {
+    Profiler::Scope profile("observer.userLoggedOut", "observer");
+    dispatch("onUserLoggedOut", [](Observer& observer) { observer.onUserLoggedOut(); });
+}
+
+void ObserverSubject::notifyDataUpdated(const std::string& dataType) {
+    Profiler::Scope profile("observer.dataUpdated", "observer");
+    auto snapshot = observers.load();
+    for (const auto& registration : *snapshot) {
+        if (registration->delivery.coalesceWindow.count() > 0 && !openWindow(registration, dataType)) {
+            continue;
+        }
+        deliver(registration, "onDataUpdated", [dataType](Observer& observer) {
+            observer.onDataUpdated(dataType);
+        });
+    }
+}
+
+void ObserverSubject::notifyMarkbookChanged(const MarkbookChangeSet& changes) {
+    Profiler::Scope profile("observer.markbookChanged", "observer");
+    auto shared = std::make_shared<const MarkbookChangeSet>(changes);
+    dispatch("onMarkbookChanged", [shared](Observer& observer) { observer.onMarkbookChanged(*shared); });
+}
+
+void ObserverSubject::notifyGroupInfoChanged(const GroupChangeSet& changes) {
+    Profiler::Scope profile("observer.groupInfoChanged", "observer");
+    auto shared = std::make_shared<const GroupChangeSet>(changes);
+    dispatch("onGroupInfoChanged", [shared](Observer& observer) { observer.onGroupInfoChanged(*shared); });
+}
+
 /**
  * Демонстрационный класс Observer
  */
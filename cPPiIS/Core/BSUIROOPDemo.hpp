@@ -19,6 +19,16 @@
 #include <functional>
 #include <iostream>
 #include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include "AtomicSnapshot.hpp"
+#include "Executor.hpp"
+#include "Log.hpp"
+#include "ModelDiff.hpp"
+#include "Profiler.hpp"
+#include "Watchdog.hpp"
 
 /**
  * @namespace BSUIR
@@ -98,14 +108,14 @@ public:
     // Template Method - общий алгоритм для всех API запросов
     virtual bool makeRequest() final {
         if (!validateRequest()) {
-            std::cout << "Request validation failed" << std::endl;
+            BSUIR_LOG_WARNING(Api, "Request validation failed");
             return false;
         }
         
         logRequest();
         
         std::string endpoint = buildEndpoint();
-        std::cout << "Making request to: " << endpoint << std::endl;
+        BSUIR_LOG_DEBUG(Api, "Making request to: ", endpoint);
         
         return executeRequest(endpoint);
     }
@@ -441,42 +451,78 @@ public:
     virtual void onUserLoggedIn(const AbstractUser* user) = 0;
     virtual void onUserLoggedOut() = 0;
     virtual void onDataUpdated(const std::string& dataType) = 0;
+    
+    // Дельты после повторной загрузки; по умолчанию игнорируются
+    virtual void onMarkbookChanged(const MarkbookChangeSet& /*changes*/) {}
+    virtual void onGroupInfoChanged(const GroupChangeSet& /*changes*/) {}
+};
+
+/**
+ * Доставка уведомлений одному наблюдателю
+ */
+struct ObserverDelivery {
+    std::shared_ptr<IExecutor> executor;            ///< Исполнитель доставки (пусто: поток уведомителя)
+    std::chrono::milliseconds coalesceWindow{0};    ///< Окно слияния onDataUpdated (0: без слияния)
 };
 
+/**
+ * Реестр наблюдателей в стиле RCU:
+ * уведомления читают неизменяемый снимок без блокировок, а
+ * добавление/удаление публикуют новый снимок. removeObserver()
+ * возвращается, когда ни один другой поток уже не вызывает этого
+ * наблюдателя (отписаться из собственного обработчика можно), так что
+ * после него наблюдатель можно уничтожать. Два наблюдателя не должны
+ * одновременно отписывать друг друга из своих обработчиков.
+ *
+ * Наблюдателю с исполнителем уведомления доставляются задачами на нём:
+ * изменения копируются один раз на уведомление, указатель user должен
+ * пережить доставку. С окном слияния первое onDataUpdated(type)
+ * приходит сразу, а повторы того же type внутри окна сливаются в одно
+ * уведомление в его конце (на исполнителе наблюдателя, без него — на
+ * отдельном потоке доставки, а не на потоке таймеров).
+ */
 class ObserverSubject {
 private:
-    std::vector<Observer*> observers;
+    struct Registration {
+        Observer* observer = nullptr;
+        ObserverDelivery delivery;
+        std::atomic<bool> active{true};
+        std::atomic<int> calls{0};                  ///< Вызовы, идущие сейчас
+        std::mutex windowsMutex;
+        std::unordered_map<std::string, bool> windows;  ///< Открытые окна: type -> были повторы
+    };
+    using ObserverList = std::vector<std::shared_ptr<Registration>>;
     
-public:
-    void addObserver(Observer* observer) {
-        observers.push_back(observer);
-    }
+    AtomicSnapshot<const ObserverList> observers{std::make_shared<const ObserverList>()};
+    std::mutex writersMutex;
     
-    void removeObserver(Observer* observer) {
-        observers.erase(
-            std::remove(observers.begin(), observers.end(), observer),
-            observers.end()
-        );
-    }
+    template<typename Call>
+    static void invoke(Registration& registration, const char* event, const Call& call);
+    template<typename Call>
+    static void deliver(const std::shared_ptr<Registration>& registration, const char* event, Call call);
+    template<typename Call>
+    void dispatch(const char* event, const Call& call);
     
-protected:
-    void notifyUserLoggedIn(const AbstractUser* user) {
-        for (auto* observer : observers) {
-            observer->onUserLoggedIn(user);
-        }
-    }
+    static bool openWindow(const std::shared_ptr<Registration>& registration, const std::string& dataType);
+    static void scheduleWindowEnd(const std::shared_ptr<Registration>& registration, const std::string& dataType);
+    static void retire(Registration& registration);
     
-    void notifyUserLoggedOut() {
-        for (auto* observer : observers) {
-            observer->onUserLoggedOut();
-        }
-    }
+public:
+    ObserverSubject() = default;
+    ~ObserverSubject();
     
-    void notifyDataUpdated(const std::string& dataType) {
-        for (auto* observer : observers) {
-            observer->onDataUpdated(dataType);
-        }
-    }
+    ObserverSubject(const ObserverSubject&) = delete;
+    ObserverSubject& operator=(const ObserverSubject&) = delete;
+    
+    void addObserver(Observer* observer, ObserverDelivery delivery = {});
+    void removeObserver(Observer* observer);
+    
+protected:
+    void notifyUserLoggedIn(const AbstractUser* user);
+    void notifyUserLoggedOut();
+    void notifyDataUpdated(const std::string& dataType);
+    void notifyMarkbookChanged(const MarkbookChangeSet& changes);
+    void notifyGroupInfoChanged(const GroupChangeSet& changes);
 };
 
 /**
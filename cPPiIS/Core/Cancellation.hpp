@@ -0,0 +1,140 @@
+//
+//  Cancellation.hpp
+//  cPPiIS Core C++ Cooperative Cancellation
+//
+//  Cancellation source/token pair used by awaitable API operations
+//
+
+#ifndef Cancellation_hpp
+#define Cancellation_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief Shared state between a CancellationSource and its tokens
+ */
+class CancellationState {
+private:
+    std::atomic<bool> cancelled{false};
+    std::mutex mutex;
+    std::vector<std::pair<uint64_t, std::function<void()>>> callbacks;
+    uint64_t nextCallbackId = 1;
+
+public:
+    bool isCancelled() const noexcept {
+        return cancelled.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Register a callback invoked once on cancellation
+     * @param callback Callback to invoke
+     * @return Registration id, or 0 if the callback already ran inline
+     */
+    uint64_t registerCallback(std::function<void()> callback) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!isCancelled()) {
+                uint64_t id = nextCallbackId++;
+                callbacks.emplace_back(id, std::move(callback));
+                return id;
+            }
+        }
+        callback();
+        return 0;
+    }
+
+    void unregisterCallback(uint64_t id) {
+        if (id == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = callbacks.begin(); it != callbacks.end(); ++it) {
+            if (it->first == id) {
+                callbacks.erase(it);
+                return;
+            }
+        }
+    }
+
+    void cancel() {
+        std::vector<std::pair<uint64_t, std::function<void()>>> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (cancelled.exchange(true, std::memory_order_acq_rel)) {
+                return;
+            }
+            pending.swap(callbacks);
+        }
+        for (auto& entry : pending) {
+            entry.second();
+        }
+    }
+};
+
+/**
+ * @brief Read-only view of a cancellation request
+ *
+ * A default-constructed token can never be cancelled.
+ */
+class CancellationToken {
+private:
+    std::shared_ptr<CancellationState> state;
+
+public:
+    CancellationToken() = default;
+    explicit CancellationToken(std::shared_ptr<CancellationState> sharedState)
+        : state(std::move(sharedState)) {}
+
+    bool canBeCancelled() const noexcept {
+        return state != nullptr;
+    }
+
+    bool isCancellationRequested() const noexcept {
+        return state && state->isCancelled();
+    }
+
+    uint64_t registerCallback(std::function<void()> callback) const {
+        return state ? state->registerCallback(std::move(callback)) : 0;
+    }
+
+    void unregisterCallback(uint64_t id) const {
+        if (state) {
+            state->unregisterCallback(id);
+        }
+    }
+};
+
+/**
+ * @brief Owner side of a cancellation request
+ */
+class CancellationSource {
+private:
+    std::shared_ptr<CancellationState> state;
+
+public:
+    CancellationSource() : state(std::make_shared<CancellationState>()) {}
+
+    CancellationToken token() const {
+        return CancellationToken(state);
+    }
+
+    void cancel() {
+        state->cancel();
+    }
+
+    bool isCancellationRequested() const noexcept {
+        return state->isCancelled();
+    }
+};
+
+} // namespace BSUIR
+
+#endif /* Cancellation_hpp */
@@ -0,0 +1,612 @@
+//
+//  CookieJar.cpp
+//  cPPiIS Core C++ Cookie Jar Implementation
+//
+
+#include "CookieJar.hpp"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+namespace BSUIR {
+
+namespace {
+
+constexpr const char* SERIALIZATION_HEADER = "bsuir-cookies/1";
+constexpr std::size_t MAX_COOKIES_PER_DOMAIN = 50;
+constexpr std::size_t MAX_COOKIES = 3000;
+
+// Expiry standing for "already expired" (0 means a session cookie)
+constexpr int64_t EXPIRED = 1;
+
+/**
+ * @brief The parts of a request URL cookies are matched against
+ */
+struct CookieUrl {
+    std::string host;
+    std::string path = "/";
+    bool secure = false;
+};
+
+std::string lowercase(std::string text) {
+    for (char& c : text) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return text;
+}
+
+std::string trim(const std::string& text) {
+    const std::size_t begin = text.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return {};
+    }
+    return text.substr(begin, text.find_last_not_of(" \t") - begin + 1);
+}
+
+bool hasControl(const std::string& text) {
+    return std::any_of(text.begin(), text.end(), [](char c) {
+        const auto byte = static_cast<unsigned char>(c);
+        return byte < 0x20 || byte == 0x7F;
+    });
+}
+
+bool parseUrl(const std::string& url, CookieUrl& parsed) {
+    const std::size_t scheme = url.find("://");
+    if (scheme == std::string::npos) {
+        return false;
+    }
+    parsed.secure = lowercase(url.substr(0, scheme)) == "https";
+
+    const std::size_t authorityStart = scheme + 3;
+    const std::size_t authorityEnd = url.find_first_of("/?#", authorityStart);
+    std::string authority = url.substr(authorityStart, authorityEnd == std::string::npos
+                                                           ? std::string::npos : authorityEnd - authorityStart);
+    const std::size_t at = authority.rfind('@');
+    if (at != std::string::npos) {
+        authority.erase(0, at + 1);
+    }
+    if (!authority.empty() && authority.front() == '[') {
+        parsed.host = authority.substr(1, authority.find(']') - 1);
+    } else {
+        parsed.host = authority.substr(0, authority.find(':'));
+    }
+    parsed.host = lowercase(parsed.host);
+    if (!parsed.host.empty() && parsed.host.back() == '.') {
+        parsed.host.pop_back();
+    }
+
+    parsed.path = "/";
+    if (authorityEnd != std::string::npos && url[authorityEnd] == '/') {
+        const std::size_t pathEnd = url.find_first_of("?#", authorityEnd);
+        parsed.path = url.substr(authorityEnd, pathEnd == std::string::npos ? std::string::npos : pathEnd - authorityEnd);
+    }
+    return !parsed.host.empty();
+}
+
+bool isIpAddress(const std::string& host) {
+    return host.find(':') != std::string::npos ||
+           std::all_of(host.begin(), host.end(), [](char c) { return c == '.' || std::isdigit(static_cast<unsigned char>(c)); });
+}
+
+// RFC 6265 section 5.1.3
+bool domainMatch(const std::string& host, const std::string& domain) {
+    if (host == domain) {
+        return true;
+    }
+    return host.size() > domain.size() &&
+           host.compare(host.size() - domain.size(), domain.size(), domain) == 0 &&
+           host[host.size() - domain.size() - 1] == '.' && !isIpAddress(host);
+}
+
+// RFC 6265 section 5.1.4
+std::string defaultPath(const std::string& path) {
+    if (path.empty() || path.front() != '/') {
+        return "/";
+    }
+    const std::size_t last = path.rfind('/');
+    return last == 0 ? "/" : path.substr(0, last);
+}
+
+bool pathMatch(const std::string& requestPath, const std::string& cookiePath) {
+    if (requestPath.compare(0, cookiePath.size(), cookiePath) != 0) {
+        return false;
+    }
+    return requestPath.size() == cookiePath.size() || cookiePath.back() == '/' ||
+           requestPath[cookiePath.size()] == '/';
+}
+
+int64_t unixSeconds(CookieJar::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+bool isExpired(const Cookie& cookie, int64_t now) {
+    return cookie.expires != 0 && cookie.expires <= now;
+}
+
+// Between minimum and maximum digits at position, not followed by another digit
+bool readDigits(const std::string& token, std::size_t& position, int minimum, int maximum, int& value) {
+    int digits = 0;
+    value = 0;
+    while (position < token.size() && std::isdigit(static_cast<unsigned char>(token[position]))) {
+        if (++digits > maximum) {
+            return false;
+        }
+        value = value * 10 + (token[position++] - '0');
+    }
+    return digits >= minimum;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date
+int64_t daysFromCivil(int64_t year, int month, int day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+int daysInMonth(int year, int month) {
+    static const int DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : DAYS[month - 1];
+}
+
+std::vector<std::string> splitTabs(const std::string& line) {
+    std::vector<std::string> fields;
+    std::size_t start = 0;
+    for (;;) {
+        const std::size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+        if (tab == std::string::npos) {
+            return fields;
+        }
+        start = tab + 1;
+    }
+}
+
+} // namespace
+
+// ========================================
+// Cookie Dates
+// ========================================
+
+bool CookieJar::parseCookieDate(const std::string& text, int64_t& seconds) {
+    static const char* const MONTHS[] = {"jan", "feb", "mar", "apr", "may", "jun",
+                                         "jul", "aug", "sep", "oct", "nov", "dec"};
+    auto isDelimiter = [](unsigned char c) {
+        return c == 0x09 || (c >= 0x20 && c <= 0x2F) || (c >= 0x3B && c <= 0x40) ||
+               (c >= 0x5B && c <= 0x60) || (c >= 0x7B && c <= 0x7E);
+    };
+
+    bool foundTime = false, foundDay = false, foundMonth = false, foundYear = false;
+    int hour = 0, minute = 0, second = 0, day = 0, month = 0, year = 0;
+
+    // RFC 6265 section 5.1.1: each token is tried as time, day, month, year
+    std::size_t position = 0;
+    while (position < text.size()) {
+        while (position < text.size() && isDelimiter(static_cast<unsigned char>(text[position]))) {
+            ++position;
+        }
+        const std::size_t end = std::find_if(text.begin() + static_cast<std::ptrdiff_t>(position), text.end(),
+                                             [&](char c) { return isDelimiter(static_cast<unsigned char>(c)); }) -
+                                text.begin();
+        const std::string token = text.substr(position, end - position);
+        position = end;
+        if (token.empty()) {
+            continue;
+        }
+
+        std::size_t at = 0;
+        int h, m, s;
+        if (!foundTime && readDigits(token, at, 1, 2, h) && at < token.size() && token[at++] == ':' &&
+            readDigits(token, at, 1, 2, m) && at < token.size() && token[at++] == ':' &&
+            readDigits(token, at, 1, 2, s)) {
+            foundTime = true;
+            hour = h;
+            minute = m;
+            second = s;
+            continue;
+        }
+        at = 0;
+        if (!foundDay && readDigits(token, at, 1, 2, day)) {
+            foundDay = true;
+            continue;
+        }
+        if (!foundMonth && token.size() >= 3) {
+            const std::string prefix = lowercase(token.substr(0, 3));
+            for (int index = 0; index < 12; ++index) {
+                if (prefix == MONTHS[index]) {
+                    month = index + 1;
+                    foundMonth = true;
+                    break;
+                }
+            }
+            if (foundMonth) {
+                continue;
+            }
+        }
+        at = 0;
+        if (!foundYear && readDigits(token, at, 2, 4, year)) {
+            foundYear = true;
+        }
+    }
+
+    if (!foundTime || !foundDay || !foundMonth || !foundYear) {
+        return false;
+    }
+    if (year >= 70 && year <= 99) {
+        year += 1900;
+    } else if (year >= 0 && year <= 69) {
+        year += 2000;
+    }
+    if (year < 1601 || day < 1 || day > daysInMonth(year, month) || hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+    seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+// ========================================
+// Storing Cookies
+// ========================================
+
+bool CookieJar::setCookie(const std::string& url, const std::string& setCookie, Clock::time_point now) {
+    CookieUrl request;
+    if (!parseUrl(url, request)) {
+        return false;
+    }
+    const int64_t time = unixSeconds(now);
+
+    // RFC 6265 section 5.2: name=value, then attributes; unknown ones are ignored
+    std::size_t separator = setCookie.find(';');
+    const std::string pair = setCookie.substr(0, separator);
+    const std::size_t equals = pair.find('=');
+    if (equals == std::string::npos) {
+        return false;
+    }
+    Cookie cookie;
+    cookie.name = trim(pair.substr(0, equals));
+    cookie.value = trim(pair.substr(equals + 1));
+    if (cookie.name.empty() || hasControl(cookie.name) || hasControl(cookie.value)) {
+        return false;
+    }
+
+    bool hasMaxAge = false, hasExpires = false;
+    int64_t maxAgeExpiry = 0, expiresAt = 0;
+    std::string domain, path;
+    while (separator != std::string::npos) {
+        const std::size_t next = setCookie.find(';', separator + 1);
+        const std::string attribute = setCookie.substr(separator + 1, next == std::string::npos
+                                                                          ? std::string::npos : next - separator - 1);
+        separator = next;
+        const std::size_t assign = attribute.find('=');
+        const std::string name = lowercase(trim(attribute.substr(0, assign)));
+        const std::string value = assign == std::string::npos ? std::string() : trim(attribute.substr(assign + 1));
+
+        if (name == "expires") {
+            int64_t date = 0;
+            if (parseCookieDate(value, date)) {
+                hasExpires = true;
+                expiresAt = std::max(date, EXPIRED);
+            }
+        } else if (name == "max-age") {
+            const bool negative = !value.empty() && value.front() == '-';
+            const std::string digits = negative ? value.substr(1) : value;
+            if (digits.empty() || !std::all_of(digits.begin(), digits.end(),
+                                               [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+                continue;
+            }
+            // Saturate rather than overflow on absurd lifetimes
+            int64_t delta = 0;
+            for (char c : digits) {
+                delta = std::min<int64_t>(delta * 10 + (c - '0'), int64_t{1} << 40);
+            }
+            hasMaxAge = true;
+            maxAgeExpiry = negative || delta == 0 ? EXPIRED : time + delta;
+        } else if (name == "domain") {
+            if (!value.empty()) {
+                domain = lowercase(value.front() == '.' ? value.substr(1) : value);
+            }
+        } else if (name == "path") {
+            path = !value.empty() && value.front() == '/' && !hasControl(value) ? value : std::string();
+        } else if (name == "secure") {
+            cookie.secure = true;
+        } else if (name == "httponly") {
+            cookie.httpOnly = true;
+        }
+    }
+
+    cookie.expires = hasMaxAge ? maxAgeExpiry : hasExpires ? expiresAt : 0;
+
+    // RFC 6265 section 5.3
+    if (domain.empty()) {
+        cookie.domain = request.host;
+    } else if (domain.find('.') == std::string::npos) {
+        // Possibly a public suffix: only ever for that very host
+        if (domain != request.host) {
+            return false;
+        }
+        cookie.domain = request.host;
+    } else if (domainMatch(request.host, domain)) {
+        cookie.domain = domain;
+        cookie.hostOnly = false;
+    } else {
+        return false;
+    }
+    cookie.path = path.empty() ? defaultPath(request.path) : path;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    insert(std::move(cookie), time);
+    return true;
+}
+
+void CookieJar::restoreCookies(const std::string& url, const std::string& header) {
+    CookieUrl request;
+    if (!parseUrl(url, request)) {
+        return;
+    }
+    const int64_t time = unixSeconds(Clock::now());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t start = 0;
+    while (start < header.size()) {
+        std::size_t end = header.find(';', start);
+        if (end == std::string::npos) {
+            end = header.size();
+        }
+        const std::string pair = header.substr(start, end - start);
+        start = end + 1;
+
+        const std::size_t equals = pair.find('=');
+        if (equals == std::string::npos) {
+            continue;
+        }
+        Cookie cookie;
+        cookie.name = trim(pair.substr(0, equals));
+        cookie.value = trim(pair.substr(equals + 1));
+        if (cookie.name.empty() || hasControl(cookie.name) || hasControl(cookie.value)) {
+            continue;
+        }
+        // Session cookies again: they must not outlive the restored session
+        cookie.domain = request.host;
+        cookie.secure = request.secure;
+        insert(std::move(cookie), time);
+    }
+}
+
+void CookieJar::insert(Cookie cookie, int64_t now) {
+    const std::string domain = cookie.domain;
+    std::vector<Entry>& bucket = domains[domain];
+
+    uint64_t created = nextSequence++;
+    auto existing = std::find_if(bucket.begin(), bucket.end(), [&](const Entry& entry) {
+        return entry.cookie.name == cookie.name && entry.cookie.path == cookie.path;
+    });
+    if (existing != bucket.end()) {
+        // A replacement keeps its place in the sending order
+        created = existing->created;
+        bucket.erase(existing);
+        --count;
+    }
+
+    if (isExpired(cookie, now)) {
+        // Setting an expired cookie is how servers delete one
+        if (bucket.empty()) {
+            domains.erase(domain);
+        }
+        return;
+    }
+    bucket.push_back(Entry{std::move(cookie), created, ++accessSequence});
+    ++count;
+    evict(domain, now);
+}
+
+void CookieJar::evict(const std::string& domain, int64_t now) {
+    auto leastRecent = [](const Entry& a, const Entry& b) { return a.lastAccess < b.lastAccess; };
+
+    std::vector<Entry>& bucket = domains[domain];
+    if (bucket.size() > MAX_COOKIES_PER_DOMAIN) {
+        const std::size_t before = bucket.size();
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                    [now](const Entry& entry) { return isExpired(entry.cookie, now); }),
+                     bucket.end());
+        count -= before - bucket.size();
+        while (bucket.size() > MAX_COOKIES_PER_DOMAIN) {
+            bucket.erase(std::min_element(bucket.begin(), bucket.end(), leastRecent));
+            --count;
+        }
+    }
+
+    if (count > MAX_COOKIES) {
+        dropExpired(now);
+    }
+    while (count > MAX_COOKIES) {
+        // Rare enough for a scan of the whole jar
+        std::vector<Entry>* oldestBucket = nullptr;
+        std::vector<Entry>::iterator oldest;
+        for (auto& [name, entries] : domains) {
+            if (entries.empty()) {
+                continue;
+            }
+            auto candidate = std::min_element(entries.begin(), entries.end(), leastRecent);
+            if (!oldestBucket || candidate->lastAccess < oldest->lastAccess) {
+                oldestBucket = &entries;
+                oldest = candidate;
+            }
+        }
+        oldestBucket->erase(oldest);
+        --count;
+    }
+}
+
+std::size_t CookieJar::dropExpired(int64_t now) {
+    std::size_t removed = 0;
+    for (auto it = domains.begin(); it != domains.end();) {
+        std::vector<Entry>& bucket = it->second;
+        const std::size_t before = bucket.size();
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                    [now](const Entry& entry) { return isExpired(entry.cookie, now); }),
+                     bucket.end());
+        removed += before - bucket.size();
+        it = bucket.empty() ? domains.erase(it) : std::next(it);
+    }
+    count -= removed;
+    return removed;
+}
+
+// ========================================
+// Sending Cookies
+// ========================================
+
+std::vector<Cookie> CookieJar::cookies(const std::string& url, Clock::time_point now) const {
+    CookieUrl request;
+    if (!parseUrl(url, request)) {
+        return {};
+    }
+    const int64_t time = unixSeconds(now);
+
+    std::vector<const Entry*> matches;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto collect = [&](const std::string& domain, bool exactHost) {
+        auto bucket = domains.find(domain);
+        if (bucket == domains.end()) {
+            return;
+        }
+        for (const Entry& entry : bucket->second) {
+            const Cookie& cookie = entry.cookie;
+            if ((cookie.hostOnly && !exactHost) || isExpired(cookie, time) ||
+                (cookie.secure && !request.secure) || !pathMatch(request.path, cookie.path)) {
+                continue;
+            }
+            matches.push_back(&entry);
+        }
+    };
+
+    // One hash lookup per label: a.b.example.com, b.example.com, example.com, com
+    collect(request.host, true);
+    if (!isIpAddress(request.host)) {
+        for (std::size_t dot = request.host.find('.'); dot != std::string::npos;
+             dot = request.host.find('.', dot + 1)) {
+            collect(request.host.substr(dot + 1), false);
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const Entry* a, const Entry* b) {
+        if (a->cookie.path.size() != b->cookie.path.size()) {
+            return a->cookie.path.size() > b->cookie.path.size();
+        }
+        return a->created < b->created;
+    });
+
+    std::vector<Cookie> result;
+    result.reserve(matches.size());
+    for (const Entry* entry : matches) {
+        entry->lastAccess = ++accessSequence;
+        result.push_back(entry->cookie);
+    }
+    return result;
+}
+
+std::string CookieJar::cookieHeader(const std::string& url, Clock::time_point now) const {
+    std::string header;
+    for (const Cookie& cookie : cookies(url, now)) {
+        if (!header.empty()) header += "; ";
+        header += cookie.name + "=" + cookie.value;
+    }
+    return header;
+}
+
+// ========================================
+// Maintenance
+// ========================================
+
+std::size_t CookieJar::removeExpired(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dropExpired(unixSeconds(now));
+}
+
+void CookieJar::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    domains.clear();
+    count = 0;
+}
+
+std::size_t CookieJar::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+// ========================================
+// Persistence
+// ========================================
+
+std::string CookieJar::serialize(Clock::time_point now) const {
+    const int64_t time = unixSeconds(now);
+    std::vector<const Entry*> entries;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [domain, bucket] : domains) {
+        for (const Entry& entry : bucket) {
+            if (!isExpired(entry.cookie, time)) {
+                entries.push_back(&entry);
+            }
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b) { return a->created < b->created; });
+
+    // Tab-separated: no stored field can contain a control character
+    std::ostringstream text;
+    text << SERIALIZATION_HEADER << '\n';
+    for (const Entry* entry : entries) {
+        const Cookie& cookie = entry->cookie;
+        text << cookie.domain << '\t' << (cookie.hostOnly ? 1 : 0) << '\t' << cookie.path << '\t'
+             << (cookie.secure ? 1 : 0) << '\t' << (cookie.httpOnly ? 1 : 0) << '\t' << cookie.expires << '\t'
+             << cookie.name << '\t' << cookie.value << '\n';
+    }
+    return text.str();
+}
+
+bool CookieJar::restore(const std::string& text, Clock::time_point now) {
+    std::istringstream input(text);
+    std::string line;
+    if (!std::getline(input, line) || line != SERIALIZATION_HEADER) {
+        return false;
+    }
+
+    auto isFlag = [](const std::string& field) { return field == "0" || field == "1"; };
+    std::vector<Cookie> restored;
+    while (std::getline(input, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        const std::vector<std::string> fields = splitTabs(line);
+        if (fields.size() != 8 || fields[0].empty() || fields[2].empty() || fields[2].front() != '/' ||
+            !isFlag(fields[1]) || !isFlag(fields[3]) || !isFlag(fields[4]) || fields[6].empty()) {
+            return false;
+        }
+        Cookie cookie;
+        cookie.domain = fields[0];
+        cookie.hostOnly = fields[1] == "1";
+        cookie.path = fields[2];
+        cookie.secure = fields[3] == "1";
+        cookie.httpOnly = fields[4] == "1";
+        std::istringstream expires(fields[5]);
+        if (!(expires >> cookie.expires) || !expires.eof() || cookie.expires < 0) {
+            return false;
+        }
+        cookie.name = fields[6];
+        cookie.value = fields[7];
+        restored.push_back(std::move(cookie));
+    }
+
+    const int64_t time = unixSeconds(now);
+    std::lock_guard<std::mutex> lock(mutex);
+    domains.clear();
+    count = 0;
+    for (Cookie& cookie : restored) {
+        insert(std::move(cookie), time);
+    }
+    return true;
+}
+
+} // namespace BSUIR
@@ -0,0 +1,139 @@
+//
+//  CookieJar.hpp
+//  cPPiIS Core C++ Cookie Jar
+//
+//  Per-session RFC 6265 cookie store, so one process (and one transport)
+//  can hold any number of signed-in sessions independently of Foundation
+//
+
+#ifndef CookieJar_hpp
+#define CookieJar_hpp
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief One stored cookie
+ */
+struct Cookie {
+    std::string name;
+    std::string value;
+    std::string domain;                 ///< Lower case, no leading dot
+    std::string path = "/";
+    int64_t expires = 0;                ///< Unix seconds; 0 for a session cookie
+    bool hostOnly = true;               ///< Sent to domain only, not its subdomains
+    bool secure = false;                ///< Sent over https only
+    bool httpOnly = false;
+};
+
+/**
+ * @brief Cookie store of one session (RFC 6265 storage model)
+ *
+ * Set-Cookie lines are parsed per RFC 6265 section 5.2 (Expires in any
+ * of the date formats servers send, Max-Age winning over it, Domain,
+ * Path, Secure, HttpOnly) and stored under the section 5.3 rules: a
+ * Domain the request host does not match is rejected, no Domain makes a
+ * host-only cookie, a cookie with the same name, domain and path is
+ * replaced, and one already expired deletes it. There is no public
+ * suffix list; a Domain without a dot is accepted only for that host.
+ *
+ * Cookies are indexed by domain in a hash table, so finding the cookies
+ * for a request costs one lookup per label of the host rather than a
+ * scan of the jar. They are sent longest path first, as browsers do.
+ * Each domain keeps at most 50 cookies and the jar 3000; the least
+ * recently sent go first.
+ *
+ * Thread-safe.
+ */
+class CookieJar {
+public:
+    using Clock = std::chrono::system_clock;
+
+private:
+    struct Entry {
+        Cookie cookie;
+        uint64_t created = 0;           ///< Insertion order
+        mutable uint64_t lastAccess = 0;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::vector<Entry>> domains;
+    std::size_t count = 0;
+    uint64_t nextSequence = 1;
+    mutable uint64_t accessSequence = 0;
+
+    void insert(Cookie cookie, int64_t now);
+    void evict(const std::string& domain, int64_t now);
+    std::size_t dropExpired(int64_t now);
+
+public:
+    /**
+     * @brief Store the cookie a response set
+     * @param url URL of the request the response answered
+     * @param setCookie Value of one Set-Cookie header
+     * @param now Time of the response
+     * @return false if the line was malformed or rejected
+     */
+    bool setCookie(const std::string& url, const std::string& setCookie, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Cookie header value for a request, e.g. "a=1; b=2"
+     * @return Empty if no cookie matches
+     */
+    std::string cookieHeader(const std::string& url, Clock::time_point now = Clock::now()) const;
+
+    /**
+     * @brief Cookies a request to url would carry, in sending order
+     */
+    std::vector<Cookie> cookies(const std::string& url, Clock::time_point now = Clock::now()) const;
+
+    /**
+     * @brief Install "name=value; ..." pairs as host-only session cookies
+     *        with path "/" for the host of url (e.g. a saved Cookie header)
+     */
+    void restoreCookies(const std::string& url, const std::string& header);
+
+    /**
+     * @brief Drop expired cookies
+     * @return Number removed
+     */
+    std::size_t removeExpired(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Drop every cookie
+     */
+    void clear();
+
+    /**
+     * @brief Number of stored cookies (expired ones included until removed)
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Every unexpired cookie with its attributes, one per line
+     */
+    std::string serialize(Clock::time_point now = Clock::now()) const;
+
+    /**
+     * @brief Replace the jar with a serialize() result
+     * @return false (and nothing changed) if the text is malformed
+     */
+    bool restore(const std::string& text, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Parse an RFC 6265 cookie-date ("Wed, 21 Oct 2026 07:28:00 GMT"
+     *        and the RFC 850 and asctime variants)
+     * @return Unix seconds, or false if the date is invalid
+     */
+    static bool parseCookieDate(const std::string& text, int64_t& seconds);
+};
+
+} // namespace BSUIR
+
+#endif /* CookieJar_hpp */
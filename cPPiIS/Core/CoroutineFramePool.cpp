@@ -0,0 +1,158 @@
+//
+//  CoroutineFramePool.cpp
+//  cPPiIS Core C++ Coroutine Frame Allocator Implementation
+//
+
+#include "CoroutineFramePool.hpp"
+#include <array>
+#include <mutex>
+#include <new>
+
+namespace BSUIR {
+
+namespace {
+
+constexpr std::size_t BLOCKS_PER_CHUNK = 32;
+constexpr std::size_t MAX_CACHED_PER_THREAD = 64;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+/**
+ * @brief Process-wide free lists shared by all threads
+ *
+ * Chunks are never handed back to the system: the pool only grows to
+ * the peak number of frames that were alive at the same time.
+ */
+class SharedFreeLists {
+private:
+    std::mutex mutex;
+    std::array<FreeBlock*, CoroutineFramePool::SIZE_CLASSES> heads{};
+
+public:
+    FreeBlock* takeOrGrow(std::size_t sizeClass) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (FreeBlock* list = heads[sizeClass]) {
+                heads[sizeClass] = nullptr;
+                return list;
+            }
+        }
+
+        const std::size_t blockSize = (sizeClass + 1) * CoroutineFramePool::GRANULARITY;
+        char* chunk = static_cast<char*>(::operator new(blockSize * BLOCKS_PER_CHUNK));
+
+        FreeBlock* list = nullptr;
+        for (std::size_t i = BLOCKS_PER_CHUNK; i > 0; --i) {
+            auto* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+            block->next = list;
+            list = block;
+        }
+        return list;
+    }
+
+    void give(std::size_t sizeClass, FreeBlock* first, FreeBlock* last) {
+        std::lock_guard<std::mutex> lock(mutex);
+        last->next = heads[sizeClass];
+        heads[sizeClass] = first;
+    }
+};
+
+SharedFreeLists& sharedLists() {
+    static SharedFreeLists* lists = new SharedFreeLists();
+    return *lists;
+}
+
+/**
+ * @brief Per-thread cache in front of the shared lists
+ */
+struct ThreadCache {
+    std::array<FreeBlock*, CoroutineFramePool::SIZE_CLASSES> heads{};
+    std::array<std::size_t, CoroutineFramePool::SIZE_CLASSES> counts{};
+
+    ~ThreadCache() {
+        for (std::size_t sizeClass = 0; sizeClass < heads.size(); ++sizeClass) {
+            flush(sizeClass, counts[sizeClass]);
+        }
+    }
+
+    void flush(std::size_t sizeClass, std::size_t count) {
+        FreeBlock* first = heads[sizeClass];
+        if (!first || count == 0) {
+            return;
+        }
+
+        FreeBlock* last = first;
+        for (std::size_t i = 1; i < count && last->next; ++i) {
+            last = last->next;
+        }
+
+        heads[sizeClass] = last->next;
+        counts[sizeClass] -= count;
+        sharedLists().give(sizeClass, first, last);
+    }
+};
+
+ThreadCache& threadCache() {
+    thread_local ThreadCache cache;
+    return cache;
+}
+
+std::size_t sizeClassFor(std::size_t size) {
+    return (size + CoroutineFramePool::GRANULARITY - 1) / CoroutineFramePool::GRANULARITY - 1;
+}
+
+} // namespace
+
+// ========================================
+// CoroutineFramePool Implementation
+// ========================================
+
+void* CoroutineFramePool::allocate(std::size_t size) {
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        return ::operator new(size);
+    }
+
+    const std::size_t sizeClass = sizeClassFor(size);
+    ThreadCache& cache = threadCache();
+
+    if (!cache.heads[sizeClass]) {
+        FreeBlock* list = sharedLists().takeOrGrow(sizeClass);
+        std::size_t count = 0;
+        for (FreeBlock* block = list; block; block = block->next) {
+            ++count;
+        }
+        cache.heads[sizeClass] = list;
+        cache.counts[sizeClass] = count;
+    }
+
+    FreeBlock* block = cache.heads[sizeClass];
+    cache.heads[sizeClass] = block->next;
+    --cache.counts[sizeClass];
+    return block;
+}
+
+void CoroutineFramePool::deallocate(void* ptr, std::size_t size) noexcept {
+    if (!ptr) {
+        return;
+    }
+
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    const std::size_t sizeClass = sizeClassFor(size);
+    ThreadCache& cache = threadCache();
+
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = cache.heads[sizeClass];
+    cache.heads[sizeClass] = block;
+
+    if (++cache.counts[sizeClass] > MAX_CACHED_PER_THREAD) {
+        cache.flush(sizeClass, MAX_CACHED_PER_THREAD / 2);
+    }
+}
+
+} // namespace BSUIR
@@ -0,0 +1,60 @@
+//
+//  CoroutineFramePool.hpp
+//  cPPiIS Core C++ Coroutine Frame Allocator
+//
+//  Size-class pool for coroutine frames so that awaitable API calls
+//  do not hit the global heap on every request
+//
+
+#ifndef CoroutineFramePool_hpp
+#define CoroutineFramePool_hpp
+
+#include <cstddef>
+
+namespace BSUIR {
+
+/**
+ * @brief Pooled allocator for coroutine frames
+ *
+ * Frames are rounded up to 64-byte size classes (up to 1 KiB) and
+ * recycled through a per-thread free list backed by a shared list.
+ * Frames may be released on a different thread than the one that
+ * allocated them. Larger frames fall through to the global heap.
+ */
+class CoroutineFramePool {
+public:
+    static constexpr std::size_t GRANULARITY = 64;
+    static constexpr std::size_t SIZE_CLASSES = 16;
+    static constexpr std::size_t MAX_POOLED_SIZE = GRANULARITY * SIZE_CLASSES;
+
+    /**
+     * @brief Allocate storage for a coroutine frame
+     * @param size Frame size requested by the compiler
+     * @return Pointer to storage of at least size bytes
+     */
+    static void* allocate(std::size_t size);
+
+    /**
+     * @brief Return a coroutine frame to the pool
+     * @param ptr Pointer previously returned by allocate
+     * @param size Same size that was passed to allocate
+     */
+    static void deallocate(void* ptr, std::size_t size) noexcept;
+};
+
+/**
+ * @brief Mixin for promise types whose frames come from CoroutineFramePool
+ */
+struct PooledPromise {
+    static void* operator new(std::size_t size) {
+        return CoroutineFramePool::allocate(size);
+    }
+
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+        CoroutineFramePool::deallocate(ptr, size);
+    }
+};
+
+} // namespace BSUIR
+
+#endif /* CoroutineFramePool_hpp */
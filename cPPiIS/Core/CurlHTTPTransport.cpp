@@ -0,0 +1,344 @@
+//
+//  CurlHTTPTransport.cpp
+//  cPPiIS Core C++ libcurl Transport Implementation
+//
+
+#include "CurlHTTPTransport.hpp"
+#include "Log.hpp"
+
+#if defined(BSUIR_HAS_CURL)
+#include <curl/curl.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace BSUIR {
+
+#if defined(BSUIR_HAS_CURL)
+
+namespace {
+
+const std::size_t MAX_IDLE_HANDLES = 256;
+
+std::atomic<long> maxHostConnections{0};
+
+bool startsWithNoCase(const char* data, std::size_t size, const char* prefix) {
+    for (std::size_t i = 0; prefix[i] != '\0'; ++i) {
+        if (i >= size || std::tolower(static_cast<unsigned char>(data[i])) != prefix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+HTTPTimings::Clock::time_point offset(HTTPTimings::Clock::time_point start, curl_off_t microseconds) {
+    return start + std::chrono::duration_cast<HTTPTimings::Clock::duration>(std::chrono::microseconds(microseconds));
+}
+
+} // namespace
+
+// ========================================
+// Event Loop
+// ========================================
+
+/**
+ * @brief The one thread and multi handle behind every CurlHTTPTransport
+ */
+class CurlHTTPTransport::Loop {
+public:
+    struct Transfer {
+        std::shared_ptr<CurlHTTPTransport> owner;
+        std::shared_ptr<CookieJar> cookies;
+        HTTPRequest request;
+        ResponseCallback callback;
+        HTTPTimings::Clock::time_point requestStart;
+        HTTPTimings::Clock::time_point added;
+        CURL* easy = nullptr;
+        curl_slist* headers = nullptr;
+        std::string body;
+        char error[CURL_ERROR_SIZE] = {};
+    };
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Transfer>> submitted;
+    CURLM* multi = nullptr;
+    CURLSH* share = nullptr;
+    std::vector<CURL*> idleHandles;
+    long appliedHostLimit = 0;
+    std::thread worker;
+
+    static size_t onBody(char* data, size_t size, size_t count, void* context) {
+        static_cast<Transfer*>(context)->body.append(data, size * count);
+        return size * count;
+    }
+
+    static size_t onHeader(char* data, size_t size, size_t count, void* context) {
+        const size_t length = size * count;
+        static const char prefix[] = "set-cookie:";
+        if (startsWithNoCase(data, length, prefix)) {
+            std::string value(data + sizeof(prefix) - 1, length - (sizeof(prefix) - 1));
+            value.erase(0, value.find_first_not_of(" \t"));
+            value.erase(value.find_last_not_of(" \t\r\n") + 1);
+            Transfer* transfer = static_cast<Transfer*>(context);
+            transfer->cookies->setCookie(transfer->request.url, value);
+        }
+        return length;
+    }
+
+    CURL* acquireHandle() {
+        if (!idleHandles.empty()) {
+            CURL* easy = idleHandles.back();
+            idleHandles.pop_back();
+            return easy;
+        }
+        return curl_easy_init();
+    }
+
+    void releaseHandle(CURL* easy) {
+        if (idleHandles.size() < MAX_IDLE_HANDLES) {
+            curl_easy_reset(easy);
+            idleHandles.push_back(easy);
+        } else {
+            curl_easy_cleanup(easy);
+        }
+    }
+
+    bool start(Transfer& transfer) {
+        transfer.easy = acquireHandle();
+        if (!transfer.easy) {
+            return false;
+        }
+        CURL* easy = transfer.easy;
+        const HTTPRequest& request = transfer.request;
+
+        curl_easy_setopt(easy, CURLOPT_URL, request.url.c_str());
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, &transfer);
+        curl_easy_setopt(easy, CURLOPT_SHARE, share);
+        curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(request.timeoutSeconds * 1000.0));
+        curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, transfer.error);
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, &Loop::onBody);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer);
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, &Loop::onHeader);
+        curl_easy_setopt(easy, CURLOPT_HEADERDATA, &transfer);
+
+        switch (request.method) {
+            case HTTPMethod::Get:
+                curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+                break;
+            case HTTPMethod::Post:
+                curl_easy_setopt(easy, CURLOPT_POST, 1L);
+                break;
+            case HTTPMethod::Put:
+            case HTTPMethod::Delete:
+                curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, httpMethodName(request.method));
+                break;
+        }
+        if (request.method != HTTPMethod::Get && (request.method == HTTPMethod::Post || !request.body.empty())) {
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request.body.c_str());
+        }
+
+        for (const auto& header : request.headers) {
+            transfer.headers = curl_slist_append(transfer.headers, (header.first + ": " + header.second).c_str());
+        }
+        const std::string cookie = transfer.cookies->cookieHeader(request.url);
+        if (!cookie.empty()) {
+            transfer.headers = curl_slist_append(transfer.headers, ("Cookie: " + cookie).c_str());
+        }
+        // No 100-continue round trip for small JSON bodies
+        transfer.headers = curl_slist_append(transfer.headers, "Expect:");
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer.headers);
+
+        transfer.added = HTTPTimings::Clock::now();
+        return curl_multi_add_handle(multi, easy) == CURLM_OK;
+    }
+
+    void finish(Transfer& transfer, CURLcode code) {
+        HTTPResponse response;
+        response.timings.requestStart = transfer.requestStart;
+        response.timings.responseEnd = HTTPTimings::Clock::now();
+
+        long status = 0;
+        long connects = 0;
+        curl_off_t connectTime = 0;
+        curl_off_t firstByteTime = 0;
+        curl_easy_getinfo(transfer.easy, CURLINFO_RESPONSE_CODE, &status);
+        curl_easy_getinfo(transfer.easy, CURLINFO_NUM_CONNECTS, &connects);
+        curl_easy_getinfo(transfer.easy, CURLINFO_CONNECT_TIME_T, &connectTime);
+        curl_easy_getinfo(transfer.easy, CURLINFO_STARTTRANSFER_TIME_T, &firstByteTime);
+        response.timings.connectEnd = connects > 0 ? offset(transfer.added, connectTime) : transfer.requestStart;
+        if (firstByteTime > 0) {
+            response.timings.firstByte = offset(transfer.added, firstByteTime);
+        }
+
+        response.statusCode = static_cast<int>(status);
+        if (code != CURLE_OK) {
+            response.success = false;
+            response.errorMessage = transfer.error[0] != '\0' ? transfer.error : curl_easy_strerror(code);
+            BSUIR_LOG_WARNING(Network, "💥 Request failed with error: ", response.errorMessage);
+        } else {
+            response.success = status >= 200 && status < 300;
+            response.data = std::move(transfer.body);
+            if (!response.success) {
+                response.errorMessage = "HTTP Error " + std::to_string(status);
+                BSUIR_LOG_WARNING(Network, "🔴 HTTP Error ", status, ": Request unsuccessful");
+            }
+        }
+        BSUIR_LOG_DEBUG(Network, "🌐 Response ", status, ", ", response.data.size(), " bytes");
+
+        curl_multi_remove_handle(multi, transfer.easy);
+        curl_slist_free_all(transfer.headers);
+        releaseHandle(transfer.easy);
+        transfer.easy = nullptr;
+        transfer.headers = nullptr;
+
+        transfer.callback(response);
+    }
+
+    void run() {
+        int running = 0;
+        for (;;) {
+            std::vector<std::unique_ptr<Transfer>> batch;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                batch.swap(submitted);
+            }
+            const long hostLimit = maxHostConnections.load();
+            if (hostLimit != appliedHostLimit) {
+                curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, hostLimit);
+                appliedHostLimit = hostLimit;
+            }
+            for (auto& transfer : batch) {
+                Transfer* raw = transfer.release();
+                if (!start(*raw)) {
+                    if (raw->easy) {
+                        releaseHandle(raw->easy);
+                    }
+                    curl_slist_free_all(raw->headers);
+                    HTTPResponse response;
+                    response.timings.requestStart = raw->requestStart;
+                    response.errorMessage = "Could not start transfer";
+                    raw->callback(response);
+                    delete raw;
+                }
+            }
+
+            curl_multi_perform(multi, &running);
+
+            int queued = 0;
+            while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+                if (message->msg != CURLMSG_DONE) {
+                    continue;
+                }
+                Transfer* transfer = nullptr;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+                const CURLcode code = message->data.result;
+                std::unique_ptr<Transfer> owned(transfer);
+                finish(*owned, code);
+            }
+
+            // Sleeps until a socket is ready, a timeout is due or submit() wakes it
+            curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+    }
+
+public:
+    Loop() {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+        multi = curl_multi_init();
+        share = curl_share_init();
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        worker = std::thread([this] { run(); });
+        worker.detach();
+    }
+
+    static Loop& shared() {
+        // Leaked: transfers may still complete while static destructors run
+        static Loop* loop = new Loop();
+        return *loop;
+    }
+
+    void submit(std::unique_ptr<Transfer> transfer) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            submitted.push_back(std::move(transfer));
+        }
+        curl_multi_wakeup(multi);
+    }
+};
+
+// ========================================
+// CurlHTTPTransport Implementation
+// ========================================
+
+void CurlHTTPTransport::send(const HTTPRequest& request, ResponseCallback callback) {
+    BSUIR_LOG_DEBUG(Network, "🌐 ", httpMethodName(request.method), " ", request.url);
+
+    auto transfer = std::make_unique<Loop::Transfer>();
+    transfer->owner = shared_from_this();
+    transfer->cookies = request.cookies ? request.cookies : cookies;
+    transfer->request = request;
+    transfer->callback = std::move(callback);
+    transfer->requestStart = HTTPTimings::Clock::now();
+    Loop::shared().submit(std::move(transfer));
+}
+
+std::string CurlHTTPTransport::cookieHeader(const std::string& url) const {
+    return cookies->cookieHeader(url);
+}
+
+void CurlHTTPTransport::restoreCookies(const std::string& url, const std::string& header) {
+    cookies->restoreCookies(url, header);
+}
+
+void CurlHTTPTransport::setMaxHostConnections(long connections) {
+    maxHostConnections.store(connections);
+}
+
+#elif !defined(__APPLE__)
+
+namespace {
+
+/**
+ * @brief Stand-in for builds without libcurl: every request fails
+ */
+class UnavailableHTTPTransport : public IHTTPTransport {
+public:
+    void send(const HTTPRequest& request, ResponseCallback callback) override {
+        HTTPResponse response;
+        response.timings.requestStart = HTTPTimings::Clock::now();
+        response.errorMessage = "No HTTP transport: built without libcurl";
+        callback(response);
+    }
+};
+
+} // namespace
+
+#endif
+
+// ========================================
+// HTTPTransportFactory (non-Apple builds)
+// ========================================
+
+#if !defined(__APPLE__)
+// FoundationHTTPTransport.mm provides the factory on Apple platforms
+std::shared_ptr<IHTTPTransport> HTTPTransportFactory::createDefault() {
+#if defined(BSUIR_HAS_CURL)
+    return std::make_shared<CurlHTTPTransport>();
+#else
+    BSUIR_LOG_ERROR(Network, "❌ Built without libcurl, requests will fail");
+    return std::make_shared<UnavailableHTTPTransport>();
+#endif
+}
+#endif
+
+} // namespace BSUIR
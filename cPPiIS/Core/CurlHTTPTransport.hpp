@@ -0,0 +1,69 @@
+//
+//  CurlHTTPTransport.hpp
+//  cPPiIS Core C++ libcurl Transport
+//
+//  Native IHTTPTransport for non-Apple builds (Linux daemons and tools),
+//  compiled only where libcurl headers are available
+//
+
+#ifndef CurlHTTPTransport_hpp
+#define CurlHTTPTransport_hpp
+
+#include "CookieJar.hpp"
+#include "HTTPTransport.hpp"
+#include <memory>
+#include <string>
+
+#if !defined(__APPLE__) && defined(__has_include)
+#if __has_include(<curl/curl.h>)
+#define BSUIR_HAS_CURL 1
+#endif
+#endif
+
+namespace BSUIR {
+
+#if defined(BSUIR_HAS_CURL)
+
+/**
+ * @brief Transport over a process-wide libcurl multi handle
+ *
+ * Every instance submits to the same event loop: one thread drives all
+ * transfers, keeps connections alive per host and shares DNS and TLS
+ * sessions, so thousands of instances cost a cookie jar each rather
+ * than a thread or connection pool each. Cookies go to the jar of the
+ * request (HTTPClient attaches one per session), so a single instance
+ * can also carry any number of signed-in sessions; requests without a
+ * jar use the instance's own.
+ *
+ * Callbacks run on the loop thread and must not block; HTTPClient hands
+ * them to its completion executor when one is set.
+ */
+class CurlHTTPTransport : public IHTTPTransport,
+                          public std::enable_shared_from_this<CurlHTTPTransport> {
+private:
+    class Loop;
+
+    std::shared_ptr<CookieJar> cookies = std::make_shared<CookieJar>();
+
+public:
+    CurlHTTPTransport() = default;
+
+    CurlHTTPTransport(const CurlHTTPTransport&) = delete;
+    CurlHTTPTransport& operator=(const CurlHTTPTransport&) = delete;
+
+    void send(const HTTPRequest& request, ResponseCallback callback) override;
+    std::string cookieHeader(const std::string& url) const override;
+    void restoreCookies(const std::string& url, const std::string& header) override;
+
+    /**
+     * @brief Limit connections kept open to one host across all instances
+     * @param connections Maximum parallel connections per host (0: unlimited)
+     */
+    static void setMaxHostConnections(long connections);
+};
+
+#endif
+
+} // namespace BSUIR
+
+#endif /* CurlHTTPTransport_hpp */
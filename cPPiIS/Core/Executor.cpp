@@ -0,0 +1,195 @@
+//
+//  Executor.cpp
+//  cPPiIS Core C++ Executor Implementation
+//
+
+#include "Executor.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <string>
+
+namespace BSUIR {
+
+namespace {
+
+// Identifies the pool and worker slot of the current thread
+thread_local const WorkStealingThreadPool* currentPool = nullptr;
+thread_local std::size_t currentWorkerIndex = 0;
+
+std::atomic<std::size_t> poolCounter{0};
+
+Metrics::Counter& failedTasks() {
+    static Metrics::Counter& counter = Metrics::MetricsRegistry::shared().counter(
+        "bsuir_executor_task_failures_total", {}, "Posted tasks that threw");
+    return counter;
+}
+
+} // namespace
+
+// ========================================
+// WorkStealingThreadPool Implementation
+// ========================================
+
+WorkStealingThreadPool::WorkStealingThreadPool(std::size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
+    const std::size_t pool = poolCounter.fetch_add(1, std::memory_order_relaxed);
+    threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back([this, i, pool] {
+            Profiler::setThreadName("pool " + std::to_string(pool) + " worker " + std::to_string(i));
+            workerLoop(i);
+        });
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wakeUp.notify_all();
+
+    for (auto& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void WorkStealingThreadPool::post(std::function<void()> task) {
+    if (!task) {
+        return;
+    }
+
+    std::size_t index;
+    if (currentPool == this) {
+        index = currentWorkerIndex;
+    } else {
+        index = nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    }
+
+    {
+        // Counted under the deque lock so a worker's fetch_sub after popping
+        // the task can never run ahead of this increment
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        pendingTasks.fetch_add(1);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+
+    // Only touch the sleep mutex when somebody may actually be sleeping
+    if (sleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wakeUp.notify_one();
+    }
+}
+
+std::size_t WorkStealingThreadPool::threadCount() const noexcept {
+    return threads.size();
+}
+
+bool WorkStealingThreadPool::popLocal(std::size_t index, std::function<void()>& task) {
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingThreadPool::steal(std::size_t thiefIndex, std::function<void()>& task) {
+    const std::size_t count = workers.size();
+    bool skippedBusy = false;
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        Worker& victim = *workers[(thiefIndex + offset) % count];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            skippedBusy = true;
+            continue;
+        }
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    if (!skippedBusy) {
+        return false;
+    }
+
+    // A busy deque may hold the pending work, so wait for each lock once
+    // rather than spinning on try_lock while pendingTasks stays above zero
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        Worker& victim = *workers[(thiefIndex + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingThreadPool::workerLoop(std::size_t index) {
+    currentPool = this;
+    currentWorkerIndex = index;
+
+    std::function<void()> task;
+    for (;;) {
+        if (popLocal(index, task) || steal(index, task)) {
+            pendingTasks.fetch_sub(1);
+            try {
+                Profiler::Scope profile("executor.task", "executor");
+                task();
+            } catch (const std::exception& e) {
+                // The task outlives its caller, so the pool is the last place to see the error
+                failedTasks().add();
+                BSUIR_LOG_ERROR(Executor, "💥 Posted task threw: ", e.what());
+            } catch (...) {
+                failedTasks().add();
+                BSUIR_LOG_ERROR(Executor, "💥 Posted task threw a non-standard exception");
+            }
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1);
+        wakeUp.wait(lock, [this] {
+            return pendingTasks.load() > 0 || stopping.load();
+        });
+        sleepingWorkers.fetch_sub(1);
+
+        if (stopping.load() && pendingTasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+// ========================================
+// ExecutorFactory Implementation
+// ========================================
+
+std::shared_ptr<IExecutor> ExecutorFactory::createInline() {
+    return std::make_shared<InlineExecutor>();
+}
+
+std::shared_ptr<IExecutor> ExecutorFactory::createThreadPool(std::size_t threadCount) {
+    return std::make_shared<WorkStealingThreadPool>(threadCount);
+}
+
+} // namespace BSUIR
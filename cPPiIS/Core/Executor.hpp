@@ -0,0 +1,123 @@
+//
+//  Executor.hpp
+//  cPPiIS Core C++ Executor Abstraction
+//
+//  Pluggable task executors for I/O completion, parsing, coroutine
+//  resumption and callback delivery
+//
+
+#ifndef Executor_hpp
+#define Executor_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief Abstract executor interface
+ *
+ * An executor decides on which thread a unit of work runs. Callers
+ * inject an executor wherever they care about the execution context;
+ * components fall back to running work inline when none is set.
+ */
+class IExecutor {
+public:
+    virtual ~IExecutor() = default;
+
+    /**
+     * @brief Schedule work for execution
+     * @param task Work item, invoked exactly once
+     */
+    virtual void post(std::function<void()> task) = 0;
+};
+
+/**
+ * @brief Executor that runs work immediately on the calling thread
+ */
+class InlineExecutor : public IExecutor {
+public:
+    void post(std::function<void()> task) override {
+        task();
+    }
+};
+
+/**
+ * @brief Fixed-size thread pool with per-worker deques and work stealing
+ *
+ * Work posted from a worker thread goes to the back of that worker's
+ * own deque and is popped LIFO for cache locality; external posts are
+ * distributed round-robin. Idle workers steal from the front of other
+ * deques before going to sleep, so a burst of parse jobs submitted by a
+ * single completion thread spreads across all cores.
+ */
+class WorkStealingThreadPool : public IExecutor {
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> nextWorker{0};
+    std::atomic<std::size_t> pendingTasks{0};
+    std::atomic<std::size_t> sleepingWorkers{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+
+    bool popLocal(std::size_t index, std::function<void()>& task);
+    bool steal(std::size_t thiefIndex, std::function<void()>& task);
+    void workerLoop(std::size_t index);
+
+public:
+    /**
+     * @brief Start the pool
+     * @param threadCount Number of worker threads (0 selects hardware concurrency)
+     */
+    explicit WorkStealingThreadPool(std::size_t threadCount = 0);
+
+    /**
+     * @brief Drain queued work and join all workers
+     */
+    ~WorkStealingThreadPool() override;
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    void post(std::function<void()> task) override;
+
+    /**
+     * @brief Number of worker threads
+     */
+    std::size_t threadCount() const noexcept;
+};
+
+/**
+ * @brief Factory for commonly used executors
+ */
+class ExecutorFactory {
+public:
+    /**
+     * @brief Create an executor that runs work inline
+     */
+    static std::shared_ptr<IExecutor> createInline();
+
+    /**
+     * @brief Create a work-stealing pool
+     * @param threadCount Number of workers (0 selects hardware concurrency)
+     */
+    static std::shared_ptr<IExecutor> createThreadPool(std::size_t threadCount = 0);
+};
+
+} // namespace BSUIR
+
+#endif /* Executor_hpp */
@@ -0,0 +1,33 @@
+//
+//  FoundationHTTPTransport.hpp
+//  cPPiIS Core C++ Foundation Transport
+//
+//  IHTTPTransport implementation over NSURLSession (via HTTPClientBridge)
+//
+
+#ifndef FoundationHTTPTransport_hpp
+#define FoundationHTTPTransport_hpp
+
+#include "HTTPTransport.hpp"
+
+namespace BSUIR {
+
+/**
+ * @brief Transport backed by the shared NSURLSessions of HTTPClientBridge
+ *
+ * Requests carrying a cookie jar go through a session without cookie
+ * storage: the jar's cookies are sent and the response's stored back in
+ * it, so sessions of different accounts share one connection pool.
+ * Requests without a jar use the shared NSHTTPCookieStorage, where every
+ * instance sees the same IIS session.
+ */
+class FoundationHTTPTransport : public IHTTPTransport {
+public:
+    void send(const HTTPRequest& request, ResponseCallback callback) override;
+    std::string cookieHeader(const std::string& url) const override;
+    void restoreCookies(const std::string& url, const std::string& header) override;
+};
+
+} // namespace BSUIR
+
+#endif /* FoundationHTTPTransport_hpp */
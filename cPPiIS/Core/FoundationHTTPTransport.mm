@@ -0,0 +1,166 @@
+//
+//  FoundationHTTPTransport.mm
+//  cPPiIS Core C++ Foundation Transport Implementation
+//
+//  Objective-C++ adapter from IHTTPTransport to the C bridge - C++ OOP coursework
+//
+//  GitHub Copilot: Для Objective-C++ интеграции обеспечивай безопасность памяти
+//
+
+#include "FoundationHTTPTransport.hpp"
+#include "CookieJar.hpp"
+#include "Log.hpp"
+#include "../Bridge/HTTPClientBridge.h"
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string_view>
+
+namespace BSUIR {
+
+namespace {
+
+// Callback wrapper structure
+struct CallbackWrapper {
+    ResponseCallback userCallback;
+    HTTPTimings::Clock::time_point requestStart;
+    std::shared_ptr<CookieJar> cookies;     ///< Jar of a cookieless request
+    std::string url;
+};
+
+HTTPMethodType bridgeMethod(HTTPMethod method) {
+    switch (method) {
+        case HTTPMethod::Get:    return HTTPMethodTypeGET;
+        case HTTPMethod::Post:   return HTTPMethodTypePOST;
+        case HTTPMethod::Put:    return HTTPMethodTypePUT;
+        case HTTPMethod::Delete: return HTTPMethodTypeDELETE;
+    }
+    return HTTPMethodTypeGET;
+}
+
+// Bridge expects "key:value|key:value"
+std::string buildHeadersString(const std::map<std::string, std::string>& headerMap) {
+    std::ostringstream headers;
+    for (const auto& header : headerMap) {
+        if (!headers.str().empty()) headers << "|";
+        headers << header.first << ":" << header.second;
+    }
+    return headers.str();
+}
+
+} // namespace
+
+// C callback adapter
+void httpCallbackAdapter(const char* data, int statusCode, const char* error, void* context) {
+    CallbackWrapper* wrapper = static_cast<CallbackWrapper*>(context);
+    
+    BSUIR_LOG_DEBUG(Network, "🌐 Response ", statusCode, ", ", data ? std::strlen(data) : 0, " bytes");
+    BSUIR_LOG_TRACE(Network, "📄 Response data (truncated): ",
+                    std::string_view(data ? data : "").substr(0, 500));
+    
+    if (wrapper && wrapper->userCallback) {
+        HTTPResponse response;
+        response.timings.requestStart = wrapper->requestStart;
+        response.timings.responseEnd = HTTPTimings::Clock::now();
+        
+        if (error && strlen(error) > 0) {
+            response.success = false;
+            response.errorMessage = error;
+            response.statusCode = statusCode;
+            BSUIR_LOG_WARNING(Network, "💥 Request failed with error: ", error);
+        } else {
+            response.success = (statusCode >= 200 && statusCode < 300);
+            response.statusCode = statusCode;
+            response.data = data ? data : "";
+            
+            if (!response.success) {
+                response.errorMessage = "HTTP Error " + std::to_string(statusCode);
+                BSUIR_LOG_WARNING(Network, "🔴 HTTP Error ", statusCode, ": Request unsuccessful");
+            }
+        }
+        
+        wrapper->userCallback(response);
+    }
+    
+    // Clean up
+    delete wrapper;
+}
+
+// C callback adapter for cookieless requests: cookies first, then the response
+void httpCookieCallbackAdapter(const char* data, int statusCode, const char* error, const char* setCookies,
+                               void* context) {
+    CallbackWrapper* wrapper = static_cast<CallbackWrapper*>(context);
+    if (wrapper && wrapper->cookies && setCookies) {
+        std::istringstream lines(setCookies);
+        std::string line;
+        while (std::getline(lines, line)) {
+            wrapper->cookies->setCookie(wrapper->url, line);
+        }
+    }
+    httpCallbackAdapter(data, statusCode, error, context);
+}
+
+// ========================================
+// FoundationHTTPTransport Implementation
+// ========================================
+
+void FoundationHTTPTransport::send(const HTTPRequest& request, ResponseCallback callback) {
+    std::string headersString = buildHeadersString(request.headers);
+    
+    BSUIR_LOG_DEBUG(Network, "🌐 ", httpMethodName(request.method), " ", request.url);
+    BSUIR_LOG_TRACE(Network, "🌐 Headers: ", headersString);
+    
+    // Create callback wrapper
+    CallbackWrapper* wrapper = new CallbackWrapper{std::move(callback), HTTPTimings::Clock::now(),
+                                                   request.cookies, request.url};
+    
+    if (request.cookies) {
+        // The session's own jar: keep NSHTTPCookieStorage out of it
+        performCookielessHTTPRequest(
+            request.url.c_str(),
+            bridgeMethod(request.method),
+            headersString.c_str(),
+            request.body.empty() ? nullptr : request.body.c_str(),
+            request.timeoutSeconds,
+            request.cookies->cookieHeader(request.url).c_str(),
+            httpCookieCallbackAdapter,
+            wrapper
+        );
+        return;
+    }
+    
+    // Make the request
+    performHTTPRequest(
+        request.url.c_str(),
+        bridgeMethod(request.method),
+        headersString.c_str(),
+        request.body.empty() ? nullptr : request.body.c_str(),
+        request.timeoutSeconds,
+        httpCallbackAdapter,
+        wrapper
+    );
+}
+
+std::string FoundationHTTPTransport::cookieHeader(const std::string& url) const {
+    char* header = copyCookieHeader(url.c_str());
+    if (!header) {
+        return {};
+    }
+    std::string result(header);
+    std::free(header);
+    return result;
+}
+
+void FoundationHTTPTransport::restoreCookies(const std::string& url, const std::string& header) {
+    restoreCookieHeader(url.c_str(), header.c_str());
+}
+
+// ========================================
+// HTTPTransportFactory Implementation
+// ========================================
+
+std::shared_ptr<IHTTPTransport> HTTPTransportFactory::createDefault() {
+    return std::make_shared<FoundationHTTPTransport>();
+}
+
+} // namespace BSUIR
@@ -0,0 +1,271 @@
+//
+//  HTTPClient.cpp
+//  cPPiIS Core C++ HTTP Client Implementation
+//
+//  Platform-neutral request building on top of IHTTPTransport - C++ OOP coursework
+//
+//  GitHub Copilot: Используй современный C++ стиль, RAII принципы, умные указатели
+//
+
+#include "HTTPClient.hpp"
+#include "Metrics.hpp"
+#include "Profiler.hpp"
+#include "Tracing.hpp"
+
+namespace BSUIR {
+
+namespace {
+
+// Split the transport's timestamps into connect / ttfb / transfer spans
+void recordTransportSpans(Tracing::SpanContext parent, const HTTPTimings& timings) {
+    if (!HTTPTimings::isSet(timings.requestStart)) {
+        return;
+    }
+    auto stageStart = timings.requestStart;
+    if (HTTPTimings::isSet(timings.connectEnd)) {
+        Tracing::recordSpan("http.connect", parent, Tracing::toNanoseconds(stageStart),
+                            Tracing::toNanoseconds(timings.connectEnd));
+        stageStart = timings.connectEnd;
+    }
+    if (HTTPTimings::isSet(timings.firstByte)) {
+        Tracing::recordSpan("http.ttfb", parent, Tracing::toNanoseconds(stageStart),
+                            Tracing::toNanoseconds(timings.firstByte));
+        stageStart = timings.firstByte;
+    }
+    if (HTTPTimings::isSet(timings.responseEnd)) {
+        Tracing::recordSpan(stageStart == timings.requestStart ? "http.exchange" : "http.transfer", parent,
+                            Tracing::toNanoseconds(stageStart), Tracing::toNanoseconds(timings.responseEnd));
+    }
+}
+
+/**
+ * @brief Stages of one request on its Profiler async track
+ */
+struct RequestProfile {
+    uint64_t id = 0;                ///< 0 when no profiling session was recording at send time
+    uint64_t sent = 0;
+    uint64_t arrived = 0;
+    HTTPTimings timings;
+};
+
+// Draw queue / transport / completion / callback under one http.request interval
+void recordRequestProfile(const RequestProfile& profile, const std::string& path,
+                          uint64_t callbackStart, uint64_t callbackEnd) {
+    const HTTPTimings& timings = profile.timings;
+    Profiler::async("http.request", "network", profile.id, profile.sent, callbackEnd, path.c_str());
+    if (HTTPTimings::isSet(timings.requestStart) && HTTPTimings::isSet(timings.responseEnd)) {
+        const uint64_t requestStart = Profiler::toNanoseconds(timings.requestStart);
+        Profiler::async("queue", "network", profile.id, profile.sent, requestStart);
+        Profiler::async("transport", "network", profile.id, requestStart,
+                        Profiler::toNanoseconds(timings.responseEnd));
+    } else {
+        Profiler::async("transport", "network", profile.id, profile.sent, profile.arrived);
+    }
+    Profiler::async("completion", "network", profile.id, profile.arrived, callbackStart);
+    Profiler::async("callback", "network", profile.id, callbackStart, callbackEnd);
+}
+
+} // namespace
+
+HTTPClient::HTTPClient(std::shared_ptr<IHTTPTransport> transportPtr)
+    : baseUrl("https://iis.bsuir.by/api/v1"),
+      transport(transportPtr ? std::move(transportPtr) : HTTPTransportFactory::createDefault()),
+      cookieJar(std::make_shared<CookieJar>()) {
+}
+
+HTTPClient::~HTTPClient() {
+    // Destructor
+}
+
+void HTTPClient::setBaseUrl(const std::string& url) {
+    baseUrl = url;
+}
+
+void HTTPClient::setTransport(std::shared_ptr<IHTTPTransport> transportPtr) {
+    if (transportPtr) {
+        transport = std::move(transportPtr);
+    }
+}
+
+void HTTPClient::setCookieJar(std::shared_ptr<CookieJar> jar) {
+    cookieJar = std::move(jar);
+}
+
+std::shared_ptr<CookieJar> HTTPClient::getCookieJar() const {
+    return cookieJar;
+}
+
+std::string HTTPClient::sessionCookies() const {
+    const std::string url = buildFullUrl("/");
+    return cookieJar ? cookieJar->cookieHeader(url) : transport->cookieHeader(url);
+}
+
+void HTTPClient::restoreSessionCookies(const std::string& header) {
+    const std::string url = buildFullUrl("/");
+    if (cookieJar) {
+        cookieJar->restoreCookies(url, header);
+    } else {
+        transport->restoreCookies(url, header);
+    }
+}
+
+void HTTPClient::setCompletionExecutor(std::shared_ptr<IExecutor> executor) {
+    completionExecutor.store(std::move(executor));
+}
+
+void HTTPClient::setTrafficRecorder(std::shared_ptr<TrafficRecorder> recorder) {
+    trafficRecorder.store(std::move(recorder));
+}
+
+void HTTPClient::setDefaultHeader(const std::string& key, const std::string& value) {
+    defaultHeaders[key] = value;
+}
+
+void HTTPClient::removeDefaultHeader(const std::string& key) {
+    defaultHeaders.erase(key);
+}
+
+std::map<std::string, std::string> BSUIR::HTTPClient::buildHeaders(const std::map<std::string, std::string>& additionalHeaders) const {
+    std::map<std::string, std::string> headers = defaultHeaders;
+    
+    // Per-request headers override defaults
+    for (const auto& header : additionalHeaders) {
+        headers[header.first] = header.second;
+    }
+    
+    return headers;
+}
+
+std::string BSUIR::HTTPClient::buildFullUrl(const std::string& endpoint) const {
+    if (endpoint.find("http://") == 0 || endpoint.find("https://") == 0) {
+        return endpoint; // Already a full URL
+    }
+    
+    std::string url = baseUrl;
+    if (!url.empty() && url.back() != '/') {
+        url += "/";
+    }
+    
+    std::string cleanEndpoint = endpoint;
+    if (!cleanEndpoint.empty() && cleanEndpoint.front() == '/') {
+        cleanEndpoint = cleanEndpoint.substr(1);
+    }
+    
+    return url + cleanEndpoint;
+}
+
+void BSUIR::HTTPClient::get(const std::string& endpoint, 
+                             ResponseCallback callback,
+                             const std::map<std::string, std::string>& headers) {
+    performRequest(HTTPMethod::Get, endpoint, "", headers, callback);
+}
+
+void BSUIR::HTTPClient::post(const std::string& endpoint,
+                              const std::string& body,
+                              ResponseCallback callback,
+                              const std::map<std::string, std::string>& headers) {
+    auto mergedHeaders = headers.empty() ? 
+        std::map<std::string, std::string>{{"Content-Type", "application/json"}} : headers;
+    performRequest(HTTPMethod::Post, endpoint, body, mergedHeaders, callback);
+}
+
+void BSUIR::HTTPClient::put(const std::string& endpoint,
+                             const std::string& body,
+                             ResponseCallback callback,
+                             const std::map<std::string, std::string>& headers) {
+    auto mergedHeaders = headers.empty() ? 
+        std::map<std::string, std::string>{{"Content-Type", "application/json"}} : headers;
+    performRequest(HTTPMethod::Put, endpoint, body, mergedHeaders, callback);
+}
+
+void BSUIR::HTTPClient::deleteRequest(const std::string& endpoint,
+                                      ResponseCallback callback,
+                                      const std::map<std::string, std::string>& headers) {
+    performRequest(HTTPMethod::Delete, endpoint, "", headers, callback);
+}
+
+void BSUIR::HTTPClient::performRequest(HTTPMethod method,
+                               const std::string& endpoint,
+                               const std::string& body,
+                               const std::map<std::string, std::string>& additionalHeaders,
+                               ResponseCallback callback) {
+    
+    HTTPRequest request;
+    request.method = method;
+    request.url = buildFullUrl(endpoint);
+    request.headers = buildHeaders(additionalHeaders);
+    request.body = body;
+    request.timeoutSeconds = 30.0; // 30 seconds timeout
+    request.cookies = cookieJar;
+    
+    if (auto recorder = trafficRecorder.load()) {
+        callback = [recorder, request, callback = std::move(callback)](const HTTPResponse& response) {
+            recorder->record(request, response);
+            callback(response);
+        };
+    }
+    
+    const Metrics::EndpointMetrics& metrics = Metrics::endpoint(endpoint);
+    metrics.requests->add();
+    metrics.bytesOut->add(request.body.size());
+    Metrics::inFlight().add(1);
+    const auto sent = HTTPTimings::Clock::now();
+    
+    RequestProfile profile;
+    if (Profiler::isActive()) {
+        profile.id = Profiler::newAsyncId();
+        profile.sent = Profiler::toNanoseconds(sent);
+        Profiler::counter("http.inFlight", Metrics::inFlight().value());
+    }
+    
+    // Child of the caller's span (e.g. api.markbook); inert when not sampled
+    const Tracing::SpanContext parent = Tracing::current();
+    const Tracing::Span span = Tracing::Span::child("http.request", parent);
+    auto executor = completionExecutor.load();
+    
+    transport->send(request, [executor, parent, span, sent, profile, &metrics,
+                              callback = std::move(callback)](const HTTPResponse& response) mutable {
+        metrics.duration->record(HTTPTimings::Clock::now() - sent);
+        metrics.bytesIn->add(response.data.size());
+        Metrics::inFlight().add(-1);
+        if (!response.isSuccessful()) {
+            Metrics::recordError(metrics, response.statusCode);
+        }
+        
+        if (span.isActive()) {
+            recordTransportSpans(span.context(), response.timings);
+            span.finish({{"http.status", response.statusCode}});
+        }
+        if (profile.id != 0) {
+            profile.arrived = Profiler::now();
+            profile.timings = response.timings;
+            Profiler::counter("http.inFlight", Metrics::inFlight().value());
+        }
+        
+        auto deliver = [parent, profile, &metrics](const ResponseCallback& callback, const HTTPResponse& response) {
+            const uint64_t callbackStart = profile.id != 0 ? Profiler::now() : 0;
+            {
+                Tracing::ContextScope scope(parent);
+                callback(response);
+            }
+            if (profile.id != 0) {
+                recordRequestProfile(profile, metrics.path, callbackStart, Profiler::now());
+            }
+        };
+        if (!executor) {
+            deliver(callback, response);
+            return;
+        }
+        
+        // Leave the transport's thread; the response already owns its data
+        const uint64_t arrived = span.isActive() ? Tracing::nowNanoseconds() : 0;
+        executor->post([parent, arrived, deliver, callback, response] {
+            if (arrived != 0) {
+                Tracing::recordSpan("http.completion", parent, arrived, Tracing::nowNanoseconds());
+            }
+            deliver(callback, response);
+        });
+    });
+}
+
+} // namespace BSUIR
\ No newline at end of file
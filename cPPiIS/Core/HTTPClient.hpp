@@ -2,7 +2,7 @@
 //  HTTPClient.hpp
 //  cPPiIS Core C++ HTTP Client
 //
-//  HTTP client for API requests using Foundation networking - C++ OOP coursework
+//  HTTP client for API requests over a pluggable transport - C++ OOP coursework
 //  Demonstrates modern C++ practices and OOP principles
 //
 
@@ -10,7 +10,11 @@
 #define HTTPClient_hpp
 
 #include "Models.hpp"
-#include "../Bridge/HTTPClientBridge.h"
+#include "Executor.hpp"
+#include "AtomicSnapshot.hpp"
+#include "CookieJar.hpp"
+#include "HTTPTransport.hpp"
+#include "TrafficCapture.hpp"
 #include <string>
 #include <map>
 #include <functional>
@@ -18,29 +22,6 @@
 
 namespace BSUIR {
 
-/**
- * @brief HTTP response structure containing response data and metadata
- */
-struct HTTPResponse {
-    bool success = false;
-    int statusCode = 0;
-    std::string data;
-    std::string errorMessage;
-    
-    /**
-     * @brief Check if the response indicates success
-     * @return true if status code is in 200-299 range
-     */
-    bool isSuccessful() const noexcept {
-        return success && statusCode >= 200 && statusCode < 300;
-    }
-};
-
-/**
- * @brief Callback type for async HTTP requests
- */
-using ResponseCallback = std::function<void(const HTTPResponse&)>;
-
 /**
  * @brief Modern C++ HTTP Client implementing RAII and smart memory management
  * 
@@ -50,18 +31,31 @@ using ResponseCallback = std::function<void(const HTTPResponse&)>;
  * - Method overloading with default parameters (instead of multiple overloads)
  * - Const correctness
  * - Modern C++ features
+ *
+ * Request methods may be called concurrently. Configuration setters
+ * (base URL, default headers, cookie jar) are meant to be used before
+ * the client is shared; the completion executor and traffic recorder
+ * may be swapped at any time.
+ *
+ * Each client owns the cookie jar of its session and hands it to the
+ * transport with every request, so clients for different accounts can
+ * share one transport and its connections.
  */
 class HTTPClient {
 private:
     std::string baseUrl;
     std::map<std::string, std::string> defaultHeaders;
+    std::shared_ptr<IHTTPTransport> transport;
+    std::shared_ptr<CookieJar> cookieJar;
+    AtomicSnapshot<IExecutor> completionExecutor;
+    AtomicSnapshot<TrafficRecorder> trafficRecorder;
     
     /**
-     * @brief Helper method to build headers string from maps
-     * @param additionalHeaders Additional headers to merge with defaults
-     * @return Combined headers as string
+     * @brief Helper method to merge default and per-request headers
+     * @param additionalHeaders Additional headers overriding defaults
+     * @return Combined header map
      */
-    std::string buildHeadersString(const std::map<std::string, std::string>& additionalHeaders = {}) const;
+    std::map<std::string, std::string> buildHeaders(const std::map<std::string, std::string>& additionalHeaders = {}) const;
     
     /**
      * @brief Helper method to build full URL from base URL and endpoint
@@ -73,8 +67,10 @@ private:
 public:
     /**
      * @brief Constructor initializing HTTPClient with default configuration
+     * @param transportPtr Transport to send requests through
+     *                     (default: platform transport from HTTPTransportFactory)
      */
-    HTTPClient();
+    explicit HTTPClient(std::shared_ptr<IHTTPTransport> transportPtr = nullptr);
     
     /**
      * @brief Destructor ensuring proper cleanup (RAII principle)
@@ -85,9 +81,9 @@ public:
     HTTPClient(const HTTPClient&) = delete;
     HTTPClient& operator=(const HTTPClient&) = delete;
     
-    // Allow move constructor and assignment for performance
-    HTTPClient(HTTPClient&&) = default;
-    HTTPClient& operator=(HTTPClient&&) = default;
+    // Not movable: in-flight requests hold a pointer to this instance
+    HTTPClient(HTTPClient&&) = delete;
+    HTTPClient& operator=(HTTPClient&&) = delete;
     
     /**
      * @brief Configure base URL for all requests
@@ -108,6 +104,50 @@ public:
      */
     void removeDefaultHeader(const std::string& key);
     
+    /**
+     * @brief Replace the transport used for subsequent requests
+     * @param transportPtr New transport (must not be null)
+     */
+    void setTransport(std::shared_ptr<IHTTPTransport> transportPtr);
+    
+    /**
+     * @brief Set executor on which response callbacks are delivered
+     * @param executor Completion executor (nullptr delivers on the
+     *                 networking thread that received the response)
+     */
+    void setCompletionExecutor(std::shared_ptr<IExecutor> executor);
+    
+    /**
+     * @brief Enable or disable recording of request/response pairs
+     * @param recorder Capture to append every completed exchange to
+     *                 (nullptr stops recording)
+     */
+    void setTrafficRecorder(std::shared_ptr<TrafficRecorder> recorder);
+    
+    /**
+     * @brief Replace the session's cookie jar
+     * @param jar Jar to send and store cookies in (nullptr leaves cookies
+     *            to the transport, e.g. the shared NSHTTPCookieStorage)
+     */
+    void setCookieJar(std::shared_ptr<CookieJar> jar);
+    
+    /**
+     * @brief The session's cookie jar (null if cookies are left to the transport)
+     */
+    std::shared_ptr<CookieJar> getCookieJar() const;
+    
+    /**
+     * @brief Cookies sent to the base URL
+     * @return Cookie header value (empty if none or not exposed by the transport)
+     */
+    std::string sessionCookies() const;
+    
+    /**
+     * @brief Install cookies for the base URL, e.g. a saved session
+     * @param header Cookie header value as returned by sessionCookies()
+     */
+    void restoreSessionCookies(const std::string& header);
+    
     /**
      * @brief Perform GET request with optional additional headers
      * @param endpoint API endpoint path
@@ -161,7 +201,7 @@ private:
      * @param additionalHeaders Additional headers to merge
      * @param callback Response callback function
      */
-    void performRequest(HTTPMethodType method,
+    void performRequest(HTTPMethod method,
                        const std::string& endpoint,
                        const std::string& body,
                        const std::map<std::string, std::string>& additionalHeaders,
@@ -0,0 +1,149 @@
+//
+//  HTTPTransport.hpp
+//  cPPiIS Core C++ HTTP Transport Interface
+//
+//  Platform-neutral request/response types and the transport strategy
+//  used by HTTPClient (Foundation on Apple platforms, mocks in tools)
+//
+
+#ifndef HTTPTransport_hpp
+#define HTTPTransport_hpp
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace BSUIR {
+
+class CookieJar;
+
+/**
+ * @brief HTTP method
+ */
+enum class HTTPMethod {
+    Get,
+    Post,
+    Put,
+    Delete
+};
+
+/**
+ * @brief Canonical method name ("GET", "POST", ...)
+ */
+inline const char* httpMethodName(HTTPMethod method) noexcept {
+    switch (method) {
+        case HTTPMethod::Get:    return "GET";
+        case HTTPMethod::Post:   return "POST";
+        case HTTPMethod::Put:    return "PUT";
+        case HTTPMethod::Delete: return "DELETE";
+    }
+    return "GET";
+}
+
+/**
+ * @brief Fully resolved request handed to a transport
+ */
+struct HTTPRequest {
+    HTTPMethod method = HTTPMethod::Get;
+    std::string url;
+    std::map<std::string, std::string> headers;
+    std::string body;
+    double timeoutSeconds = 30.0;
+    std::shared_ptr<CookieJar> cookies;     ///< Session cookies to send and update (null: the transport's own)
+};
+
+/**
+ * @brief Monotonic timestamps of the network stages of one request
+ *
+ * Transports fill in what they can observe; unobserved stages stay
+ * default-constructed (zero).
+ */
+struct HTTPTimings {
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point requestStart;   ///< Request handed to the transport
+    Clock::time_point connectEnd;     ///< Connection ready (equals requestStart when reused)
+    Clock::time_point firstByte;      ///< First response byte received
+    Clock::time_point responseEnd;    ///< Response fully received
+
+    static bool isSet(Clock::time_point point) noexcept {
+        return point != Clock::time_point{};
+    }
+};
+
+/**
+ * @brief HTTP response structure containing response data and metadata
+ */
+struct HTTPResponse {
+    bool success = false;
+    int statusCode = 0;
+    std::string data;
+    std::string errorMessage;
+    HTTPTimings timings;
+
+    /**
+     * @brief Check if the response indicates success
+     * @return true if status code is in 200-299 range
+     */
+    bool isSuccessful() const noexcept {
+        return success && statusCode >= 200 && statusCode < 300;
+    }
+};
+
+/**
+ * @brief Callback type for async HTTP requests
+ */
+using ResponseCallback = std::function<void(const HTTPResponse&)>;
+
+/**
+ * @brief Strategy interface for sending HTTP requests
+ *
+ * Implementations must invoke the callback exactly once, on any thread,
+ * and keep session cookies between requests the way a browser would: in
+ * the request's cookie jar when it carries one, so one transport can
+ * serve many sessions, otherwise in their own.
+ */
+class IHTTPTransport {
+public:
+    virtual ~IHTTPTransport() = default;
+
+    /**
+     * @brief Send a request asynchronously
+     * @param request Request to send
+     * @param callback Completion callback
+     */
+    virtual void send(const HTTPRequest& request, ResponseCallback callback) = 0;
+
+    /**
+     * @brief Cookies the transport would send to a URL without a request jar
+     * @param url Absolute URL
+     * @return Cookie header value ("name=value; name2=value2"), empty if
+     *         none or if the transport does not expose its cookies
+     */
+    virtual std::string cookieHeader(const std::string& /*url*/) const { return {}; }
+
+    /**
+     * @brief Install cookies for a URL, e.g. a session saved by an earlier run
+     * @param url Absolute URL the cookies belong to
+     * @param header Cookie header value as returned by cookieHeader()
+     */
+    virtual void restoreCookies(const std::string& /*url*/, const std::string& /*header*/) {}
+};
+
+/**
+ * @brief Factory for the platform's native transport
+ */
+class HTTPTransportFactory {
+public:
+    /**
+     * @brief Create the default transport for the current platform
+     * @return Shared transport instance
+     */
+    static std::shared_ptr<IHTTPTransport> createDefault();
+};
+
+} // namespace BSUIR
+
+#endif /* HTTPTransport_hpp */
@@ -4,12 +4,118 @@
 //
 
 #include "JSONParser.hpp"
+#include "Log.hpp"
+#include "Tracing.hpp"
 #include <algorithm>
 #include <regex>
-#include <iostream>
 
 namespace BSUIR {
 
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+size_t skipSpace(const std::string& json, size_t pos) {
+    while (pos < json.size() && isSpace(json[pos])) ++pos;
+    return pos;
+}
+
+// Position just past the string literal opening at pos
+size_t skipString(const std::string& json, size_t pos) {
+    for (++pos; pos < json.size(); ++pos) {
+        if (json[pos] == '\\') ++pos;
+        else if (json[pos] == '"') return pos + 1;
+    }
+    return json.size();
+}
+
+// Position just past the value starting at pos, nested objects and arrays included
+size_t skipValue(const std::string& json, size_t pos) {
+    int depth = 0;
+    while (pos < json.size()) {
+        const char c = json[pos];
+        if (c == '"') {
+            pos = skipString(json, pos);
+            continue;
+        }
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) break;
+            if (--depth == 0) return pos + 1;
+        } else if (c == ',' && depth == 0) {
+            break;
+        }
+        ++pos;
+    }
+    while (pos > 0 && isSpace(json[pos - 1])) --pos;
+    return pos;
+}
+
+// Four hex digits of a \uXXXX escape starting at pos, or -1 if malformed
+long hexQuad(const std::string& raw, size_t pos) {
+    if (pos + 4 > raw.size()) return -1;
+    long value = 0;
+    for (size_t i = pos; i < pos + 4; ++i) {
+        const char c = raw[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9') value |= c - '0';
+        else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+        else return -1;
+    }
+    return value;
+}
+
+void appendUtf8(std::string& out, unsigned long codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+// Decodes the \uXXXX escape at pos (just past the 'u'), joining surrogate pairs.
+// Returns the index of the last consumed character.
+size_t decodeUnicodeEscape(const std::string& raw, size_t pos, std::string& out) {
+    constexpr unsigned long REPLACEMENT = 0xFFFD;
+    const long high = hexQuad(raw, pos);
+    if (high < 0) {
+        appendUtf8(out, REPLACEMENT);
+        return pos - 1;
+    }
+    if (high >= 0xD800 && high <= 0xDBFF) {
+        if (pos + 10 <= raw.size() && raw[pos + 4] == '\\' && raw[pos + 5] == 'u') {
+            const long low = hexQuad(raw, pos + 6);
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+                appendUtf8(out, 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00));
+                return pos + 9;
+            }
+        }
+        appendUtf8(out, REPLACEMENT);
+    } else if (high >= 0xDC00 && high <= 0xDFFF) {
+        // Lone low surrogate
+        appendUtf8(out, REPLACEMENT);
+    } else {
+        appendUtf8(out, static_cast<unsigned long>(high));
+    }
+    return pos + 3;
+}
+
+} // namespace
+
 std::string JSONParser::trim(const std::string& str) {
     size_t start = str.find_first_not_of(" \t\n\r\"");
     if (start == std::string::npos) return "";
@@ -27,6 +133,8 @@ std::string JSONParser::unescapeString(const std::string& str) {
 }
 
 std::map<std::string, std::string> JSONParser::parseObject(const std::string& json) {
+    Tracing::ScopedSpan span("parser.object");
+    
     std::map<std::string, std::string> result;
     std::string cleaned = json;
     
@@ -52,6 +160,8 @@ std::map<std::string, std::string> JSONParser::parseObject(const std::string& js
 }
 
 std::vector<std::string> JSONParser::parseArray(const std::string& json) {
+    Tracing::ScopedSpan span("parser.array");
+    
     std::vector<std::string> result;
     std::string cleaned = json;
     
@@ -74,6 +184,71 @@ std::vector<std::string> JSONParser::parseArray(const std::string& json) {
     return result;
 }
 
+std::map<std::string, std::string> JSONParser::parseMembers(const std::string& json) {
+    // Unlike parseObject, only the outermost members are returned and
+    // nested objects and arrays are kept whole as raw JSON
+    std::map<std::string, std::string> result;
+    size_t pos = json.find('{');
+    if (pos == std::string::npos) return result;
+    
+    pos = skipSpace(json, pos + 1);
+    while (pos < json.size() && json[pos] == '"') {
+        const size_t keyEnd = skipString(json, pos);
+        std::string key = stringValue(json.substr(pos, keyEnd - pos));
+        pos = skipSpace(json, keyEnd);
+        if (pos >= json.size() || json[pos] != ':') break;
+        pos = skipSpace(json, pos + 1);
+        const size_t valueEnd = skipValue(json, pos);
+        result[std::move(key)] = json.substr(pos, valueEnd - pos);
+        pos = skipSpace(json, valueEnd);
+        if (pos >= json.size() || json[pos] != ',') break;
+        pos = skipSpace(json, pos + 1);
+    }
+    return result;
+}
+
+std::vector<std::string> JSONParser::parseElements(const std::string& json) {
+    std::vector<std::string> result;
+    size_t pos = json.find('[');
+    if (pos == std::string::npos) return result;
+    
+    pos = skipSpace(json, pos + 1);
+    while (pos < json.size() && json[pos] != ']') {
+        const size_t end = skipValue(json, pos);
+        if (end == pos) break;
+        result.push_back(json.substr(pos, end - pos));
+        pos = skipSpace(json, end);
+        if (pos >= json.size() || json[pos] != ',') break;
+        pos = skipSpace(json, pos + 1);
+    }
+    return result;
+}
+
+std::string JSONParser::stringValue(const std::string& raw) {
+    if (raw.empty() || raw[0] != '"') {
+        return raw == "null" ? "" : raw;
+    }
+    std::string result;
+    result.reserve(raw.size());
+    for (size_t pos = 1; pos < raw.size() && raw[pos] != '"'; ++pos) {
+        if (raw[pos] != '\\' || pos + 1 >= raw.size()) {
+            result.push_back(raw[pos]);
+            continue;
+        }
+        switch (raw[++pos]) {
+            case 'n': result.push_back('\n'); break;
+            case 't': result.push_back('\t'); break;
+            case 'r': result.push_back('\r'); break;
+            case 'b': result.push_back('\b'); break;
+            case 'f': result.push_back('\f'); break;
+            case 'u': pos = decodeUnicodeEscape(raw, pos + 1, result); break;
+            // \" \\ and \/ stand for themselves
+            default: result.push_back(raw[pos]); break;
+        }
+    }
+    return result;
+}
+
 std::optional<int> JSONParser::parseOptionalInt(const std::string& value) {
     if (value == "null" || value.empty()) return std::nullopt;
     try {
@@ -93,18 +268,18 @@ std::optional<double> JSONParser::parseOptionalDouble(const std::string& value)
 }
 
 std::optional<LoginResponse> JSONParser::parseLoginResponse(const std::string& json) {
-    std::cout << "🔍 JSONParser: Parsing login response:" << std::endl;
-    std::cout << "🔍 Raw JSON: " << json << std::endl;
+    Tracing::ScopedSpan span("parser.login");
+    
+    BSUIR_LOG_TRACE(Parser, "🔍 Parsing login response: ", json);
     
     auto obj = parseObject(json);
     if (obj.empty()) {
-        std::cout << "❌ JSONParser: Failed to parse JSON object" << std::endl;
+        BSUIR_LOG_WARNING(Parser, "❌ Failed to parse login JSON object");
         return std::nullopt;
     }
     
-    std::cout << "🔍 Parsed object keys:" << std::endl;
     for (const auto& pair : obj) {
-        std::cout << "🔍 Key: " << pair.first << ", Value: " << pair.second << std::endl;
+        BSUIR_LOG_TRACE(Parser, "🔍 Key: ", pair.first, ", Value: ", pair.second);
     }
     
     LoginResponse response;
@@ -143,26 +318,25 @@ std::optional<LoginResponse> JSONParser::parseLoginResponse(const std::string& j
         // Set a default userId (API doesn't return numeric ID in this response)
         response.userId = 1; // We'll use 1 as default since we don't have ID in response
         
-        std::cout << "✅ JSONParser: Successfully parsed login response" << std::endl;
-        std::cout << "👤 Student: " << response.firstName << " " << response.lastName << std::endl;
-        std::cout << "🎫 Student Number: " << response.studentNumber << std::endl;
+        BSUIR_LOG_DEBUG(Parser, "✅ Parsed login response for ", response.studentNumber);
         return response;
     } catch (const std::exception& e) {
-        std::cout << "❌ JSONParser: Exception parsing login response: " << e.what() << std::endl;
+        BSUIR_LOG_ERROR(Parser, "❌ Exception parsing login response: ", e.what());
         return std::nullopt;
     } catch (...) {
-        std::cout << "❌ JSONParser: Unknown error parsing login response" << std::endl;
+        BSUIR_LOG_ERROR(Parser, "❌ Unknown error parsing login response");
         return std::nullopt;
     }
 }
 
 std::optional<PersonalInfo> JSONParser::parsePersonalInfo(const std::string& json) {
-    std::cout << "🔍 JSONParser: Parsing PersonalInfo response:" << std::endl;
-    std::cout << "🔍 Raw JSON: " << json << std::endl;
+    Tracing::ScopedSpan span("parser.personalInfo");
+    
+    BSUIR_LOG_TRACE(Parser, "🔍 Parsing PersonalInfo response: ", json);
     
     auto obj = parseObject(json);
     if (obj.empty()) {
-        std::cout << "❌ JSONParser: Failed to parse PersonalInfo JSON object" << std::endl;
+        BSUIR_LOG_WARNING(Parser, "❌ Failed to parse PersonalInfo JSON object");
         return std::nullopt;
     }
     
@@ -180,71 +354,130 @@ std::optional<PersonalInfo> JSONParser::parsePersonalInfo(const std::string& jso
         info.middleNameBel = obj.count("middleNameBel") ? obj["middleNameBel"] : "";
         info.birthDate = obj.count("birthDate") ? obj["birthDate"] : "";
         info.course = obj.count("course") ? std::stoi(obj["course"]) : 0;
-        info.faculty = obj.count("faculty") ? obj["faculty"] : "";
-        info.speciality = obj.count("speciality") ? obj["speciality"] : "";
+        // Shared by every student of the faculty, so kept once per process
+        info.faculty = StringPool::shared().intern(obj.count("faculty") ? obj["faculty"] : "");
+        info.speciality = StringPool::shared().intern(obj.count("speciality") ? obj["speciality"] : "");
         info.group = obj.count("group") ? obj["group"] : "";
         info.email = obj.count("email") ? obj["email"] : "";
         info.phone = obj.count("phone") ? obj["phone"] : "";
         
-        std::cout << "✅ JSONParser: Successfully parsed PersonalInfo" << std::endl;
-        std::cout << "👤 Name: " << info.firstName << " " << info.lastName << std::endl;
-        std::cout << "🎫 Student: " << info.studentNumber << ", Group: " << info.group << std::endl;
+        BSUIR_LOG_DEBUG(Parser, "✅ Parsed PersonalInfo for ", info.studentNumber, ", group ", info.group);
         
         return info;
     } catch (const std::exception& e) {
-        std::cout << "❌ JSONParser: Exception parsing PersonalInfo: " << e.what() << std::endl;
+        BSUIR_LOG_ERROR(Parser, "❌ Exception parsing PersonalInfo: ", e.what());
         return std::nullopt;
     } catch (...) {
-        std::cout << "❌ JSONParser: Unknown error parsing PersonalInfo" << std::endl;
+        BSUIR_LOG_ERROR(Parser, "❌ Unknown error parsing PersonalInfo");
         return std::nullopt;
     }
 }
 
 std::optional<Markbook> JSONParser::parseMarkbook(const std::string& json) {
-    auto obj = parseObject(json);
+    Tracing::ScopedSpan span("parser.markbook");
+    
+    auto obj = parseMembers(json);
     if (obj.empty()) return std::nullopt;
     
     Markbook markbook;
     
     try {
-        markbook.studentNumber = obj["studentNumber"];
-        markbook.overallGPA = std::stod(obj["overallGPA"]);
+        markbook.studentNumber = stringValue(obj["studentNumber"]);
+        markbook.overallGPA = parseOptionalDouble(obj["overallGPA"]).value_or(0.0);
+        
+        for (const auto& semesterJson : parseElements(obj["semesters"])) {
+            auto semesterObj = parseMembers(semesterJson);
+            Semester semester;
+            semester.number = parseOptionalInt(semesterObj["number"]).value_or(0);
+            semester.gpa = parseOptionalDouble(semesterObj["gpa"]).value_or(0.0);
+            
+            for (const auto& subjectJson : parseElements(semesterObj["subjects"])) {
+                auto subjectObj = parseMembers(subjectJson);
+                Subject subject;
+                // Names and control forms repeat across students and refreshes
+                subject.name = StringPool::shared().intern(stringValue(subjectObj["name"]));
+                subject.hours = parseOptionalDouble(subjectObj["hours"]).value_or(0.0);
+                subject.credits = parseOptionalInt(subjectObj["credits"]).value_or(0);
+                subject.controlForm = StringPool::shared().intern(stringValue(subjectObj["controlForm"]));
+                subject.grade = parseOptionalInt(subjectObj["grade"]);
+                subject.retakes = parseOptionalInt(subjectObj["retakes"]).value_or(0);
+                subject.averageGrade = parseOptionalDouble(subjectObj["averageGrade"]);
+                subject.retakeChance = parseOptionalDouble(subjectObj["retakeChance"]).value_or(0.0);
+                subject.isOnline = subjectObj["isOnline"] == "true";
+                semester.subjects.push_back(std::move(subject));
+            }
+            markbook.semesters.push_back(std::move(semester));
+        }
         
-        // Note: Full array parsing would be more complex
-        // This is a simplified version
+        BSUIR_LOG_DEBUG(Parser, "✅ Parsed Markbook for ", markbook.studentNumber, ", ", markbook.semesters.size(), " semesters");
         
         return markbook;
+    } catch (const std::exception& e) {
+        BSUIR_LOG_ERROR(Parser, "❌ Exception parsing Markbook: ", e.what());
+        return std::nullopt;
     } catch (...) {
         return std::nullopt;
     }
 }
 
 std::optional<GroupInfo> JSONParser::parseGroupInfo(const std::string& json) {
-    auto obj = parseObject(json);
+    Tracing::ScopedSpan span("parser.groupInfo");
+    
+    auto obj = parseMembers(json);
     if (obj.empty()) return std::nullopt;
     
     GroupInfo info;
     
     try {
-        info.number = obj["number"];
-        info.faculty = obj["faculty"];
-        info.course = std::stoi(obj["course"]);
+        // Group details are nested under "group", the roster sits beside it
+        auto groupObj = parseMembers(obj["group"]);
+        info.number = stringValue(groupObj["number"]);
+        info.faculty = StringPool::shared().intern(stringValue(groupObj["faculty"]));
+        info.course = parseOptionalInt(groupObj["course"]).value_or(0);
+        
+        auto curatorObj = parseMembers(groupObj["curator"]);
+        info.curator.fullName = stringValue(curatorObj["fullName"]);
+        info.curator.phone = stringValue(curatorObj["phone"]);
+        info.curator.email = stringValue(curatorObj["email"]);
+        info.curator.profileUrl = stringValue(curatorObj["profileUrl"]);
+        
+        for (const auto& studentJson : parseElements(obj["students"])) {
+            auto studentObj = parseMembers(studentJson);
+            info.students.push_back(GroupStudent{parseOptionalInt(studentObj["number"]).value_or(0), stringValue(studentObj["fullName"])});
+        }
         
-        // Simplified parsing - in real implementation would parse nested objects
-        info.curator.fullName = obj["curatorName"];
-        info.curator.phone = obj["curatorPhone"];
-        info.curator.email = obj["curatorEmail"];
+        BSUIR_LOG_DEBUG(Parser, "✅ Parsed GroupInfo for ", info.number, ", ", info.students.size(), " students");
         
         return info;
+    } catch (const std::exception& e) {
+        BSUIR_LOG_ERROR(Parser, "❌ Exception parsing GroupInfo: ", e.what());
+        return std::nullopt;
     } catch (...) {
         return std::nullopt;
     }
 }
 
+std::optional<std::vector<std::string>> JSONParser::parseSkills(const std::string& json) {
+    Tracing::ScopedSpan span("parser.skills");
+    
+    // The endpoint wraps the array as {"skills": [...]}; a bare array is accepted too
+    auto obj = parseMembers(json);
+    std::string array = obj.count("skills") ? obj["skills"] : json.substr(skipSpace(json, 0));
+    if (array.empty() || array[0] != '[') return std::nullopt;
+    if (array[skipValue(array, 0) - 1] != ']') {
+        BSUIR_LOG_WARNING(Parser, "❌ Unterminated skills array");
+        return std::nullopt;
+    }
+    
+    std::vector<std::string> skills;
+    for (const auto& element : parseElements(array)) {
+        skills.push_back(stringValue(element));
+    }
+    return skills;
+}
+
 ApiError JSONParser::parseError(const std::string& json, int httpCode) {
-    std::cout << "🚨 JSONParser: Parsing error response" << std::endl;
-    std::cout << "🚨 HTTP Code: " << httpCode << std::endl;
-    std::cout << "🚨 Raw response: " << json << std::endl;
+    BSUIR_LOG_TRACE(Parser, "🚨 Parsing error response, HTTP ", httpCode, ": ", json);
     
     auto obj = parseObject(json);
     
@@ -254,10 +487,8 @@ ApiError JSONParser::parseError(const std::string& json, int httpCode) {
     // Try different possible error message fields in JSON
     if (obj.count("message")) {
         error.message = obj["message"];
-        std::cout << "📄 Found error message: " << error.message << std::endl;
     } else if (obj.count("error_description")) {
         error.message = obj["error_description"];
-        std::cout << "📄 Found error_description: " << error.message << std::endl;
     } else if (obj.count("error") && obj.count("path")) {
         // BSUIR API specific format: {"timestamp":..,"status":401,"error":"Unauthorized","path":"/api/v1/auth/login"}
         std::string errorType = obj["error"];
@@ -270,13 +501,10 @@ ApiError JSONParser::parseError(const std::string& json, int httpCode) {
         } else {
             error.message = "Ошибка " + status + ": " + errorType + " (" + path + ")";
         }
-        std::cout << "📄 BSUIR API format error: " << error.message << std::endl;
     } else if (obj.count("error")) {
         error.message = obj["error"];
-        std::cout << "📄 Found error field: " << error.message << std::endl;
     } else if (obj.count("status")) {
         error.message = obj["status"];
-        std::cout << "📄 Found status field: " << error.message << std::endl;
     } else {
         // Fallback error messages
         if (httpCode == 400) {
@@ -292,7 +520,6 @@ ApiError JSONParser::parseError(const std::string& json, int httpCode) {
         } else {
             error.message = "HTTP " + std::to_string(httpCode) + " ошибка";
         }
-        std::cout << "📄 Using fallback error message: " << error.message << std::endl;
     }
     
     // Include additional details if available
@@ -320,9 +547,8 @@ ApiError JSONParser::parseError(const std::string& json, int httpCode) {
     
     error.details = details;
     
-    std::cout << "🚨 Final parsed error: Code=" << error.code 
-              << ", Message=" << error.message 
-              << ", Details=" << error.details << std::endl;
+    BSUIR_LOG_DEBUG(Parser, "🚨 Parsed error: Code=", error.code,
+                    ", Message=", error.message, ", Details=", error.details);
     
     return error;
 }
@@ -343,11 +569,10 @@ std::string BSUIR::JSONParser::createLoginRequest(const std::string& login,
     
     oss << "}";
     
-    std::string requestBody = oss.str();
-    std::cout << "🔑 JSONParser: Creating corrected login request:" << std::endl;
-    std::cout << "🔑 Request body: " << requestBody << std::endl;
+    // The body carries the password, so only the login is logged
+    BSUIR_LOG_TRACE(Parser, "🔑 Created login request for ", login);
     
-    return requestBody;
+    return oss.str();
 }
 
 } // namespace BSUIR
\ No newline at end of file
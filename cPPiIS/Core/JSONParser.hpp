@@ -23,6 +23,9 @@ private:
     static std::string unescapeString(const std::string& str);
     static std::map<std::string, std::string> parseObject(const std::string& json);
     static std::vector<std::string> parseArray(const std::string& json);
+    static std::map<std::string, std::string> parseMembers(const std::string& json);
+    static std::vector<std::string> parseElements(const std::string& json);
+    static std::string stringValue(const std::string& raw);
     static std::optional<int> parseOptionalInt(const std::string& value);
     static std::optional<double> parseOptionalDouble(const std::string& value);
     
@@ -39,6 +42,9 @@ public:
     // Parse group information
     static std::optional<GroupInfo> parseGroupInfo(const std::string& json);
     
+    // Parse skill search results ({"skills": [...]})
+    static std::optional<std::vector<std::string>> parseSkills(const std::string& json);
+    
     // Parse generic API error
     static ApiError parseError(const std::string& json, int httpCode = 0);
     
@@ -0,0 +1,321 @@
+//
+//  LocalStore.cpp
+//  cPPiIS Core C++ Local Store Implementation
+//
+
+#include "LocalStore.hpp"
+#include "Log.hpp"
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+namespace BSUIR {
+
+namespace {
+
+const char MAGIC[8] = {'B', 'S', 'S', 'T', 'O', 'R', '0', '1'};
+const uint32_t MAX_RECORD_BYTES = 64u * 1024u * 1024u;
+const uint64_t MIN_COMPACTION_BYTES = 64u * 1024u;
+
+const uint8_t KIND_PUT = 1;
+const uint8_t KIND_ERASE = 2;
+
+uint32_t fnv1a(const uint8_t* data, std::size_t size) {
+    uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void putFixed32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putString(std::string& out, const std::string& value) {
+    putVarint(out, value.size());
+    out.append(value);
+}
+
+uint32_t readFixed32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+bool readVarint(const uint8_t*& position, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && position < end; shift += 7) {
+        const uint8_t byte = *position++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+bool readString(const uint8_t*& position, const uint8_t* end, std::string& value) {
+    uint64_t length;
+    if (!readVarint(position, end, length) || length > static_cast<uint64_t>(end - position)) return false;
+    value.assign(reinterpret_cast<const char*>(position), static_cast<std::size_t>(length));
+    position += length;
+    return true;
+}
+
+std::string encodeRecord(uint8_t kind, const std::string& key, const std::string& value, int64_t storedAt) {
+    std::string payload;
+    payload.reserve(24 + key.size() + value.size());
+    payload.push_back(static_cast<char>(kind));
+    putVarint(payload, static_cast<uint64_t>(storedAt > 0 ? storedAt : 0));
+    putString(payload, key);
+    putString(payload, value);
+
+    std::string record;
+    record.reserve(payload.size() + 8);
+    putFixed32(record, static_cast<uint32_t>(payload.size()));
+    record.append(payload);
+    putFixed32(record, fnv1a(reinterpret_cast<const uint8_t*>(payload.data()), payload.size()));
+    return record;
+}
+
+// Approximate on-disk size of a live record, for the compaction ratio
+uint64_t recordBytes(const std::string& key, const std::string& value) {
+    return 8 + 1 + 10 + 10 + key.size() + 10 + value.size();
+}
+
+int64_t toMilliseconds(std::chrono::system_clock::time_point point) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(point.time_since_epoch()).count();
+}
+
+bool flushFile(std::FILE* file, bool sync) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+    return !sync || fsync(fileno(file)) == 0;
+}
+
+} // namespace
+
+std::chrono::milliseconds StoredValue::age() const {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now() - storedAt);
+    return elapsed.count() > 0 ? elapsed : std::chrono::milliseconds(0);
+}
+
+// ========================================
+// LocalStore Implementation
+// ========================================
+
+LocalStore::LocalStore(const std::string& path, bool sync) : filePath(path), syncWrites(sync) {
+    if (!load()) {
+        return;
+    }
+    file = std::fopen(filePath.c_str(), "ab");
+    if (file && std::ftell(file) == 0) {
+        std::fwrite(MAGIC, 1, sizeof(MAGIC), file);
+        flushFile(file, syncWrites);
+        fileBytes = sizeof(MAGIC);
+    }
+    if (!file) {
+        BSUIR_LOG_ERROR(Storage, "❌ Cannot open local store ", filePath);
+    }
+}
+
+LocalStore::~LocalStore() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool LocalStore::isOpen() const noexcept {
+    return file != nullptr;
+}
+
+bool LocalStore::load() {
+    std::FILE* input = std::fopen(filePath.c_str(), "rb");
+    if (!input) {
+        return true;    // New store
+    }
+    std::vector<uint8_t> data;
+    uint8_t chunk[64 * 1024];
+    std::size_t count;
+    while ((count = std::fread(chunk, 1, sizeof(chunk), input)) > 0) {
+        data.insert(data.end(), chunk, chunk + count);
+    }
+    std::fclose(input);
+
+    if (data.empty()) {
+        return true;
+    }
+    if (data.size() < sizeof(MAGIC) || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        BSUIR_LOG_ERROR(Storage, "❌ ", filePath, " is not a local store");
+        return false;
+    }
+
+    std::size_t offset = sizeof(MAGIC);
+    while (data.size() - offset >= 8) {
+        const uint32_t size = readFixed32(data.data() + offset);
+        if (size > MAX_RECORD_BYTES || data.size() - offset - 8 < size) break;
+        const uint8_t* payload = data.data() + offset + 4;
+        if (readFixed32(payload + size) != fnv1a(payload, size)) break;
+
+        const uint8_t* position = payload;
+        const uint8_t* end = payload + size;
+        uint64_t storedAt;
+        std::string key, value;
+        const uint8_t kind = *position++;
+        if ((kind != KIND_PUT && kind != KIND_ERASE) || !readVarint(position, end, storedAt) ||
+            !readString(position, end, key) || !readString(position, end, value) || position != end) {
+            break;
+        }
+
+        auto existing = entries.find(key);
+        if (existing != entries.end()) {
+            liveBytes -= recordBytes(key, existing->second.value);
+        }
+        if (kind == KIND_PUT) {
+            liveBytes += recordBytes(key, value);
+            entries[std::move(key)] = Entry{std::move(value), static_cast<int64_t>(storedAt)};
+        } else if (existing != entries.end()) {
+            entries.erase(existing);
+        }
+        offset += 8 + size;
+    }
+    fileBytes = offset;
+
+    if (offset < data.size()) {
+        // Torn tail from a crash mid-write: cut it so new records follow intact ones
+        BSUIR_LOG_WARNING(Storage, "⚠️ Discarding ", data.size() - offset, " corrupt bytes at the end of ", filePath);
+        if (truncate(filePath.c_str(), static_cast<off_t>(offset)) != 0) {
+            BSUIR_LOG_ERROR(Storage, "❌ Cannot truncate ", filePath);
+            return false;
+        }
+    }
+    BSUIR_LOG_DEBUG(Storage, "📦 Loaded ", entries.size(), " values from ", filePath);
+    return true;
+}
+
+bool LocalStore::append(uint8_t kind, const std::string& key, const std::string& value, int64_t storedAt) {
+    if (!file) {
+        return false;
+    }
+    const std::string record = encodeRecord(kind, key, value, storedAt);
+    if (std::fwrite(record.data(), 1, record.size(), file) != record.size() || !flushFile(file, syncWrites)) {
+        BSUIR_LOG_ERROR(Storage, "❌ Write to ", filePath, " failed");
+        discardTornRecord();
+        return false;
+    }
+    fileBytes += record.size();
+    return true;
+}
+
+void LocalStore::discardTornRecord() {
+    // Closing drops what stdio still buffers of the failed record; cutting
+    // back to fileBytes keeps later appends from following a torn one
+    std::fclose(file);
+    file = nullptr;
+    if (truncate(filePath.c_str(), static_cast<off_t>(fileBytes)) == 0) {
+        file = std::fopen(filePath.c_str(), "ab");
+    }
+    if (!file) {
+        // Closed for good; the next load() trims whatever tail is left
+        BSUIR_LOG_ERROR(Storage, "❌ Cannot recover ", filePath, " after a failed write, closing the store");
+    }
+}
+
+bool LocalStore::rewrite() {
+    const std::string temporaryPath = filePath + ".tmp";
+    std::FILE* output = std::fopen(temporaryPath.c_str(), "wb");
+    if (!output) {
+        return false;
+    }
+    bool written = std::fwrite(MAGIC, 1, sizeof(MAGIC), output) == sizeof(MAGIC);
+    uint64_t bytes = sizeof(MAGIC);
+    for (const auto& [key, entry] : entries) {
+        if (!written) break;
+        const std::string record = encodeRecord(KIND_PUT, key, entry.value, entry.storedAtMilliseconds);
+        written = std::fwrite(record.data(), 1, record.size(), output) == record.size();
+        bytes += record.size();
+    }
+    // The new file must be durable before it replaces the old one
+    written = written && flushFile(output, true);
+    if (std::fclose(output) != 0 || !written || std::rename(temporaryPath.c_str(), filePath.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+
+    std::fclose(file);
+    file = std::fopen(filePath.c_str(), "ab");
+    fileBytes = bytes;
+    return file != nullptr;
+}
+
+void LocalStore::compactIfWasteful() {
+    if (fileBytes > MIN_COMPACTION_BYTES && fileBytes > 2 * liveBytes && !rewrite()) {
+        BSUIR_LOG_WARNING(Storage, "⚠️ Compaction of ", filePath, " failed");
+    }
+}
+
+std::optional<StoredValue> LocalStore::get(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = entries.find(key);
+    if (found == entries.end()) {
+        return std::nullopt;
+    }
+    return StoredValue{found->second.value,
+                       std::chrono::system_clock::time_point(std::chrono::milliseconds(found->second.storedAtMilliseconds))};
+}
+
+bool LocalStore::put(const std::string& key, const std::string& value, std::chrono::system_clock::time_point storedAt) {
+    const int64_t milliseconds = toMilliseconds(storedAt);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!append(KIND_PUT, key, value, milliseconds)) {
+        return false;
+    }
+    auto found = entries.find(key);
+    if (found != entries.end()) {
+        liveBytes -= recordBytes(key, found->second.value);
+        found->second = Entry{value, milliseconds};
+    } else {
+        entries.emplace(key, Entry{value, milliseconds});
+    }
+    liveBytes += recordBytes(key, value);
+    compactIfWasteful();
+    return true;
+}
+
+bool LocalStore::erase(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = entries.find(key);
+    if (found == entries.end()) {
+        return true;
+    }
+    if (!append(KIND_ERASE, key, "", toMilliseconds(std::chrono::system_clock::now()))) {
+        return false;
+    }
+    liveBytes -= recordBytes(key, found->second.value);
+    entries.erase(found);
+    compactIfWasteful();
+    return true;
+}
+
+std::size_t LocalStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+bool LocalStore::compact() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return file && rewrite();
+}
+
+} // namespace BSUIR
@@ -0,0 +1,124 @@
+//
+//  LocalStore.hpp
+//  cPPiIS Core C++ Local Store
+//
+//  Embedded crash-safe key/value store backed by an append-only log,
+//  used to serve the last known API data while offline
+//
+
+#ifndef LocalStore_hpp
+#define LocalStore_hpp
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace BSUIR {
+
+/**
+ * @brief Value read from the store together with its write time
+ */
+struct StoredValue {
+    std::string value;
+    std::chrono::system_clock::time_point storedAt;
+
+    /**
+     * @brief Time since the value was written (zero if the clock went back)
+     */
+    std::chrono::milliseconds age() const;
+};
+
+/**
+ * @brief Persistent key/value store without an external database
+ *
+ * File layout: the 8-byte magic "BSSTOR01" followed by records of
+ * [u32 payload length][payload][u32 FNV-1a of payload], little endian.
+ * A payload is [u8 kind][varint storedAt, ms since the Unix epoch]
+ * [varint key length][key][varint value length][value]; kind 1 writes a
+ * value and kind 2 erases the key. Every record goes out in a single
+ * write (followed by fsync unless disabled), and on open the log is
+ * replayed up to the first torn or corrupt record, where it is cut, so a
+ * crash loses at most the last write. The live set is kept in memory and
+ * the log is rewritten (temporary file + rename) once superseded records
+ * dominate it. Thread-safe.
+ */
+class LocalStore {
+private:
+    struct Entry {
+        std::string value;
+        int64_t storedAtMilliseconds = 0;
+    };
+
+    mutable std::mutex mutex;
+    std::string filePath;
+    std::FILE* file = nullptr;
+    bool syncWrites;
+    std::unordered_map<std::string, Entry> entries;
+    uint64_t fileBytes = 0;
+    uint64_t liveBytes = 0;
+
+    bool load();
+    bool append(uint8_t kind, const std::string& key, const std::string& value, int64_t storedAt);
+    void discardTornRecord();
+    bool rewrite();
+    void compactIfWasteful();
+
+public:
+    /**
+     * @brief Open (or create) a store file
+     * @param path Store file path
+     * @param sync fsync after every write; off trades durability on power
+     *             loss for speed (a process crash still loses nothing)
+     */
+    explicit LocalStore(const std::string& path, bool sync = true);
+    ~LocalStore();
+
+    LocalStore(const LocalStore&) = delete;
+    LocalStore& operator=(const LocalStore&) = delete;
+
+    /**
+     * @brief Check whether the file was opened successfully
+     */
+    bool isOpen() const noexcept;
+
+    /**
+     * @brief Read a value
+     * @return Empty if the key was never written or was erased
+     */
+    std::optional<StoredValue> get(const std::string& key) const;
+
+    /**
+     * @brief Write a value
+     * @param key Key
+     * @param value Value (replaces any previous one)
+     * @param storedAt Write time reported by get() (default: now)
+     * @return false if the record could not be written
+     */
+    bool put(const std::string& key, const std::string& value,
+             std::chrono::system_clock::time_point storedAt = std::chrono::system_clock::now());
+
+    /**
+     * @brief Remove a value
+     * @return false if the record could not be written
+     */
+    bool erase(const std::string& key);
+
+    /**
+     * @brief Number of live keys
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Rewrite the log with live records only
+     * @return false if the new file could not be written (the old one is kept)
+     */
+    bool compact();
+};
+
+} // namespace BSUIR
+
+#endif /* LocalStore_hpp */
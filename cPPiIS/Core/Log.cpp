@@ -0,0 +1,561 @@
+//
+//  Log.cpp
+//  cPPiIS Core C++ Logging Facade Implementation
+//
+
+#include "Log.hpp"
+#include "AtomicSnapshot.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BSUIR {
+namespace Log {
+
+namespace {
+
+constexpr std::size_t SCRATCH_CAPACITY = 2 * detail::MAX_STRING_ARG;
+constexpr std::size_t MIN_RING_CAPACITY = 4 * SCRATCH_CAPACITY;
+constexpr std::size_t DEFAULT_RING_CAPACITY = 64 * 1024;
+constexpr auto CONSUMER_INTERVAL = std::chrono::milliseconds(5);
+
+std::size_t roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Single-producer single-consumer byte ring owned by one thread
+ *
+ * Records are stored as [u32 length][payload] and may wrap around the
+ * end of the buffer. The producer only advances head, the consumer only
+ * advances tail; a record that does not fit is dropped and counted.
+ */
+struct Ring {
+    const std::size_t capacity;
+    const std::size_t mask;
+    std::unique_ptr<char[]> buffer;
+
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+    alignas(64) std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> abandoned{false};
+
+    explicit Ring(std::size_t bytes)
+        : capacity(bytes), mask(bytes - 1), buffer(new char[bytes]) {}
+
+    void copyIn(uint64_t position, const void* source, std::size_t count) {
+        const std::size_t offset = position & mask;
+        const std::size_t first = std::min(count, capacity - offset);
+        std::memcpy(buffer.get() + offset, source, first);
+        std::memcpy(buffer.get(), static_cast<const char*>(source) + first, count - first);
+    }
+
+    void copyOut(uint64_t position, void* destination, std::size_t count) const {
+        const std::size_t offset = position & mask;
+        const std::size_t first = std::min(count, capacity - offset);
+        std::memcpy(destination, buffer.get() + offset, first);
+        std::memcpy(static_cast<char*>(destination) + first, buffer.get(), count - first);
+    }
+
+    bool push(const char* bytes, std::size_t length) {
+        const auto size = static_cast<uint32_t>(length);
+        const uint64_t needed = sizeof(size) + length;
+        const uint64_t position = head.load(std::memory_order_relaxed);
+        if (capacity - (position - tail.load(std::memory_order_acquire)) < needed) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        copyIn(position, &size, sizeof(size));
+        copyIn(position + sizeof(size), bytes, length);
+        head.store(position + needed, std::memory_order_release);
+        written.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    template<typename Visitor>
+    void drain(std::string& scratch, Visitor&& visit) {
+        const uint64_t end = head.load(std::memory_order_acquire);
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        while (position < end) {
+            uint32_t size = 0;
+            copyOut(position, &size, sizeof(size));
+            scratch.resize(size);
+            copyOut(position + sizeof(size), scratch.data(), size);
+            position += sizeof(size) + size;
+            visit(std::string_view(scratch));
+        }
+        tail.store(position, std::memory_order_release);
+    }
+};
+
+/**
+ * @brief Bounds-checked reader over one encoded record
+ */
+class RecordReader {
+private:
+    std::string_view data;
+    std::size_t offset = 0;
+
+public:
+    explicit RecordReader(std::string_view record) : data(record) {}
+
+    template<typename T>
+    bool read(T& value) {
+        if (data.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool readBytes(std::size_t count, std::string_view& bytes) {
+        if (data.size() - offset < count) {
+            return false;
+        }
+        bytes = data.substr(offset, count);
+        offset += count;
+        return true;
+    }
+};
+
+void appendArgument(RecordReader& reader, std::string& message) {
+    uint8_t tag = 0;
+    if (!reader.read(tag)) {
+        return;
+    }
+    switch (static_cast<detail::ArgType>(tag)) {
+        case detail::ArgType::Int: {
+            int64_t value = 0;
+            if (reader.read(value)) message += std::to_string(value);
+            break;
+        }
+        case detail::ArgType::UInt: {
+            uint64_t value = 0;
+            if (reader.read(value)) message += std::to_string(value);
+            break;
+        }
+        case detail::ArgType::Double: {
+            double value = 0.0;
+            if (reader.read(value)) {
+                char text[32];
+                const int length = std::snprintf(text, sizeof(text), "%g", value);
+                message.append(text, length > 0 ? static_cast<std::size_t>(length) : 0);
+            }
+            break;
+        }
+        case detail::ArgType::Bool: {
+            uint8_t value = 0;
+            if (reader.read(value)) message += value ? '1' : '0';
+            break;
+        }
+        case detail::ArgType::Char: {
+            char value = 0;
+            if (reader.read(value)) message += value;
+            break;
+        }
+        case detail::ArgType::String: {
+            uint32_t length = 0;
+            std::string_view bytes;
+            if (reader.read(length) && reader.readBytes(length, bytes)) message += bytes;
+            break;
+        }
+    }
+}
+
+bool decodeRecord(std::string_view record, Entry& entry) {
+    RecordReader reader(record);
+    uint64_t nanoseconds = 0;
+    uint8_t level = 0;
+    uint8_t category = 0;
+    uint16_t argCount = 0;
+    const CallSite* site = nullptr;
+    if (!reader.read(nanoseconds) || !reader.read(level) || !reader.read(category) ||
+        !reader.read(argCount) || !reader.read(site)) {
+        return false;
+    }
+    entry.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+    entry.level = static_cast<Level>(level);
+    entry.category = static_cast<Category>(category);
+    entry.site = site;
+    entry.message.clear();
+    for (uint16_t i = 0; i < argCount; ++i) {
+        appendArgument(reader, entry.message);
+    }
+    return true;
+}
+
+std::string formatLine(const Entry& entry) {
+    std::string line;
+    line.reserve(entry.message.size() + 24);
+    line += "[";
+    line += levelName(entry.level);
+    line += "] ";
+    line += categoryName(entry.category);
+    line += ": ";
+    line += entry.message;
+    line += "\n";
+    return line;
+}
+
+using SinkList = std::vector<std::shared_ptr<ILogSink>>;
+
+/**
+ * @brief Ring registry and background consumer
+ *
+ * Intentionally leaked so that threads logging during static destruction
+ * never touch a destroyed pipeline; an atexit hook delivers what is left.
+ */
+class Pipeline {
+private:
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::atomic<std::size_t> ringCapacity{DEFAULT_RING_CAPACITY};
+
+    AtomicSnapshot<const SinkList> sinks;
+    std::shared_ptr<ILogSink> fallbackSink = std::make_shared<StderrSink>();
+
+    std::mutex drainMutex;
+    std::vector<Entry> batch;
+    std::string recordScratch;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeUp;
+    std::atomic<bool> stopping{false};
+    std::once_flag consumerStarted;
+
+    std::atomic<uint64_t> retiredWritten{0};
+    std::atomic<uint64_t> retiredDropped{0};
+    std::atomic<uint64_t> delivered{0};
+
+    void consumerLoop() {
+        while (!stopping.load(std::memory_order_acquire)) {
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wakeUp.wait_for(lock, CONSUMER_INTERVAL);
+            }
+            drain();
+        }
+    }
+
+public:
+    std::shared_ptr<Ring> registerRing() {
+        auto ring = std::make_shared<Ring>(ringCapacity.load(std::memory_order_relaxed));
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            rings.push_back(ring);
+        }
+        std::call_once(consumerStarted, [this] {
+            std::thread(&Pipeline::consumerLoop, this).detach();
+            std::atexit([] { Pipeline::instance().shutdown(); });
+        });
+        return ring;
+    }
+
+    void setRingCapacity(std::size_t bytes) {
+        ringCapacity.store(roundUpToPowerOfTwo(std::max(bytes, MIN_RING_CAPACITY)), std::memory_order_relaxed);
+    }
+
+    void wake() {
+        wakeUp.notify_one();
+    }
+
+    void setSinks(SinkList list) {
+        sinks.store(std::make_shared<const SinkList>(std::move(list)));
+    }
+
+    void addSink(std::shared_ptr<ILogSink> sink) {
+        sinks.update([&](const std::shared_ptr<const SinkList>& current) {
+            auto next = current ? std::make_shared<SinkList>(*current) : std::make_shared<SinkList>();
+            next->push_back(sink);
+            return std::shared_ptr<const SinkList>(std::move(next));
+        });
+    }
+
+    /**
+     * @brief Move every pending record to the sinks (serialised with flush())
+     */
+    void drain() {
+        std::lock_guard<std::mutex> drainLock(drainMutex);
+
+        std::vector<std::shared_ptr<Ring>> current;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            current = rings;
+        }
+
+        std::size_t count = 0;
+        std::vector<Ring*> finished;
+        for (const auto& ring : current) {
+            // Observed before draining: an abandoned ring receives no more records
+            const bool abandoned = ring->abandoned.load(std::memory_order_acquire);
+            ring->drain(recordScratch, [&](std::string_view record) {
+                if (batch.size() <= count) {
+                    batch.emplace_back();
+                }
+                if (decodeRecord(record, batch[count])) {
+                    ++count;
+                }
+            });
+            if (abandoned) {
+                finished.push_back(ring.get());
+            }
+        }
+
+        if (!finished.empty()) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            rings.erase(std::remove_if(rings.begin(), rings.end(), [&](const std::shared_ptr<Ring>& ring) {
+                if (std::find(finished.begin(), finished.end(), ring.get()) == finished.end()) {
+                    return false;
+                }
+                retiredWritten.fetch_add(ring->written.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                retiredDropped.fetch_add(ring->dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                return true;
+            }), rings.end());
+        }
+
+        if (count == 0) {
+            return;
+        }
+
+        // Rings are drained one after another; restore global order
+        std::stable_sort(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(count),
+                         [](const Entry& a, const Entry& b) { return a.timestamp < b.timestamp; });
+
+        auto installed = sinks.load();
+        auto deliverTo = [&](ILogSink& sink) {
+            for (std::size_t i = 0; i < count; ++i) {
+                sink.write(batch[i]);
+            }
+            sink.flush();
+        };
+        if (installed && !installed->empty()) {
+            for (const auto& sink : *installed) {
+                deliverTo(*sink);
+            }
+        } else {
+            deliverTo(*fallbackSink);
+        }
+        delivered.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void shutdown() {
+        drain();
+        stopping.store(true, std::memory_order_release);
+        wakeUp.notify_one();
+    }
+
+    Statistics statistics() {
+        Statistics result;
+        result.written = retiredWritten.load(std::memory_order_relaxed);
+        result.dropped = retiredDropped.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for (const auto& ring : rings) {
+                result.written += ring->written.load(std::memory_order_relaxed);
+                result.dropped += ring->dropped.load(std::memory_order_relaxed);
+            }
+        }
+        result.delivered = delivered.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    static Pipeline& instance() {
+        static Pipeline* pipeline = new Pipeline();
+        return *pipeline;
+    }
+};
+
+/**
+ * @brief Per-thread producer state; hands the ring to the consumer on thread exit
+ */
+struct ThreadState {
+    std::unique_ptr<char[]> scratch{new char[SCRATCH_CAPACITY]};
+    std::shared_ptr<Ring> ring;
+
+    ~ThreadState() {
+        if (ring) {
+            ring->abandoned.store(true, std::memory_order_release);
+        }
+    }
+};
+
+ThreadState& threadState() {
+    thread_local ThreadState state;
+    return state;
+}
+
+} // namespace
+
+// ============================================================================
+// MARK: - Producer
+// ============================================================================
+
+namespace detail {
+
+// Record layout: [u64 ns since epoch][u8 level][u8 category][u16 argc][const CallSite*]
+// followed by argc tagged arguments
+void RecordBuilder::header(Level level, Category category, const CallSite* site, uint16_t argCount) {
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const auto nanoseconds = static_cast<uint64_t>(now);
+    const auto levelValue = static_cast<uint8_t>(level);
+    const auto categoryValue = static_cast<uint8_t>(category);
+    size = 0;
+    append(&nanoseconds, sizeof(nanoseconds));
+    append(&levelValue, sizeof(levelValue));
+    append(&categoryValue, sizeof(categoryValue));
+    append(&argCount, sizeof(argCount));
+    append(&site, sizeof(site));
+}
+
+RecordBuilder beginRecord() {
+    return RecordBuilder(threadState().scratch.get(), SCRATCH_CAPACITY);
+}
+
+void submit(const RecordBuilder& record, Level level) {
+    ThreadState& state = threadState();
+    if (!state.ring) {
+        state.ring = Pipeline::instance().registerRing();
+    }
+    state.ring->push(record.bytes(), record.length());
+    if (level >= Level::Error) {
+        Pipeline::instance().wake();
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// MARK: - Sinks
+// ============================================================================
+
+void StderrSink::write(const Entry& entry) {
+    const std::string line = formatLine(entry);
+    std::fwrite(line.data(), 1, line.size(), stderr);
+}
+
+FileSink::FileSink(const std::string& path) : file(std::fopen(path.c_str(), "a")) {}
+
+FileSink::~FileSink() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+void FileSink::write(const Entry& entry) {
+    if (!file) {
+        return;
+    }
+    const auto seconds = std::chrono::system_clock::to_time_t(entry.timestamp);
+    const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+        entry.timestamp.time_since_epoch()).count() % 1000;
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &utc);
+    std::fprintf(file, "%s.%03dZ ", stamp, static_cast<int>(milliseconds));
+    const std::string line = formatLine(entry);
+    std::fwrite(line.data(), 1, line.size(), file);
+}
+
+void FileSink::flush() {
+    if (file) {
+        std::fflush(file);
+    }
+}
+
+// ============================================================================
+// MARK: - Configuration
+// ============================================================================
+
+const char* levelName(Level level) noexcept {
+    switch (level) {
+        case Level::Trace:   return "TRACE";
+        case Level::Debug:   return "DEBUG";
+        case Level::Info:    return "INFO";
+        case Level::Warning: return "WARNING";
+        case Level::Error:   return "ERROR";
+        case Level::Off:     return "OFF";
+    }
+    return "UNKNOWN";
+}
+
+const char* categoryName(Category category) noexcept {
+    switch (category) {
+        case Category::General:  return "General";
+        case Category::Network:  return "Network";
+        case Category::Parser:   return "Parser";
+        case Category::Api:      return "Api";
+        case Category::Executor: return "Executor";
+        case Category::Storage:  return "Storage";
+        case Category::Count:    break;
+    }
+    return "Unknown";
+}
+
+void setLevel(Category category, Level level) noexcept {
+    detail::categoryLevels[static_cast<std::size_t>(category)].store(static_cast<uint8_t>(level),
+                                                                     std::memory_order_relaxed);
+}
+
+void setLevel(Level level) noexcept {
+    for (auto& categoryLevel : detail::categoryLevels) {
+        categoryLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+}
+
+Level getLevel(Category category) noexcept {
+    return static_cast<Level>(detail::categoryLevels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed));
+}
+
+void addSink(std::shared_ptr<ILogSink> sink) {
+    if (sink) {
+        Pipeline::instance().addSink(std::move(sink));
+    }
+}
+
+void clearSinks() {
+    Pipeline::instance().setSinks({});
+}
+
+void setSink(Sink sink) {
+    if (!sink) {
+        clearSinks();
+        return;
+    }
+    auto callback = std::make_shared<Sink>(std::move(sink));
+    Pipeline::instance().setSinks({std::make_shared<DelegateSink>([callback](const Entry& entry) {
+        (*callback)(entry.level, entry.category, entry.message);
+    })});
+}
+
+void setRingCapacity(std::size_t bytes) {
+    Pipeline::instance().setRingCapacity(bytes);
+}
+
+void flush() {
+    Pipeline::instance().drain();
+}
+
+Statistics statistics() {
+    return Pipeline::instance().statistics();
+}
+
+void write(Level level, Category category, const std::string& message) {
+    detail::log(level, category, nullptr, message);
+}
+
+} // namespace Log
+} // namespace BSUIR
@@ -0,0 +1,368 @@
+//
+//  Log.hpp
+//  cPPiIS Core C++ Logging Facade
+//
+//  Structured logging with compile-time level thresholds, per-category
+//  runtime levels and a lock-free asynchronous pipeline
+//
+
+#ifndef Log_hpp
+#define Log_hpp
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Statements below this level are discarded at compile time together
+// with their arguments: 0 Trace, 1 Debug, 2 Info, 3 Warning, 4 Error, 5 Off.
+#ifndef BSUIR_LOG_MIN_LEVEL
+#  if defined(DEBUG) && DEBUG
+#    define BSUIR_LOG_MIN_LEVEL 1
+#  else
+#    define BSUIR_LOG_MIN_LEVEL 2
+#  endif
+#endif
+
+namespace BSUIR {
+namespace Log {
+
+/**
+ * @brief Log severity, ordered from most to least verbose
+ */
+enum class Level : uint8_t {
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warning = 3,
+    Error = 4,
+    Off = 5
+};
+
+/**
+ * @brief Subsystem a log statement belongs to
+ */
+enum class Category : uint8_t {
+    General,
+    Network,
+    Parser,
+    Api,
+    Executor,
+    Storage,
+    Count
+};
+
+const char* levelName(Level level) noexcept;
+const char* categoryName(Category category) noexcept;
+
+/**
+ * @brief Source location of a log statement, doubling as its format id
+ */
+struct CallSite {
+    const char* file;
+    int line;
+};
+
+/**
+ * @brief Formatted log entry handed to sinks on the consumer thread
+ */
+struct Entry {
+    std::chrono::system_clock::time_point timestamp;
+    Level level = Level::Info;
+    Category category = Category::General;
+    const CallSite* site = nullptr;     ///< nullptr for messages logged without a call site
+    std::string message;
+};
+
+/**
+ * @brief Destination for log entries
+ *
+ * Sinks are called from the single consumer thread (or from flush()),
+ * one write() per entry followed by one flush() per batch.
+ */
+class ILogSink {
+public:
+    virtual ~ILogSink() = default;
+    virtual void write(const Entry& entry) = 0;
+    virtual void flush() {}
+};
+
+/**
+ * @brief Writes "[LEVEL] Category: message" lines to stderr
+ */
+class StderrSink : public ILogSink {
+public:
+    void write(const Entry& entry) override;
+};
+
+/**
+ * @brief Appends timestamped lines to a file
+ */
+class FileSink : public ILogSink {
+private:
+    std::FILE* file;
+
+public:
+    explicit FileSink(const std::string& path);
+    ~FileSink() override;
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    bool isOpen() const noexcept { return file != nullptr; }
+    void write(const Entry& entry) override;
+    void flush() override;
+};
+
+/**
+ * @brief Forwards entries to a callback (used by BSUIRLogBridge)
+ */
+class DelegateSink : public ILogSink {
+public:
+    using Callback = std::function<void(const Entry&)>;
+    using BatchEnd = std::function<void()>;
+
+private:
+    Callback callback;
+    BatchEnd batchEnd;
+
+public:
+    explicit DelegateSink(Callback onEntry, BatchEnd onBatchEnd = nullptr)
+        : callback(std::move(onEntry)), batchEnd(std::move(onBatchEnd)) {}
+
+    void write(const Entry& entry) override { callback(entry); }
+    void flush() override { if (batchEnd) batchEnd(); }
+};
+
+/**
+ * @brief Pipeline counters
+ */
+struct Statistics {
+    uint64_t written = 0;   ///< Records accepted into a ring
+    uint64_t dropped = 0;   ///< Records discarded because a ring was full
+    uint64_t delivered = 0; ///< Records formatted and handed to sinks
+};
+
+namespace detail {
+
+// Runtime thresholds start at the compile-time threshold
+inline std::atomic<uint8_t> categoryLevels[static_cast<std::size_t>(Category::Count)] = {
+    BSUIR_LOG_MIN_LEVEL, BSUIR_LOG_MIN_LEVEL, BSUIR_LOG_MIN_LEVEL,
+    BSUIR_LOG_MIN_LEVEL, BSUIR_LOG_MIN_LEVEL, BSUIR_LOG_MIN_LEVEL
+};
+
+/**
+ * @brief Argument type tags of the binary record format
+ */
+enum class ArgType : uint8_t {
+    Int,
+    UInt,
+    Double,
+    Bool,
+    Char,
+    String
+};
+
+// Longer string arguments are cut so one record cannot monopolise a ring
+constexpr std::size_t MAX_STRING_ARG = 4096;
+
+/**
+ * @brief Thread-local scratch buffer a record is encoded into before it
+ *        is copied into the calling thread's ring
+ */
+class RecordBuilder {
+private:
+    char* data;
+    std::size_t size = 0;
+    std::size_t capacity;
+
+    void append(const void* bytes, std::size_t count) {
+        if (size + count > capacity) {
+            count = capacity > size ? capacity - size : 0;
+        }
+        std::memcpy(data + size, bytes, count);
+        size += count;
+    }
+
+    template<typename T>
+    void appendValue(ArgType type, T value) {
+        const auto tag = static_cast<uint8_t>(type);
+        append(&tag, 1);
+        append(&value, sizeof(value));
+    }
+
+public:
+    RecordBuilder(char* buffer, std::size_t bufferCapacity) : data(buffer), capacity(bufferCapacity) {}
+
+    void header(Level level, Category category, const CallSite* site, uint16_t argCount);
+
+    void add(std::string_view text) {
+        const std::size_t room = capacity - size > 5 ? capacity - size - 5 : 0;
+        if (text.size() > MAX_STRING_ARG || text.size() > room) {
+            text = text.substr(0, MAX_STRING_ARG < room ? MAX_STRING_ARG : room);
+        }
+        const auto tag = static_cast<uint8_t>(ArgType::String);
+        const auto length = static_cast<uint32_t>(text.size());
+        append(&tag, 1);
+        append(&length, sizeof(length));
+        append(text.data(), text.size());
+    }
+
+    template<typename T>
+    void add(const T& value) {
+        using Decayed = std::decay_t<T>;
+        if constexpr (std::is_same_v<Decayed, bool>) {
+            appendValue(ArgType::Bool, static_cast<uint8_t>(value));
+        } else if constexpr (std::is_same_v<Decayed, char>) {
+            appendValue(ArgType::Char, value);
+        } else if constexpr (std::is_integral_v<Decayed> && std::is_signed_v<Decayed>) {
+            appendValue(ArgType::Int, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<Decayed>) {
+            appendValue(ArgType::UInt, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_floating_point_v<Decayed>) {
+            appendValue(ArgType::Double, static_cast<double>(value));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            add(std::string_view(value));
+        } else {
+            // Rare argument types are formatted on the producer thread
+            std::ostringstream text;
+            text << value;
+            add(std::string_view(text.str()));
+        }
+    }
+
+    const char* bytes() const noexcept { return data; }
+    std::size_t length() const noexcept { return size; }
+};
+
+/**
+ * @brief Scratch buffer of the calling thread
+ */
+RecordBuilder beginRecord();
+
+/**
+ * @brief Copy an encoded record into the calling thread's ring (drops if full)
+ */
+void submit(const RecordBuilder& record, Level level);
+
+template<typename... Args>
+void log(Level level, Category category, const CallSite* site, const Args&... args) {
+    RecordBuilder record = beginRecord();
+    record.header(level, category, site, static_cast<uint16_t>(sizeof...(Args)));
+    (record.add(args), ...);
+    submit(record, level);
+}
+
+} // namespace detail
+
+/**
+ * @brief Runtime check used by the logging macros (a single load and compare)
+ */
+inline bool isEnabled(Level level, Category category) noexcept {
+    return static_cast<uint8_t>(level) >=
+           detail::categoryLevels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Set the runtime level of one category
+ */
+void setLevel(Category category, Level level) noexcept;
+
+/**
+ * @brief Set the runtime level of all categories
+ */
+void setLevel(Level level) noexcept;
+
+/**
+ * @brief Current runtime level of a category
+ */
+Level getLevel(Category category) noexcept;
+
+/**
+ * @brief Add a sink; with no sinks installed entries go to a StderrSink
+ */
+void addSink(std::shared_ptr<ILogSink> sink);
+
+/**
+ * @brief Remove all sinks (restores the default stderr output)
+ */
+void clearSinks();
+
+/**
+ * @brief Simple callback signature accepted by setSink()
+ */
+using Sink = std::function<void(Level, Category, const std::string&)>;
+
+/**
+ * @brief Replace all sinks with a single callback (nullptr restores stderr)
+ */
+void setSink(Sink sink);
+
+/**
+ * @brief Size of the ring created for each producer thread
+ * @param bytes Capacity, rounded up to a power of two; applies to
+ *              threads that have not logged yet
+ */
+void setRingCapacity(std::size_t bytes);
+
+/**
+ * @brief Drain every ring and deliver pending entries synchronously
+ */
+void flush();
+
+/**
+ * @brief Snapshot of the pipeline counters
+ */
+Statistics statistics();
+
+/**
+ * @brief Log a preformatted message without a call site
+ */
+void write(Level level, Category category, const std::string& message);
+
+/**
+ * @brief Log the concatenation of all arguments without a call site
+ */
+template<typename... Args>
+void format(Level level, Category category, const Args&... args) {
+    detail::log(level, category, nullptr, args...);
+}
+
+} // namespace Log
+} // namespace BSUIR
+
+/**
+ * Usage: BSUIR_LOG_DEBUG(Parser, "Parsed ", count, " subjects");
+ * Arguments are only evaluated when the statement is compiled in and
+ * the category is enabled at runtime. The producer only encodes the raw
+ * arguments into its thread's ring; formatting and I/O happen on the
+ * background consumer, and a full ring drops the record instead of
+ * blocking.
+ */
+#define BSUIR_LOG(LEVEL, CATEGORY, ...)                                                              \
+    do {                                                                                             \
+        if constexpr (static_cast<int>(::BSUIR::Log::Level::LEVEL) >= BSUIR_LOG_MIN_LEVEL) {          \
+            if (::BSUIR::Log::isEnabled(::BSUIR::Log::Level::LEVEL, ::BSUIR::Log::Category::CATEGORY)) { \
+                static constexpr ::BSUIR::Log::CallSite bsuirLogSite{__FILE__, __LINE__};             \
+                ::BSUIR::Log::detail::log(::BSUIR::Log::Level::LEVEL,                                \
+                                          ::BSUIR::Log::Category::CATEGORY,                          \
+                                          &bsuirLogSite, __VA_ARGS__);                               \
+            }                                                                                        \
+        }                                                                                            \
+    } while (0)
+
+#define BSUIR_LOG_TRACE(CATEGORY, ...)   BSUIR_LOG(Trace, CATEGORY, __VA_ARGS__)
+#define BSUIR_LOG_DEBUG(CATEGORY, ...)   BSUIR_LOG(Debug, CATEGORY, __VA_ARGS__)
+#define BSUIR_LOG_INFO(CATEGORY, ...)    BSUIR_LOG(Info, CATEGORY, __VA_ARGS__)
+#define BSUIR_LOG_WARNING(CATEGORY, ...) BSUIR_LOG(Warning, CATEGORY, __VA_ARGS__)
+#define BSUIR_LOG_ERROR(CATEGORY, ...)   BSUIR_LOG(Error, CATEGORY, __VA_ARGS__)
+
+#endif /* Log_hpp */
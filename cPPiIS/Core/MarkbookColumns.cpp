@@ -0,0 +1,263 @@
+//
+//  MarkbookColumns.cpp
+//  cPPiIS Core C++ Columnar Markbook Implementation
+//
+
+#include "MarkbookColumns.hpp"
+#include <algorithm>
+
+namespace BSUIR {
+
+namespace {
+
+std::size_t bitmapWords(std::size_t rows) {
+    return (rows + 63) / 64;
+}
+
+void setBit(std::vector<uint64_t>& bitmap, std::size_t row, bool value) {
+    const uint64_t mask = uint64_t{1} << (row & 63);
+    bitmap[row >> 6] = value ? (bitmap[row >> 6] | mask) : (bitmap[row >> 6] & ~mask);
+}
+
+// Bit of each row as 0.0 / 1.0, so kernels multiply instead of branching
+inline double bitAsDouble(const uint64_t* bitmap, std::size_t row) noexcept {
+    return static_cast<double>((bitmap[row >> 6] >> (row & 63)) & 1u);
+}
+
+constexpr std::size_t LANES = 4;
+
+double sumLanes(const double (&lanes)[LANES]) noexcept {
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+int clampGrade(int value) {
+    return std::clamp(value, 0, MarkbookColumns::MAX_GRADE);
+}
+
+} // namespace
+
+double MarkbookColumns::Aggregate::gpa() const noexcept {
+    if (credits > 0.0) {
+        return weightedSum / credits;
+    }
+    return graded ? gradeSum / graded : 0.0;
+}
+
+// ========================================
+// Construction
+// ========================================
+
+MarkbookColumns::MarkbookColumns(const Markbook& markbook) {
+    std::size_t rows = 0;
+    for (const auto& semester : markbook.semesters) {
+        rows += semester.subjects.size();
+    }
+    gradeColumn.reserve(rows);
+    creditColumn.reserve(rows);
+    hoursColumn.reserve(rows);
+    averageColumn.reserve(rows);
+    retakeChanceColumn.reserve(rows);
+    names.reserve(rows);
+    controlForms.reserve(rows);
+    rowSemester.reserve(rows);
+    gradeValid.assign(bitmapWords(rows), 0);
+    averageValid.assign(bitmapWords(rows), 0);
+
+    semesterOffsets.push_back(0);
+    for (const auto& semester : markbook.semesters) {
+        const auto semesterIndex = static_cast<uint32_t>(semesterNumbers.size());
+        semesterNumbers.push_back(semester.number);
+        for (const auto& subject : semester.subjects) {
+            const std::size_t row = gradeColumn.size();
+            gradeColumn.push_back(subject.grade ? clampGrade(*subject.grade) : 0.0);
+            creditColumn.push_back(static_cast<double>(subject.credits));
+            hoursColumn.push_back(subject.hours);
+            averageColumn.push_back(subject.averageGrade.value_or(0.0));
+            retakeChanceColumn.push_back(subject.retakeChance);
+            setBit(gradeValid, row, subject.grade.has_value());
+            setBit(averageValid, row, subject.averageGrade.has_value());
+            names.push_back(subject.name);
+            controlForms.push_back(subject.controlForm);
+            rowSemester.push_back(semesterIndex);
+        }
+        semesterOffsets.push_back(gradeColumn.size());
+    }
+
+    semesterTotals.reserve(semesterNumbers.size());
+    for (std::size_t i = 0; i < semesterNumbers.size(); ++i) {
+        semesterTotals.push_back(aggregateRows(semesterOffsets[i], semesterOffsets[i + 1]));
+    }
+    overallTotals = aggregateRows(0, rows);
+
+    for (std::size_t row = 0; row < rows; ++row) {
+        if (testBit(gradeValid, row)) {
+            ++gradeCounts[static_cast<std::size_t>(gradeColumn[row])];
+        }
+    }
+}
+
+std::optional<std::size_t> MarkbookColumns::findRow(int semester, const std::string& name,
+                                                    const std::string& controlForm) const {
+    // Row keys are interned, so a key never interned cannot match and the
+    // scan compares pointers
+    const auto internedName = StringPool::shared().find(name);
+    const auto internedForm = StringPool::shared().find(controlForm);
+    if (!internedName || !internedForm) {
+        return std::nullopt;
+    }
+
+    for (std::size_t i = 0; i < semesterNumbers.size(); ++i) {
+        if (semesterNumbers[i] != semester) {
+            continue;
+        }
+        for (std::size_t row = semesterOffsets[i]; row < semesterOffsets[i + 1]; ++row) {
+            if (names[row] == *internedName && controlForms[row] == *internedForm) {
+                return row;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<int> MarkbookColumns::grade(std::size_t row) const {
+    if (!testBit(gradeValid, row)) {
+        return std::nullopt;
+    }
+    return static_cast<int>(gradeColumn[row]);
+}
+
+std::optional<double> MarkbookColumns::averageGrade(std::size_t row) const {
+    if (!testBit(averageValid, row)) {
+        return std::nullopt;
+    }
+    return averageColumn[row];
+}
+
+// ========================================
+// Kernels
+// ========================================
+
+MarkbookColumns::Aggregate MarkbookColumns::aggregateRows(std::size_t begin, std::size_t end) const noexcept {
+    const double* grade = gradeColumn.data();
+    const double* credit = creditColumn.data();
+    const uint64_t* valid = gradeValid.data();
+
+    // Null grades are stored as 0, so only the denominators need the mask.
+    // Independent per-lane accumulators let the reductions vectorize
+    // without relaxing floating-point semantics.
+    double gradeSum[LANES] = {}, weightedSum[LANES] = {}, credits[LANES] = {}, graded[LANES] = {};
+    std::size_t row = begin;
+    for (; row + LANES <= end; row += LANES) {
+        for (std::size_t lane = 0; lane < LANES; ++lane) {
+            const double mask = bitAsDouble(valid, row + lane);
+            gradeSum[lane] += grade[row + lane];
+            weightedSum[lane] += grade[row + lane] * credit[row + lane];
+            credits[lane] += credit[row + lane] * mask;
+            graded[lane] += mask;
+        }
+    }
+    for (; row < end; ++row) {
+        const double mask = bitAsDouble(valid, row);
+        gradeSum[0] += grade[row];
+        weightedSum[0] += grade[row] * credit[row];
+        credits[0] += credit[row] * mask;
+        graded[0] += mask;
+    }
+    return Aggregate{sumLanes(gradeSum), sumLanes(weightedSum), sumLanes(credits),
+                     static_cast<uint32_t>(sumLanes(graded))};
+}
+
+double MarkbookColumns::semesterHours(std::size_t semesterIndex) const noexcept {
+    const double* hour = hoursColumn.data();
+    double total = 0.0;
+    for (std::size_t row = semesterOffsets[semesterIndex]; row < semesterOffsets[semesterIndex + 1]; ++row) {
+        total += hour[row];
+    }
+    return total;
+}
+
+double MarkbookColumns::semesterAverageGrade(std::size_t semesterIndex) const noexcept {
+    const double* average = averageColumn.data();
+    const uint64_t* valid = averageValid.data();
+    double sum = 0.0, count = 0.0;
+    for (std::size_t row = semesterOffsets[semesterIndex]; row < semesterOffsets[semesterIndex + 1]; ++row) {
+        sum += average[row];
+        count += bitAsDouble(valid, row);
+    }
+    return count > 0.0 ? sum / count : 0.0;
+}
+
+double MarkbookColumns::expectedRetakes() const noexcept {
+    const double* chance = retakeChanceColumn.data();
+    const uint64_t* valid = gradeValid.data();
+    double total = 0.0;
+    for (std::size_t row = 0; row < rowCount(); ++row) {
+        total += chance[row] * (1.0 - bitAsDouble(valid, row));
+    }
+    return total;
+}
+
+std::vector<std::size_t> MarkbookColumns::pendingRows() const {
+    std::vector<std::size_t> rows;
+    for (std::size_t row = 0; row < rowCount(); ++row) {
+        if (!testBit(gradeValid, row)) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+// ========================================
+// What-if
+// ========================================
+
+void MarkbookColumns::setGrade(std::size_t row, std::optional<int> value) {
+    Aggregate& semesterTotal = semesterTotals[rowSemester[row]];
+    const double credit = creditColumn[row];
+
+    if (testBit(gradeValid, row)) {
+        const double old = gradeColumn[row];
+        for (Aggregate* total : {&semesterTotal, &overallTotals}) {
+            total->gradeSum -= old;
+            total->weightedSum -= old * credit;
+            total->credits -= credit;
+            total->graded -= 1;
+        }
+        --gradeCounts[static_cast<std::size_t>(old)];
+    }
+
+    const double next = value ? clampGrade(*value) : 0.0;
+    gradeColumn[row] = next;
+    setBit(gradeValid, row, value.has_value());
+    if (value) {
+        for (Aggregate* total : {&semesterTotal, &overallTotals}) {
+            total->gradeSum += next;
+            total->weightedSum += next * credit;
+            total->credits += credit;
+            total->graded += 1;
+        }
+        ++gradeCounts[static_cast<std::size_t>(next)];
+    }
+}
+
+double MarkbookColumns::projectedGPA(int assumedGrade) const {
+    const double grade = clampGrade(assumedGrade);
+    const double* credit = creditColumn.data();
+    const uint64_t* valid = gradeValid.data();
+
+    double pendingCredits = 0.0, pendingRows = 0.0;
+    for (std::size_t row = 0; row < rowCount(); ++row) {
+        const double pending = 1.0 - bitAsDouble(valid, row);
+        pendingCredits += credit[row] * pending;
+        pendingRows += pending;
+    }
+
+    Aggregate projected = overallTotals;
+    projected.gradeSum += grade * pendingRows;
+    projected.weightedSum += grade * pendingCredits;
+    projected.credits += pendingCredits;
+    projected.graded += static_cast<uint32_t>(pendingRows);
+    return projected.gpa();
+}
+
+} // namespace BSUIR
@@ -0,0 +1,162 @@
+//
+//  MarkbookColumns.hpp
+//  cPPiIS Core C++ Columnar Markbook
+//
+//  Structure-of-arrays view of a Markbook with null bitmaps, branch-free
+//  aggregate kernels and incremental what-if updates
+//
+
+#ifndef MarkbookColumns_hpp
+#define MarkbookColumns_hpp
+
+#include "Models.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief Columnar copy of a markbook for analytics
+ *
+ * Subjects become rows stored semester by semester, so each semester is
+ * a contiguous row range. Numeric fields live in contiguous double
+ * columns; a missing grade or average is marked in a bitmap and stored
+ * as 0 in its column. Aggregates are computed once on construction by
+ * kernels without data-dependent branches (written for the compiler's
+ * auto-vectorizer) and are then maintained incrementally by setGrade(),
+ * which only touches the row's semester, the overall totals and the
+ * distribution. Copy the object to explore a scenario without losing
+ * the original.
+ */
+class MarkbookColumns {
+public:
+    static constexpr int MAX_GRADE = 10;
+
+    /**
+     * @brief Grade totals over a set of rows
+     */
+    struct Aggregate {
+        double gradeSum = 0.0;
+        double weightedSum = 0.0;   ///< Sum of grade × credits
+        double credits = 0.0;       ///< Credits of graded rows
+        uint32_t graded = 0;
+
+        /**
+         * @brief Credit-weighted mean grade (plain mean if no graded row carries credits)
+         */
+        double gpa() const noexcept;
+    };
+
+    /**
+     * @brief Number of rows per grade, index 0..MAX_GRADE
+     */
+    using Distribution = std::array<uint32_t, MAX_GRADE + 1>;
+
+private:
+    std::vector<double> gradeColumn;
+    std::vector<double> creditColumn;
+    std::vector<double> hoursColumn;
+    std::vector<double> averageColumn;
+    std::vector<double> retakeChanceColumn;
+    std::vector<uint64_t> gradeValid;       ///< Bit per row
+    std::vector<uint64_t> averageValid;
+
+    std::vector<InternedString> names;
+    std::vector<InternedString> controlForms;
+    std::vector<uint32_t> rowSemester;      ///< Semester index of each row
+    std::vector<int> semesterNumbers;
+    std::vector<std::size_t> semesterOffsets;   ///< Rows of semester i: [offsets[i], offsets[i + 1])
+
+    std::vector<Aggregate> semesterTotals;
+    Aggregate overallTotals;
+    Distribution gradeCounts{};
+
+    static bool testBit(const std::vector<uint64_t>& bitmap, std::size_t row) noexcept {
+        return (bitmap[row >> 6] >> (row & 63)) & 1u;
+    }
+
+    Aggregate aggregateRows(std::size_t begin, std::size_t end) const noexcept;
+
+public:
+    explicit MarkbookColumns(const Markbook& markbook);
+
+    std::size_t rowCount() const noexcept { return gradeColumn.size(); }
+    std::size_t semesterCount() const noexcept { return semesterNumbers.size(); }
+
+    int semesterNumber(std::size_t semesterIndex) const { return semesterNumbers[semesterIndex]; }
+
+    /**
+     * @brief Row range [first, second) of a semester
+     */
+    std::pair<std::size_t, std::size_t> semesterRows(std::size_t semesterIndex) const {
+        return {semesterOffsets[semesterIndex], semesterOffsets[semesterIndex + 1]};
+    }
+
+    /**
+     * @brief Row of a subject by its stable key
+     */
+    std::optional<std::size_t> findRow(int semester, const std::string& name, const std::string& controlForm) const;
+
+    // Row accessors
+    const std::string& name(std::size_t row) const { return names[row].str(); }
+    const std::string& controlForm(std::size_t row) const { return controlForms[row].str(); }
+    std::optional<int> grade(std::size_t row) const;
+    std::optional<double> averageGrade(std::size_t row) const;
+
+    // Raw columns (rowCount() elements; null entries hold 0)
+    const double* grades() const noexcept { return gradeColumn.data(); }
+    const double* credits() const noexcept { return creditColumn.data(); }
+    const double* hours() const noexcept { return hoursColumn.data(); }
+    const double* averageGrades() const noexcept { return averageColumn.data(); }
+    const double* retakeChances() const noexcept { return retakeChanceColumn.data(); }
+    const uint64_t* gradeBitmap() const noexcept { return gradeValid.data(); }
+    const uint64_t* averageBitmap() const noexcept { return averageValid.data(); }
+
+    // Aggregates
+    const Aggregate& semester(std::size_t semesterIndex) const { return semesterTotals[semesterIndex]; }
+    const Aggregate& overall() const noexcept { return overallTotals; }
+    const Distribution& distribution() const noexcept { return gradeCounts; }
+
+    /**
+     * @brief Total hours of a semester
+     */
+    double semesterHours(std::size_t semesterIndex) const noexcept;
+
+    /**
+     * @brief Mean group average over the rows of a semester that have one
+     */
+    double semesterAverageGrade(std::size_t semesterIndex) const noexcept;
+
+    /**
+     * @brief Expected number of retakes over rows still without a grade
+     */
+    double expectedRetakes() const noexcept;
+
+    /**
+     * @brief Rows still without a grade (pending exams and credits)
+     */
+    std::vector<std::size_t> pendingRows() const;
+
+    // What-if
+
+    /**
+     * @brief Set or clear a row's grade and update the affected aggregates in O(1)
+     * @param row Row index
+     * @param value Grade in 0..MAX_GRADE, or empty to clear it
+     */
+    void setGrade(std::size_t row, std::optional<int> value);
+
+    /**
+     * @brief Overall GPA if every pending row received the same grade
+     */
+    double projectedGPA(int assumedGrade) const;
+};
+
+} // namespace BSUIR
+
+#endif /* MarkbookColumns_hpp */
@@ -0,0 +1,532 @@
+//
+//  Metrics.cpp
+//  cPPiIS Core C++ Metrics Registry Implementation
+//
+
+#include "Metrics.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace BSUIR {
+namespace Metrics {
+
+// ============================================================================
+// MARK: - Allocation counting
+// ============================================================================
+
+namespace {
+
+thread_local uint64_t allocationCount = 0;
+
+} // namespace
+
+uint64_t threadAllocations() noexcept {
+    return allocationCount;
+}
+
+bool countsAllocations() noexcept {
+#if defined(BSUIR_METRICS_COUNT_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace Metrics
+} // namespace BSUIR
+
+#if defined(BSUIR_METRICS_COUNT_ALLOCATIONS)
+// Counting replacements of the global allocation functions; array and
+// nothrow forms forward to these by default
+void* operator new(std::size_t size) {
+    ++BSUIR::Metrics::allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#endif
+
+namespace BSUIR {
+namespace Metrics {
+
+// ============================================================================
+// MARK: - Counter
+// ============================================================================
+
+namespace detail {
+
+std::size_t shardIndex() noexcept {
+    static std::atomic<std::size_t> nextShard{0};
+    thread_local const std::size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return shard;
+}
+
+} // namespace detail
+
+uint64_t Counter::value() const noexcept {
+    uint64_t total = 0;
+    for (const auto& cell : cells) {
+        total += cell.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// ============================================================================
+// MARK: - Histogram
+// ============================================================================
+
+Histogram::Histogram(Unit unit) : valueUnit(unit), shards(new Shard[SHARD_COUNT]) {
+}
+
+std::size_t Histogram::bucketIndex(uint64_t value) noexcept {
+    constexpr uint64_t subBuckets = 1ull << SUB_BUCKET_BITS;
+    if (value < subBuckets) {
+        return static_cast<std::size_t>(value);
+    }
+    const unsigned msb = static_cast<unsigned>(std::bit_width(value)) - 1;
+    if (msb >= MAX_VALUE_BITS) {
+        return BUCKET_COUNT - 1;
+    }
+    const unsigned shift = msb - SUB_BUCKET_BITS;
+    const uint64_t subBucket = (value >> shift) & (subBuckets - 1);
+    return static_cast<std::size_t>((msb - SUB_BUCKET_BITS + 1) * subBuckets + subBucket);
+}
+
+uint64_t Histogram::bucketUpperBound(std::size_t index) noexcept {
+    constexpr uint64_t subBuckets = 1ull << SUB_BUCKET_BITS;
+    if (index < subBuckets) {
+        return index;
+    }
+    const uint64_t group = index >> SUB_BUCKET_BITS;
+    const uint64_t subBucket = index & (subBuckets - 1);
+    const unsigned shift = static_cast<unsigned>(group - 1);
+    const uint64_t lower = (subBuckets + subBucket) << shift;
+    return lower + (1ull << shift) - 1;
+}
+
+void Histogram::record(uint64_t value) noexcept {
+    Shard& shard = shards[detail::shardIndex() % SHARD_COUNT];
+    shard.buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t seen = shard.min.load(std::memory_order_relaxed);
+    while (value < seen && !shard.min.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+    seen = shard.max.load(std::memory_order_relaxed);
+    while (value > seen && !shard.max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot result;
+    std::array<uint64_t, BUCKET_COUNT> merged{};
+    uint64_t min = UINT64_MAX;
+    for (std::size_t s = 0; s < SHARD_COUNT; ++s) {
+        const Shard& shard = shards[s];
+        for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+            merged[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+        min = std::min(min, shard.min.load(std::memory_order_relaxed));
+        result.max = std::max(result.max, shard.max.load(std::memory_order_relaxed));
+    }
+    // Count from the merged buckets so quantiles stay consistent under concurrent writes
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        if (merged[i] != 0) {
+            result.buckets.emplace_back(bucketUpperBound(i), merged[i]);
+            result.count += merged[i];
+        }
+    }
+    result.min = result.count ? min : 0;
+    return result;
+}
+
+uint64_t HistogramSnapshot::percentile(double quantile) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    if (quantile <= 0.0) {
+        return min;
+    }
+    const auto rank = static_cast<uint64_t>(std::ceil(std::min(quantile, 1.0) * static_cast<double>(count)));
+    uint64_t seen = 0;
+    for (const auto& bucket : buckets) {
+        seen += bucket.second;
+        if (seen >= rank) {
+            return std::min(bucket.first, max);
+        }
+    }
+    return max;
+}
+
+// ============================================================================
+// MARK: - Registry
+// ============================================================================
+
+namespace {
+
+std::string makeKey(const std::string& name, const Labels& labels) {
+    std::string key = name;
+    for (const auto& label : labels) {
+        key += '\x1f';
+        key += label.first;
+        key += '=';
+        key += label.second;
+    }
+    return key;
+}
+
+} // namespace
+
+MetricsRegistry& MetricsRegistry::shared() {
+    // Leaked: metrics may be updated during static destruction
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::findOrCreate(const std::string& name, const std::string& help, Labels labels,
+                                                      RegistrySnapshot::Type type, Histogram::Unit unit) {
+    std::sort(labels.begin(), labels.end());
+    const std::string key = makeKey(name, labels);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = entries[key];
+    if (!slot) {
+        slot = std::make_unique<Entry>();
+        slot->name = name;
+        slot->help = help;
+        slot->labels = std::move(labels);
+        slot->type = type;
+        switch (type) {
+            case RegistrySnapshot::Type::Counter:   slot->counter = std::make_unique<Counter>(); break;
+            case RegistrySnapshot::Type::Gauge:     slot->gauge = std::make_unique<Gauge>(); break;
+            case RegistrySnapshot::Type::Histogram: slot->histogram = std::make_unique<Histogram>(unit); break;
+        }
+    }
+    return *slot;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, Labels labels, const std::string& help) {
+    Entry& entry = findOrCreate(name, help, std::move(labels), RegistrySnapshot::Type::Counter, Histogram::Unit::Count);
+    return *entry.counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, Labels labels, const std::string& help) {
+    Entry& entry = findOrCreate(name, help, std::move(labels), RegistrySnapshot::Type::Gauge, Histogram::Unit::Count);
+    return *entry.gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, Labels labels, const std::string& help,
+                                      Histogram::Unit unit) {
+    Entry& entry = findOrCreate(name, help, std::move(labels), RegistrySnapshot::Type::Histogram, unit);
+    return *entry.histogram;
+}
+
+RegistrySnapshot MetricsRegistry::snapshot() const {
+    RegistrySnapshot result;
+    std::lock_guard<std::mutex> lock(mutex);
+    result.metrics.reserve(entries.size());
+    for (const auto& item : entries) {
+        const Entry& entry = *item.second;
+        RegistrySnapshot::Metric metric;
+        metric.name = entry.name;
+        metric.help = entry.help;
+        metric.labels = entry.labels;
+        metric.type = entry.type;
+        switch (entry.type) {
+            case RegistrySnapshot::Type::Counter:
+                metric.value = static_cast<int64_t>(entry.counter->value());
+                break;
+            case RegistrySnapshot::Type::Gauge:
+                metric.value = entry.gauge->value();
+                break;
+            case RegistrySnapshot::Type::Histogram:
+                metric.unit = entry.histogram->unit();
+                metric.histogram = entry.histogram->snapshot();
+                break;
+        }
+        result.metrics.push_back(std::move(metric));
+    }
+    return result;
+}
+
+// ============================================================================
+// MARK: - Exporters
+// ============================================================================
+
+namespace {
+
+void appendEscaped(std::string& out, const std::string& text, bool json) {
+    for (char c : text) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"':  out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default:
+                if (json && static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+}
+
+std::string formatNumber(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.9g", value);
+    return text;
+}
+
+// Export value of a histogram sample (seconds for durations)
+std::string exportValue(uint64_t value, Histogram::Unit unit) {
+    return unit == Histogram::Unit::Nanoseconds ? formatNumber(static_cast<double>(value) / 1e9)
+                                                : std::to_string(value);
+}
+
+void appendPrometheusLabels(std::string& out, const Labels& labels, const char* extraKey = nullptr,
+                            const std::string& extraValue = "") {
+    if (labels.empty() && !extraKey) {
+        return;
+    }
+    out += '{';
+    bool first = true;
+    for (const auto& label : labels) {
+        if (!first) out += ',';
+        first = false;
+        out += label.first;
+        out += "=\"";
+        appendEscaped(out, label.second, false);
+        out += '"';
+    }
+    if (extraKey) {
+        if (!first) out += ',';
+        out += extraKey;
+        out += "=\"";
+        out += extraValue;
+        out += '"';
+    }
+    out += '}';
+}
+
+const char* prometheusType(RegistrySnapshot::Type type) {
+    switch (type) {
+        case RegistrySnapshot::Type::Counter:   return "counter";
+        case RegistrySnapshot::Type::Gauge:     return "gauge";
+        case RegistrySnapshot::Type::Histogram: return "summary";
+    }
+    return "untyped";
+}
+
+constexpr double EXPORTED_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+} // namespace
+
+std::string toPrometheus(const RegistrySnapshot& snapshot) {
+    std::string out;
+    const std::string* previousName = nullptr;
+    for (const auto& metric : snapshot.metrics) {
+        if (!previousName || *previousName != metric.name) {
+            if (!metric.help.empty()) {
+                out += "# HELP " + metric.name + " ";
+                appendEscaped(out, metric.help, false);
+                out += "\n";
+            }
+            out += "# TYPE " + metric.name + " " + prometheusType(metric.type) + "\n";
+            previousName = &metric.name;
+        }
+
+        if (metric.type != RegistrySnapshot::Type::Histogram) {
+            out += metric.name;
+            appendPrometheusLabels(out, metric.labels);
+            out += " " + std::to_string(metric.value) + "\n";
+            continue;
+        }
+
+        const HistogramSnapshot& histogram = metric.histogram;
+        for (double quantile : EXPORTED_QUANTILES) {
+            out += metric.name;
+            appendPrometheusLabels(out, metric.labels, "quantile", formatNumber(quantile));
+            out += " " + exportValue(histogram.percentile(quantile), metric.unit) + "\n";
+        }
+        out += metric.name + "_sum";
+        appendPrometheusLabels(out, metric.labels);
+        out += " " + exportValue(histogram.sum, metric.unit) + "\n";
+        out += metric.name + "_count";
+        appendPrometheusLabels(out, metric.labels);
+        out += " " + std::to_string(histogram.count) + "\n";
+    }
+    return out;
+}
+
+std::string toJSON(const RegistrySnapshot& snapshot) {
+    std::string out = "{\"metrics\":[";
+    bool firstMetric = true;
+    for (const auto& metric : snapshot.metrics) {
+        if (!firstMetric) out += ',';
+        firstMetric = false;
+
+        out += "{\"name\":\"";
+        appendEscaped(out, metric.name, true);
+        out += "\",\"type\":\"";
+        out += metric.type == RegistrySnapshot::Type::Histogram ? "histogram" : prometheusType(metric.type);
+        out += "\",\"labels\":{";
+        bool firstLabel = true;
+        for (const auto& label : metric.labels) {
+            if (!firstLabel) out += ',';
+            firstLabel = false;
+            out += '"';
+            appendEscaped(out, label.first, true);
+            out += "\":\"";
+            appendEscaped(out, label.second, true);
+            out += '"';
+        }
+        out += '}';
+
+        if (metric.type != RegistrySnapshot::Type::Histogram) {
+            out += ",\"value\":" + std::to_string(metric.value) + "}";
+            continue;
+        }
+
+        const HistogramSnapshot& histogram = metric.histogram;
+        out += ",\"unit\":\"";
+        out += metric.unit == Histogram::Unit::Nanoseconds ? "ns" : "count";
+        out += "\",\"count\":" + std::to_string(histogram.count);
+        out += ",\"sum\":" + std::to_string(histogram.sum);
+        out += ",\"min\":" + std::to_string(histogram.min);
+        out += ",\"max\":" + std::to_string(histogram.max);
+        out += ",\"p50\":" + std::to_string(histogram.percentile(0.5));
+        out += ",\"p90\":" + std::to_string(histogram.percentile(0.9));
+        out += ",\"p99\":" + std::to_string(histogram.percentile(0.99));
+        out += ",\"p999\":" + std::to_string(histogram.percentile(0.999));
+        out += ",\"buckets\":[";
+        bool firstBucket = true;
+        for (const auto& bucket : histogram.buckets) {
+            if (!firstBucket) out += ',';
+            firstBucket = false;
+            out += "[" + std::to_string(bucket.first) + "," + std::to_string(bucket.second) + "]";
+        }
+        out += "]}";
+    }
+    out += "]}";
+    return out;
+}
+
+bool writePrometheusFile(const MetricsRegistry& registry, const std::string& path) {
+    const std::string text = toPrometheus(registry.snapshot());
+    const std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    const bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    if (std::fclose(file) != 0 || !written) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+// ============================================================================
+// MARK: - Pre-wired core metrics
+// ============================================================================
+
+namespace {
+
+std::string normalizeEndpoint(const std::string& endpoint) {
+    std::string path = endpoint;
+    const auto scheme = path.find("://");
+    if (scheme != std::string::npos) {
+        const auto slash = path.find('/', scheme + 3);
+        path = slash == std::string::npos ? "/" : path.substr(slash);
+    }
+    const auto query = path.find('?');
+    if (query != std::string::npos) {
+        path.resize(query);
+    }
+    if (path.rfind("/api/v1", 0) == 0) {
+        path.erase(0, 7);
+    }
+    if (path.empty() || path.front() != '/') {
+        path.insert(path.begin(), '/');
+    }
+    return path;
+}
+
+using EndpointMap = std::unordered_map<std::string, std::shared_ptr<const EndpointMetrics>>;
+
+AtomicSnapshot<const EndpointMap>& endpointCache() {
+    static AtomicSnapshot<const EndpointMap>* cache = new AtomicSnapshot<const EndpointMap>();
+    return *cache;
+}
+
+std::shared_ptr<const EndpointMetrics> createEndpointMetrics(const std::string& path) {
+    MetricsRegistry& registry = MetricsRegistry::shared();
+    const Labels labels{{"endpoint", path}};
+    auto metrics = std::make_shared<EndpointMetrics>();
+    metrics->path = path;
+    metrics->requests = &registry.counter("bsuir_http_requests_total", labels, "Requests sent");
+    metrics->retries = &registry.counter("bsuir_http_retries_total", labels, "Requests repeated after a failure");
+    metrics->cacheHits = &registry.counter("bsuir_cache_hits_total", labels, "Reads served from the local cache");
+    metrics->cacheMisses = &registry.counter("bsuir_cache_misses_total", labels, "Reads that had to go to the network");
+    metrics->bytesIn = &registry.counter("bsuir_http_received_bytes_total", labels, "Response body bytes received");
+    metrics->bytesOut = &registry.counter("bsuir_http_sent_bytes_total", labels, "Request body bytes sent");
+    metrics->duration = &registry.histogram("bsuir_http_request_duration_seconds", labels,
+                                            "Time from send to response");
+    metrics->parseTime = &registry.histogram("bsuir_parse_duration_seconds", labels, "JSON decoding time");
+    metrics->parseAllocations = &registry.histogram("bsuir_parse_allocations", labels,
+                                                    "Heap allocations per decode", Histogram::Unit::Count);
+    return metrics;
+}
+
+} // namespace
+
+const EndpointMetrics& endpoint(const std::string& endpointPath) {
+    // Keyed by the normalised path: raw keys would add an entry, and a copy
+    // of the map, for every distinct query string (/skill?name=<prefix>)
+    const std::string path = normalizeEndpoint(endpointPath);
+    if (auto cache = endpointCache().load()) {
+        auto found = cache->find(path);
+        if (found != cache->end()) {
+            return *found->second;
+        }
+    }
+
+    const auto metrics = createEndpointMetrics(path);
+    std::shared_ptr<const EndpointMetrics> result;
+    endpointCache().update([&](const std::shared_ptr<const EndpointMap>& current) {
+        auto next = current ? std::make_shared<EndpointMap>(*current) : std::make_shared<EndpointMap>();
+        result = next->emplace(path, metrics).first->second;
+        return std::shared_ptr<const EndpointMap>(std::move(next));
+    });
+    return *result;
+}
+
+void recordError(const EndpointMetrics& metrics, int statusCode) {
+    MetricsRegistry::shared()
+        .counter("bsuir_http_errors_total",
+                 {{"endpoint", metrics.path}, {"status", std::to_string(statusCode)}},
+                 "Failed requests by status code (0: transport error)")
+        .add();
+}
+
+Gauge& inFlight() {
+    static Gauge& gauge = MetricsRegistry::shared().gauge("bsuir_http_in_flight", {}, "Requests awaiting a response");
+    return gauge;
+}
+
+} // namespace Metrics
+} // namespace BSUIR
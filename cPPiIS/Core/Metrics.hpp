@@ -0,0 +1,293 @@
+//
+//  Metrics.hpp
+//  cPPiIS Core C++ Metrics Registry
+//
+//  Sharded counters, gauges and log-linear latency histograms with a
+//  snapshot API and Prometheus / JSON exporters
+//
+
+#ifndef Metrics_hpp
+#define Metrics_hpp
+
+#include "AtomicSnapshot.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace BSUIR {
+namespace Metrics {
+
+/**
+ * @brief Label set of a metric, e.g. {{"endpoint", "/markbook"}}
+ */
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+namespace detail {
+
+constexpr std::size_t SHARD_COUNT = 16;
+
+/**
+ * @brief Shard assigned to the calling thread (round-robin on first use)
+ */
+std::size_t shardIndex() noexcept;
+
+} // namespace detail
+
+/**
+ * @brief Monotonic counter sharded across cache lines
+ *
+ * Each thread increments its own shard with a relaxed add; value()
+ * sums the shards.
+ */
+class Counter {
+private:
+    struct alignas(64) Cell {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Cell, detail::SHARD_COUNT> cells;
+
+public:
+    void add(uint64_t amount = 1) noexcept {
+        cells[detail::shardIndex()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const noexcept;
+};
+
+/**
+ * @brief Value that can go up and down
+ */
+class Gauge {
+private:
+    std::atomic<int64_t> current{0};
+
+public:
+    void set(int64_t value) noexcept { current.store(value, std::memory_order_relaxed); }
+    void add(int64_t delta) noexcept { current.fetch_add(delta, std::memory_order_relaxed); }
+    int64_t value() const noexcept { return current.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Merged state of a histogram at one point in time
+ */
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> buckets;     ///< (inclusive upper bound, count), non-empty only
+
+    /**
+     * @brief Value at a quantile (upper bound of the containing bucket, capped at max)
+     * @param quantile In [0, 1]
+     */
+    uint64_t percentile(double quantile) const noexcept;
+
+    double mean() const noexcept { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+};
+
+/**
+ * @brief HDR-style log-linear histogram of non-negative integers
+ *
+ * Every power of two is split into 16 linear sub-buckets, bounding the
+ * relative error at 6.25% over [0, 2^40). Values are recorded into the
+ * calling thread's shard with relaxed atomics, so recording never locks
+ * and snapshots merge shards without stopping writers.
+ */
+class Histogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 4;
+    static constexpr unsigned MAX_VALUE_BITS = 40;
+    static constexpr std::size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+    static constexpr std::size_t SHARD_COUNT = 4;
+
+    /**
+     * @brief What recorded values measure (affects export only)
+     */
+    enum class Unit {
+        Nanoseconds,    ///< Exported in seconds
+        Count           ///< Exported as is
+    };
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> min{UINT64_MAX};
+        std::atomic<uint64_t> max{0};
+    };
+
+    Unit valueUnit;
+    std::unique_ptr<Shard[]> shards;
+
+public:
+    explicit Histogram(Unit unit = Unit::Nanoseconds);
+
+    /**
+     * @brief Bucket index of a value
+     */
+    static std::size_t bucketIndex(uint64_t value) noexcept;
+
+    /**
+     * @brief Largest value that maps to a bucket
+     */
+    static uint64_t bucketUpperBound(std::size_t index) noexcept;
+
+    void record(uint64_t value) noexcept;
+
+    template<typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> duration) noexcept {
+        const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        record(static_cast<uint64_t>(nanoseconds > 0 ? nanoseconds : 0));
+    }
+
+    HistogramSnapshot snapshot() const;
+
+    Unit unit() const noexcept { return valueUnit; }
+};
+
+/**
+ * @brief Point-in-time copy of every registered metric
+ */
+struct RegistrySnapshot {
+    enum class Type { Counter, Gauge, Histogram };
+
+    struct Metric {
+        std::string name;
+        std::string help;
+        Labels labels;
+        Type type = Type::Counter;
+        Histogram::Unit unit = Histogram::Unit::Count;
+        int64_t value = 0;                  ///< Counter / gauge value
+        HistogramSnapshot histogram;        ///< Histogram state
+    };
+
+    std::vector<Metric> metrics;            ///< Ordered by name, then labels
+};
+
+/**
+ * @brief Owner of named metrics
+ *
+ * Lookups take a mutex and are meant for wiring time; hot paths keep
+ * the returned reference, which stays valid for the registry's lifetime.
+ */
+class MetricsRegistry {
+private:
+    struct Entry {
+        std::string name;
+        std::string help;
+        Labels labels;
+        RegistrySnapshot::Type type;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::string, std::unique_ptr<Entry>> entries;
+
+    Entry& findOrCreate(const std::string& name, const std::string& help, Labels labels,
+                        RegistrySnapshot::Type type, Histogram::Unit unit);
+
+public:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief Process-wide registry used by the pre-wired core metrics
+     */
+    static MetricsRegistry& shared();
+
+    Counter& counter(const std::string& name, Labels labels = {}, const std::string& help = "");
+    Gauge& gauge(const std::string& name, Labels labels = {}, const std::string& help = "");
+    Histogram& histogram(const std::string& name, Labels labels = {}, const std::string& help = "",
+                         Histogram::Unit unit = Histogram::Unit::Nanoseconds);
+
+    RegistrySnapshot snapshot() const;
+};
+
+// ========================================
+// Exporters
+// ========================================
+
+/**
+ * @brief Prometheus text exposition format (histograms as summaries)
+ */
+std::string toPrometheus(const RegistrySnapshot& snapshot);
+
+/**
+ * @brief JSON document with counters, gauges and histogram buckets
+ */
+std::string toJSON(const RegistrySnapshot& snapshot);
+
+/**
+ * @brief Atomically replace a file with the Prometheus export
+ *        (for the node_exporter textfile collector)
+ * @return false if the file could not be written
+ */
+bool writePrometheusFile(const MetricsRegistry& registry, const std::string& path);
+
+// ========================================
+// Pre-wired core metrics
+// ========================================
+
+/**
+ * @brief Metrics of one API endpoint in the shared registry
+ */
+struct EndpointMetrics {
+    std::string path;           ///< Normalised endpoint label
+    Counter* requests;          ///< bsuir_http_requests_total
+    Counter* retries;           ///< bsuir_http_retries_total
+    Counter* cacheHits;         ///< bsuir_cache_hits_total
+    Counter* cacheMisses;       ///< bsuir_cache_misses_total
+    Counter* bytesIn;           ///< bsuir_http_received_bytes_total
+    Counter* bytesOut;          ///< bsuir_http_sent_bytes_total
+    Histogram* duration;        ///< bsuir_http_request_duration_seconds
+    Histogram* parseTime;       ///< bsuir_parse_duration_seconds
+    Histogram* parseAllocations;///< bsuir_parse_allocations
+};
+
+/**
+ * @brief Endpoint metrics, created on first use
+ * @param endpoint Path or URL; scheme, host, /api/v1 and query are stripped
+ */
+const EndpointMetrics& endpoint(const std::string& endpoint);
+
+/**
+ * @brief Count a failed request in bsuir_http_errors_total
+ * @param metrics Endpoint the request went to
+ * @param statusCode HTTP status (0 for transport failures)
+ */
+void recordError(const EndpointMetrics& metrics, int statusCode);
+
+/**
+ * @brief Requests currently waiting for a response (bsuir_http_in_flight)
+ */
+Gauge& inFlight();
+
+/**
+ * @brief Heap allocations made by the calling thread so far
+ *
+ * Counted only when the core is built with BSUIR_METRICS_COUNT_ALLOCATIONS,
+ * which replaces the global operator new; always 0 otherwise.
+ */
+uint64_t threadAllocations() noexcept;
+
+/**
+ * @brief Whether allocation counting was compiled in
+ */
+bool countsAllocations() noexcept;
+
+} // namespace Metrics
+} // namespace BSUIR
+
+#endif /* Metrics_hpp */
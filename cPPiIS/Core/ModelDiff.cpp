@@ -0,0 +1,214 @@
+//
+//  ModelDiff.cpp
+//  cPPiIS Core C++ Model Diffing Implementation
+//
+
+#include "ModelDiff.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace BSUIR {
+
+namespace {
+
+// Tolerance for server-side rounding of averages and probabilities
+constexpr double EPSILON = 1e-9;
+
+bool differs(double a, double b) {
+    return std::fabs(a - b) > EPSILON;
+}
+
+bool differs(const std::optional<double>& a, const std::optional<double>& b) {
+    if (a.has_value() != b.has_value()) {
+        return true;
+    }
+    return a.has_value() && differs(*a, *b);
+}
+
+/**
+ * @brief Key of a subject; names are interned, so hashing and comparing
+ *        it never touches the text
+ */
+struct SubjectKey {
+    int semester;
+    InternedString name;
+    InternedString controlForm;
+
+    bool operator==(const SubjectKey& other) const noexcept {
+        return semester == other.semester && name == other.name && controlForm == other.controlForm;
+    }
+};
+
+struct SubjectKeyHash {
+    std::size_t operator()(const SubjectKey& key) const noexcept {
+        const std::hash<InternedString> hash;
+        std::size_t seed = std::hash<int>()(key.semester);
+        seed ^= hash(key.name) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        seed ^= hash(key.controlForm) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+MarkbookChange makeChange(MarkbookChangeKind kind, int semester, const Subject& subject) {
+    MarkbookChange change;
+    change.kind = kind;
+    change.semester = semester;
+    change.subject = subject.name;
+    change.controlForm = subject.controlForm;
+    return change;
+}
+
+void compareSubjects(int semester, const Subject& before, const Subject& after,
+                     std::vector<MarkbookChange>& changes) {
+    if (before.grade != after.grade) {
+        const MarkbookChangeKind kind = !before.grade ? MarkbookChangeKind::GradePosted
+                                      : !after.grade  ? MarkbookChangeKind::GradeRemoved
+                                                      : MarkbookChangeKind::GradeChanged;
+        MarkbookChange change = makeChange(kind, semester, after);
+        change.oldGrade = before.grade;
+        change.newGrade = after.grade;
+        changes.push_back(std::move(change));
+    }
+    if (differs(before.averageGrade, after.averageGrade)) {
+        MarkbookChange change = makeChange(MarkbookChangeKind::AverageChanged, semester, after);
+        change.oldAverage = before.averageGrade;
+        change.newAverage = after.averageGrade;
+        changes.push_back(std::move(change));
+    }
+    if (differs(before.retakeChance, after.retakeChance)) {
+        MarkbookChange change = makeChange(MarkbookChangeKind::RetakeChanceChanged, semester, after);
+        change.oldRetakeChance = before.retakeChance;
+        change.newRetakeChance = after.retakeChance;
+        changes.push_back(std::move(change));
+    }
+}
+
+} // namespace
+
+std::vector<MarkbookChange> MarkbookChangeSet::ofKind(MarkbookChangeKind kind) const {
+    std::vector<MarkbookChange> result;
+    for (const auto& change : changes) {
+        if (change.kind == kind) {
+            result.push_back(change);
+        }
+    }
+    return result;
+}
+
+MarkbookChangeSet diffMarkbook(const Markbook& before, const Markbook& after) {
+    std::size_t subjectCount = 0;
+    for (const auto& semester : before.semesters) {
+        subjectCount += semester.subjects.size();
+    }
+
+    // Old subjects by key in order of appearance; a key's subjects are
+    // consumed front to back, so what is left over are removals
+    struct Candidates {
+        std::vector<const Subject*> subjects;
+        std::size_t matched = 0;
+    };
+    std::unordered_map<SubjectKey, Candidates, SubjectKeyHash> index;
+    index.reserve(subjectCount);
+    for (const auto& semester : before.semesters) {
+        for (const auto& subject : semester.subjects) {
+            index[SubjectKey{semester.number, subject.name, subject.controlForm}].subjects.push_back(&subject);
+        }
+    }
+
+    MarkbookChangeSet result;
+    std::size_t matchedCount = 0;
+    for (const auto& semester : after.semesters) {
+        for (const auto& subject : semester.subjects) {
+            auto found = index.find(SubjectKey{semester.number, subject.name, subject.controlForm});
+            if (found == index.end() || found->second.matched == found->second.subjects.size()) {
+                MarkbookChange change = makeChange(MarkbookChangeKind::SubjectAdded, semester.number, subject);
+                change.newGrade = subject.grade;
+                change.newAverage = subject.averageGrade;
+                change.newRetakeChance = subject.retakeChance;
+                result.changes.push_back(std::move(change));
+                if (subject.grade) {
+                    MarkbookChange posted = makeChange(MarkbookChangeKind::GradePosted, semester.number, subject);
+                    posted.newGrade = subject.grade;
+                    result.changes.push_back(std::move(posted));
+                }
+                continue;
+            }
+            compareSubjects(semester.number, *found->second.subjects[found->second.matched++], subject, result.changes);
+            ++matchedCount;
+        }
+    }
+
+    // Report removals in the old snapshot's order
+    if (matchedCount < subjectCount) {
+        for (const auto& semester : before.semesters) {
+            for (const auto& subject : semester.subjects) {
+                const Candidates& candidates =
+                    index.find(SubjectKey{semester.number, subject.name, subject.controlForm})->second;
+                if (std::find(candidates.subjects.begin() + static_cast<std::ptrdiff_t>(candidates.matched),
+                              candidates.subjects.end(), &subject) == candidates.subjects.end()) {
+                    continue;
+                }
+                MarkbookChange change = makeChange(MarkbookChangeKind::SubjectRemoved, semester.number, subject);
+                change.oldGrade = subject.grade;
+                change.oldAverage = subject.averageGrade;
+                change.oldRetakeChance = subject.retakeChance;
+                result.changes.push_back(std::move(change));
+            }
+        }
+    }
+    return result;
+}
+
+GroupChangeSet diffGroupInfo(const GroupInfo& before, const GroupInfo& after) {
+    std::unordered_map<int, const GroupStudent*> index;
+    index.reserve(before.students.size());
+    for (const auto& student : before.students) {
+        index.emplace(student.number, &student);
+    }
+
+    GroupChangeSet result;
+    std::unordered_set<const GroupStudent*> removed;
+    for (const auto& student : after.students) {
+        auto found = index.find(student.number);
+        if (found != index.end()) {
+            const bool same = found->second->fullName == student.fullName;
+            if (!same) {
+                removed.insert(found->second);
+            }
+            index.erase(found);
+            if (same) {
+                continue;
+            }
+        }
+        result.changes.push_back({GroupChangeKind::StudentAdded, student});
+    }
+    for (const auto& entry : index) {
+        removed.insert(entry.second);
+    }
+
+    // Report removals in the old roster's order
+    for (const auto& student : before.students) {
+        if (removed.count(&student) != 0) {
+            result.changes.push_back({GroupChangeKind::StudentRemoved, student});
+        }
+    }
+    return result;
+}
+
+const char* markbookChangeKindName(MarkbookChangeKind kind) noexcept {
+    switch (kind) {
+        case MarkbookChangeKind::SubjectAdded:        return "subjectAdded";
+        case MarkbookChangeKind::SubjectRemoved:      return "subjectRemoved";
+        case MarkbookChangeKind::GradePosted:         return "gradePosted";
+        case MarkbookChangeKind::GradeChanged:        return "gradeChanged";
+        case MarkbookChangeKind::GradeRemoved:        return "gradeRemoved";
+        case MarkbookChangeKind::AverageChanged:      return "averageChanged";
+        case MarkbookChangeKind::RetakeChanceChanged: return "retakeChanceChanged";
+    }
+    return "unknown";
+}
+
+} // namespace BSUIR
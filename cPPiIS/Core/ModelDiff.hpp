@@ -0,0 +1,110 @@
+//
+//  ModelDiff.hpp
+//  cPPiIS Core C++ Model Diffing
+//
+//  Linear-time comparison of two Markbook / GroupInfo snapshots by
+//  stable keys, producing typed change sets for observers
+//
+
+#ifndef ModelDiff_hpp
+#define ModelDiff_hpp
+
+#include "Models.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief Kind of a markbook change
+ */
+enum class MarkbookChangeKind {
+    SubjectAdded,
+    SubjectRemoved,
+    GradePosted,            ///< No grade before, a grade now
+    GradeChanged,           ///< A different grade than before
+    GradeRemoved,           ///< A grade before, none now
+    AverageChanged,         ///< Group average grade of the subject
+    RetakeChanceChanged
+};
+
+/**
+ * @brief One change of a subject, identified by semester, name and control form
+ */
+struct MarkbookChange {
+    MarkbookChangeKind kind;
+    int semester = 0;
+    std::string subject;
+    std::string controlForm;
+    std::optional<int> oldGrade;
+    std::optional<int> newGrade;
+    std::optional<double> oldAverage;
+    std::optional<double> newAverage;
+    double oldRetakeChance = 0.0;
+    double newRetakeChance = 0.0;
+};
+
+/**
+ * @brief Changes between two markbook snapshots, in the order of the new snapshot
+ *        (removed subjects last)
+ */
+struct MarkbookChangeSet {
+    std::vector<MarkbookChange> changes;
+
+    bool empty() const noexcept { return changes.empty(); }
+
+    /**
+     * @brief Changes of one kind, e.g. GradePosted for grade notifications
+     */
+    std::vector<MarkbookChange> ofKind(MarkbookChangeKind kind) const;
+};
+
+/**
+ * @brief Kind of a group roster change
+ */
+enum class GroupChangeKind {
+    StudentAdded,
+    StudentRemoved
+};
+
+/**
+ * @brief One roster change, identified by the student's number in the group
+ */
+struct GroupChange {
+    GroupChangeKind kind;
+    GroupStudent student;
+};
+
+/**
+ * @brief Changes between two group snapshots
+ */
+struct GroupChangeSet {
+    std::vector<GroupChange> changes;
+
+    bool empty() const noexcept { return changes.empty(); }
+};
+
+/**
+ * @brief Compare two markbooks subject by subject
+ *
+ * Subjects are matched by (semester number, name, control form) through
+ * a hash index of the old snapshot, so the cost is linear in the number
+ * of subjects. A subject listed twice under the same key is matched in
+ * order of appearance.
+ */
+MarkbookChangeSet diffMarkbook(const Markbook& before, const Markbook& after);
+
+/**
+ * @brief Compare two group rosters by student number
+ *
+ * A number that now belongs to a different name is reported as the old
+ * student removed and the new one added.
+ */
+GroupChangeSet diffGroupInfo(const GroupInfo& before, const GroupInfo& after);
+
+const char* markbookChangeKindName(MarkbookChangeKind kind) noexcept;
+
+} // namespace BSUIR
+
+#endif /* ModelDiff_hpp */
@@ -8,6 +8,8 @@
 #ifndef Models_hpp
 #define Models_hpp
 
+#include "StringPool.hpp"
+#include <chrono>
 #include <string>
 #include <vector>
 #include <optional>
@@ -41,8 +43,8 @@ struct PersonalInfo {
     std::string middleNameBel;
     std::string birthDate;
     int course;
-    std::string faculty;
-    std::string speciality;
+    InternedString faculty;
+    InternedString speciality;
     std::string group;
     std::string email;
     std::string phone;
@@ -50,10 +52,10 @@ struct PersonalInfo {
 
 // Subject in markbook
 struct Subject {
-    std::string name;
+    InternedString name;
     double hours;
     int credits;
-    std::string controlForm;
+    InternedString controlForm;
     std::optional<int> grade;
     int retakes;
     std::optional<double> averageGrade;
@@ -92,7 +94,7 @@ struct GroupStudent {
 // Group information
 struct GroupInfo {
     std::string number;
-    std::string faculty;
+    InternedString faculty;
     int course;
     Curator curator;
     std::vector<GroupStudent> students;
@@ -111,6 +113,7 @@ struct ApiResult {
     bool success;
     std::optional<T> data;
     std::optional<ApiError> error;
+    std::optional<std::chrono::milliseconds> cacheAge;  ///< Set when data was served from the local store
     
     ApiResult(T&& data) : success(true), data(std::move(data)) {}
     ApiResult(const ApiError& error) : success(false), error(error) {}
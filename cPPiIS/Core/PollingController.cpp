@@ -0,0 +1,239 @@
+//
+//  PollingController.cpp
+//  cPPiIS Core C++ Adaptive Polling Controller Implementation
+//
+
+#include "PollingController.hpp"
+#include "../Config.h"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace BSUIR {
+
+namespace {
+
+constexpr const char* SERIALIZATION_HEADER = "bsuir-polling/1";
+
+// Pseudo-observation of the prior: one poll, half a change
+constexpr double PRIOR_CHANGES = 0.5;
+
+std::string stripQuery(const std::string& endpoint) {
+    return endpoint.substr(0, endpoint.find('?'));
+}
+
+int64_t unixSeconds(PollingController::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+const char* outcomeName(PollOutcome outcome) {
+    switch (outcome) {
+        case PollOutcome::Changed:     return "changed";
+        case PollOutcome::Unchanged:   return "unchanged";
+        case PollOutcome::NotModified: return "not_modified";
+        case PollOutcome::Failed:      return "failed";
+    }
+    return "failed";
+}
+
+Metrics::Counter& pollCounter(std::array<Metrics::Counter*, 4>& counters, const std::string& endpoint,
+                              PollOutcome outcome) {
+    Metrics::Counter*& counter = counters[static_cast<std::size_t>(outcome)];
+    if (!counter) {
+        counter = &Metrics::MetricsRegistry::shared().counter(
+            "bsuir_polls_total", {{"endpoint", endpoint}, {"outcome", outcomeName(outcome)}},
+            "Scheduled refreshes by what they found");
+    }
+    return *counter;
+}
+
+} // namespace
+
+PollingBounds defaultPollingBounds(const std::string& endpoint) {
+    PollingBounds bounds;
+    if (endpoint == API_MARKBOOK_ENDPOINT) {
+        bounds.minInterval = std::chrono::minutes(2);
+        bounds.maxInterval = std::chrono::hours(6);
+        bounds.initialInterval = std::chrono::minutes(15);
+    } else if (endpoint == API_PERSONAL_INFO_ENDPOINT || endpoint == API_GROUP_INFO_ENDPOINT) {
+        bounds.minInterval = std::chrono::hours(1);
+        bounds.maxInterval = std::chrono::hours(24 * 7);
+        bounds.initialInterval = std::chrono::hours(24);
+    }
+    return bounds;
+}
+
+// ========================================
+// Configuration
+// ========================================
+
+void PollingController::setBounds(const std::string& endpoint, PollingBounds bounds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    endpoints[stripQuery(endpoint)].bounds = bounds;
+}
+
+void PollingController::addBoost(const std::string& endpoint, PollingBoost boost) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::string key = stripQuery(endpoint);
+    EndpointSettings& settings = endpoints.try_emplace(key, EndpointSettings{defaultPollingBounds(key), {}, {}}).first->second;
+    settings.boosts.push_back(boost);
+}
+
+PollingController::EndpointSettings& PollingController::settingsFor(const std::string& endpoint) {
+    return endpoints.try_emplace(endpoint, EndpointSettings{defaultPollingBounds(endpoint), {}, {}}).first->second;
+}
+
+// ========================================
+// Learning
+// ========================================
+
+void PollingController::record(const std::string& account, const std::string& endpoint, PollOutcome outcome,
+                               Clock::time_point now) {
+    const std::string key = stripQuery(endpoint);
+    std::lock_guard<std::mutex> lock(mutex);
+    EndpointSettings& settings = settingsFor(key);
+    pollCounter(settings.pollCounters, key, outcome).add();
+    if (outcome == PollOutcome::Failed) {
+        return;
+    }
+
+    const PollingBounds& bounds = settings.bounds;
+    History& history = accounts[account][key];
+    const int64_t time = unixSeconds(now);
+
+    // The first poll only starts the clock: there is nothing to compare it with
+    if (history.lastPoll > 0 && time > history.lastPoll) {
+        const double elapsed = static_cast<double>(time - history.lastPoll);
+        const double decay = std::exp2(-elapsed / static_cast<double>(std::max<int64_t>(bounds.halfLife.count(), 1)));
+        history.polls = history.polls * decay + 1.0;
+        history.changes *= decay;
+        history.exposure = history.exposure * decay + elapsed;
+        if (outcome == PollOutcome::Changed) {
+            history.changes += 1.0;
+            ++history.changeCount;
+        }
+    }
+    history.lastPoll = std::max(history.lastPoll, time);
+    ++history.pollCount;
+}
+
+PollingEstimate PollingController::estimateLocked(const History& history, const std::string& endpoint,
+                                                  Clock::time_point now) {
+    const EndpointSettings& settings = settingsFor(endpoint);
+    const PollingBounds& bounds = settings.bounds;
+    const double pollsPerChange = std::max(bounds.pollsPerChange, 0.01);
+
+    // The prior alone yields the initial interval
+    const double priorExposure = static_cast<double>(bounds.initialInterval.count()) * pollsPerChange *
+                                 -std::log((1.0 - PRIOR_CHANGES + 0.5) / 1.5);
+    const double polls = history.polls + 1.0;
+    const double changes = std::min(history.changes + PRIOR_CHANGES, polls);
+    const double meanGap = std::max(history.exposure + priorExposure, 1.0) / polls;
+    const double rate = -std::log((polls - changes + 0.5) / (polls + 0.5)) / meanGap;
+
+    const double seconds = std::clamp(1.0 / (rate * pollsPerChange),
+                                      static_cast<double>(bounds.minInterval.count()),
+                                      static_cast<double>(std::max(bounds.maxInterval, bounds.minInterval).count()));
+    std::chrono::seconds interval(static_cast<int64_t>(std::llround(seconds)));
+
+    bool boosted = false;
+    for (const PollingBoost& boost : settings.boosts) {
+        if (now >= boost.begin && now < boost.end) {
+            interval = std::chrono::seconds(static_cast<int64_t>(std::llround(
+                static_cast<double>(interval.count()) * std::clamp(boost.factor, 0.0, 1.0))));
+            boosted = true;
+            break;
+        }
+    }
+    if (!boosted) {
+        for (const PollingBoost& boost : settings.boosts) {
+            // Do not sleep through the start of a boost
+            if (boost.begin > now && boost.begin < now + interval) {
+                interval = std::chrono::duration_cast<std::chrono::seconds>(boost.begin - now);
+            }
+        }
+    }
+
+    PollingEstimate estimate;
+    estimate.changesPerDay = rate * 86400.0;
+    estimate.polls = history.pollCount;
+    estimate.changes = history.changeCount;
+    estimate.interval = std::max(interval, std::chrono::seconds(1));
+    estimate.boosted = boosted;
+    return estimate;
+}
+
+std::chrono::seconds PollingController::interval(const std::string& account, const std::string& endpoint,
+                                                 Clock::time_point now) {
+    return estimate(account, endpoint, now).interval;
+}
+
+PollingEstimate PollingController::estimate(const std::string& account, const std::string& endpoint,
+                                            Clock::time_point now) {
+    const std::string key = stripQuery(endpoint);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = accounts.find(account);
+    if (it != accounts.end()) {
+        auto history = it->second.find(key);
+        if (history != it->second.end()) {
+            return estimateLocked(history->second, key, now);
+        }
+    }
+    return estimateLocked(History{}, key, now);
+}
+
+void PollingController::forget(const std::string& account) {
+    std::lock_guard<std::mutex> lock(mutex);
+    accounts.erase(account);
+}
+
+// ========================================
+// Persistence
+// ========================================
+
+std::string PollingController::serialize() const {
+    std::ostringstream text;
+    text.precision(17);
+    text << SERIALIZATION_HEADER << '\n';
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [account, histories] : accounts) {
+        for (const auto& [endpoint, history] : histories) {
+            text << account << ' ' << endpoint << ' ' << history.polls << ' ' << history.changes << ' '
+                 << history.exposure << ' ' << history.lastPoll << ' ' << history.pollCount << ' '
+                 << history.changeCount << '\n';
+        }
+    }
+    return text.str();
+}
+
+bool PollingController::restore(const std::string& text) {
+    std::istringstream input(text);
+    std::string line;
+    if (!std::getline(input, line) || line != SERIALIZATION_HEADER) {
+        return false;
+    }
+
+    std::unordered_map<std::string, std::unordered_map<std::string, History>> restored;
+    while (std::getline(input, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string account, endpoint;
+        History history;
+        if (!(fields >> account >> endpoint >> history.polls >> history.changes >> history.exposure
+                     >> history.lastPoll >> history.pollCount >> history.changeCount) ||
+            !std::isfinite(history.polls) || !std::isfinite(history.changes) || !std::isfinite(history.exposure) ||
+            history.changes < 0 || history.changes > history.polls || history.exposure < 0) {
+            return false;
+        }
+        restored[account][endpoint] = history;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    accounts = std::move(restored);
+    return true;
+}
+
+} // namespace BSUIR
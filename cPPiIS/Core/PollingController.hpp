@@ -0,0 +1,170 @@
+//
+//  PollingController.hpp
+//  cPPiIS Core C++ Adaptive Polling Controller
+//
+//  Per-account, per-endpoint refresh intervals learned from how often
+//  the data actually changes, with calendar boosts (exam weeks)
+//
+
+#ifndef PollingController_hpp
+#define PollingController_hpp
+
+#include "Metrics.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief What one poll found
+ */
+enum class PollOutcome {
+    Changed,        ///< Content differs from the previous poll
+    Unchanged,      ///< Same content transferred again
+    NotModified,    ///< 304: same content, nothing transferred
+    Failed          ///< No answer; says nothing about changes
+};
+
+/**
+ * @brief Limits and learning settings of one endpoint
+ */
+struct PollingBounds {
+    std::chrono::seconds minInterval{60};
+    std::chrono::seconds maxInterval{std::chrono::hours(24)};
+    std::chrono::seconds initialInterval{900};  ///< Before anything is learned
+    double pollsPerChange = 2.0;                ///< Polls aimed for per expected change
+    std::chrono::seconds halfLife{std::chrono::hours(24 * 7)};  ///< Age at which a change counts half
+};
+
+/**
+ * @brief Default bounds (markbook: 2 min to 6 h; personal and group info: 1 h to 7 days)
+ */
+PollingBounds defaultPollingBounds(const std::string& endpoint);
+
+/**
+ * @brief Window in which an endpoint is polled faster, e.g. an exam session
+ */
+struct PollingBoost {
+    std::chrono::system_clock::time_point begin;
+    std::chrono::system_clock::time_point end;
+    double factor = 0.25;                       ///< Interval multiplier inside the window
+};
+
+/**
+ * @brief Learned state of one account and endpoint
+ */
+struct PollingEstimate {
+    double changesPerDay = 0.0;
+    uint64_t polls = 0;
+    uint64_t changes = 0;
+    std::chrono::seconds interval{0};
+    bool boosted = false;
+};
+
+/**
+ * @brief Chooses when to poll each endpoint of each account
+ *
+ * Changes are modelled as a Poisson process seen only through polls: a
+ * poll tells whether anything changed since the previous one, not how
+ * often. The rate is estimated as -ln((n - X + 0.5) / (n + 0.5)) / mean
+ * gap over n polls with X changed (Cho and Garcia-Molina), which does not
+ * undercount changes that happen twice between polls. Counts and time
+ * decay exponentially, so recent behaviour dominates and a quiet holiday
+ * is forgotten within weeks; a prior worth one poll makes the first
+ * interval the initial one. The interval is 1 / (rate * pollsPerChange),
+ * clamped to the bounds: data that changed once in a month is polled
+ * rarely, a markbook changing daily often.
+ *
+ * A boost active at the time of asking multiplies the interval by its
+ * factor (it may go below minInterval by that factor); one starting
+ * before the next poll would be due moves that poll to its beginning.
+ *
+ * Thread-safe. State is kept per account in memory and can be
+ * serialized so a restart keeps what was learned.
+ */
+class PollingController {
+public:
+    using Clock = std::chrono::system_clock;
+
+private:
+    struct History {
+        double polls = 0.0;                     ///< Decayed count of compared polls
+        double changes = 0.0;                   ///< Decayed count of polls that found a change
+        double exposure = 0.0;                  ///< Decayed observed seconds
+        int64_t lastPoll = 0;                   ///< Unix seconds; 0 before the first poll
+        uint64_t pollCount = 0;
+        uint64_t changeCount = 0;
+    };
+
+    struct EndpointSettings {
+        PollingBounds bounds;
+        std::vector<PollingBoost> boosts;
+        std::array<Metrics::Counter*, 4> pollCounters{};  ///< bsuir_polls_total per PollOutcome, looked up once
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, EndpointSettings> endpoints;
+    std::unordered_map<std::string, std::unordered_map<std::string, History>> accounts;
+
+    EndpointSettings& settingsFor(const std::string& endpoint);
+    PollingEstimate estimateLocked(const History& history, const std::string& endpoint,
+                                   Clock::time_point now);
+
+public:
+    /**
+     * @brief Replace the bounds of an endpoint (otherwise defaultPollingBounds)
+     */
+    void setBounds(const std::string& endpoint, PollingBounds bounds);
+
+    /**
+     * @brief Poll an endpoint faster inside a calendar window
+     */
+    void addBoost(const std::string& endpoint, PollingBoost boost);
+
+    /**
+     * @brief Learn from one poll
+     * @param account Account polled
+     * @param endpoint Endpoint polled (query string ignored)
+     * @param outcome What the poll found
+     * @param now Time of the poll
+     */
+    void record(const std::string& account, const std::string& endpoint, PollOutcome outcome,
+                Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Time until the endpoint should be polled again
+     */
+    std::chrono::seconds interval(const std::string& account, const std::string& endpoint,
+                                  Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Learned rate, counters and current interval
+     */
+    PollingEstimate estimate(const std::string& account, const std::string& endpoint,
+                             Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Drop everything learned about an account
+     */
+    void forget(const std::string& account);
+
+    /**
+     * @brief Learned state as text, one line per account and endpoint
+     */
+    std::string serialize() const;
+
+    /**
+     * @brief Replace the learned state with a serialize() result
+     * @return false (and nothing changed) if the text is malformed
+     */
+    bool restore(const std::string& text);
+};
+
+} // namespace BSUIR
+
+#endif /* PollingController_hpp */
@@ -0,0 +1,280 @@
+//
+//  Profiler.cpp
+//  cPPiIS Core C++ Timeline Profiler Implementation
+//
+
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace BSUIR {
+namespace Profiler {
+
+namespace {
+
+constexpr std::size_t DETAIL_CAPACITY = 40;
+
+/**
+ * @brief One fixed-size event slot
+ *
+ * Writers claim a slot with one fetch_add and publish it through the
+ * ready flag, so recording never takes a lock.
+ */
+struct Event {
+    std::atomic<bool> ready{false};
+    char phase = 0;                 ///< 'X' complete, 'b'/'e' async, 'C' counter
+    uint32_t threadId = 0;
+    const char* name = nullptr;
+    const char* category = nullptr;
+    uint64_t timestamp = 0;         ///< nanoseconds
+    uint64_t duration = 0;          ///< 'X' only
+    uint64_t idOrValue = 0;         ///< async id, or counter value
+    char detail[DETAIL_CAPACITY] = {};
+};
+
+struct Session {
+    std::unique_ptr<Event[]> events;
+    std::size_t capacity;
+    std::atomic<std::size_t> next{0};
+
+    explicit Session(std::size_t size) : events(new Event[size]), capacity(size) {}
+
+    Event* claim() noexcept {
+        const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+        return index < capacity ? &events[index] : nullptr;
+    }
+};
+
+std::atomic<Session*> currentSession{nullptr};
+std::atomic<uint64_t> nextAsyncId{1};
+std::atomic<uint32_t> nextThreadId{1};
+
+std::mutex controlMutex;
+// Sessions are retired, never freed: late writers may still hold a pointer
+std::vector<std::unique_ptr<Session>> sessions;
+std::vector<std::pair<uint32_t, std::string>> threadNames;
+
+uint32_t currentThreadId() noexcept {
+    thread_local const uint32_t id = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+Event* claim() noexcept {
+    if (!isActive()) {
+        return nullptr;
+    }
+    Session* session = currentSession.load(std::memory_order_acquire);
+    return session ? session->claim() : nullptr;
+}
+
+void publish(Event* event, char phase, const char* name, const char* category,
+             uint64_t timestamp, uint64_t duration, uint64_t idOrValue, const char* detail) {
+    event->phase = phase;
+    event->threadId = currentThreadId();
+    event->name = name;
+    event->category = category;
+    event->timestamp = timestamp;
+    event->duration = duration;
+    event->idOrValue = idOrValue;
+    if (detail) {
+        std::strncpy(event->detail, detail, DETAIL_CAPACITY - 1);
+    }
+    event->ready.store(true, std::memory_order_release);
+}
+
+void appendEscaped(std::string& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '\\': out += "\\\\"; break;
+            case '"':  out += "\\\""; break;
+            default:
+                if (static_cast<unsigned char>(*c) >= 0x20) {
+                    out += *c;
+                }
+        }
+    }
+}
+
+void appendMicroseconds(std::string& out, uint64_t nanoseconds) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03llu",
+                  static_cast<unsigned long long>(nanoseconds / 1000),
+                  static_cast<unsigned long long>(nanoseconds % 1000));
+    out += text;
+}
+
+} // namespace
+
+// ============================================================================
+// MARK: - Session control
+// ============================================================================
+
+void start(std::size_t maxEvents) {
+    std::lock_guard<std::mutex> lock(controlMutex);
+    sessions.push_back(std::make_unique<Session>(std::max<std::size_t>(maxEvents, 1)));
+    currentSession.store(sessions.back().get(), std::memory_order_release);
+    detail::active.store(true, std::memory_order_release);
+}
+
+void stop() {
+    detail::active.store(false, std::memory_order_release);
+}
+
+uint64_t droppedEvents() {
+    Session* session = currentSession.load(std::memory_order_acquire);
+    if (!session) {
+        return 0;
+    }
+    const std::size_t claimed = session->next.load(std::memory_order_relaxed);
+    return claimed > session->capacity ? claimed - session->capacity : 0;
+}
+
+void setThreadName(const std::string& name) {
+    const uint32_t id = currentThreadId();
+    std::lock_guard<std::mutex> lock(controlMutex);
+    for (auto& entry : threadNames) {
+        if (entry.first == id) {
+            entry.second = name;
+            return;
+        }
+    }
+    threadNames.emplace_back(id, name);
+}
+
+uint64_t newAsyncId() noexcept {
+    return nextAsyncId.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// MARK: - Recording
+// ============================================================================
+
+void complete(const char* name, const char* category,
+              uint64_t startNanoseconds, uint64_t endNanoseconds, const char* detail) {
+    if (Event* event = claim()) {
+        const uint64_t duration = endNanoseconds > startNanoseconds ? endNanoseconds - startNanoseconds : 0;
+        publish(event, 'X', name, category, startNanoseconds, duration, 0, detail);
+    }
+}
+
+void async(const char* name, const char* category, uint64_t id,
+           uint64_t startNanoseconds, uint64_t endNanoseconds, const char* detail) {
+    Event* begin = claim();
+    Event* end = begin ? claim() : nullptr;
+    if (!end) {
+        if (begin) {
+            // Only one slot was left; mark it as skipped rather than leave an unmatched begin
+            publish(begin, 0, name, category, startNanoseconds, 0, id, nullptr);
+        }
+        return;
+    }
+    publish(begin, 'b', name, category, startNanoseconds, 0, id, detail);
+    publish(end, 'e', name, category, std::max(startNanoseconds, endNanoseconds), 0, id, nullptr);
+}
+
+void counter(const char* name, int64_t value) {
+    if (Event* event = claim()) {
+        publish(event, 'C', name, "counter", now(), 0, static_cast<uint64_t>(value), nullptr);
+    }
+}
+
+// ============================================================================
+// MARK: - Export
+// ============================================================================
+
+std::string toChromeTraceJSON() {
+    Session* session = currentSession.load(std::memory_order_acquire);
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&] {
+        if (!first) out += ",\n";
+        first = false;
+    };
+
+    const int processId = static_cast<int>(getpid());
+    {
+        std::lock_guard<std::mutex> lock(controlMutex);
+        for (const auto& entry : threadNames) {
+            separator();
+            out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + std::to_string(processId) +
+                   ",\"tid\":" + std::to_string(entry.first) + ",\"args\":{\"name\":\"";
+            appendEscaped(out, entry.second.c_str());
+            out += "\"}}";
+        }
+    }
+
+    if (!session) {
+        out += "]}";
+        return out;
+    }
+
+    // Timestamps relative to the first event keep the numbers short
+    const std::size_t count = std::min(session->next.load(std::memory_order_acquire), session->capacity);
+    uint64_t origin = UINT64_MAX;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Event& event = session->events[i];
+        if (event.ready.load(std::memory_order_acquire) && event.phase != 0) {
+            origin = std::min(origin, event.timestamp);
+        }
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const Event& event = session->events[i];
+        if (!event.ready.load(std::memory_order_acquire) || event.phase == 0) {
+            continue;
+        }
+        separator();
+        out += "{\"ph\":\"";
+        out += event.phase;
+        out += "\",\"name\":\"";
+        appendEscaped(out, event.name);
+        out += "\",\"cat\":\"";
+        appendEscaped(out, event.category);
+        out += "\",\"pid\":" + std::to_string(processId) + ",\"tid\":" + std::to_string(event.threadId) + ",\"ts\":";
+        appendMicroseconds(out, event.timestamp - origin);
+        switch (event.phase) {
+            case 'X':
+                out += ",\"dur\":";
+                appendMicroseconds(out, event.duration);
+                break;
+            case 'b':
+            case 'e':
+                out += ",\"id\":\"0x";
+                char id[24];
+                std::snprintf(id, sizeof(id), "%llx", static_cast<unsigned long long>(event.idOrValue));
+                out += id;
+                out += "\"";
+                break;
+            case 'C':
+                out += ",\"args\":{\"value\":" + std::to_string(static_cast<int64_t>(event.idOrValue)) + "}";
+                break;
+        }
+        if (event.detail[0] != '\0') {
+            out += ",\"args\":{\"detail\":\"";
+            appendEscaped(out, event.detail);
+            out += "\"}";
+        }
+        out += "}";
+    }
+    out += "]}";
+    return out;
+}
+
+bool writeChromeTrace(const std::string& path) {
+    const std::string json = toChromeTraceJSON();
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    return std::fclose(file) == 0 && written;
+}
+
+} // namespace Profiler
+} // namespace BSUIR
@@ -0,0 +1,146 @@
+//
+//  Profiler.hpp
+//  cPPiIS Core C++ Timeline Profiler
+//
+//  In-memory recording of begin/end, async and counter events exported
+//  as Chrome trace-event JSON (loadable in Perfetto and chrome://tracing)
+//
+
+#ifndef Profiler_hpp
+#define Profiler_hpp
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace BSUIR {
+namespace Profiler {
+
+namespace detail {
+
+inline std::atomic<bool> active{false};
+
+} // namespace detail
+
+/**
+ * @brief Whether a profiling session is recording (a single relaxed load)
+ */
+inline bool isActive() noexcept {
+    return detail::active.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Monotonic timestamp in nanoseconds (steady_clock epoch)
+ */
+inline uint64_t now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Convert a steady_clock time point (e.g. from HTTPTimings)
+ */
+inline uint64_t toNanoseconds(std::chrono::steady_clock::time_point point) noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        point.time_since_epoch()).count());
+}
+
+/**
+ * @brief Start a new session, discarding the previous one
+ * @param maxEvents Buffer size; events beyond it are dropped
+ */
+void start(std::size_t maxEvents = 256 * 1024);
+
+/**
+ * @brief Stop recording; the buffer stays available for export
+ */
+void stop();
+
+/**
+ * @brief Events dropped because the buffer was full
+ */
+uint64_t droppedEvents();
+
+/**
+ * @brief Name the calling thread on the timeline
+ */
+void setThreadName(const std::string& name);
+
+/**
+ * @brief Identifier for a new async track (e.g. one HTTP request)
+ */
+uint64_t newAsyncId() noexcept;
+
+/**
+ * @brief Record a complete (begin/end) event on the calling thread
+ * @param name Static event name
+ * @param category Static category ("network", "parser", "executor", ...)
+ * @param startNanoseconds Start timestamp from now()
+ * @param endNanoseconds End timestamp
+ * @param detail Optional argument shown in the event details (copied, truncated)
+ */
+void complete(const char* name, const char* category,
+              uint64_t startNanoseconds, uint64_t endNanoseconds,
+              const char* detail = nullptr);
+
+/**
+ * @brief Record an interval on an async track; nested intervals on the same
+ *        id are drawn inside each other
+ * @param name Static event name
+ * @param category Static category
+ * @param id Track from newAsyncId()
+ * @param startNanoseconds Start timestamp
+ * @param endNanoseconds End timestamp
+ * @param detail Optional argument (copied, truncated)
+ */
+void async(const char* name, const char* category, uint64_t id,
+           uint64_t startNanoseconds, uint64_t endNanoseconds,
+           const char* detail = nullptr);
+
+/**
+ * @brief Record a sample on a counter track
+ * @param name Static counter name
+ * @param value Current value
+ */
+void counter(const char* name, int64_t value);
+
+/**
+ * @brief Recorded session as Chrome trace-event JSON
+ */
+std::string toChromeTraceJSON();
+
+/**
+ * @brief Write the recorded session to a file
+ * @return false if the file could not be written
+ */
+bool writeChromeTrace(const std::string& path);
+
+/**
+ * @brief Complete event covering a scope (no-op when not profiling)
+ */
+class Scope {
+private:
+    const char* name;
+    const char* category;
+    uint64_t startNanoseconds;
+
+public:
+    Scope(const char* eventName, const char* eventCategory) noexcept
+        : name(eventName), category(eventCategory), startNanoseconds(isActive() ? now() : 0) {}
+
+    ~Scope() {
+        if (startNanoseconds != 0) {
+            complete(name, category, startNanoseconds, now());
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+} // namespace Profiler
+} // namespace BSUIR
+
+#endif /* Profiler_hpp */
@@ -0,0 +1,510 @@
+//
+//  RosterIndex.cpp
+//  cPPiIS Core C++ Roster Search Index Implementation
+//
+
+#include "RosterIndex.hpp"
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+
+namespace BSUIR {
+
+namespace {
+
+constexpr char32_t SEPARATOR = 0xFFFFFFFF;
+constexpr char32_t DROPPED = 0;
+constexpr char32_t PADDING = U' ';
+
+// Fuzzy search needs at least one full trigram of real letters
+constexpr std::size_t MIN_FUZZY_LETTERS = 3;
+
+char32_t decodeUTF8(const std::string& text, std::size_t& position) {
+    const auto lead = static_cast<unsigned char>(text[position++]);
+    if (lead < 0x80) {
+        return lead;
+    }
+    int length = (lead & 0xE0) == 0xC0 ? 1 : (lead & 0xF0) == 0xE0 ? 2 : (lead & 0xF8) == 0xF0 ? 3 : -1;
+    if (length < 0 || position + static_cast<std::size_t>(length) > text.size()) {
+        return 0xFFFD;
+    }
+    char32_t codePoint = lead & (0x3F >> length);
+    for (; length > 0; --length) {
+        const auto next = static_cast<unsigned char>(text[position]);
+        if ((next & 0xC0) != 0x80) {
+            return 0xFFFD;
+        }
+        codePoint = (codePoint << 6) | (next & 0x3F);
+        ++position;
+    }
+    return codePoint;
+}
+
+/**
+ * @brief Folded form of a character: a letter or digit, DROPPED or SEPARATOR
+ */
+char32_t foldCodePoint(char32_t c) {
+    if ((c >= U'a' && c <= U'z') || (c >= U'0' && c <= U'9')) return c;
+    if (c >= U'A' && c <= U'Z') return c + 0x20;
+    if (c >= 0x410 && c <= 0x42F) c += 0x20;            // А..Я -> а..я
+    else if (c >= 0x400 && c <= 0x40F) c += 0x50;       // Ѐ..Џ -> ѐ..џ
+    switch (c) {
+        case 0x451: case 0x450: case 0x454: return 0x435;   // ё ѐ є -> е
+        case 0x456: case 0x457: return 0x438;               // і ї -> и
+        case 0x45E: return 0x443;                           // ў -> у
+        case U'\'': case 0x2019: case 0x02BC: return DROPPED;
+        default: break;
+    }
+    return c >= 0x430 && c <= 0x45F ? c : SEPARATOR;
+}
+
+// Latin spelling of а..я, close to the passport transliteration
+const char* const TRANSLITERATION[32] = {
+    "a", "b", "v", "g", "d", "e", "zh", "z", "i", "y", "k", "l", "m", "n", "o", "p",
+    "r", "s", "t", "u", "f", "kh", "ts", "ch", "sh", "shch", "", "y", "", "e", "yu", "ya"
+};
+
+bool isCyrillic(char32_t folded) {
+    return folded >= 0x430 && folded <= 0x45F;
+}
+
+bool hasPrefix(const std::u32string& word, const std::u32string& prefix) {
+    return word.size() >= prefix.size() && word.compare(0, prefix.size(), prefix) == 0;
+}
+
+uint64_t packTrigram(char32_t a, char32_t b, char32_t c) {
+    return (static_cast<uint64_t>(a) << 42) | (static_cast<uint64_t>(b) << 21) | static_cast<uint64_t>(c);
+}
+
+void appendTrigrams(const std::u32string& word, std::vector<uint64_t>& out) {
+    std::u32string padded;
+    padded.reserve(word.size() + 3);
+    padded.append(2, PADDING);
+    padded.append(word);
+    padded.push_back(PADDING);
+    for (std::size_t i = 0; i + 2 < padded.size(); ++i) {
+        out.push_back(packTrigram(padded[i], padded[i + 1], padded[i + 2]));
+    }
+}
+
+template<typename T>
+void sortUnique(std::vector<T>& values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+void removePosting(std::vector<uint32_t>& postings, uint32_t id) {
+    auto found = std::find(postings.begin(), postings.end(), id);
+    if (found != postings.end()) {
+        *found = postings.back();
+        postings.pop_back();
+    }
+}
+
+std::u32string joinWords(const std::vector<std::u32string>& words) {
+    std::u32string joined;
+    for (const auto& word : words) {
+        if (!joined.empty()) joined.push_back(PADDING);
+        joined.append(word);
+    }
+    return joined;
+}
+
+std::string joinName(const std::string& last, const std::string& first, const std::string& middle) {
+    std::string name;
+    for (const std::string* part : {&last, &first, &middle}) {
+        if (part->empty()) continue;
+        if (!name.empty()) name.push_back(' ');
+        name.append(*part);
+    }
+    return name;
+}
+
+bool isRosterKey(const std::string& key, const std::string& group) {
+    return key.size() > group.size() && key.compare(0, group.size(), group) == 0 && key[group.size()] == '/';
+}
+
+/**
+ * @brief Per-thread dense counters indexed by entry id, so a query does no
+ *        hashing or allocation in its inner loops
+ *
+ * Every touched id is listed in `touched` and reset after the query.
+ */
+struct QueryScratch {
+    std::vector<uint32_t> matched;      ///< Query words matched by prefix so far
+    std::vector<double> total;          ///< Sum of per-word prefix scores
+    std::vector<double> last;           ///< Score of the current word
+    std::vector<uint32_t> shared;       ///< Trigrams shared with the query
+    std::vector<uint32_t> touched;
+
+    void reset() {
+        for (uint32_t id : touched) {
+            matched[id] = 0;
+            total[id] = 0.0;
+            last[id] = 0.0;
+            shared[id] = 0;
+        }
+        touched.clear();
+    }
+};
+
+QueryScratch& queryScratch(std::size_t entryCount) {
+    thread_local QueryScratch scratch;
+    if (scratch.matched.size() < entryCount) {
+        scratch.matched.resize(entryCount);
+        scratch.total.resize(entryCount);
+        scratch.last.resize(entryCount);
+        scratch.shared.resize(entryCount);
+    }
+    return scratch;
+}
+
+struct Ranked {
+    double score;
+    uint32_t id;
+    bool fuzzy;
+};
+
+} // namespace
+
+// ========================================
+// Normalization
+// ========================================
+
+std::vector<std::u32string> RosterIndex::foldWords(const std::string& text) {
+    std::vector<std::u32string> words;
+    std::u32string word;
+    std::size_t position = 0;
+    while (position < text.size()) {
+        const char32_t folded = foldCodePoint(decodeUTF8(text, position));
+        if (folded == DROPPED) {
+            continue;
+        }
+        if (folded == SEPARATOR) {
+            if (!word.empty()) words.push_back(std::move(word));
+            word.clear();
+            continue;
+        }
+        word.push_back(folded);
+    }
+    if (!word.empty()) {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+std::u32string RosterIndex::transliterate(const std::u32string& word) {
+    std::u32string latin;
+    latin.reserve(word.size() + 4);
+    for (char32_t c : word) {
+        if (c >= 0x430 && c <= 0x44F) {
+            for (const char* letter = TRANSLITERATION[c - 0x430]; *letter; ++letter) {
+                latin.push_back(static_cast<char32_t>(*letter));
+            }
+        } else if (!isCyrillic(c)) {
+            latin.push_back(c);
+        }
+    }
+    return latin;
+}
+
+// ========================================
+// Updates
+// ========================================
+
+void RosterIndex::insertLocked(std::string key, std::string fullName, std::string group,
+                               std::vector<std::string> aliases) {
+    auto existing = keys.find(key);
+    if (existing != keys.end()) {
+        eraseLocked(existing->second);
+    }
+
+    uint32_t id;
+    if (!freeSlots.empty()) {
+        id = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        id = static_cast<uint32_t>(entries.size());
+        entries.emplace_back();
+    }
+
+    Entry& entry = entries[id];
+    entry.key = std::move(key);
+    entry.fullName = std::move(fullName);
+    entry.group = std::move(group);
+    entry.aliases = std::move(aliases);
+
+    auto addName = [&entry](const std::string& name) {
+        for (auto& word : foldWords(name)) {
+            entry.words[Latin].push_back(transliterate(word));
+            entry.words[Folded].push_back(std::move(word));
+        }
+    };
+    addName(entry.fullName);
+    for (const auto& alias : entry.aliases) {
+        addName(alias);
+    }
+
+    for (std::size_t script = 0; script < ScriptCount; ++script) {
+        sortUnique(entry.words[script]);
+        for (const auto& word : entry.words[script]) {
+            wordPostings[script][word].push_back(id);
+        }
+    }
+    for (const auto& word : entry.words[Latin]) {
+        appendTrigrams(word, entry.trigrams);
+    }
+    sortUnique(entry.trigrams);
+    for (uint64_t trigram : entry.trigrams) {
+        trigramPostings[trigram].push_back(id);
+    }
+
+    keys.emplace(entry.key, id);
+    groups[entry.group].push_back(id);
+}
+
+void RosterIndex::eraseLocked(uint32_t id) {
+    Entry& entry = entries[id];
+    for (std::size_t script = 0; script < ScriptCount; ++script) {
+        for (const auto& word : entry.words[script]) {
+            auto found = wordPostings[script].find(word);
+            removePosting(found->second, id);
+            if (found->second.empty()) wordPostings[script].erase(found);
+        }
+    }
+    for (uint64_t trigram : entry.trigrams) {
+        auto found = trigramPostings.find(trigram);
+        removePosting(found->second, id);
+        if (found->second.empty()) trigramPostings.erase(found);
+    }
+
+    auto group = groups.find(entry.group);
+    removePosting(group->second, id);
+    if (group->second.empty()) {
+        groups.erase(group);
+    }
+    keys.erase(entry.key);
+
+    entry = Entry{};
+    freeSlots.push_back(id);
+}
+
+uint32_t RosterIndex::findInGroupLocked(const std::string& group, const std::u32string& foldedName) const {
+    auto found = groups.find(group);
+    if (found == groups.end()) {
+        return UINT32_MAX;
+    }
+    for (uint32_t id : found->second) {
+        if (isRosterKey(entries[id].key, group) && joinWords(foldWords(entries[id].fullName)) == foldedName) {
+            return id;
+        }
+    }
+    return UINT32_MAX;
+}
+
+void RosterIndex::upsert(const std::string& key, const std::string& fullName, const std::string& group,
+                         std::vector<std::string> aliases) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    insertLocked(key, fullName, group, std::move(aliases));
+}
+
+bool RosterIndex::remove(const std::string& key) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto found = keys.find(key);
+    if (found == keys.end()) {
+        return false;
+    }
+    eraseLocked(found->second);
+    return true;
+}
+
+void RosterIndex::indexGroup(const GroupInfo& info) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    std::unordered_set<std::string> current;
+    current.reserve(info.students.size());
+    for (const auto& student : info.students) {
+        std::string key = info.number + "/" + std::to_string(student.number);
+        auto found = keys.find(key);
+        if (found == keys.end() || entries[found->second].fullName != student.fullName) {
+            insertLocked(key, student.fullName, info.number, {});
+        }
+        current.insert(std::move(key));
+    }
+
+    std::vector<uint32_t> stale;
+    std::vector<uint32_t> people;
+    auto group = groups.find(info.number);
+    if (group != groups.end()) {
+        for (uint32_t id : group->second) {
+            if (!isRosterKey(entries[id].key, info.number)) {
+                people.push_back(id);
+            } else if (current.count(entries[id].key) == 0) {
+                stale.push_back(id);
+            }
+        }
+    }
+    for (uint32_t id : stale) {
+        eraseLocked(id);
+    }
+
+    // Students indexed before their group was: fold them into their roster entries
+    for (uint32_t personId : people) {
+        const uint32_t rosterId = findInGroupLocked(info.number, joinWords(foldWords(entries[personId].fullName)));
+        if (rosterId == UINT32_MAX) {
+            continue;
+        }
+        std::vector<std::string> aliases = entries[rosterId].aliases;
+        aliases.insert(aliases.end(), entries[personId].aliases.begin(), entries[personId].aliases.end());
+        const Entry& roster = entries[rosterId];
+        std::string key = roster.key, fullName = roster.fullName;
+        eraseLocked(personId);
+        insertLocked(std::move(key), std::move(fullName), info.number, std::move(aliases));
+    }
+}
+
+void RosterIndex::indexPerson(const PersonalInfo& info) {
+    const std::string russian = joinName(info.lastName, info.firstName, info.middleName);
+    const std::string belarusian = joinName(info.lastNameBel, info.firstNameBel, info.middleNameBel);
+    if (russian.empty() && belarusian.empty()) {
+        return;
+    }
+    const std::string& displayName = russian.empty() ? belarusian : russian;
+    std::vector<std::string> aliases;
+    if (!belarusian.empty() && belarusian != displayName) {
+        aliases.push_back(belarusian);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    const std::string personKey = "student/" + info.studentNumber;
+    const uint32_t rosterId = findInGroupLocked(info.group, joinWords(foldWords(displayName)));
+    if (rosterId == UINT32_MAX) {
+        insertLocked(personKey, displayName, info.group, std::move(aliases));
+        return;
+    }
+
+    auto person = keys.find(personKey);
+    if (person != keys.end()) {
+        eraseLocked(person->second);
+    }
+    const Entry& roster = entries[rosterId];
+    if (roster.aliases == aliases) {
+        return;
+    }
+    std::string key = roster.key, fullName = roster.fullName;
+    insertLocked(std::move(key), std::move(fullName), info.group, std::move(aliases));
+}
+
+std::size_t RosterIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return keys.size();
+}
+
+void RosterIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    entries.clear();
+    freeSlots.clear();
+    keys.clear();
+    groups.clear();
+    for (auto& postings : wordPostings) {
+        postings.clear();
+    }
+    trigramPostings.clear();
+}
+
+// ========================================
+// Search
+// ========================================
+
+std::vector<RosterMatch> RosterIndex::search(const std::string& query, std::size_t limit) const {
+    std::vector<std::u32string> words = foldWords(query);
+    if (words.empty() || limit == 0) {
+        return {};
+    }
+    const bool cyrillic = std::any_of(words.begin(), words.end(), [](const std::u32string& word) {
+        return std::any_of(word.begin(), word.end(), isCyrillic);
+    });
+    if (!cyrillic) {
+        for (auto& word : words) word = transliterate(word);
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    const auto& index = wordPostings[cyrillic ? Folded : Latin];
+    QueryScratch& scratch = queryScratch(entries.size());
+
+    // Prefix stage: every query word must prefix some word of the entry.
+    // An exact word scores 1, a prefix between 0.5 and 1 by covered length.
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        const auto matchedBefore = static_cast<uint32_t>(i);
+        for (auto it = index.lower_bound(words[i]); it != index.end() && hasPrefix(it->first, words[i]); ++it) {
+            const double score = 0.5 + 0.5 * static_cast<double>(words[i].size()) / static_cast<double>(it->first.size());
+            for (uint32_t id : it->second) {
+                if (scratch.matched[id] == matchedBefore) {
+                    if (i == 0) scratch.touched.push_back(id);
+                    scratch.matched[id] = matchedBefore + 1;
+                    scratch.total[id] += score;
+                    scratch.last[id] = score;
+                } else if (scratch.matched[id] == matchedBefore + 1 && score > scratch.last[id]) {
+                    scratch.total[id] += score - scratch.last[id];
+                    scratch.last[id] = score;
+                }
+            }
+        }
+    }
+
+    std::vector<Ranked> ranked;
+    const auto allMatched = static_cast<uint32_t>(words.size());
+    for (uint32_t id : scratch.touched) {
+        if (scratch.matched[id] == allMatched) {
+            ranked.push_back({1.0 + scratch.total[id] / static_cast<double>(words.size()), id, false});
+        }
+    }
+
+    // Fuzzy stage: share of the query's trigrams found in the entry, with
+    // a Dice term so that shorter names win among equally good matches.
+    // Always runs on transliterated words, which also bridges Russian and
+    // Belarusian spellings ("щербаков" / "шчарбакоў").
+    std::size_t letters = 0;
+    for (const auto& word : words) letters += word.size();
+    if (ranked.size() < limit && letters >= MIN_FUZZY_LETTERS) {
+        std::vector<uint64_t> trigrams;
+        for (const auto& word : words) appendTrigrams(cyrillic ? transliterate(word) : word, trigrams);
+        sortUnique(trigrams);
+
+        for (uint64_t trigram : trigrams) {
+            auto found = trigramPostings.find(trigram);
+            if (found == trigramPostings.end()) continue;
+            for (uint32_t id : found->second) {
+                if (scratch.matched[id] == 0 && scratch.shared[id] == 0) scratch.touched.push_back(id);
+                ++scratch.shared[id];
+            }
+        }
+        const double queryCount = static_cast<double>(trigrams.size());
+        for (uint32_t id : scratch.touched) {
+            if (scratch.matched[id] == allMatched) continue;
+            const double containment = scratch.shared[id] / queryCount;
+            if (containment < MIN_SIMILARITY) continue;
+            const double dice = 2.0 * scratch.shared[id] /
+                                (queryCount + static_cast<double>(entries[id].trigrams.size()));
+            ranked.push_back({0.5 * containment + 0.5 * dice, id, true});
+        }
+    }
+    scratch.reset();
+
+    auto better = [this](const Ranked& a, const Ranked& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return entries[a.id].fullName < entries[b.id].fullName;
+    };
+    const std::size_t count = std::min(limit, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(count), ranked.end(), better);
+
+    std::vector<RosterMatch> matches;
+    matches.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Entry& entry = entries[ranked[i].id];
+        matches.push_back({entry.key, entry.fullName, entry.group, ranked[i].score, ranked[i].fuzzy});
+    }
+    return matches;
+}
+
+} // namespace BSUIR
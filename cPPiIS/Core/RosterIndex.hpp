@@ -0,0 +1,141 @@
+//
+//  RosterIndex.hpp
+//  cPPiIS Core C++ Roster Search Index
+//
+//  Incremental name index over group rosters and personal info with
+//  Cyrillic case folding, transliteration, prefix and trigram search
+//
+
+#ifndef RosterIndex_hpp
+#define RosterIndex_hpp
+
+#include "Models.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief One search hit
+ */
+struct RosterMatch {
+    std::string key;            ///< Entry key ("<group>/<number>" for roster entries)
+    std::string fullName;
+    std::string group;
+    double score = 0.0;         ///< >= 1 for prefix matches, (0, 1) for fuzzy ones
+    bool fuzzy = false;
+};
+
+/**
+ * @brief Name search over students of any number of groups
+ *
+ * Names are split into words and folded: case, ё/е, Belarusian і/и and
+ * ў/у, apostrophes dropped. Every word is indexed twice, as folded text
+ * and as its Latin transliteration, so "Ёлкин", "елкин" and "elkin"
+ * all find the same student. A query in Cyrillic searches the folded
+ * words, a query in Latin the transliterated ones.
+ *
+ * Search first looks for entries where every query word is a prefix of
+ * some name word (an ordered word map makes that a range scan). When
+ * that yields fewer than the requested number of hits, entries sharing
+ * trigrams with the query fill up the rest, ranked by the share of the
+ * query's trigrams they contain. Trigrams come from transliterated words,
+ * so this tolerates typos, other transliteration schemes ("yolkin") and
+ * Russian versus Belarusian spellings.
+ *
+ * Updates touch only the postings of the changed entry. Queries take a
+ * shared lock and may run concurrently with each other.
+ */
+class RosterIndex {
+public:
+    static constexpr double MIN_SIMILARITY = 0.4;  ///< Share of query trigrams a fuzzy match must contain
+
+private:
+    enum Script : std::size_t { Folded = 0, Latin = 1, ScriptCount = 2 };
+
+    struct Entry {
+        std::string key;
+        std::string fullName;
+        std::string group;
+        std::vector<std::string> aliases;   ///< Other spellings, e.g. the Belarusian name
+        std::array<std::vector<std::u32string>, ScriptCount> words;
+        std::vector<uint64_t> trigrams;     ///< Of the transliterated words
+    };
+
+    mutable std::shared_mutex mutex;
+    std::vector<Entry> entries;
+    std::vector<uint32_t> freeSlots;
+    std::unordered_map<std::string, uint32_t> keys;
+    std::unordered_map<std::string, std::vector<uint32_t>> groups;
+    std::array<std::map<std::u32string, std::vector<uint32_t>>, ScriptCount> wordPostings;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> trigramPostings;
+
+    void insertLocked(std::string key, std::string fullName, std::string group, std::vector<std::string> aliases);
+    void eraseLocked(uint32_t id);
+    uint32_t findInGroupLocked(const std::string& group, const std::u32string& foldedName) const;
+
+public:
+    /**
+     * @brief Add or replace an entry
+     * @param key Caller-chosen unique key
+     * @param fullName Display name, indexed
+     * @param group Group number reported with matches
+     * @param aliases Extra spellings that are indexed but not displayed
+     */
+    void upsert(const std::string& key, const std::string& fullName, const std::string& group,
+                std::vector<std::string> aliases = {});
+
+    /**
+     * @brief Remove an entry
+     * @return False if the key was not indexed
+     */
+    bool remove(const std::string& key);
+
+    /**
+     * @brief Replace the indexed roster of a group
+     *
+     * Students whose number and name are unchanged keep their entries
+     * (and any aliases added by indexPerson), so a refresh with a few
+     * roster changes costs only those changes.
+     */
+    void indexGroup(const GroupInfo& info);
+
+    /**
+     * @brief Index a student's Russian and Belarusian names
+     *
+     * If the student's group is indexed and lists the same name, the
+     * names become aliases of that roster entry; otherwise the student
+     * gets an entry of their own under "student/<number>".
+     */
+    void indexPerson(const PersonalInfo& info);
+
+    /**
+     * @brief Ranked search
+     * @param query Any part of a name in Cyrillic or Latin, words in any order
+     * @param limit Maximum number of matches
+     */
+    std::vector<RosterMatch> search(const std::string& query, std::size_t limit = 10) const;
+
+    std::size_t size() const;
+    void clear();
+
+    /**
+     * @brief Split into folded words (exposed for callers that cache queries)
+     */
+    static std::vector<std::u32string> foldWords(const std::string& text);
+
+    /**
+     * @brief Latin transliteration of a folded word
+     */
+    static std::u32string transliterate(const std::u32string& word);
+};
+
+} // namespace BSUIR
+
+#endif /* RosterIndex_hpp */
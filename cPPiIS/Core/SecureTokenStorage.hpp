@@ -9,12 +9,40 @@
 #ifndef SecureTokenStorage_hpp
 #define SecureTokenStorage_hpp
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <optional>
 
 namespace BSUIR {
 
+/**
+ * @brief Platform secret store (Keychain on iOS) holding opaque blobs by key
+ *
+ * Implementations must be safe to call from any thread.
+ */
+class ISecureVault {
+public:
+    virtual ~ISecureVault() = default;
+    
+    /**
+     * @brief Read a stored blob
+     * @return Blob or empty optional if nothing is stored under the key
+     */
+    virtual std::optional<std::string> read(const std::string& key) const = 0;
+    
+    /**
+     * @brief Store a blob, replacing any previous one
+     * @return true if the blob was stored
+     */
+    virtual bool write(const std::string& key, const std::string& value) = 0;
+    
+    /**
+     * @brief Delete a blob (no-op if absent)
+     */
+    virtual void remove(const std::string& key) = 0;
+};
+
 /**
  * @brief Secure token storage with automatic cleanup
  * 
@@ -53,6 +81,7 @@ private:
     
     std::unique_ptr<SecureString> accessToken;
     std::unique_ptr<SecureString> refreshToken;
+    std::string account;
     int64_t expirationTime;
     bool isValid;
     
@@ -119,6 +148,31 @@ public:
      * @return Seconds until expiration, 0 if expired
      */
     int64_t getTimeUntilExpiration() const noexcept;
+    
+    /**
+     * @brief Set the user the tokens belong to
+     * @param accountValue Student number
+     */
+    void setAccount(const std::string& accountValue);
+    
+    /**
+     * @brief Get the user the tokens belong to
+     * @return Student number (empty if not set)
+     */
+    const std::string& getAccount() const noexcept;
+    
+    /**
+     * @brief Encode tokens, account and expiry for a secure vault
+     * @return Blob accepted by restore(), empty if there is nothing to save
+     */
+    std::string serialize() const;
+    
+    /**
+     * @brief Replace the contents with a blob produced by serialize()
+     * @param blob Encoded session
+     * @return true if the blob was well-formed and has not expired
+     */
+    bool restore(const std::string& blob);
 };
 
 /**
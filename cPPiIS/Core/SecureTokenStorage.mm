@@ -9,9 +9,44 @@
 #include <cstring>
 #include <chrono>
 #include <algorithm>
+#include <charconv>
 
 namespace BSUIR {
 
+namespace {
+
+constexpr const char* SESSION_FORMAT = "bsuir-session/1";
+constexpr size_t MAX_FIELD_DIGITS = 19;   ///< Largest length prefix that cannot overflow
+
+// Fields are length-prefixed ("<size>:<bytes>") so tokens may contain any byte
+void appendField(std::string& blob, const std::string& value) {
+    blob += std::to_string(value.size());
+    blob += ':';
+    blob += value;
+}
+
+bool readField(const std::string& blob, size_t& position, std::string& value) {
+    size_t colon = blob.find(':', position);
+    if (colon == std::string::npos || colon == position || colon - position > MAX_FIELD_DIGITS) {
+        return false;
+    }
+    size_t size = 0;
+    for (size_t i = position; i < colon; ++i) {
+        if (blob[i] < '0' || blob[i] > '9') {
+            return false;
+        }
+        size = size * 10 + static_cast<size_t>(blob[i] - '0');
+    }
+    if (size > blob.size() - colon - 1) {
+        return false;
+    }
+    value.assign(blob, colon + 1, size);
+    position = colon + 1 + size;
+    return true;
+}
+
+} // namespace
+
 // ========================================
 // SecureString Implementation
 // ========================================
@@ -79,6 +114,7 @@ SecureTokenStorage::~SecureTokenStorage() {
 SecureTokenStorage::SecureTokenStorage(SecureTokenStorage&& other) noexcept 
     : accessToken(std::move(other.accessToken)),
       refreshToken(std::move(other.refreshToken)),
+      account(std::move(other.account)),
       expirationTime(other.expirationTime),
       isValid(other.isValid) {
     other.expirationTime = 0;
@@ -90,6 +126,7 @@ SecureTokenStorage& SecureTokenStorage::operator=(SecureTokenStorage&& other) no
         clearTokens();
         accessToken = std::move(other.accessToken);
         refreshToken = std::move(other.refreshToken);
+        account = std::move(other.account);
         expirationTime = other.expirationTime;
         isValid = other.isValid;
         other.expirationTime = 0;
@@ -170,6 +207,7 @@ void SecureTokenStorage::clearTokens() {
         refreshToken.reset();
     }
     
+    account.clear();
     expirationTime = 0;
     isValid = false;
 }
@@ -187,6 +225,72 @@ int64_t SecureTokenStorage::getTimeUntilExpiration() const noexcept {
     return std::max(static_cast<int64_t>(0), remaining);
 }
 
+void SecureTokenStorage::setAccount(const std::string& accountValue) {
+    account = accountValue;
+}
+
+const std::string& SecureTokenStorage::getAccount() const noexcept {
+    return account;
+}
+
+std::string SecureTokenStorage::serialize() const {
+    if (!isValid) {
+        return "";
+    }
+    
+    std::string blob = SESSION_FORMAT;
+    blob += '\n';
+    appendField(blob, std::to_string(expirationTime));
+    appendField(blob, account);
+    appendField(blob, accessToken ? accessToken->getValue() : "");
+    appendField(blob, refreshToken ? refreshToken->getValue() : "");
+    return blob;
+}
+
+bool SecureTokenStorage::restore(const std::string& blob) {
+    clearTokens();
+    
+    const std::string header = std::string(SESSION_FORMAT) + '\n';
+    if (blob.compare(0, header.size(), header) != 0) {
+        return false;
+    }
+    
+    size_t position = header.size();
+    std::string expiration, accountValue, access, refresh;
+    if (!readField(blob, position, expiration) || !readField(blob, position, accountValue) ||
+        !readField(blob, position, access) || !readField(blob, position, refresh) ||
+        position != blob.size()) {
+        return false;
+    }
+    // A tampered or corrupt blob must not throw out of restoreSession
+    int64_t expiresAt = 0;
+    const char* expirationEnd = expiration.data() + expiration.size();
+    const auto [parsedEnd, error] = std::from_chars(expiration.data(), expirationEnd, expiresAt);
+    if (expiration.empty() || expiration.front() == '-' || error != std::errc() || parsedEnd != expirationEnd) {
+        return false;
+    }
+    
+    if (!access.empty()) {
+        accessToken = std::make_unique<SecureString>(access);
+    }
+    if (!refresh.empty()) {
+        refreshToken = std::make_unique<SecureString>(refresh);
+    }
+    account = std::move(accountValue);
+    expirationTime = expiresAt;
+    isValid = accessToken || refreshToken;
+    
+    // Wipe the plain copies; the SecureStrings hold their own
+    std::fill(access.begin(), access.end(), '\0');
+    std::fill(refresh.begin(), refresh.end(), '\0');
+    
+    if (!isValid || isTokenExpired()) {
+        clearTokens();
+        return false;
+    }
+    return true;
+}
+
 // ========================================
 // SecureTokenStorageFactory Implementation
 // ========================================
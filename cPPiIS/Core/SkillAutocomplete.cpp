@@ -0,0 +1,277 @@
+//
+//  SkillAutocomplete.cpp
+//  cPPiIS Core C++ Skill Autocomplete Implementation
+//
+
+#include "SkillAutocomplete.hpp"
+#include "../Config.h"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "SkillTrie.hpp"
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <typeinfo>
+#include <utility>
+
+namespace BSUIR {
+
+namespace {
+
+using Delivery = std::pair<SkillSuggestionsCallback, ApiResult<SkillSuggestions>>;
+
+const Metrics::EndpointMetrics& skillMetrics() {
+    static const Metrics::EndpointMetrics& metrics = Metrics::endpoint(API_SKILL_ENDPOINT);
+    return metrics;
+}
+
+Metrics::Counter& supersededCounter() {
+    static Metrics::Counter& counter = Metrics::MetricsRegistry::shared().counter(
+        "bsuir_autocomplete_superseded_total", {}, "Autocomplete queries replaced before they were answered");
+    return counter;
+}
+
+ApiResult<SkillSuggestions> suggestions(const std::string& query, std::vector<std::string> skills, bool fromCache) {
+    return ApiResult<SkillSuggestions>(SkillSuggestions{query, std::move(skills), fromCache});
+}
+
+} // namespace
+
+double SkillAutocompleteStats::hitRate() const noexcept {
+    const uint64_t answered = localHits + coalesced + requests;
+    return answered ? static_cast<double>(localHits + coalesced) / static_cast<double>(answered) : 0.0;
+}
+
+// ========================================
+// Shared state
+// ========================================
+
+struct SkillAutocomplete::State : std::enable_shared_from_this<State> {
+    struct Query {
+        uint64_t id = 0;
+        std::string text;
+        std::string key;            ///< Folded text
+        SkillSuggestionsCallback callback;
+        std::string awaiting;       ///< Key of the request it waits for
+        bool waiting = false;
+    };
+
+    ApiService& service;
+    const SkillAutocompleteOptions options;
+
+    mutable std::mutex mutex;
+    SkillTrie trie;
+    std::optional<Query> current;
+    uint64_t nextId = 0;
+    std::vector<std::string> inFlight;
+    SkillAutocompleteStats counters;
+
+    State(ApiService& apiService, SkillAutocompleteOptions settings)
+        : service(apiService), options(settings) {}
+
+    /**
+     * @brief Hand results to their callbacks through the service
+     *
+     * Like the service's own results: a slow callback is reported by the
+     * watchdog and, with a callback executor, does not hold up the
+     * scheduler thread and every other timer of the wheel.
+     */
+    void run(std::vector<Delivery>& deliveries) {
+        for (auto& [callback, result] : deliveries) {
+            if (callback) {
+                service.deliverCallback(typeid(SkillSuggestions),
+                                        [callback = std::move(callback), result = std::move(result)] { callback(result); });
+            }
+        }
+    }
+
+    std::optional<ApiResult<SkillSuggestions>> answerLocked(const Query& query, bool fromCache) const {
+        auto skills = trie.lookup(query.key, options.limit);
+        if (!skills) {
+            return std::nullopt;
+        }
+        return suggestions(query.text, std::move(*skills), fromCache);
+    }
+
+    void supersedeLocked(std::vector<Delivery>& deliveries, const char* reason) {
+        if (!current) {
+            return;
+        }
+        ++counters.superseded;
+        supersededCounter().add();
+        deliveries.emplace_back(std::move(current->callback), ApiResult<SkillSuggestions>(
+            ApiError{API_ERROR_CANCELLED, reason, current->text}));
+        current.reset();
+    }
+
+    void answerCurrentLocked(std::vector<Delivery>& deliveries, ApiResult<SkillSuggestions> result) {
+        deliveries.emplace_back(std::move(current->callback), std::move(result));
+        current.reset();
+    }
+
+    /**
+     * @brief Mark the current query as waiting for its own request
+     * @return Text and key to send
+     */
+    std::pair<std::string, std::string> startRequestLocked() {
+        current->waiting = true;
+        current->awaiting = current->key;
+        inFlight.push_back(current->key);
+        ++counters.requests;
+        skillMetrics().cacheMisses->add();
+        return {current->text, current->key};
+    }
+
+    void send(const std::pair<std::string, std::string>& request) {
+        BSUIR_LOG_DEBUG(Api, "🔎 Skill search for \"", request.first, "\"");
+        std::weak_ptr<State> weak = weak_from_this();
+        const std::string key = request.second;
+        service.searchSkills(request.first, [weak, key](const ApiResult<std::vector<std::string>>& result) {
+            if (auto self = weak.lock()) {
+                self->onResponse(key, result);
+            }
+        });
+    }
+
+    void fire(uint64_t id) {
+        std::vector<Delivery> deliveries;
+        std::optional<std::pair<std::string, std::string>> request;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!current || current->id != id || current->waiting) {
+                return;
+            }
+            if (auto answer = answerLocked(*current, true)) {
+                // Covered by a response that arrived during the debounce
+                ++counters.localHits;
+                skillMetrics().cacheHits->add();
+                answerCurrentLocked(deliveries, std::move(*answer));
+            } else {
+                auto pending = std::find_if(inFlight.begin(), inFlight.end(), [this](const std::string& key) {
+                    return current->key.compare(0, key.size(), key) == 0;
+                });
+                if (pending != inFlight.end()) {
+                    current->waiting = true;
+                    current->awaiting = *pending;
+                    ++counters.coalesced;
+                    skillMetrics().cacheHits->add();
+                } else {
+                    request = startRequestLocked();
+                }
+            }
+        }
+        run(deliveries);
+        if (request) {
+            send(*request);
+        }
+    }
+
+    void onResponse(const std::string& key, const ApiResult<std::vector<std::string>>& result) {
+        std::vector<Delivery> deliveries;
+        std::optional<std::pair<std::string, std::string>> request;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight.erase(std::find(inFlight.begin(), inFlight.end(), key));
+            const bool answered = result.success && result.data;
+            if (answered) {
+                const bool complete = options.serverPageSize == 0 || result.data->size() < options.serverPageSize;
+                trie.insert(key, *result.data, complete);
+            }
+            if (!current || !current->waiting || current->awaiting != key) {
+                return;
+            }
+            if (auto answer = answerLocked(*current, current->key != key)) {
+                answerCurrentLocked(deliveries, std::move(*answer));
+            } else if (!answered) {
+                answerCurrentLocked(deliveries, ApiResult<SkillSuggestions>(
+                    result.error.value_or(ApiError{-1, "Skill search failed", ""})));
+            } else if (current->key == key) {
+                // Truncated page for this very query: it is the best answer there is
+                std::vector<std::string> skills = *result.data;
+                if (options.limit != 0 && skills.size() > options.limit) {
+                    skills.resize(options.limit);
+                }
+                answerCurrentLocked(deliveries, suggestions(current->text, std::move(skills), false));
+            } else {
+                // Truncated page of a shorter prefix does not cover this query
+                --counters.coalesced;
+                request = startRequestLocked();
+            }
+        }
+        run(deliveries);
+        if (request) {
+            send(*request);
+        }
+    }
+};
+
+// ========================================
+// SkillAutocomplete Implementation
+// ========================================
+
+SkillAutocomplete::SkillAutocomplete(ApiService& service, SkillAutocompleteOptions options,
+                                     std::shared_ptr<TimerWheel> timer)
+    : scheduler(timer ? std::move(timer) : TimerWheel::shared()),
+      state(std::make_shared<State>(service, options)) {}
+
+SkillAutocomplete::~SkillAutocomplete() {
+    cancel();
+}
+
+void SkillAutocomplete::complete(const std::string& query, SkillSuggestionsCallback callback) {
+    std::vector<Delivery> deliveries;
+    uint64_t scheduled = 0;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        ++state->counters.queries;
+        state->supersedeLocked(deliveries, "Superseded by a newer query");
+
+        State::Query next;
+        next.id = ++state->nextId;
+        next.text = query;
+        next.key = SkillTrie::foldKey(query);
+        next.callback = std::move(callback);
+
+        if (next.key.size() < state->options.minQueryLength) {
+            deliveries.emplace_back(std::move(next.callback), suggestions(query, {}, true));
+        } else if (auto answer = state->answerLocked(next, true)) {
+            ++state->counters.localHits;
+            skillMetrics().cacheHits->add();
+            deliveries.emplace_back(std::move(next.callback), std::move(*answer));
+        } else {
+            scheduled = next.id;
+            state->current = std::move(next);
+        }
+    }
+    state->run(deliveries);
+
+    if (scheduled != 0) {
+        std::weak_ptr<State> weak = state;
+        scheduler->schedule(state->options.debounce, [weak, scheduled] {
+            if (auto self = weak.lock()) {
+                self->fire(scheduled);
+            }
+        });
+    }
+}
+
+void SkillAutocomplete::cancel() {
+    std::vector<Delivery> deliveries;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->supersedeLocked(deliveries, "Autocomplete cancelled");
+    }
+    state->run(deliveries);
+}
+
+void SkillAutocomplete::clearCache() {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->trie.clear();
+}
+
+SkillAutocompleteStats SkillAutocomplete::stats() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->counters;
+}
+
+} // namespace BSUIR
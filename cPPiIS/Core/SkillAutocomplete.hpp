@@ -0,0 +1,124 @@
+//
+//  SkillAutocomplete.hpp
+//  cPPiIS Core C++ Skill Autocomplete
+//
+//  Type-ahead over the /skill endpoint: debounced keystrokes, superseded
+//  queries cancelled, answers cached in a prefix trie
+//
+
+#ifndef SkillAutocomplete_hpp
+#define SkillAutocomplete_hpp
+
+#include "ApiService.hpp"
+#include "TimerWheel.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief Suggestions for one query
+ */
+struct SkillSuggestions {
+    std::string query;
+    std::vector<std::string> skills;
+    bool fromCache = false;     ///< Answered by the trie without a request of its own
+};
+
+using SkillSuggestionsCallback = std::function<void(const ApiResult<SkillSuggestions>&)>;
+
+/**
+ * @brief Autocomplete tuning
+ */
+struct SkillAutocompleteOptions {
+    std::chrono::milliseconds debounce{150};   ///< Quiet time after a keystroke before a request is sent
+    std::size_t minQueryLength = 1;             ///< Shorter queries get an empty answer without a request
+    std::size_t limit = 20;                     ///< Suggestions per answer (0 for all)
+    std::size_t serverPageSize = 0;             ///< A response this long may be truncated (0: responses are complete)
+};
+
+/**
+ * @brief Autocomplete counters since construction
+ */
+struct SkillAutocompleteStats {
+    uint64_t queries = 0;
+    uint64_t localHits = 0;         ///< Answered from the trie on arrival or after the debounce
+    uint64_t requests = 0;          ///< Requests sent to /skill
+    uint64_t coalesced = 0;         ///< Waited for an in-flight request of a shorter prefix
+    uint64_t superseded = 0;        ///< Replaced by a newer query before being answered
+
+    /**
+     * @brief Share of answered queries that needed no request of their own
+     */
+    double hitRate() const noexcept;
+};
+
+/**
+ * @brief Debounced, cached type-ahead for skill names
+ *
+ * Only the latest query is live: each complete() call cancels the
+ * previous one, whose callback receives an API_ERROR_CANCELLED result.
+ * A query is answered at once if the trie covers it (a complete server
+ * answer for one of its prefixes is known). Otherwise it waits for the
+ * debounce interval; if it is still current then and still not covered,
+ * it joins an in-flight request for one of its prefixes or sends its
+ * own. Every server answer is kept, even for a superseded query, since
+ * the user usually keeps typing the same word.
+ *
+ * Hits and misses are counted in bsuir_cache_hits_total /
+ * bsuir_cache_misses_total for the /skill endpoint, superseded queries in
+ * bsuir_autocomplete_superseded_total.
+ *
+ * Callbacks are delivered through ApiService::deliverCallback(): on the
+ * service's callback executor if it has one, otherwise on the thread
+ * that resolved the query (the caller's for an immediate answer, the
+ * scheduler thread after the debounce).
+ */
+class SkillAutocomplete {
+private:
+    struct State;
+    // Declared first so it is destroyed last: pending timers then find
+    // the state gone, and the timer thread never owns the wheel
+    std::shared_ptr<TimerWheel> scheduler;
+    std::shared_ptr<State> state;
+
+public:
+    /**
+     * @param service Service used for requests; must outlive this object
+     * @param options Tuning
+     * @param scheduler Timer for debouncing (TimerWheel::shared() if empty)
+     */
+    explicit SkillAutocomplete(ApiService& service, SkillAutocompleteOptions options = {},
+                               std::shared_ptr<TimerWheel> scheduler = nullptr);
+    ~SkillAutocomplete();
+
+    SkillAutocomplete(const SkillAutocomplete&) = delete;
+    SkillAutocomplete& operator=(const SkillAutocomplete&) = delete;
+
+    /**
+     * @brief Suggest skills for the text typed so far
+     * @param query Current text of the field
+     * @param callback Invoked exactly once, with suggestions, an error or a cancellation
+     */
+    void complete(const std::string& query, SkillSuggestionsCallback callback);
+
+    /**
+     * @brief Cancel the pending query, if any (e.g. the field lost focus)
+     */
+    void cancel();
+
+    /**
+     * @brief Forget all cached answers
+     */
+    void clearCache();
+
+    SkillAutocompleteStats stats() const;
+};
+
+} // namespace BSUIR
+
+#endif /* SkillAutocomplete_hpp */
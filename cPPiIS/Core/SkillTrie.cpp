@@ -0,0 +1,165 @@
+//
+//  SkillTrie.cpp
+//  cPPiIS Core C++ Skill Prefix Trie Implementation
+//
+
+#include "SkillTrie.hpp"
+
+namespace BSUIR {
+
+SkillTrie::SkillTrie() {
+    nodes.emplace_back();
+}
+
+std::string SkillTrie::foldKey(const std::string& text) {
+    std::string key;
+    key.reserve(text.size());
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const auto c = static_cast<unsigned char>(text[i]);
+        if (c >= 'A' && c <= 'Z') {
+            key.push_back(static_cast<char>(c + 0x20));
+            continue;
+        }
+        if (c == 0xD0 && i + 1 < text.size()) {
+            const auto next = static_cast<unsigned char>(text[i + 1]);
+            if (next >= 0x90 && next <= 0x9F) {             // А..П -> а..п
+                key.push_back(static_cast<char>(0xD0));
+                key.push_back(static_cast<char>(next + 0x20));
+                ++i;
+                continue;
+            }
+            if (next >= 0xA0 && next <= 0xAF) {             // Р..Я -> р..я
+                key.push_back(static_cast<char>(0xD1));
+                key.push_back(static_cast<char>(next - 0x20));
+                ++i;
+                continue;
+            }
+            if (next >= 0x80 && next <= 0x8F) {             // Ѐ..Џ (Ё, І, Ў) -> ѐ..џ
+                key.push_back(static_cast<char>(0xD1));
+                key.push_back(static_cast<char>(next + 0x10));
+                ++i;
+                continue;
+            }
+        }
+        key.push_back(static_cast<char>(c));
+    }
+    return key;
+}
+
+uint32_t SkillTrie::findChild(uint32_t node, char label) const {
+    for (uint32_t child = nodes[node].firstChild; child != NONE; child = nodes[child].nextSibling) {
+        if (nodes[child].label == label) {
+            return child;
+        }
+        if (static_cast<unsigned char>(nodes[child].label) > static_cast<unsigned char>(label)) {
+            break;
+        }
+    }
+    return NONE;
+}
+
+uint32_t SkillTrie::insertPath(const std::string& key) {
+    uint32_t node = 0;
+    for (char label : key) {
+        // Find the sorted insertion point among the children
+        uint32_t previous = NONE;
+        uint32_t child = nodes[node].firstChild;
+        while (child != NONE && static_cast<unsigned char>(nodes[child].label) < static_cast<unsigned char>(label)) {
+            previous = child;
+            child = nodes[child].nextSibling;
+        }
+        if (child == NONE || nodes[child].label != label) {
+            const auto created = static_cast<uint32_t>(nodes.size());
+            Node fresh;
+            fresh.label = label;
+            fresh.nextSibling = child;
+            nodes.push_back(fresh);
+            if (previous == NONE) {
+                nodes[node].firstChild = created;
+            } else {
+                nodes[previous].nextSibling = created;
+            }
+            child = created;
+        }
+        node = child;
+    }
+    return node;
+}
+
+void SkillTrie::insert(const std::string& prefix, const std::vector<std::string>& results, bool complete) {
+    for (const auto& skill : results) {
+        const uint32_t node = insertPath(foldKey(skill));
+        if (nodes[node].skill == NONE) {
+            nodes[node].skill = static_cast<uint32_t>(skills.size());
+            skills.push_back(skill);
+        }
+    }
+    if (complete) {
+        nodes[insertPath(foldKey(prefix))].complete = true;
+    }
+}
+
+bool SkillTrie::covers(const std::string& prefix) const {
+    const std::string key = foldKey(prefix);
+    uint32_t node = 0;
+    bool covered = nodes[0].complete;
+    for (char label : key) {
+        if (covered) {
+            return true;
+        }
+        node = findChild(node, label);
+        if (node == NONE) {
+            return false;
+        }
+        covered = nodes[node].complete;
+    }
+    return covered;
+}
+
+std::optional<std::vector<std::string>> SkillTrie::lookup(const std::string& prefix, std::size_t limit) const {
+    const std::string key = foldKey(prefix);
+    uint32_t node = 0;
+    bool covered = nodes[0].complete;
+    for (char label : key) {
+        node = findChild(node, label);
+        if (node == NONE) {
+            // A complete ancestor without this path: the server has no such skill
+            return covered ? std::optional<std::vector<std::string>>(std::vector<std::string>{}) : std::nullopt;
+        }
+        covered = covered || nodes[node].complete;
+    }
+    if (!covered) {
+        return std::nullopt;
+    }
+
+    // Pre-order walk: a name comes before its extensions, siblings in byte order
+    std::vector<std::string> result;
+    if (nodes[node].skill != NONE) {
+        result.push_back(skills[nodes[node].skill]);
+    }
+    std::vector<uint32_t> stack;
+    if (nodes[node].firstChild != NONE) {
+        stack.push_back(nodes[node].firstChild);
+    }
+    while (!stack.empty() && (limit == 0 || result.size() < limit)) {
+        const uint32_t current = stack.back();
+        stack.pop_back();
+        if (nodes[current].nextSibling != NONE) {
+            stack.push_back(nodes[current].nextSibling);
+        }
+        if (nodes[current].skill != NONE) {
+            result.push_back(skills[nodes[current].skill]);
+        }
+        if (nodes[current].firstChild != NONE) {
+            stack.push_back(nodes[current].firstChild);
+        }
+    }
+    return result;
+}
+
+void SkillTrie::clear() {
+    nodes.assign(1, Node{});
+    skills.clear();
+}
+
+} // namespace BSUIR
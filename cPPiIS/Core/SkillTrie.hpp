@@ -0,0 +1,90 @@
+//
+//  SkillTrie.hpp
+//  cPPiIS Core C++ Skill Prefix Trie
+//
+//  Flat byte trie of skill names that remembers which prefixes the
+//  server has answered completely
+//
+
+#ifndef SkillTrie_hpp
+#define SkillTrie_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief Local answer cache for prefix searches
+ *
+ * Keys are folded (ASCII and Cyrillic lower case) UTF-8 bytes. Nodes
+ * live in one vector and link by 32-bit index (first child, next
+ * sibling, 16 bytes per node), children kept sorted so a walk of a
+ * subtree lists skills alphabetically.
+ *
+ * A node marked complete means the server listed every skill starting
+ * with that prefix; any longer prefix below it can then be answered
+ * from the trie alone. This relies on the endpoint matching by prefix.
+ *
+ * Not thread-safe; SkillAutocomplete guards it with its own lock.
+ */
+class SkillTrie {
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        uint32_t firstChild = NONE;
+        uint32_t nextSibling = NONE;
+        uint32_t skill = NONE;      ///< Index into skills when a name ends here
+        char label = 0;
+        bool complete = false;      ///< Server results for this prefix are complete
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::string> skills;
+
+    uint32_t findChild(uint32_t node, char label) const;
+    uint32_t insertPath(const std::string& key);
+
+public:
+    SkillTrie();
+
+    /**
+     * @brief Record a server answer
+     * @param prefix Query that was sent
+     * @param results Skill names returned
+     * @param complete Whether results list every skill with the prefix
+     *                 (false for a response that may have been truncated)
+     */
+    void insert(const std::string& prefix, const std::vector<std::string>& results, bool complete);
+
+    /**
+     * @brief Answer a prefix locally
+     * @param prefix Query
+     * @param limit Maximum number of names (0 for all)
+     * @return Matching names in alphabetical order, or nullopt if no
+     *         complete answer covers the prefix
+     */
+    std::optional<std::vector<std::string>> lookup(const std::string& prefix, std::size_t limit = 0) const;
+
+    /**
+     * @brief Whether lookup() would answer the prefix
+     */
+    bool covers(const std::string& prefix) const;
+
+    std::size_t skillCount() const noexcept { return skills.size(); }
+    std::size_t nodeCount() const noexcept { return nodes.size(); }
+    void clear();
+
+    /**
+     * @brief Case-folded key as stored in the trie
+     */
+    static std::string foldKey(const std::string& text);
+};
+
+} // namespace BSUIR
+
+#endif /* SkillTrie_hpp */
@@ -0,0 +1,122 @@
+//
+//  StringPool.cpp
+//  cPPiIS Core C++ String Interning Implementation
+//
+
+#include "StringPool.hpp"
+#include "Metrics.hpp"
+#include <ostream>
+
+namespace BSUIR {
+
+namespace {
+
+// Function-local so a static InternedString in another file never sees it unconstructed
+const std::string* emptyString() noexcept {
+    static const std::string empty;
+    return &empty;
+}
+
+Metrics::Gauge& internedStrings() {
+    static Metrics::Gauge& gauge = Metrics::MetricsRegistry::shared().gauge(
+        "bsuir_interned_strings", {}, "Distinct strings in the interning pool");
+    return gauge;
+}
+
+Metrics::Gauge& internedBytes() {
+    static Metrics::Gauge& gauge = Metrics::MetricsRegistry::shared().gauge(
+        "bsuir_interned_bytes", {}, "Characters held by the interning pool");
+    return gauge;
+}
+
+} // namespace
+
+// ========================================
+// InternedString
+// ========================================
+
+InternedString::InternedString() noexcept : value(emptyString()) {}
+
+InternedString::InternedString(std::string_view text) : InternedString(StringPool::shared().intern(text)) {}
+
+InternedString& InternedString::operator=(std::string_view text) {
+    return *this = StringPool::shared().intern(text);
+}
+
+std::ostream& operator<<(std::ostream& out, InternedString text) {
+    return out << text.str();
+}
+
+// ========================================
+// StringPool
+// ========================================
+
+StringPool& StringPool::shared() {
+    // Leaked so handles stay valid during static destruction
+    static StringPool* pool = new StringPool();
+    return *pool;
+}
+
+std::size_t StringPool::shardIndex(std::string_view text) noexcept {
+    // High bits, so the shard does not repeat the bucket choice inside it
+    const std::size_t hash = Hash()(text);
+    return (hash >> (sizeof(std::size_t) * 8 - 4)) % SHARD_COUNT;
+}
+
+InternedString StringPool::intern(std::string_view text) {
+    if (text.empty()) {
+        return InternedString();
+    }
+
+    Shard& shard = shards[shardIndex(text)];
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto found = shard.strings.find(text);
+        if (found != shard.strings.end()) {
+            return InternedString(&*found);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto [it, inserted] = shard.strings.emplace(text);
+    if (inserted) {
+        shard.bytes += text.size();
+        internedStrings().add(1);
+        internedBytes().add(static_cast<int64_t>(text.size()));
+    }
+    return InternedString(&*it);
+}
+
+std::optional<InternedString> StringPool::find(std::string_view text) const {
+    if (text.empty()) {
+        return InternedString();
+    }
+
+    const Shard& shard = shards[shardIndex(text)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto found = shard.strings.find(text);
+    if (found == shard.strings.end()) {
+        return std::nullopt;
+    }
+    return InternedString(&*found);
+}
+
+std::size_t StringPool::size() const {
+    std::size_t total = 0;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.strings.size();
+    }
+    return total;
+}
+
+std::size_t StringPool::bytes() const {
+    std::size_t total = 0;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.bytes;
+    }
+    return total;
+}
+
+} // namespace BSUIR
@@ -0,0 +1,139 @@
+//
+//  StringPool.hpp
+//  cPPiIS Core C++ String Interning
+//
+//  Process-wide pool of the strings that repeat across snapshots and
+//  accounts (faculties, specialities, subject names, control forms)
+//
+
+#ifndef StringPool_hpp
+#define StringPool_hpp
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace BSUIR {
+
+class StringPool;
+
+/**
+ * @brief Handle to a string stored once in StringPool::shared()
+ *
+ * One pointer wide and trivially copyable. Interned strings are never
+ * freed, so the handle and the references it hands out stay valid for
+ * the life of the process. Two handles are equal exactly when their
+ * texts are, which is a pointer compare; comparing with other strings
+ * compares the text. Default-constructed handles hold the empty string.
+ */
+class InternedString {
+private:
+    const std::string* value;
+
+    friend class StringPool;
+    explicit InternedString(const std::string* value) noexcept : value(value) {}
+
+public:
+    InternedString() noexcept;
+
+    /**
+     * @brief Intern text in the shared pool
+     */
+    explicit InternedString(std::string_view text);
+    InternedString& operator=(std::string_view text);
+
+    const std::string& str() const noexcept { return *value; }
+    const char* c_str() const noexcept { return value->c_str(); }
+    std::size_t size() const noexcept { return value->size(); }
+    bool empty() const noexcept { return value->empty(); }
+
+    operator const std::string&() const noexcept { return *value; }
+    operator std::string_view() const noexcept { return *value; }
+
+    friend bool operator==(InternedString a, InternedString b) noexcept { return a.value == b.value; }
+    friend bool operator==(InternedString a, std::string_view b) noexcept { return *a.value == b; }
+
+    /**
+     * @brief Identity of the text, for hashing
+     */
+    const void* identity() const noexcept { return value; }
+};
+
+std::ostream& operator<<(std::ostream& out, InternedString text);
+
+/**
+ * @brief Concurrent set of interned strings
+ *
+ * Meant for low-cardinality fields only: nothing is ever removed, so
+ * interning free text (names, e-mails) would grow the pool for good.
+ * Strings are spread over shards by hash; a lookup of a string already
+ * present takes a shared lock on one shard, so parsers on many threads
+ * do not serialize. Strings live in hash set nodes, whose addresses do
+ * not change when the set grows. Size is published as the
+ * bsuir_interned_strings and bsuir_interned_bytes gauges.
+ */
+class StringPool {
+private:
+    static constexpr std::size_t SHARD_COUNT = 16;
+
+    struct Hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view text) const noexcept {
+            return std::hash<std::string_view>()(text);
+        }
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_set<std::string, Hash, std::equal_to<>> strings;
+        std::size_t bytes = 0;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards;
+
+    StringPool() = default;
+    static std::size_t shardIndex(std::string_view text) noexcept;
+
+public:
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    static StringPool& shared();
+
+    /**
+     * @brief Handle to text, adding it to the pool if it is new
+     */
+    InternedString intern(std::string_view text);
+
+    /**
+     * @brief Handle to text if it was interned before; never adds it
+     */
+    std::optional<InternedString> find(std::string_view text) const;
+
+    /**
+     * @brief Number of distinct strings held
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Characters held, without per-node overhead
+     */
+    std::size_t bytes() const;
+};
+
+} // namespace BSUIR
+
+template <>
+struct std::hash<BSUIR::InternedString> {
+    std::size_t operator()(BSUIR::InternedString text) const noexcept {
+        return std::hash<const void*>()(text.identity());
+    }
+};
+
+#endif /* StringPool_hpp */
@@ -0,0 +1,551 @@
+//
+//  Task.hpp
+//  cPPiIS Core C++ Coroutine Support
+//
+//  Lazy C++20 coroutine task, awaitable API operations and
+//  structured concurrency helpers (whenAll, spawn, syncWait)
+//
+
+#ifndef Task_hpp
+#define Task_hpp
+
+#include "Models.hpp"
+#include "Executor.hpp"
+#include "Cancellation.hpp"
+#include "CoroutineFramePool.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief Error code reported by awaitable operations that were cancelled
+ */
+constexpr int API_ERROR_CANCELLED = -2;
+
+template<typename T> class Task;
+
+namespace detail {
+
+template<typename T>
+class TaskPromiseBase : public PooledPromise {
+private:
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+
+public:
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            auto next = handle.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+
+    void setContinuation(std::coroutine_handle<> handle) noexcept {
+        continuation = handle;
+    }
+
+    void rethrowIfFailed() const {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase<T> {
+private:
+    std::optional<T> value;
+
+public:
+    Task<T> get_return_object() noexcept;
+
+    template<typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T takeResult() {
+        this->rethrowIfFailed();
+        return std::move(*value);
+    }
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase<void> {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void takeResult() const {
+        rethrowIfFailed();
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a value of type T
+ *
+ * The coroutine body does not run until the task is awaited (or handed
+ * to spawn/syncWait). Completion resumes the awaiting coroutine through
+ * symmetric transfer, so long await chains do not grow the stack.
+ * Frames are allocated from CoroutineFramePool.
+ */
+template<typename T>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+private:
+    Handle handle;
+
+public:
+    Task() noexcept = default;
+    explicit Task(Handle coroutine) noexcept : handle(coroutine) {}
+
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    // Tasks own their coroutine frame and are move-only
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+
+    bool isReady() const noexcept {
+        return !handle || handle.done();
+    }
+
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            Handle coroutine;
+
+            bool await_ready() const noexcept {
+                return !coroutine || coroutine.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                coroutine.promise().setContinuation(awaiting);
+                return coroutine;
+            }
+
+            T await_resume() {
+                return coroutine.promise().takeResult();
+            }
+        };
+        return Awaiter{handle};
+    }
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief Fire-and-forget coroutine used by spawn()
+ */
+struct DetachedTask {
+    struct promise_type : PooledPromise {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+template<typename T, typename Callback>
+DetachedTask runDetached(Task<T> task, Callback onComplete) {
+    if constexpr (std::is_void_v<T>) {
+        co_await task;
+        onComplete();
+    } else {
+        onComplete(co_await task);
+    }
+}
+
+// ========================================
+// whenAll machinery
+// ========================================
+
+struct WhenAllLatch {
+    std::atomic<std::size_t> remaining;
+    std::coroutine_handle<> awaiting;
+
+    // One extra count is held by the awaiter until all children started
+    explicit WhenAllLatch(std::size_t count) : remaining(count + 1) {}
+
+    std::coroutine_handle<> arrive() noexcept {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            return awaiting;
+        }
+        return std::noop_coroutine();
+    }
+};
+
+class WhenAllChild {
+public:
+    struct promise_type : PooledPromise {
+        WhenAllLatch* latch = nullptr;
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                return handle.promise().latch->arrive();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        WhenAllChild get_return_object() noexcept {
+            return WhenAllChild(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+public:
+    explicit WhenAllChild(std::coroutine_handle<promise_type> coroutine) noexcept : handle(coroutine) {}
+
+    ~WhenAllChild() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    WhenAllChild(const WhenAllChild&) = delete;
+    WhenAllChild& operator=(const WhenAllChild&) = delete;
+    WhenAllChild(WhenAllChild&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    WhenAllChild& operator=(WhenAllChild&&) = delete;
+
+    void start(WhenAllLatch& latch) {
+        handle.promise().latch = &latch;
+        handle.resume();
+    }
+};
+
+template<typename T>
+struct WhenAllSlot {
+    std::optional<T> value;
+    std::exception_ptr error;
+
+    T take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template<typename T>
+WhenAllChild makeWhenAllChild(Task<T>& task, WhenAllSlot<T>& slot) {
+    try {
+        slot.value.emplace(co_await task);
+    } catch (...) {
+        slot.error = std::current_exception();
+    }
+}
+
+struct WhenAllAwaiter {
+    std::vector<WhenAllChild>& children;
+    WhenAllLatch& latch;
+
+    bool await_ready() const noexcept {
+        return children.empty();
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        latch.awaiting = awaiting;
+        for (auto& child : children) {
+            child.start(latch);
+        }
+        // Suspend unless every child already finished synchronously
+        return latch.remaining.fetch_sub(1, std::memory_order_acq_rel) > 1;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+template<typename... Ts, std::size_t... I>
+Task<std::tuple<Ts...>> whenAllImpl(std::tuple<Task<Ts>...> tasks, std::index_sequence<I...>) {
+    std::tuple<WhenAllSlot<Ts>...> slots;
+    std::vector<WhenAllChild> children;
+    children.reserve(sizeof...(Ts));
+    (children.push_back(makeWhenAllChild(std::get<I>(tasks), std::get<I>(slots))), ...);
+
+    WhenAllLatch latch(children.size());
+    co_await WhenAllAwaiter{children, latch};
+
+    co_return std::tuple<Ts...>(std::get<I>(slots).take()...);
+}
+
+} // namespace detail
+
+// ========================================
+// Structured concurrency helpers
+// ========================================
+
+/**
+ * @brief Run tasks concurrently and wait for all of them
+ * @param tasks Tasks to run; each is started in order on the awaiting thread
+ * @return Task yielding results in the same order
+ */
+template<typename T>
+Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks) {
+    std::vector<detail::WhenAllSlot<T>> slots(tasks.size());
+    std::vector<detail::WhenAllChild> children;
+    children.reserve(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        children.push_back(detail::makeWhenAllChild(tasks[i], slots[i]));
+    }
+
+    detail::WhenAllLatch latch(children.size());
+    co_await detail::WhenAllAwaiter{children, latch};
+
+    std::vector<T> results;
+    results.reserve(slots.size());
+    for (auto& slot : slots) {
+        results.push_back(slot.take());
+    }
+    co_return results;
+}
+
+/**
+ * @brief Run heterogeneous tasks concurrently and wait for all of them
+ * @return Task yielding a tuple of results
+ */
+template<typename... Ts>
+Task<std::tuple<Ts...>> whenAll(Task<Ts>... tasks) {
+    return detail::whenAllImpl<Ts...>(std::tuple<Task<Ts>...>(std::move(tasks)...),
+                                      std::index_sequence_for<Ts...>{});
+}
+
+/**
+ * @brief Start a task without awaiting it
+ * @param task Task to run; it starts immediately on the calling thread
+ * @param onComplete Invoked with the task result when it finishes
+ */
+template<typename T, typename Callback>
+void spawn(Task<T> task, Callback onComplete) {
+    detail::runDetached(std::move(task), std::move(onComplete));
+}
+
+/**
+ * @brief Block the calling thread until a task completes
+ *
+ * Intended for tools and command line drivers. Never call it from a
+ * thread that the task itself needs in order to make progress.
+ */
+template<typename T>
+T syncWait(Task<T> task) {
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> result;
+
+    auto signal = [&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        finished.notify_one();
+    };
+
+    if constexpr (std::is_void_v<T>) {
+        spawn(std::move(task), [&] { signal(); });
+    } else {
+        spawn(std::move(task), [&](T value) {
+            result.emplace(std::move(value));
+            signal();
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return done; });
+
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*result);
+    }
+}
+
+/**
+ * @brief Awaitable that continues the coroutine on the given executor
+ */
+class ResumeOnExecutor {
+private:
+    std::shared_ptr<IExecutor> executor;
+
+public:
+    explicit ResumeOnExecutor(std::shared_ptr<IExecutor> target) : executor(std::move(target)) {}
+
+    bool await_ready() const noexcept {
+        return !executor;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        executor->post([handle] { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+};
+
+inline ResumeOnExecutor resumeOn(std::shared_ptr<IExecutor> executor) {
+    return ResumeOnExecutor(std::move(executor));
+}
+
+// ========================================
+// Awaitable adapter for callback-based API calls
+// ========================================
+
+/**
+ * @brief Awaitable wrapper around a callback-style ApiService request
+ *
+ * The completion callback only captures shared state, never the
+ * awaiting coroutine frame directly, so a late HTTP response after
+ * cancellation is dropped safely. Whichever of completion and
+ * suspension happens second resumes the coroutine, which makes it
+ * safe for the callback to fire synchronously.
+ */
+template<typename T>
+class ApiOperation {
+public:
+    using Callback = std::function<void(const ApiResult<T>&)>;
+    using Starter = std::function<void(Callback)>;
+
+private:
+    struct State {
+        std::atomic<bool> completed{false};
+        std::atomic<bool> rendezvous{false};
+        std::optional<ApiResult<T>> result;
+        std::coroutine_handle<> handle;
+        std::shared_ptr<IExecutor> executor;
+
+        void complete(const ApiResult<T>& value) {
+            if (completed.exchange(true, std::memory_order_acq_rel)) {
+                return;
+            }
+            result.emplace(value);
+            if (rendezvous.exchange(true, std::memory_order_acq_rel)) {
+                resume();
+            }
+        }
+
+        void resume() {
+            if (executor) {
+                auto coroutine = handle;
+                executor->post([coroutine] { coroutine.resume(); });
+            } else {
+                handle.resume();
+            }
+        }
+    };
+
+    Starter starter;
+    CancellationToken token;
+    std::shared_ptr<State> state;
+    uint64_t cancellationId = 0;
+
+    static ApiResult<T> cancelledResult() {
+        return ApiResult<T>(ApiError{API_ERROR_CANCELLED, "Operation cancelled", ""});
+    }
+
+public:
+    ApiOperation(Starter start,
+                 std::shared_ptr<IExecutor> executor = nullptr,
+                 CancellationToken cancellation = {})
+        : starter(std::move(start)),
+          token(std::move(cancellation)),
+          state(std::make_shared<State>()) {
+        state->executor = std::move(executor);
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        state->handle = handle;
+
+        if (token.isCancellationRequested()) {
+            state->result.emplace(cancelledResult());
+            return false;
+        }
+
+        std::weak_ptr<State> weakState = state;
+        cancellationId = token.registerCallback([weakState] {
+            if (auto shared = weakState.lock()) {
+                shared->complete(cancelledResult());
+            }
+        });
+
+        if (state->completed.load(std::memory_order_acquire)) {
+            return !state->rendezvous.exchange(true, std::memory_order_acq_rel);
+        }
+
+        auto sharedState = state;
+        starter([sharedState](const ApiResult<T>& result) {
+            sharedState->complete(result);
+        });
+
+        return !state->rendezvous.exchange(true, std::memory_order_acq_rel);
+    }
+
+    ApiResult<T> await_resume() {
+        token.unregisterCallback(cancellationId);
+        return std::move(*state->result);
+    }
+};
+
+} // namespace BSUIR
+
+#endif /* Task_hpp */
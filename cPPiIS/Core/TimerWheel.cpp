@@ -0,0 +1,306 @@
+//
+//  TimerWheel.cpp
+//  cPPiIS Core C++ Hierarchical Timer Wheel Implementation
+//
+
+#include "TimerWheel.hpp"
+#include <algorithm>
+#include <random>
+
+namespace BSUIR {
+
+namespace {
+
+constexpr uint64_t MAX_DELTA = (uint64_t{1} << 32) - 1;
+
+} // namespace
+
+TimerWheel::TimerWheel(TimerWheelOptions wheelOptions)
+    : options(std::move(wheelOptions)), origin(std::chrono::steady_clock::now()) {
+    if (options.tick.count() <= 0) {
+        options.tick = std::chrono::microseconds(1);
+    }
+    options.batchSize = std::max<std::size_t>(options.batchSize, 1);
+    for (Level& level : levels) {
+        level.heads.fill(NONE);
+    }
+    worker = std::thread([this] { run(); });
+}
+
+TimerWheel::~TimerWheel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    worker.join();
+}
+
+// ========================================
+// Public Interface
+// ========================================
+
+TimerWheel::TimerId TimerWheel::schedule(std::chrono::microseconds delay, std::function<void()> work) {
+    const auto due = std::chrono::steady_clock::now() + std::max(delay, std::chrono::microseconds(0));
+    TimerId id;
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pendingCount == 0) {
+            // Nothing to cascade: skip the idle stretch instead of stepping through it
+            currentTick = std::max(currentTick, tickAt(std::chrono::steady_clock::now(), false));
+        }
+
+        uint32_t index;
+        if (freeNodes.empty()) {
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        } else {
+            index = freeNodes.back();
+            freeNodes.pop_back();
+        }
+        Node& node = nodes[index];
+        node.work = std::move(work);
+        node.due = std::clamp(tickAt(due, true), currentTick + 1, currentTick + MAX_DELTA);
+        ++pendingCount;
+
+        std::vector<std::function<void()>> none;
+        link(index, none);
+        id = (static_cast<TimerId>(node.generation) << 32) | (index + 1);
+        wake = nextWakeTick() < wakeTick;
+    }
+    if (wake) {
+        changed.notify_one();
+    }
+    return id;
+}
+
+TimerWheel::TimerId TimerWheel::schedule(std::chrono::microseconds delay, double jitter, std::function<void()> work) {
+    return schedule(jittered(delay, jitter), std::move(work));
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    const uint64_t slot = id & 0xFFFFFFFFu;
+    const uint32_t generation = static_cast<uint32_t>(id >> 32);
+    std::function<void()> work;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (slot == 0 || slot > nodes.size()) {
+            return false;
+        }
+        const uint32_t index = static_cast<uint32_t>(slot - 1);
+        Node& node = nodes[index];
+        if (node.generation != generation || !node.linked) {
+            return false;
+        }
+        unlink(index);
+        work = std::move(node.work);
+        release(index);
+        --pendingCount;
+    }
+    // Captured state is destroyed outside the lock
+    return true;
+}
+
+std::size_t TimerWheel::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pendingCount;
+}
+
+std::chrono::microseconds TimerWheel::jittered(std::chrono::microseconds delay, double jitter) {
+    jitter = std::clamp(jitter, 0.0, 1.0);
+    if (jitter == 0.0 || delay.count() <= 0) {
+        return delay;
+    }
+    thread_local std::mt19937_64 random(std::random_device{}());
+    std::uniform_real_distribution<double> spread(1.0 - jitter, 1.0 + jitter);
+    return std::chrono::microseconds(static_cast<int64_t>(static_cast<double>(delay.count()) * spread(random)));
+}
+
+std::shared_ptr<TimerWheel> TimerWheel::shared() {
+    // Leaked: timers may still be scheduled from other threads during exit
+    static auto* wheel = new std::shared_ptr<TimerWheel>(std::make_shared<TimerWheel>());
+    return *wheel;
+}
+
+// ========================================
+// Wheel Internals (mutex held)
+// ========================================
+
+uint64_t TimerWheel::tickAt(std::chrono::steady_clock::time_point time, bool roundUp) const {
+    const int64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time - origin).count();
+    if (elapsed <= 0) {
+        return 0;
+    }
+    const uint64_t ticks = static_cast<uint64_t>(elapsed) / static_cast<uint64_t>(options.tick.count());
+    const bool partial = static_cast<uint64_t>(elapsed) % static_cast<uint64_t>(options.tick.count()) != 0;
+    return ticks + (roundUp && partial ? 1 : 0);
+}
+
+void TimerWheel::link(uint32_t index, std::vector<std::function<void()>>& expired) {
+    Node& node = nodes[index];
+    if (node.due <= currentTick) {
+        expired.push_back(std::move(node.work));
+        release(index);
+        --pendingCount;
+        return;
+    }
+
+    // Coarsest level needed for the remaining time; the slot is absolute
+    // so the timer comes round exactly when its range starts
+    const uint64_t delta = node.due - currentTick;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    const uint32_t slot = static_cast<uint32_t>(node.due >> (SLOT_BITS * level)) & (SLOTS - 1);
+    Level& wheel = levels[level];
+
+    node.level = static_cast<uint8_t>(level);
+    node.previous = NONE;
+    node.next = wheel.heads[slot];
+    if (node.next != NONE) {
+        nodes[node.next].previous = index;
+    }
+    wheel.heads[slot] = index;
+    wheel.occupied[slot / 64] |= uint64_t{1} << (slot % 64);
+    node.linked = true;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes[index];
+    Level& wheel = levels[node.level];
+    const uint32_t slot = static_cast<uint32_t>(node.due >> (SLOT_BITS * node.level)) & (SLOTS - 1);
+
+    if (node.previous != NONE) {
+        nodes[node.previous].next = node.next;
+    } else {
+        wheel.heads[slot] = node.next;
+    }
+    if (node.next != NONE) {
+        nodes[node.next].previous = node.previous;
+    }
+    if (wheel.heads[slot] == NONE) {
+        wheel.occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+    }
+    node.linked = false;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Node& node = nodes[index];
+    node.linked = false;
+    // A new generation makes ids of the finished timer stale
+    ++node.generation;
+    freeNodes.push_back(index);
+}
+
+void TimerWheel::cascade(int level, std::vector<std::function<void()>>& expired) {
+    Level& wheel = levels[level];
+    const uint32_t slot = static_cast<uint32_t>(currentTick >> (SLOT_BITS * level)) & (SLOTS - 1);
+    uint32_t index = wheel.heads[slot];
+    wheel.heads[slot] = NONE;
+    wheel.occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+
+    while (index != NONE) {
+        const uint32_t next = nodes[index].next;
+        nodes[index].linked = false;
+        link(index, expired);
+        index = next;
+    }
+}
+
+void TimerWheel::advance(uint64_t tick, std::vector<std::function<void()>>& expired) {
+    while (currentTick < tick) {
+        if (pendingCount == 0) {
+            currentTick = tick;
+            return;
+        }
+        const uint64_t next = nextWakeTick();
+        if (next > tick) {
+            currentTick = tick;
+            return;
+        }
+        currentTick = next;
+
+        // At a level boundary the coarser slots whose range starts now move down
+        for (int level = LEVELS - 1; level > 0; --level) {
+            if ((currentTick & ((uint64_t{1} << (SLOT_BITS * level)) - 1)) == 0) {
+                cascade(level, expired);
+            }
+        }
+        cascade(0, expired);
+    }
+}
+
+uint64_t TimerWheel::nextWakeTick() const {
+    if (pendingCount == 0) {
+        return UINT64_MAX;
+    }
+    // Level 0 slots still ahead in this revolution; otherwise the next
+    // boundary, where coarser slots cascade
+    const uint64_t boundary = (currentTick | (SLOTS - 1)) + 1;
+    const uint32_t start = static_cast<uint32_t>(currentTick + 1) & (SLOTS - 1);
+    if (start == 0) {
+        return boundary;
+    }
+    const Level& wheel = levels[0];
+    for (uint32_t word = start / 64; word < SLOTS / 64; ++word) {
+        uint64_t bits = wheel.occupied[word];
+        if (word == start / 64) {
+            bits &= ~uint64_t{0} << (start % 64);
+        }
+        if (bits != 0) {
+            return (currentTick & ~uint64_t{SLOTS - 1}) + word * 64 + static_cast<uint32_t>(__builtin_ctzll(bits));
+        }
+    }
+    return boundary;
+}
+
+// ========================================
+// Timer Thread
+// ========================================
+
+void TimerWheel::dispatch(std::vector<std::function<void()>>& expired) {
+    if (!options.executor) {
+        for (auto& work : expired) {
+            work();
+        }
+        return;
+    }
+    for (std::size_t begin = 0; begin < expired.size(); begin += options.batchSize) {
+        const std::size_t end = std::min(expired.size(), begin + options.batchSize);
+        auto batch = std::make_shared<std::vector<std::function<void()>>>(
+            std::make_move_iterator(expired.begin() + static_cast<std::ptrdiff_t>(begin)),
+            std::make_move_iterator(expired.begin() + static_cast<std::ptrdiff_t>(end)));
+        options.executor->post([batch] {
+            for (auto& work : *batch) {
+                work();
+            }
+        });
+    }
+}
+
+void TimerWheel::run() {
+    std::vector<std::function<void()>> expired;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        advance(tickAt(std::chrono::steady_clock::now(), false), expired);
+        if (!expired.empty()) {
+            lock.unlock();
+            dispatch(expired);
+            expired.clear();
+            lock.lock();
+            continue;
+        }
+
+        wakeTick = nextWakeTick();
+        if (wakeTick == UINT64_MAX) {
+            changed.wait(lock);
+        } else {
+            changed.wait_until(lock, origin + options.tick * static_cast<int64_t>(wakeTick));
+        }
+        wakeTick = UINT64_MAX;
+    }
+}
+
+} // namespace BSUIR
@@ -0,0 +1,148 @@
+//
+//  TimerWheel.hpp
+//  cPPiIS Core C++ Hierarchical Timer Wheel
+//
+//  Cancellable timers for periodic refresh, retry backoff and session
+//  expiry across thousands of accounts on one thread
+//
+
+#ifndef TimerWheel_hpp
+#define TimerWheel_hpp
+
+#include "Executor.hpp"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BSUIR {
+
+struct TimerWheelOptions {
+    std::chrono::microseconds tick{10000};          ///< Resolution
+    std::shared_ptr<IExecutor> executor;            ///< Runs expired timers (empty: the timer thread)
+    std::size_t batchSize = 256;                    ///< Timers per executor task
+};
+
+/**
+ * @brief Hierarchical timing wheel with O(1) schedule and cancel
+ *
+ * Time is cut into ticks (10 ms by default). Four levels of 256 slots
+ * cover 2^32 ticks; a timer sits in the slot of the coarsest level its
+ * remaining time needs and moves one level down each time that slot's
+ * turn comes round, so no timer is ever compared against another.
+ * Timers live in a slab with intrusive slot lists: scheduling, cancelling
+ * and firing allocate nothing once the slab has grown.
+ *
+ * Everything due on a tick is unlinked under the lock in one pass and run
+ * as a batch after it is released, inline on the timer thread or posted
+ * to an executor in chunks. The thread sleeps until the next occupied
+ * slot (or the next cascade) rather than waking every tick.
+ *
+ * Timers fire no earlier than asked and at most one tick late. Pending
+ * timers are dropped when the wheel is destroyed.
+ */
+class TimerWheel {
+public:
+    using TimerId = uint64_t;                           ///< 0 is never a valid id
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        std::function<void()> work;
+        uint64_t due = 0;                               ///< Absolute tick
+        uint32_t previous = NONE;
+        uint32_t next = NONE;
+        uint32_t generation = 1;
+        uint8_t level = 0;
+        bool linked = false;
+    };
+
+    struct Level {
+        std::array<uint32_t, SLOTS> heads;
+        std::array<uint64_t, SLOTS / 64> occupied{};     ///< Bit per non-empty slot
+    };
+
+    TimerWheelOptions options;
+    std::chrono::steady_clock::time_point origin;
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> freeNodes;
+    std::array<Level, LEVELS> levels;
+    uint64_t currentTick = 0;                           ///< Last tick processed
+    uint64_t wakeTick = UINT64_MAX;                     ///< Tick the thread sleeps until
+    std::size_t pendingCount = 0;
+    bool stopping = false;
+    std::thread worker;
+
+    uint64_t tickAt(std::chrono::steady_clock::time_point time, bool roundUp) const;
+    void link(uint32_t index, std::vector<std::function<void()>>& expired);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    void cascade(int level, std::vector<std::function<void()>>& expired);
+    void advance(uint64_t tick, std::vector<std::function<void()>>& expired);
+    uint64_t nextWakeTick() const;
+    void dispatch(std::vector<std::function<void()>>& expired);
+    void run();
+
+public:
+    explicit TimerWheel(TimerWheelOptions wheelOptions = {});
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Run work once the delay has elapsed
+     * @param delay Delay from now (zero or negative runs on the next tick;
+     *        beyond the wheel's range, about 500 days at 10 ms, is clamped)
+     * @param work Work item, invoked at most once
+     * @return Id for cancel()
+     */
+    TimerId schedule(std::chrono::microseconds delay, std::function<void()> work);
+
+    /**
+     * @brief Run work after a delay spread uniformly by +-jitter
+     *
+     * Timers created together for many accounts (a restart, a shared
+     * backoff) then fire spread out instead of as one burst.
+     * @param jitter Fraction of the delay, 0..1
+     */
+    TimerId schedule(std::chrono::microseconds delay, double jitter, std::function<void()> work);
+
+    /**
+     * @brief Cancel a pending timer
+     * @return true if the work will not run; false if it already ran,
+     *         is running or the id is stale
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief Number of timers not yet fired or cancelled
+     */
+    std::size_t pending() const;
+
+    /**
+     * @brief Delay spread uniformly by +-jitter (thread-local generator)
+     */
+    static std::chrono::microseconds jittered(std::chrono::microseconds delay, double jitter);
+
+    /**
+     * @brief Process-wide wheel (10 ms ticks, inline delivery); never destroyed
+     */
+    static std::shared_ptr<TimerWheel> shared();
+};
+
+} // namespace BSUIR
+
+#endif /* TimerWheel_hpp */
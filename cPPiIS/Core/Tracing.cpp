@@ -0,0 +1,176 @@
+//
+//  Tracing.cpp
+//  cPPiIS Core C++ Request Tracing Implementation
+//
+
+#include "Tracing.hpp"
+#include "AtomicSnapshot.hpp"
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace BSUIR {
+namespace Tracing {
+
+namespace {
+
+AtomicSnapshot<ISpanSink>& currentSink() {
+    static AtomicSnapshot<ISpanSink> sink;
+    return sink;
+}
+
+// splitmix64: cheap, well-distributed, never shared between threads
+uint64_t splitmix(uint64_t& state) noexcept {
+    uint64_t value = (state += 0x9E3779B97F4A7C15ull);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+uint64_t& randomState() noexcept {
+    static std::atomic<uint64_t> seedCounter{0};
+    thread_local uint64_t state = nowNanoseconds() ^
+        (seedCounter.fetch_add(1, std::memory_order_relaxed) * 0xD1B54A32D192ED03ull);
+    return state;
+}
+
+uint64_t currentThreadId() noexcept {
+    thread_local const uint64_t id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return id;
+}
+
+} // namespace
+
+// ============================================================================
+// MARK: - Internals
+// ============================================================================
+
+namespace detail {
+
+SpanContext& currentContext() noexcept {
+    thread_local SpanContext context;
+    return context;
+}
+
+uint64_t nextId() noexcept {
+    uint64_t id = 0;
+    while (id == 0) {
+        id = splitmix(randomState());
+    }
+    return id;
+}
+
+void emit(SpanRecord&& record) {
+    if (auto sink = currentSink().load()) {
+        record.threadId = currentThreadId();
+        sink->record(record);
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// MARK: - Configuration
+// ============================================================================
+
+void setSink(std::shared_ptr<ISpanSink> sink) {
+    currentSink().store(std::move(sink));
+}
+
+void setSampleRate(double rate) noexcept {
+    uint64_t threshold = 0;
+    if (rate >= 1.0) {
+        threshold = std::numeric_limits<uint64_t>::max();
+    } else if (rate > 0.0) {
+        threshold = static_cast<uint64_t>(rate * 18446744073709551615.0);
+        threshold = threshold == 0 ? 1 : threshold;
+    }
+    detail::sampleThreshold.store(threshold, std::memory_order_relaxed);
+}
+
+void recordSpan(const char* name, SpanContext parent,
+                uint64_t startNanoseconds, uint64_t endNanoseconds,
+                std::initializer_list<Attribute> attributes) {
+    if (!parent.isSampled()) {
+        return;
+    }
+    SpanRecord record;
+    record.traceId = parent.traceId;
+    record.spanId = detail::nextId();
+    record.parentId = parent.spanId;
+    record.name = name;
+    record.startNanoseconds = startNanoseconds;
+    record.endNanoseconds = endNanoseconds < startNanoseconds ? startNanoseconds : endNanoseconds;
+    record.attributes.assign(attributes.begin(), attributes.end());
+    detail::emit(std::move(record));
+}
+
+// ============================================================================
+// MARK: - Span
+// ============================================================================
+
+Span::Span(const char* name, SpanContext context, uint64_t parent) noexcept
+    : spanContext(context), parentId(parent), spanName(name), startNanoseconds(nowNanoseconds()) {
+}
+
+Span Span::start(const char* name) noexcept {
+    const SpanContext parent = current();
+    if (parent.isSampled()) {
+        return child(name, parent);
+    }
+    const uint64_t threshold = detail::sampleThreshold.load(std::memory_order_relaxed);
+    if (threshold == 0 || splitmix(randomState()) > threshold) {
+        return Span();
+    }
+    return Span(name, SpanContext{detail::nextId(), detail::nextId()}, 0);
+}
+
+Span Span::child(const char* name, SpanContext parent) noexcept {
+    if (!parent.isSampled()) {
+        return Span();
+    }
+    return Span(name, SpanContext{parent.traceId, detail::nextId()}, parent.spanId);
+}
+
+void Span::finish(std::initializer_list<Attribute> attributes) const {
+    if (!isActive()) {
+        return;
+    }
+    SpanRecord record;
+    record.traceId = spanContext.traceId;
+    record.spanId = spanContext.spanId;
+    record.parentId = parentId;
+    record.name = spanName;
+    record.startNanoseconds = startNanoseconds;
+    record.endNanoseconds = nowNanoseconds();
+    record.attributes.assign(attributes.begin(), attributes.end());
+    detail::emit(std::move(record));
+}
+
+// ============================================================================
+// MARK: - SpanBuffer
+// ============================================================================
+
+void SpanBuffer::record(const SpanRecord& span) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (spans.size() >= capacity) {
+        ++droppedSpans;
+        return;
+    }
+    spans.push_back(span);
+}
+
+std::vector<SpanRecord> SpanBuffer::drain() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<SpanRecord> result;
+    result.swap(spans);
+    return result;
+}
+
+uint64_t SpanBuffer::dropped() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return droppedSpans;
+}
+
+} // namespace Tracing
+} // namespace BSUIR
@@ -0,0 +1,266 @@
+//
+//  Tracing.hpp
+//  cPPiIS Core C++ Request Tracing
+//
+//  Lightweight spans with monotonic nanosecond timestamps and parent/child
+//  ids, propagated from ApiService through HTTPClient and JSONParser
+//
+
+#ifndef Tracing_hpp
+#define Tracing_hpp
+
+#include "Profiler.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace BSUIR {
+namespace Tracing {
+
+/**
+ * @brief Identity of a span; a zero traceId means "not sampled"
+ */
+struct SpanContext {
+    uint64_t traceId = 0;
+    uint64_t spanId = 0;
+
+    bool isSampled() const noexcept { return traceId != 0; }
+};
+
+/**
+ * @brief Key/value annotation attached to a finished span
+ */
+struct Attribute {
+    const char* key;        ///< Static string
+    std::string text;
+    int64_t number = 0;
+    bool isNumber = false;
+
+    Attribute(const char* name, std::string value) : key(name), text(std::move(value)) {}
+    Attribute(const char* name, const char* value) : key(name), text(value) {}
+    Attribute(const char* name, int64_t value) : key(name), number(value), isNumber(true) {}
+    Attribute(const char* name, int value) : key(name), number(value), isNumber(true) {}
+    Attribute(const char* name, bool value) : key(name), number(value ? 1 : 0), isNumber(true) {}
+};
+
+/**
+ * @brief Finished span handed to the sink
+ */
+struct SpanRecord {
+    uint64_t traceId = 0;
+    uint64_t spanId = 0;
+    uint64_t parentId = 0;          ///< 0 for a trace root
+    const char* name = "";          ///< Static string
+    uint64_t startNanoseconds = 0;  ///< steady_clock, see nowNanoseconds()
+    uint64_t endNanoseconds = 0;
+    uint64_t threadId = 0;          ///< Thread that finished the span
+    std::vector<Attribute> attributes;
+
+    uint64_t durationNanoseconds() const noexcept { return endNanoseconds - startNanoseconds; }
+};
+
+/**
+ * @brief Destination for finished spans
+ *
+ * Called synchronously on the thread that finishes a span, only for
+ * sampled traces. Implementations must be thread-safe and cheap.
+ */
+class ISpanSink {
+public:
+    virtual ~ISpanSink() = default;
+    virtual void record(const SpanRecord& span) = 0;
+};
+
+/**
+ * @brief Sink that buffers spans in memory until drained
+ */
+class SpanBuffer : public ISpanSink {
+private:
+    std::mutex mutex;
+    std::vector<SpanRecord> spans;
+    std::size_t capacity;
+    uint64_t droppedSpans = 0;
+
+public:
+    /**
+     * @param maxSpans Spans beyond this many are dropped until drain()
+     */
+    explicit SpanBuffer(std::size_t maxSpans = 100000) : capacity(maxSpans) {}
+
+    void record(const SpanRecord& span) override;
+
+    /**
+     * @brief Take all buffered spans
+     */
+    std::vector<SpanRecord> drain();
+
+    /**
+     * @brief Spans discarded because the buffer was full
+     */
+    uint64_t dropped();
+};
+
+namespace detail {
+
+// 0 disables tracing; otherwise a trace is sampled when a 64-bit random
+// value falls below the threshold
+inline std::atomic<uint64_t> sampleThreshold{0};
+
+SpanContext& currentContext() noexcept;
+uint64_t nextId() noexcept;
+void emit(SpanRecord&& record);
+
+} // namespace detail
+
+/**
+ * @brief Monotonic timestamp in nanoseconds (steady_clock epoch)
+ */
+inline uint64_t nowNanoseconds() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Convert a steady_clock time point (e.g. from HTTPTimings)
+ */
+inline uint64_t toNanoseconds(std::chrono::steady_clock::time_point point) noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        point.time_since_epoch()).count());
+}
+
+/**
+ * @brief Install the span sink (nullptr disables recording)
+ */
+void setSink(std::shared_ptr<ISpanSink> sink);
+
+/**
+ * @brief Fraction of new traces to sample
+ * @param rate 0 disables tracing (the default), 1 samples every trace
+ */
+void setSampleRate(double rate) noexcept;
+
+/**
+ * @brief Whether new traces may currently be sampled
+ */
+inline bool isEnabled() noexcept {
+    return detail::sampleThreshold.load(std::memory_order_relaxed) != 0;
+}
+
+/**
+ * @brief Span context active on the calling thread
+ */
+inline SpanContext current() noexcept {
+    return detail::currentContext();
+}
+
+/**
+ * @brief Record an already measured interval as a child span
+ * @param name Static span name
+ * @param parent Parent context (nothing is recorded if unsampled)
+ * @param startNanoseconds Start, from nowNanoseconds() or toNanoseconds()
+ * @param endNanoseconds End
+ * @param attributes Optional annotations
+ */
+void recordSpan(const char* name, SpanContext parent,
+                uint64_t startNanoseconds, uint64_t endNanoseconds,
+                std::initializer_list<Attribute> attributes = {});
+
+/**
+ * @brief An open span
+ *
+ * A small copyable value so that it can travel through callbacks and
+ * executor hops; the span is recorded when finish() is called. An
+ * unsampled span is inert and never reads the clock.
+ */
+class Span {
+private:
+    SpanContext spanContext;
+    uint64_t parentId = 0;
+    const char* spanName = "";
+    uint64_t startNanoseconds = 0;
+
+    Span(const char* name, SpanContext context, uint64_t parent) noexcept;
+
+public:
+    Span() = default;
+
+    /**
+     * @brief Child of the thread's current span, or a new root subject to sampling
+     */
+    static Span start(const char* name) noexcept;
+
+    /**
+     * @brief Child of the given context; inert when the parent is unsampled
+     */
+    static Span child(const char* name, SpanContext parent = current()) noexcept;
+
+    bool isActive() const noexcept { return spanContext.isSampled(); }
+    SpanContext context() const noexcept { return spanContext; }
+    uint64_t startTime() const noexcept { return startNanoseconds; }
+
+    /**
+     * @brief Record the span ending now
+     * @param attributes Optional annotations
+     */
+    void finish(std::initializer_list<Attribute> attributes = {}) const;
+};
+
+/**
+ * @brief Makes a context current on this thread for the lifetime of the scope
+ */
+class ContextScope {
+private:
+    SpanContext previous;
+
+public:
+    explicit ContextScope(SpanContext context) noexcept : previous(detail::currentContext()) {
+        detail::currentContext() = context;
+    }
+
+    ~ContextScope() {
+        detail::currentContext() = previous;
+    }
+
+    ContextScope(const ContextScope&) = delete;
+    ContextScope& operator=(const ContextScope&) = delete;
+};
+
+/**
+ * @brief Child span covering a synchronous scope, current while it is open
+ *
+ * The scope also appears on the Profiler timeline while a profiling
+ * session is recording, whether or not the trace is sampled.
+ */
+class ScopedSpan {
+private:
+    Span span;
+    ContextScope scope;
+    Profiler::Scope profile;
+
+public:
+    explicit ScopedSpan(const char* name, SpanContext parent = current()) noexcept
+        : span(Span::child(name, parent)), scope(span.isActive() ? span.context() : parent),
+          profile(name, "core") {}
+
+    ~ScopedSpan() {
+        if (span.isActive()) {
+            span.finish();
+        }
+    }
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+    bool isActive() const noexcept { return span.isActive(); }
+};
+
+} // namespace Tracing
+} // namespace BSUIR
+
+#endif /* Tracing_hpp */
@@ -0,0 +1,338 @@
+//
+//  TrafficCapture.cpp
+//  cPPiIS Core C++ Traffic Record/Replay Implementation
+//
+
+#include "TrafficCapture.hpp"
+#include <cctype>
+#include <cstring>
+
+namespace BSUIR {
+
+namespace {
+
+const char MAGIC[8] = {'B', 'S', 'T', 'R', 'A', 'F', '0', '1'};
+const uint32_t MAX_RECORD_BYTES = 64u * 1024u * 1024u;
+
+uint32_t fnv1a(const uint8_t* data, std::size_t size) {
+    uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// ---- encoding ----
+
+void putFixed32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putString(std::string& out, const std::string& value) {
+    putVarint(out, value.size());
+    out.append(value);
+}
+
+uint64_t nanos(std::chrono::nanoseconds value) {
+    return value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0;
+}
+
+// ---- decoding ----
+
+class Cursor {
+private:
+    const uint8_t* position;
+    const uint8_t* end;
+
+public:
+    Cursor(const uint8_t* begin, std::size_t size) : position(begin), end(begin + size) {}
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && position < end; shift += 7) {
+            uint8_t byte = *position++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+    bool byte(uint8_t& value) {
+        if (position >= end) return false;
+        value = *position++;
+        return true;
+    }
+
+    bool string(std::string& value) {
+        uint64_t length;
+        if (!varint(length) || length > static_cast<uint64_t>(end - position)) return false;
+        value.assign(reinterpret_cast<const char*>(position), static_cast<std::size_t>(length));
+        position += length;
+        return true;
+    }
+
+    bool atEnd() const noexcept { return position == end; }
+};
+
+uint32_t readFixed32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+bool decodeEntry(const uint8_t* payload, std::size_t size, TrafficEntry& entry) {
+    Cursor cursor(payload, size);
+    uint64_t offset, duration, ttfb, status, headerCount;
+    uint8_t method, flags;
+
+    if (!cursor.varint(offset) || !cursor.varint(duration) || !cursor.varint(ttfb) ||
+        !cursor.byte(method) || !cursor.varint(status) || !cursor.byte(flags) ||
+        !cursor.string(entry.request.url) || !cursor.varint(headerCount)) {
+        return false;
+    }
+    if (method > static_cast<uint8_t>(HTTPMethod::Delete)) {
+        return false;
+    }
+
+    for (uint64_t i = 0; i < headerCount; ++i) {
+        std::string name, value;
+        if (!cursor.string(name) || !cursor.string(value)) return false;
+        entry.request.headers.emplace(std::move(name), std::move(value));
+    }
+
+    if (!cursor.string(entry.request.body) || !cursor.string(entry.response.data) ||
+        !cursor.string(entry.response.errorMessage) || !cursor.atEnd()) {
+        return false;
+    }
+
+    entry.offset = std::chrono::nanoseconds(offset);
+    entry.duration = std::chrono::nanoseconds(duration);
+    entry.timeToFirstByte = std::chrono::nanoseconds(ttfb);
+    entry.request.method = static_cast<HTTPMethod>(method);
+    entry.response.statusCode = static_cast<int>(status);
+    entry.response.success = (flags & 0x01) != 0;
+    return true;
+}
+
+// ---- redaction ----
+
+bool isCredentialHeader(const std::string& name) {
+    static const char* const SECRET_HEADERS[] = {"authorization", "cookie", "set-cookie"};
+    for (const char* secret : SECRET_HEADERS) {
+        if (name.size() == std::strlen(secret)) {
+            bool equal = true;
+            for (std::size_t i = 0; i < name.size() && equal; ++i) {
+                equal = std::tolower(static_cast<unsigned char>(name[i])) == secret[i];
+            }
+            if (equal) return true;
+        }
+    }
+    return false;
+}
+
+// Replace the value of every "password":"..." pair with a fixed mask
+std::string maskPasswords(std::string body) {
+    const std::string key = "\"password\"";
+    std::size_t position = 0;
+    while ((position = body.find(key, position)) != std::string::npos) {
+        std::size_t open = body.find('"', body.find(':', position + key.size()));
+        if (open == std::string::npos) break;
+        std::size_t close = open + 1;
+        while (close < body.size() && body[close] != '"') {
+            close += body[close] == '\\' ? 2 : 1;
+        }
+        if (close >= body.size()) break;
+        body.replace(open + 1, close - open - 1, "***");
+        position = open + 5;
+    }
+    return body;
+}
+
+} // namespace
+
+// ========================================
+// TrafficRecorder Implementation
+// ========================================
+
+TrafficRecorder::TrafficRecorder(const std::string& path, bool redact)
+    : epoch(HTTPTimings::Clock::now()), redactCredentials(redact) {
+    file = std::fopen(path.c_str(), "ab");
+    if (file && std::ftell(file) == 0) {
+        std::fwrite(MAGIC, 1, sizeof(MAGIC), file);
+        std::fflush(file);
+    }
+}
+
+TrafficRecorder::~TrafficRecorder() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool TrafficRecorder::isOpen() const noexcept {
+    return file != nullptr;
+}
+
+void TrafficRecorder::record(const HTTPRequest& request, const HTTPResponse& response) {
+    if (!file) {
+        return;
+    }
+
+    const HTTPTimings& timings = response.timings;
+    const bool hasStart = HTTPTimings::isSet(timings.requestStart);
+    const auto start = hasStart ? timings.requestStart : HTTPTimings::Clock::now();
+    const auto end = HTTPTimings::isSet(timings.responseEnd) ? timings.responseEnd : start;
+    const auto firstByte = HTTPTimings::isSet(timings.firstByte) ? timings.firstByte : start;
+
+    std::string payload;
+    payload.reserve(64 + request.url.size() + request.body.size() + response.data.size());
+    putVarint(payload, nanos(start - epoch));
+    putVarint(payload, nanos(end - start));
+    putVarint(payload, nanos(firstByte - start));
+    payload.push_back(static_cast<char>(request.method));
+    putVarint(payload, static_cast<uint64_t>(response.statusCode < 0 ? 0 : response.statusCode));
+    payload.push_back(static_cast<char>(response.success ? 0x01 : 0x00));
+    putString(payload, request.url);
+
+    std::size_t headerCount = 0;
+    for (const auto& header : request.headers) {
+        headerCount += redactCredentials && isCredentialHeader(header.first) ? 0 : 1;
+    }
+    putVarint(payload, headerCount);
+    for (const auto& header : request.headers) {
+        if (redactCredentials && isCredentialHeader(header.first)) continue;
+        putString(payload, header.first);
+        putString(payload, header.second);
+    }
+
+    putString(payload, redactCredentials ? maskPasswords(request.body) : request.body);
+    putString(payload, response.data);
+    putString(payload, response.errorMessage);
+
+    std::string record;
+    record.reserve(payload.size() + 8);
+    putFixed32(record, static_cast<uint32_t>(payload.size()));
+    record.append(payload);
+    putFixed32(record, fnv1a(reinterpret_cast<const uint8_t*>(payload.data()), payload.size()));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::fwrite(record.data(), 1, record.size(), file);
+    std::fflush(file);
+}
+
+// ========================================
+// Capture Reading
+// ========================================
+
+std::vector<TrafficEntry> readTrafficCapture(const std::string& path, std::string* error) {
+    std::vector<TrafficEntry> entries;
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        if (error) *error = "Cannot open " + path;
+        return entries;
+    }
+
+    char magic[sizeof(MAGIC)];
+    if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        if (error) *error = path + " is not a traffic capture";
+        std::fclose(file);
+        return entries;
+    }
+
+    std::vector<uint8_t> payload;
+    uint8_t header[4];
+    while (std::fread(header, 1, 4, file) == 4) {
+        const uint32_t size = readFixed32(header);
+        if (size > MAX_RECORD_BYTES) break;
+
+        payload.resize(size + 4);
+        if (std::fread(payload.data(), 1, payload.size(), file) != payload.size()) break;
+        if (readFixed32(payload.data() + size) != fnv1a(payload.data(), size)) break;
+
+        TrafficEntry entry;
+        if (!decodeEntry(payload.data(), size, entry)) break;
+        entries.push_back(std::move(entry));
+    }
+
+    std::fclose(file);
+    return entries;
+}
+
+std::string trafficKey(const HTTPRequest& request) {
+    std::size_t path = 0;
+    std::size_t scheme = request.url.find("://");
+    if (scheme != std::string::npos) {
+        path = request.url.find('/', scheme + 3);
+    }
+    return std::string(httpMethodName(request.method)) + " " +
+           (path == std::string::npos ? std::string("/") : request.url.substr(path));
+}
+
+// ========================================
+// ReplayTransport Implementation
+// ========================================
+
+ReplayTransport::ReplayTransport(std::vector<TrafficEntry> entries, Pacing replayPacing,
+                                 std::shared_ptr<TimerWheel> timer)
+    : pacing(replayPacing) {
+    for (auto& entry : entries) {
+        queues[trafficKey(entry.request)].entries.push_back(std::move(entry));
+    }
+    if (pacing == Pacing::Recorded) {
+        scheduler = timer ? std::move(timer) : TimerWheel::shared();
+    }
+}
+
+void ReplayTransport::send(const HTTPRequest& request, ResponseCallback callback) {
+    const auto requestStart = HTTPTimings::Clock::now();
+    HTTPResponse response;
+    std::chrono::nanoseconds delay{0};
+    std::chrono::nanoseconds firstByte{0};
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = queues.find(trafficKey(request));
+        if (found == queues.end() || found->second.entries.empty()) {
+            response.errorMessage = "No recorded response for " + trafficKey(request);
+        } else {
+            Queue& queue = found->second;
+            const TrafficEntry& entry = queue.entries[queue.next];
+            queue.next = (queue.next + 1) % queue.entries.size();
+            response = entry.response;
+            delay = entry.duration;
+            firstByte = entry.timeToFirstByte;
+        }
+    }
+
+    response.timings = HTTPTimings{};
+    response.timings.requestStart = requestStart;
+    response.timings.connectEnd = requestStart;
+
+    if (pacing == Pacing::AsFastAsPossible) {
+        response.timings.firstByte = response.timings.responseEnd = HTTPTimings::Clock::now();
+        callback(response);
+        return;
+    }
+
+    const auto ttfb = std::chrono::duration_cast<HTTPTimings::Clock::duration>(firstByte);
+    scheduler->schedule(std::chrono::duration_cast<std::chrono::microseconds>(delay),
+                        [callback = std::move(callback), response = std::move(response), ttfb]() mutable {
+        response.timings.firstByte = response.timings.requestStart + ttfb;
+        response.timings.responseEnd = HTTPTimings::Clock::now();
+        callback(response);
+    });
+}
+
+} // namespace BSUIR
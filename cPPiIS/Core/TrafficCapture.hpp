@@ -0,0 +1,128 @@
+//
+//  TrafficCapture.hpp
+//  cPPiIS Core C++ Traffic Record/Replay
+//
+//  Compact append-only capture of HTTP exchanges and a transport that
+//  serves them back for reproducible parser and ApiService benchmarks
+//
+
+#ifndef TrafficCapture_hpp
+#define TrafficCapture_hpp
+
+#include "HTTPTransport.hpp"
+#include "TimerWheel.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace BSUIR {
+
+/**
+ * @brief One recorded request/response pair
+ */
+struct TrafficEntry {
+    std::chrono::nanoseconds offset{0};     ///< Request start relative to the recording start
+    std::chrono::nanoseconds duration{0};   ///< Request start to response end
+    std::chrono::nanoseconds timeToFirstByte{0};
+    HTTPRequest request;
+    HTTPResponse response;
+};
+
+/**
+ * @brief Appends exchanges to a capture file
+ *
+ * File layout: the 8-byte magic "BSTRAF01" followed by records of
+ * [u32 payload length][payload][u32 FNV-1a of payload], all little
+ * endian, with integers inside the payload varint-encoded. Each record
+ * is written with a single fwrite, so a crash can only truncate the
+ * last record, which readers detect and skip. Thread-safe.
+ */
+class TrafficRecorder {
+private:
+    std::FILE* file = nullptr;
+    std::mutex mutex;
+    HTTPTimings::Clock::time_point epoch;
+    bool redactCredentials;
+
+public:
+    /**
+     * @brief Open (or create) a capture file for appending
+     * @param path Capture file path
+     * @param redact Drop Cookie/Authorization headers and mask passwords in bodies
+     */
+    explicit TrafficRecorder(const std::string& path, bool redact = true);
+    ~TrafficRecorder();
+
+    TrafficRecorder(const TrafficRecorder&) = delete;
+    TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+    /**
+     * @brief Check whether the file was opened successfully
+     */
+    bool isOpen() const noexcept;
+
+    /**
+     * @brief Append one exchange
+     * @param request Request as sent to the transport
+     * @param response Response including transport timings
+     */
+    void record(const HTTPRequest& request, const HTTPResponse& response);
+};
+
+/**
+ * @brief Reads all intact records from a capture file
+ * @param path Capture file path
+ * @param error Receives a description if the file is missing or not a capture
+ * @return Entries in file order (a truncated or corrupt tail is ignored)
+ */
+std::vector<TrafficEntry> readTrafficCapture(const std::string& path, std::string* error = nullptr);
+
+/**
+ * @brief Match key for replay: method plus path and query, host ignored
+ */
+std::string trafficKey(const HTTPRequest& request);
+
+/**
+ * @brief Transport answering requests from a capture
+ *
+ * Requests are matched by method, path and query; repeated requests to
+ * the same endpoint receive the recorded responses in order, cycling
+ * when exhausted. Requests with no recording fail with status 0.
+ */
+class ReplayTransport : public IHTTPTransport {
+public:
+    enum class Pacing {
+        Recorded,       ///< Deliver after the recorded request duration
+        AsFastAsPossible    ///< Deliver synchronously from send()
+    };
+
+private:
+    struct Queue {
+        std::vector<TrafficEntry> entries;
+        std::size_t next = 0;
+    };
+
+    std::mutex mutex;
+    std::map<std::string, Queue> queues;
+    Pacing pacing;
+    std::shared_ptr<TimerWheel> scheduler;
+
+public:
+    /**
+     * @param scheduler Timer for Recorded pacing (TimerWheel::shared() if
+     *        empty); responses arrive up to one of its ticks late
+     */
+    ReplayTransport(std::vector<TrafficEntry> entries, Pacing replayPacing,
+                    std::shared_ptr<TimerWheel> scheduler = nullptr);
+
+    void send(const HTTPRequest& request, ResponseCallback callback) override;
+};
+
+} // namespace BSUIR
+
+#endif /* TrafficCapture_hpp */
@@ -0,0 +1,380 @@
+//
+//  Watchdog.cpp
+//  cPPiIS Core C++ Stall Detector Implementation
+//
+
+#include "Watchdog.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+
+#if __has_include(<execinfo.h>)
+#  include <execinfo.h>
+#  define BSUIR_WATCHDOG_CAN_SAMPLE 1
+#else
+#  define BSUIR_WATCHDOG_CAN_SAMPLE 0
+#endif
+
+namespace BSUIR {
+namespace Watchdog {
+
+namespace {
+
+constexpr int MAX_FRAMES = 48;
+constexpr int SAMPLE_SIGNAL = SIGPROF;
+constexpr auto MIN_MONITOR_INTERVAL = std::chrono::milliseconds(1);
+constexpr auto MAX_MONITOR_INTERVAL = std::chrono::milliseconds(50);
+
+uint64_t nowNanoseconds() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Invocation state of one thread, shared with the monitor
+ *
+ * Only the owning thread writes sequence and start; the monitor requests
+ * a sample by storing the sequence it wants in sampleRequested and
+ * signalling the thread, whose handler fills frames and publishes
+ * sampledSequence. signalMutex is held by the monitor from its abandoned
+ * check until pthread_kill returns and by the owner while it abandons the
+ * slot, so a thread never exits, or hands its slot on, mid-signal.
+ */
+struct ThreadSlot {
+    std::mutex signalMutex;
+    pthread_t thread;
+    uint64_t nextSequence = 0;
+    std::atomic<uint64_t> sequence{0};          ///< Innermost open scope, 0 when idle
+    std::atomic<uint64_t> start{0};
+    std::atomic<uint64_t> sampleRequested{0};
+    std::atomic<uint64_t> sampledSequence{0};
+    std::atomic<bool> abandoned{false};
+    void* frames[MAX_FRAMES] = {};
+    int frameCount = 0;
+};
+
+struct State {
+    std::mutex mutex;
+    Options options;
+    std::deque<Stall> history;
+    // Slots are leaked and recycled once their thread exits, so the
+    // monitor and signal handler never see a dangling pointer
+    std::vector<ThreadSlot*> slots;
+    std::atomic<int64_t> sampleAfterNanoseconds{0};
+    bool monitorStarted = false;
+
+    Metrics::Histogram* durations[2];
+    Metrics::Counter* stalls[2];
+
+    State() {
+        auto& registry = Metrics::MetricsRegistry::shared();
+        for (Category category : {Category::Callback, Category::Observer}) {
+            const Metrics::Labels labels{{"kind", categoryName(category)}};
+            const auto index = static_cast<std::size_t>(category);
+            durations[index] = &registry.histogram("bsuir_invocation_duration_seconds", labels,
+                                                   "Time spent in user callbacks and observers");
+            stalls[index] = &registry.counter("bsuir_stalls_total", labels,
+                                              "Callback and observer invocations over the watchdog budget");
+        }
+    }
+
+    static State& instance() {
+        static State* state = new State();
+        return *state;
+    }
+};
+
+thread_local ThreadSlot* currentSlot = nullptr;
+
+struct SlotOwner {
+    ~SlotOwner() {
+        if (currentSlot) {
+            std::lock_guard<std::mutex> signalLock(currentSlot->signalMutex);
+            currentSlot->sequence.store(0, std::memory_order_relaxed);
+            currentSlot->abandoned.store(true, std::memory_order_release);
+            currentSlot = nullptr;
+        }
+    }
+};
+
+ThreadSlot* threadSlot() {
+    if (currentSlot) {
+        return currentSlot;
+    }
+    thread_local SlotOwner owner;
+    State& state = State::instance();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    ThreadSlot* slot = nullptr;
+    for (ThreadSlot* candidate : state.slots) {
+        if (candidate->abandoned.load(std::memory_order_acquire)) {
+            slot = candidate;
+            break;
+        }
+    }
+    if (!slot) {
+        slot = new ThreadSlot();
+        state.slots.push_back(slot);
+    }
+    std::lock_guard<std::mutex> signalLock(slot->signalMutex);
+    slot->thread = pthread_self();
+    slot->sampleRequested.store(0, std::memory_order_relaxed);
+    slot->sampledSequence.store(0, std::memory_order_relaxed);
+    slot->abandoned.store(false, std::memory_order_release);
+    currentSlot = slot;
+    return slot;
+}
+
+std::string demangle(const char* name) {
+    int status = 0;
+    char* readable = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status != 0 || !readable) {
+        return name;
+    }
+    std::string result(readable);
+    std::free(readable);
+    return result;
+}
+
+#if BSUIR_WATCHDOG_CAN_SAMPLE
+
+// Disposition SAMPLE_SIGNAL had before the monitor started; written once before installing ours
+struct sigaction previousAction = {};
+
+/**
+ * @brief Hand a signal that was not a sample request to whoever handled SAMPLE_SIGNAL before us
+ */
+void chainSampleSignal(int signal, siginfo_t* info, void* context) {
+    if (previousAction.sa_flags & SA_SIGINFO) {
+        if (previousAction.sa_sigaction) {
+            previousAction.sa_sigaction(signal, info, context);
+        }
+    } else if (previousAction.sa_handler != SIG_DFL && previousAction.sa_handler != SIG_IGN) {
+        previousAction.sa_handler(signal);
+    }
+    // SIG_DFL would terminate the process on SIGPROF; a stray signal is dropped instead
+}
+
+void onSampleSignal(int signal, siginfo_t* info, void* context) {
+    const int savedErrno = errno;
+    bool sampled = false;
+    if (ThreadSlot* slot = currentSlot) {
+        const uint64_t requested = slot->sampleRequested.load(std::memory_order_acquire);
+        if (requested != 0 && requested == slot->sequence.load(std::memory_order_relaxed) &&
+            requested != slot->sampledSequence.load(std::memory_order_relaxed)) {
+            slot->frameCount = backtrace(slot->frames, MAX_FRAMES);
+            slot->sampledSequence.store(requested, std::memory_order_release);
+            sampled = true;
+        }
+    }
+    errno = savedErrno;
+    if (!sampled) {
+        chainSampleSignal(signal, info, context);
+    }
+}
+
+/**
+ * @brief Signal every thread whose innermost scope outlived sampleAfter
+ */
+void monitorLoop() {
+    State& state = State::instance();
+    std::vector<ThreadSlot*> slots;
+    while (true) {
+        const int64_t sampleAfter = state.sampleAfterNanoseconds.load(std::memory_order_relaxed);
+        const auto interval = sampleAfter > 0
+            ? std::clamp<std::chrono::nanoseconds>(std::chrono::nanoseconds(sampleAfter / 2),
+                                                   MIN_MONITOR_INTERVAL, MAX_MONITOR_INTERVAL)
+            : std::chrono::nanoseconds(MAX_MONITOR_INTERVAL);
+        std::this_thread::sleep_for(interval);
+        if (sampleAfter <= 0) {
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            slots = state.slots;
+        }
+        const uint64_t now = nowNanoseconds();
+        for (ThreadSlot* slot : slots) {
+            std::lock_guard<std::mutex> signalLock(slot->signalMutex);
+            if (slot->abandoned.load(std::memory_order_acquire)) {
+                continue;
+            }
+            const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const uint64_t start = slot->start.load(std::memory_order_acquire);
+            if (sequence == 0 || sequence != slot->sequence.load(std::memory_order_acquire) ||
+                slot->sampleRequested.load(std::memory_order_relaxed) == sequence ||
+                now < start + static_cast<uint64_t>(sampleAfter)) {
+                continue;
+            }
+            slot->sampleRequested.store(sequence, std::memory_order_release);
+            pthread_kill(slot->thread, SAMPLE_SIGNAL);
+        }
+    }
+}
+
+void startMonitor(State& state) {
+    if (state.monitorStarted) {
+        return;
+    }
+    state.monitorStarted = true;
+
+    // backtrace() loads the unwinder on first use, which is not signal-safe
+    void* warmup[1];
+    backtrace(warmup, 1);
+
+    // An existing handler (a sampling profiler, say) keeps receiving the signals that are not ours
+    struct sigaction action = {};
+    action.sa_sigaction = onSampleSignal;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    sigaction(SAMPLE_SIGNAL, &action, &previousAction);
+
+    std::thread(monitorLoop).detach();
+}
+
+std::vector<std::string> symbolise(ThreadSlot& slot) {
+    std::vector<std::string> stack;
+    char** symbols = backtrace_symbols(slot.frames, slot.frameCount);
+    if (!symbols) {
+        return stack;
+    }
+    // Skip the signal handler and the trampoline that invoked it
+    for (int i = std::min(2, slot.frameCount); i < slot.frameCount; ++i) {
+        stack.emplace_back(symbols[i]);
+    }
+    std::free(symbols);
+    return stack;
+}
+
+#else
+
+void startMonitor(State&) {
+    BSUIR_LOG_WARNING(Executor, "⚠️ Watchdog stack sampling is not supported on this platform");
+}
+
+std::vector<std::string> symbolise(ThreadSlot&) {
+    return {};
+}
+
+#endif
+
+void report(Stall stall) {
+    std::string message;
+    for (const auto& frame : stall.stack) {
+        message += "\n    ";
+        message += frame;
+    }
+    BSUIR_LOG_WARNING(Executor, "🐢 Slow ", categoryName(stall.category), " ", stall.name, " (", stall.subject,
+                      "): ", std::chrono::duration<double, std::milli>(stall.duration).count(), " ms", message);
+
+    State& state = State::instance();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.options.historySize == 0) {
+        return;
+    }
+    while (state.history.size() >= state.options.historySize) {
+        state.history.pop_front();
+    }
+    state.history.push_back(std::move(stall));
+}
+
+} // namespace
+
+const char* categoryName(Category category) noexcept {
+    switch (category) {
+        case Category::Callback: return "callback";
+        case Category::Observer: return "observer";
+    }
+    return "unknown";
+}
+
+// ============================================================================
+// MARK: - Configuration
+// ============================================================================
+
+void configure(const Options& options) {
+    State& state = State::instance();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.options = options;
+    while (state.history.size() > options.historySize) {
+        state.history.pop_front();
+    }
+    state.sampleAfterNanoseconds.store(options.sampleAfter.count(), std::memory_order_relaxed);
+    detail::budgetNanoseconds.store(options.budget.count(), std::memory_order_relaxed);
+    if (options.budget.count() > 0 && options.sampleAfter.count() > 0) {
+        startMonitor(state);
+    }
+}
+
+Options options() {
+    State& state = State::instance();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.options;
+}
+
+std::vector<Stall> recentStalls() {
+    State& state = State::instance();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return {state.history.begin(), state.history.end()};
+}
+
+// ============================================================================
+// MARK: - Scope
+// ============================================================================
+
+Scope::Scope(Category scopeCategory, const char* scopeName, const std::type_info& scopeSubject) noexcept
+    : category(scopeCategory), name(scopeName), subject(&scopeSubject), startNanoseconds(0) {
+    if (!isEnabled()) {
+        return;
+    }
+    ThreadSlot* slot = threadSlot();
+    previousSequence = slot->sequence.load(std::memory_order_relaxed);
+    previousStart = slot->start.load(std::memory_order_relaxed);
+    sequence = ++slot->nextSequence;
+    startNanoseconds = nowNanoseconds();
+    slot->start.store(startNanoseconds, std::memory_order_release);
+    slot->sequence.store(sequence, std::memory_order_release);
+}
+
+Scope::~Scope() {
+    if (sequence == 0) {
+        return;
+    }
+    const uint64_t elapsed = nowNanoseconds() - startNanoseconds;
+    ThreadSlot* slot = currentSlot;
+    slot->sequence.store(previousSequence, std::memory_order_release);
+    slot->start.store(previousStart, std::memory_order_release);
+
+    State& state = State::instance();
+    const auto index = static_cast<std::size_t>(category);
+    state.durations[index]->record(elapsed);
+
+    const int64_t budget = detail::budgetNanoseconds.load(std::memory_order_relaxed);
+    if (budget <= 0 || elapsed <= static_cast<uint64_t>(budget)) {
+        return;
+    }
+    state.stalls[index]->add();
+
+    Stall stall;
+    stall.category = category;
+    stall.name = name;
+    stall.subject = demangle(subject->name());
+    stall.duration = std::chrono::nanoseconds(elapsed);
+    stall.timestamp = std::chrono::system_clock::now();
+    if (slot->sampledSequence.load(std::memory_order_acquire) == sequence) {
+        stall.stack = symbolise(*slot);
+    }
+    report(std::move(stall));
+}
+
+} // namespace Watchdog
+} // namespace BSUIR
@@ -0,0 +1,125 @@
+//
+//  Watchdog.hpp
+//  cPPiIS Core C++ Stall Detector
+//
+//  Times user callbacks and observer notifications against a budget and
+//  reports the offenders through the metrics registry and the log
+//
+
+#ifndef Watchdog_hpp
+#define Watchdog_hpp
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace BSUIR {
+namespace Watchdog {
+
+/**
+ * @brief Kind of timed invocation
+ */
+enum class Category : uint8_t {
+    Callback,   ///< ApiService result callback
+    Observer    ///< Observer notification
+};
+
+const char* categoryName(Category category) noexcept;
+
+/**
+ * @brief Watchdog configuration
+ */
+struct Options {
+    /// Invocations running longer are reported as stalls (0 disables the watchdog)
+    std::chrono::nanoseconds budget = std::chrono::milliseconds(16);
+
+    /// Capture a stack sample of an invocation still running after this long
+    /// (0: off). Sampling starts a monitor thread and signals the stalled
+    /// thread with SIGPROF, which can interrupt its blocking system calls.
+    /// The first time, the process-wide SIGPROF handler is replaced; a
+    /// handler installed earlier still receives every SIGPROF that is not
+    /// a sample request, but one installed later takes sampling over.
+    std::chrono::nanoseconds sampleAfter = std::chrono::nanoseconds::zero();
+
+    /// Stalls kept for recentStalls()
+    std::size_t historySize = 64;
+};
+
+/**
+ * @brief One invocation that exceeded the budget
+ */
+struct Stall {
+    Category category = Category::Callback;
+    std::string name;                                   ///< e.g. "api.callback", "onDataUpdated"
+    std::string subject;                                ///< Demangled observer or result type
+    std::chrono::nanoseconds duration{0};
+    std::chrono::system_clock::time_point timestamp;    ///< When the invocation finished
+    std::vector<std::string> stack;                     ///< Symbolised frames; empty without a sample
+};
+
+namespace detail {
+
+inline std::atomic<int64_t> budgetNanoseconds{16'000'000};
+
+} // namespace detail
+
+/**
+ * @brief Whether invocations are currently timed (a single relaxed load)
+ */
+inline bool isEnabled() noexcept {
+    return detail::budgetNanoseconds.load(std::memory_order_relaxed) > 0;
+}
+
+/**
+ * @brief Replace the configuration
+ */
+void configure(const Options& options);
+
+/**
+ * @brief Current configuration
+ */
+Options options();
+
+/**
+ * @brief Most recent stalls, oldest first
+ */
+std::vector<Stall> recentStalls();
+
+/**
+ * @brief Times one callback or observer invocation
+ *
+ * Every invocation is recorded in bsuir_invocation_duration_seconds;
+ * one over the budget also increments bsuir_stalls_total, is logged as a
+ * warning and is kept for recentStalls(). Scopes may nest; a stack
+ * sample belongs to the innermost scope open when it was taken.
+ */
+class Scope {
+private:
+    Category category;
+    const char* name;
+    const std::type_info* subject;
+    uint64_t startNanoseconds;
+    uint64_t sequence = 0;
+    uint64_t previousSequence = 0;
+    uint64_t previousStart = 0;
+
+public:
+    /**
+     * @param scopeCategory Kind of invocation
+     * @param scopeName Static name of the entry point
+     * @param scopeSubject Type identifying the offender (observer class, result type)
+     */
+    Scope(Category scopeCategory, const char* scopeName, const std::type_info& scopeSubject) noexcept;
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+} // namespace Watchdog
+} // namespace BSUIR
+
+#endif /* Watchdog_hpp */